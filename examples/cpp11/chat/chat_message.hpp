@@ -11,9 +11,9 @@
 #ifndef CHAT_MESSAGE_HPP
 #define CHAT_MESSAGE_HPP
 
-#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include "asio/transmit/length_prefix.hpp"
 
 class chat_message
 {
@@ -63,12 +63,16 @@ public:
       body_length_ = max_body_length;
   }
 
+  // The header is the body length as a 4 byte integer in network byte order.
+  static asio::length_prefix prefix()
+  {
+    return asio::length_prefix::fixed(header_length, max_body_length);
+  }
+
   bool decode_header()
   {
-    char header[header_length + 1] = "";
-    std::strncat(header, data_, header_length);
-    body_length_ = std::atoi(header);
-    if (body_length_ > max_body_length)
+    asio::error_code ec;
+    if (prefix().decode(data_, header_length, body_length_, ec) == 0)
     {
       body_length_ = 0;
       return false;
@@ -78,9 +82,7 @@ public:
 
   void encode_header()
   {
-    char header[header_length + 1] = "";
-    std::sprintf(header, "%4d", static_cast<int>(body_length_));
-    std::memcpy(data_, header, header_length);
+    prefix().encode(body_length_, data_);
   }
 
 private:
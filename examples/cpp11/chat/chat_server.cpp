@@ -14,7 +14,9 @@
 #include <list>
 #include <memory>
 #include <set>
+#include <string>
 #include <utility>
+#include <vector>
 #include "chat_message.hpp"
 
 // #include "asio.hpp"
@@ -22,7 +24,7 @@
 #include "asio/buffer/buffer.hpp"
 #include "asio/ip/tcp.hpp"
 #include "asio/transmit/write.hpp"
-#include "asio/transmit/read.hpp"
+#include "asio/transmit/read_frames.hpp"
 
 using asio::ip::tcp;
 
@@ -83,14 +85,15 @@ class chat_session
 public:
   chat_session(tcp::socket socket, chat_room& room)
     : socket_(std::move(socket)),
-      room_(room)
+      room_(room),
+      write_frames_(chat_message::prefix())
   {
   }
 
   void start()
   {
     room_.join(shared_from_this());
-    do_read_header();
+    do_read();
   }
 
   void deliver(const chat_message& msg)
@@ -104,35 +107,26 @@ public:
   }
 
 private:
-  void do_read_header()
+  void do_read()
   {
+    // Each completion delivers every message that has been received in full.
     auto self(shared_from_this());
-    asio::async_read(socket_,
-        asio::buffer(read_msg_.data(), chat_message::header_length),
-        [this, self](std::error_code ec, std::size_t /*length*/)
-        {
-          if (!ec && read_msg_.decode_header())
-          {
-            do_read_body();
-          }
-          else
-          {
-            room_.leave(shared_from_this());
-          }
-        });
-  }
-
-  void do_read_body()
-  {
-    auto self(shared_from_this());
-    asio::async_read(socket_,
-        asio::buffer(read_msg_.body(), read_msg_.body_length()),
-        [this, self](std::error_code ec, std::size_t /*length*/)
+    asio::async_read_frames(socket_, asio::dynamic_buffer(read_buffer_),
+        chat_message::prefix(), read_frames_,
+        [this, self](std::error_code ec, std::size_t length)
         {
           if (!ec)
           {
-            room_.deliver(read_msg_);
-            do_read_header();
+            for (auto frame: read_frames_)
+            {
+              chat_message msg;
+              msg.body_length(frame.size());
+              std::memcpy(msg.body(), frame.data(), msg.body_length());
+              msg.encode_header();
+              room_.deliver(msg);
+            }
+            read_buffer_.erase(0, length);
+            do_read();
           }
           else
           {
@@ -143,15 +137,21 @@ private:
 
   void do_write()
   {
+    // Write all of the queued messages with one gather write. Their headers
+    // are encoded by write_frames_, which is reused for every write. The write
+    // is given a view of its buffers, so that they are not copied.
+    write_frames_.clear();
+    for (auto& msg: write_msgs_)
+      write_frames_.push_back(asio::buffer(msg.body(), msg.body_length()));
+
     auto self(shared_from_this());
-    asio::async_write(socket_,
-        asio::buffer(write_msgs_.front().data(),
-          write_msgs_.front().length()),
+    asio::async_write(socket_, write_frames_.buffers(),
         [this, self](std::error_code ec, std::size_t /*length*/)
         {
           if (!ec)
           {
-            write_msgs_.pop_front();
+            write_msgs_.erase(write_msgs_.begin(),
+                write_msgs_.begin() + write_frames_.frames());
             if (!write_msgs_.empty())
             {
               do_write();
@@ -166,8 +166,10 @@ private:
 
   tcp::socket socket_;
   chat_room& room_;
-  chat_message read_msg_;
+  std::string read_buffer_;
+  std::vector<asio::const_buffer> read_frames_;
   chat_message_queue write_msgs_;
+  asio::framed_buffers write_frames_;
 };
 
 //----------------------------------------------------------------------
@@ -10,6 +10,7 @@
 #include <deque>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #define ENABLE_HEARTBEAT
 
@@ -69,17 +70,20 @@ private:
 private:
     asio::io_context io_context_;
     tcp::socket socket_;
+    asio::parallel_connect_canceller connect_canceller_;
     tcp::resolver::results_type endpoints_;
     steady_timer heartbeat_timer_;
     std::string read_msg_;
+    std::vector<asio::const_buffer> read_frames_;
     std::deque<std::string> write_msgs_;
     OnRecvCallback on_recv_;
     std::thread io_thread_;
     bool is_connected_;
+    bool is_closed_;
 };
 
 LogClientImpl::LogClientImpl(const std::string &host, const std::string &port)
-    : socket_(io_context_), heartbeat_timer_(io_context_), is_connected_(false)
+    : socket_(io_context_), heartbeat_timer_(io_context_), is_connected_(false), is_closed_(false)
 {
     // 在构造函数内部解析主机和端口
     tcp::resolver resolver(io_context_);
@@ -153,25 +157,37 @@ void LogClientImpl::set_callback(OnRecvCallback func)
 
 void LogClientImpl::close()
 {
+    // The connection attempts use their own sockets, so closing socket_ alone
+    // would not stop a connect in progress.
     asio::post(io_context_, [this]()
-               { socket_.close(); });
+               {
+        is_closed_ = true;
+        connect_canceller_.cancel();
+        socket_.close(); });
 }
 
 void LogClientImpl::start_connect()
 {
+    if (is_closed_)
+        return;
+
     THROW_C3LOG_VERBOSE("start_connect ...");
-    asio::async_connect(socket_, endpoints_,
-                        [this](std::error_code ec, tcp::endpoint endpoint)
-                        {
-                            if (!ec)
-                            {
-                                on_connect();
-                            }
-                            else
-                            {
-                                retry_connect("start_connect");
-                            }
-                        });
+    asio::async_connect_parallel(socket_, endpoints_, std::chrono::milliseconds(250), connect_canceller_,
+                                 [this](std::error_code ec, tcp::endpoint endpoint)
+                                 {
+                                     if (ec == asio::error::operation_aborted)
+                                     {
+                                         return;
+                                     }
+                                     else if (!ec)
+                                     {
+                                         on_connect();
+                                     }
+                                     else
+                                     {
+                                         retry_connect("start_connect");
+                                     }
+                                 });
 }
 
 void LogClientImpl::on_connect()
@@ -214,14 +230,15 @@ void LogClientImpl::retry_connect(const char *err)
 
 void LogClientImpl::do_async_read()
 {
-    asio::async_read_until(socket_, asio::dynamic_buffer(read_msg_), '\n', [this](std::error_code ec, std::size_t len)
+    asio::async_read_frames(socket_, asio::dynamic_buffer(read_msg_), '\n', read_frames_, [this](std::error_code ec, std::size_t len)
                            {
         THROW_C3LOG_VERBOSE("do_async_read len: %ld", len);
         if (!ec)
         {
             if (on_recv_)
             {
-                on_recv_(this, read_msg_.data(), read_msg_.length());
+                for (const asio::const_buffer &frame : read_frames_)
+                    on_recv_(this, static_cast<const char *>(frame.data()), static_cast<int>(frame.size()));
             }
 
             read_msg_.erase(0, len);
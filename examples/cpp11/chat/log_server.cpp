@@ -1,7 +1,7 @@
-#include <deque>
 #include <iostream>
 #include <set>
 #include <thread>
+#include <vector>
 #ifdef __linux__
 #include <pthread.h>
 #endif
@@ -55,14 +55,20 @@ class LogSession : public std::enable_shared_from_this<LogSession>
   private:
     void do_async_read();
 
-    void do_async_write();
+    enum
+    {
+        max_queued_bytes = 4 * 1024 * 1024,
+        resume_queued_bytes = 1024 * 1024,
+        max_unsent_bytes = 64 * 1024
+    };
 
     tcp::socket socket_;
     LogChannel &channel_;
     std::string name_;
-    std::string ip_port_;
+    char ip_port_[64];
     std::string read_msg_;
-    std::deque<std::string> write_msgs_;
+    std::vector<asio::const_buffer> read_frames_;
+    asio::backpressure_writer<tcp> writer_;
     OnRecvCallback on_recv_;
 };
 
@@ -132,10 +138,18 @@ class LogServerImpl
 //----------------------------------------------------------------------
 
 LogSession::LogSession(tcp::socket socket, LogChannel &room)
-    : socket_(std::move(socket)), channel_(room), name_("unknown"), ip_port_(std::string())
+    : socket_(std::move(socket)), channel_(room), name_("unknown"),
+      writer_(socket_, max_queued_bytes, resume_queued_bytes, asio::backpressure_writer<tcp>::drop_oldest)
 {
+    // Keep a slow reader from pinning large kernel send buffers. Not all
+    // platforms support this, in which case only the user space queue is bounded.
+    std::error_code ignored_ec;
+    writer_.kernel_low_watermark(max_unsent_bytes, ignored_ec);
+
+    // Formatted in place, so accepting a session does not allocate for it.
     tcp::endpoint endpoint = socket_.remote_endpoint();
-    ip_port_ = endpoint.address().to_string() + ":" + std::to_string(endpoint.port());
+    asio::ip::to_chars_result result = endpoint.to_chars(ip_port_, ip_port_ + sizeof(ip_port_) - 1);
+    *(result.ec ? ip_port_ : result.ptr) = '\0';
     THROW_C3LOG_VERBOSE("new session : %s", session_info().c_str());
 }
 
@@ -152,7 +166,7 @@ void LogSession::start()
 
 std::string LogSession::session_info()
 {
-    return ip_port_ + " (" + name_ + ")";
+    return std::string(ip_port_) + " (" + name_ + ")";
 }
 
 void LogSession::set_callback(OnRecvCallback func)
@@ -168,45 +182,40 @@ void LogSession::set_remote_name(std::string name)
 
 void LogSession::async_write(const std::string &msg)
 {
-    bool write_in_progress = !write_msgs_.empty();
-    write_msgs_.push_back(msg);
-    if (!write_in_progress)
+    // Old messages are dropped, rather than queued without limit, when the
+    // client cannot keep up.
+    std::error_code ec;
+    if (!writer_.write(msg, ec))
     {
-        do_async_write();
-    }
-}
+        if (writer_.error())
+        {
+            THROW_C3LOG_EXCEPTION("Error in async_write: %s", ec.message().c_str());
 
-void LogSession::do_async_write()
-{
-    auto self(shared_from_this());
-    asio::async_write(socket_, asio::buffer(write_msgs_.front()),
-                      [this, self](std::error_code ec, std::size_t /*length*/) {
-                          if (!ec)
-                          {
-                              write_msgs_.pop_front();
-                              if (!write_msgs_.empty())
-                              {
-                                  do_async_write();
-                              }
-                          }
-                          else
-                          {
-                              THROW_C3LOG_EXCEPTION("Error in async_write: %s", ec.message().c_str());
-                              channel_.leave(shared_from_this());
-                          }
-                      });
+            // Leave once the channel has finished delivering this message.
+            auto self(shared_from_this());
+            asio::post(socket_.get_executor(), [this, self]() { channel_.leave(self); });
+        }
+        else if (ec == asio::error::message_size)
+        {
+            THROW_C3LOG_EXCEPTION("Message too large for async_write: %zu bytes", msg.size());
+        }
+    }
 }
 
 void LogSession::do_async_read()
 {
     THROW_C3LOG_VERBOSE("do_async_read");
     auto self(shared_from_this());
-    asio::async_read_until(socket_, asio::dynamic_buffer(read_msg_), '\n',
-                           [this, self](std::error_code ec, std::size_t len) {
+    asio::async_read_frames(socket_, asio::dynamic_buffer(read_msg_), '\n', read_frames_,
+                            [this, self](std::error_code ec, std::size_t len) {
                                if (!ec)
                                {
                                    if (on_recv_)
-                                       on_recv_(self.get(), read_msg_.data(), read_msg_.size());
+                                   {
+                                       for (const asio::const_buffer &frame : read_frames_)
+                                           on_recv_(self.get(), static_cast<const char *>(frame.data()),
+                                                    static_cast<int>(frame.size()));
+                                   }
 
                                    read_msg_.erase(0, len);
                                    do_async_read();
@@ -252,7 +261,8 @@ void LogServerImpl::start()
 
 void LogServerImpl::broadcast(const std::string &msg)
 {
-    channel_.deliver(msg);
+    // Sessions are only touched from the io thread.
+    asio::post(io_context_, [this, msg]() { channel_.deliver(msg); });
 }
 
 void LogServerImpl::set_callback(OnRecvCallback func)
@@ -9,6 +9,7 @@
 //
 
 #include "connection.hpp"
+#include <unistd.h>
 #include <utility>
 #include <vector>
 #include "connection_manager.hpp"
@@ -18,10 +19,12 @@ namespace http {
 namespace server {
 
 connection::connection(asio::ip::tcp::socket socket,
-    connection_manager& manager, request_handler& handler)
+    connection_manager& manager, request_handler& handler,
+    asio::buffer_pool& pool)
   : socket_(std::move(socket)),
     connection_manager_(manager),
-    request_handler_(handler)
+    request_handler_(handler),
+    buffer_(pool)
 {
 }
 
@@ -33,19 +36,33 @@ void connection::start()
 void connection::stop()
 {
   socket_.close();
+  close_file();
+}
+
+void connection::close_file()
+{
+  if (reply_.file != -1)
+  {
+    ::close(reply_.file);
+    reply_.file = -1;
+  }
 }
 
 void connection::do_read()
 {
   auto self(shared_from_this());
-  socket_.async_read_some(asio::buffer(buffer_),
-      [this, self](std::error_code ec, std::size_t bytes_transferred)
+  asio::async_read_when_ready(socket_, asio::dynamic_buffer(buffer_),
+      [this, self](std::error_code ec, std::size_t)
       {
         if (!ec)
         {
+          // The parser keeps its own state between reads, so all of the data
+          // can be consumed, returning the buffer to the pool.
+          const char* data = static_cast<const char*>(buffer_.data().data());
           request_parser::result_type result;
           std::tie(result, std::ignore) = request_parser_.parse(
-              request_, buffer_.data(), buffer_.data() + bytes_transferred);
+              request_, data, data + buffer_.size());
+          buffer_.consume(buffer_.size());
 
           if (result == request_parser::good)
           {
@@ -75,20 +92,42 @@ void connection::do_write()
   asio::async_write(socket_, reply_.to_buffers(),
       [this, self](std::error_code ec, std::size_t)
       {
-        if (!ec)
+        if (!ec && reply_.file != -1)
         {
-          // Initiate graceful connection closure.
-          asio::error_code ignored_ec;
-          socket_.shutdown(asio::ip::tcp::socket::shutdown_both,
-            ignored_ec);
+          do_write_file();
+          return;
         }
 
-        if (ec != asio::error::operation_aborted)
-        {
-          connection_manager_.stop(shared_from_this());
-        }
+        handle_write(ec);
       });
 }
 
+void connection::do_write_file()
+{
+  auto self(shared_from_this());
+  asio::async_send_file(socket_, reply_.file, 0, reply_.file_size,
+      [this, self](std::error_code ec, std::size_t)
+      {
+        close_file();
+        handle_write(ec);
+      });
+}
+
+void connection::handle_write(std::error_code ec)
+{
+  if (!ec)
+  {
+    // Initiate graceful connection closure.
+    asio::error_code ignored_ec;
+    socket_.shutdown(asio::ip::tcp::socket::shutdown_both,
+      ignored_ec);
+  }
+
+  if (ec != asio::error::operation_aborted)
+  {
+    connection_manager_.stop(shared_from_this());
+  }
+}
+
 } // namespace server
 } // namespace http
@@ -11,7 +11,6 @@
 #ifndef HTTP_CONNECTION_HPP
 #define HTTP_CONNECTION_HPP
 
-#include <array>
 #include <memory>
 #include <asio.hpp>
 #include "reply.hpp"
@@ -34,7 +33,8 @@ public:
 
   /// Construct a connection with the given socket.
   explicit connection(asio::ip::tcp::socket socket,
-      connection_manager& manager, request_handler& handler);
+      connection_manager& manager, request_handler& handler,
+      asio::buffer_pool& pool);
 
   /// Start the first asynchronous operation for the connection.
   void start();
@@ -49,6 +49,15 @@ private:
   /// Perform an asynchronous write operation.
   void do_write();
 
+  /// Send the file attached to the reply, if any.
+  void do_write_file();
+
+  /// Finish the connection once the reply has been written.
+  void handle_write(std::error_code ec);
+
+  /// Close the file attached to the reply, if any.
+  void close_file();
+
   /// Socket for the connection.
   asio::ip::tcp::socket socket_;
 
@@ -58,8 +67,9 @@ private:
   /// The handler used to process the incoming request.
   request_handler& request_handler_;
 
-  /// Buffer for incoming data.
-  std::array<char, 8192> buffer_;
+  /// Buffer for incoming data. It only holds memory from the pool while a read
+  /// is in progress.
+  asio::pooled_buffer buffer_;
 
   /// The incoming request.
   request request_;
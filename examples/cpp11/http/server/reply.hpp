@@ -49,6 +49,13 @@ struct reply
   /// The content to be sent in the reply.
   std::string content;
 
+  /// A file to be sent after the content, or -1 if there is none. The reply
+  /// owns the descriptor until it has been sent.
+  int file = -1;
+
+  /// The number of bytes of the file to send.
+  std::size_t file_size = 0;
+
   /// Convert the reply into a vector of buffers. The buffers do not own the
   /// underlying memory blocks, therefore the reply object must remain valid and
   /// not be changed until the write operation has completed.
@@ -9,7 +9,9 @@
 //
 
 #include "request_handler.hpp"
-#include <fstream>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <sstream>
 #include <string>
 #include "mime_types.hpp"
@@ -59,21 +61,24 @@ void request_handler::handle_request(const request& req, reply& rep)
 
   // Open the file to send back.
   std::string full_path = doc_root_ + request_path;
-  std::ifstream is(full_path.c_str(), std::ios::in | std::ios::binary);
-  if (!is)
+  int fd = ::open(full_path.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat st;
+  if (fd == -1 || ::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
   {
+    if (fd != -1)
+      ::close(fd);
     rep = reply::stock_reply(reply::not_found);
     return;
   }
 
-  // Fill out the reply to be sent to the client.
+  // Fill out the reply to be sent to the client. The file itself is sent by
+  // the connection straight from the page cache.
   rep.status = reply::ok;
-  char buf[512];
-  while (is.read(buf, sizeof(buf)).gcount() > 0)
-    rep.content.append(buf, is.gcount());
+  rep.file = fd;
+  rep.file_size = static_cast<std::size_t>(st.st_size);
   rep.headers.resize(2);
   rep.headers[0].name = "Content-Length";
-  rep.headers[0].value = std::to_string(rep.content.size());
+  rep.headers[0].value = std::to_string(rep.file_size);
   rep.headers[1].name = "Content-Type";
   rep.headers[1].value = mime_types::extension_to_type(extension);
 }
@@ -17,7 +17,8 @@ namespace server {
 
 server::server(const std::string& address, const std::string& port,
     const std::string& doc_root)
-  : io_context_(1),
+  : buffer_pool_(),
+    io_context_(1),
     signals_(io_context_),
     acceptor_(io_context_),
     connection_manager_(),
@@ -70,7 +71,8 @@ void server::do_accept()
         if (!ec)
         {
           connection_manager_.start(std::make_shared<connection>(
-              std::move(socket), connection_manager_, request_handler_));
+              std::move(socket), connection_manager_, request_handler_,
+              buffer_pool_));
         }
 
         do_accept();
@@ -42,6 +42,10 @@ private:
   /// Wait for a request to stop the server.
   void do_await_stop();
 
+  /// The pool from which connections borrow read buffers. It is declared
+  /// first so that it outlives every connection.
+  asio::buffer_pool buffer_pool_;
+
   /// The io_context used to perform asynchronous operations.
   asio::io_context io_context_;
 
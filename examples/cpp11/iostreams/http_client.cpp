@@ -28,7 +28,13 @@ int main(int argc, char* argv[])
       return 1;
     }
 
-    asio::ip::tcp::iostream s;
+    // Use larger stream buffers than the default, so that the response body
+    // is received with fewer system calls. The stream flushes after every
+    // output operation by default, which would send each line of the request
+    // separately. Turn that off, and flush once the whole request is written.
+    asio::io_context io_context;
+    asio::ip::tcp::iostream s(tcp::socket(io_context), 16384);
+    s.unsetf(std::ios_base::unitbuf);
 
     // The entire sequence of I/O operations must complete within 60 seconds.
     // If an expiry occurs, the socket is automatically closed and the stream
@@ -50,10 +56,7 @@ int main(int argc, char* argv[])
     s << "Host: " << argv[1] << "\r\n";
     s << "Accept: */*\r\n";
     s << "Connection: close\r\n\r\n";
-
-    // By default, the stream is tied with itself. This means that the stream
-    // automatically flush the buffered output before attempting a read. It is
-    // not necessary not explicitly flush the stream at this point.
+    s.flush();
 
     // Check that response is OK.
     std::string http_version;
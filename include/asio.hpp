@@ -5,6 +5,7 @@
 #include "asio/detail/memory/associated_allocator.hpp"
 #include "asio/core/executor/helper/associated_executor.hpp"
 #include "asio/core/executor/helper/async_result.hpp"
+#include "asio/transmit/backpressure_writer.hpp"
 // #include "asio/basic_datagram_socket.hpp"
 // #include "asio/basic_deadline_timer.hpp"
 #include "asio/service/basic_io_object.hpp"
@@ -17,19 +18,25 @@
 // #include "asio/basic_socket_streambuf.hpp"
 // #include "asio/basic_stream_socket.hpp"
 // #include "asio/basic_streambuf.hpp"
+#include "asio/service/timer/basic_periodic_timer.hpp"
+#include "asio/service/timer/basic_timer_group.hpp"
 #include "asio/service/timer/basic_waitable_timer.hpp"
 #include "asio/core/executor/helper/bind_executor.hpp"
 // #include "asio/buffer/buffer.hpp"
-// #include "asio/buffered_read_stream_fwd.hpp"
-// #include "asio/buffered_read_stream.hpp"
-// #include "asio/buffered_stream_fwd.hpp"
-// #include "asio/buffered_stream.hpp"
-// #include "asio/buffered_write_stream_fwd.hpp"
-// #include "asio/buffered_write_stream.hpp"
+#include "asio/buffer/buffer_pool.hpp"
+#include "asio/service/timer/helper/cached_steady_clock.hpp"
+#include "asio/transmit/buffered_read_stream_fwd.hpp"
+#include "asio/transmit/buffered_read_stream.hpp"
+#include "asio/transmit/buffered_stream_fwd.hpp"
+#include "asio/transmit/buffered_stream.hpp"
+#include "asio/transmit/buffered_write_stream_fwd.hpp"
+#include "asio/transmit/buffered_write_stream.hpp"
 // #include "asio/buffers_iterator.hpp"
+#include "asio/transmit/checksum_stream.hpp"
 // #include "asio/completion_condition.hpp"
 #include "asio/transmit/connect.hpp"
 // #include "asio/coroutine.hpp"
+#include "asio/buffer/crc32c.hpp"
 // #include "asio/datagram_socket_service.hpp"
 #include "asio/service/timer/deadline_timer_service.hpp"
 // #include "asio/deadline_timer.hpp"
@@ -49,7 +56,7 @@
 #include "asio/core/handler/handler_continuation_hook.hpp"
 #include "asio/core/handler/handler_invoke_hook.hpp"
 #include "asio/core/executor/helper/handler_type.hpp"
-// #include "asio/high_resolution_timer.hpp"
+#include "asio/service/timer/high_resolution_timer.hpp"
 #include "asio/core/io_context.hpp"
 // #include "asio/io_context_strand.hpp"
 // #include "asio/io_service.hpp"
@@ -70,21 +77,25 @@
 #include "asio/ip/host_name.hpp"
 // #include "asio/ip/icmp.hpp"
 #include "asio/ip/multicast.hpp"
+#include "asio/ip/network_map.hpp"
 #include "asio/ip/resolver_base.hpp"
 #include "asio/ip/resolver_query_base.hpp"
 #include "asio/ip/resolver_service.hpp"
 #include "asio/ip/tcp.hpp"
+#include "asio/ip/tcp_profile.hpp"
 #include "asio/ip/udp.hpp"
 #include "asio/ip/unicast.hpp"
 // #include "asio/ip/v6_only.hpp"
 #include "asio/core/executor/is_executor.hpp"
-// #include "asio/is_read_buffered.hpp"
-// #include "asio/is_write_buffered.hpp"
+#include "asio/transmit/is_read_buffered.hpp"
+#include "asio/transmit/is_write_buffered.hpp"
+#include "asio/transmit/length_prefix.hpp"
 // #include "asio/local/basic_endpoint.hpp"
 // #include "asio/local/connect_pair.hpp"
 // #include "asio/local/datagram_protocol.hpp"
 // #include "asio/local/stream_protocol.hpp"
 // #include "asio/packaged_task.hpp"
+#include "asio/transmit/parallel_connect.hpp"
 #include "asio/detail/base/stdcpp/placeholders.hpp"
 // #include "asio/posix/basic_descriptor.hpp"
 // #include "asio/posix/basic_stream_descriptor.hpp"
@@ -95,8 +106,13 @@
 #include "asio/core/executor/submit/post.hpp"
 // #include "asio/raw_socket_service.hpp"
 #include "asio/transmit/read.hpp"
+#include "asio/transmit/read_frames.hpp"
+#include "asio/transmit/read_size.hpp"
 // #include "asio/read_at.hpp"
 #include "asio/transmit/read_until.hpp"
+#include "asio/transmit/read_when_ready.hpp"
+#include "asio/buffer/ring_buffer.hpp"
+#include "asio/transmit/send_file.hpp"
 // #include "asio/seq_packet_socket_service.hpp"
 // #include "asio/serial_port.hpp"
 // #include "asio/serial_port_base.hpp"
@@ -105,17 +121,18 @@
 // #include "asio/signal_set_service.hpp"
 // #include "asio/socket_acceptor_service.hpp"
 // #include "asio/socket_base.hpp"
-// #include "asio/service/timer/steady_timer.hpp"
+#include "asio/service/timer/steady_timer.hpp"
 // #include "asio/strand.hpp"
 // #include "asio/stream_socket_service.hpp"
 // #include "asio/streambuf.hpp"
 #include "asio/core/system_context.hpp"
 #include "asio/error/system_error.hpp"
 #include "asio/core/executor/system_executor.hpp"
-// #include "asio/system_timer.hpp"
+#include "asio/service/timer/system_timer.hpp"
 #include "asio/detail/thread/thread.hpp"
 #include "asio/detail/thread/thread_pool.hpp"
 #include "asio/detail/base/time_traits.hpp"
+#include "asio/core/timer_metrics.hpp"
 // #include "asio/use_future.hpp"
 #include "asio/core/executor/helper/uses_executor.hpp"
 // #include "asio/version.hpp"
@@ -1312,6 +1312,75 @@ inline ASIO_CONST_BUFFER buffer(
 
 /*@}*/
 
+#if (defined(ASIO_HAS_VARIADIC_TEMPLATES) && defined(ASIO_HAS_STD_ARRAY)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+/** @defgroup buffer_array asio::buffer_array
+ *
+ * @brief The asio::buffer_array function creates a buffer sequence of a fixed
+ * length from individual buffers.
+ *
+ * The buffer sequence is a @c std::array, so it requires no heap allocation
+ * and its length is known at compile time. When it is passed to a socket or
+ * stream operation it is translated into a native scatter-gather array of
+ * exactly that length, without iterating over the sequence at run time.
+ *
+ * The result is an array of mutable_buffer if every argument is a
+ * mutable_buffer, and an array of const_buffer otherwise.
+ *
+ * @par Example
+ * Writing a header and a body with a single gather operation:
+ * @code std::string header = ...;
+ * std::vector<char> body = ...;
+ * asio::write(sock, asio::buffer_array(
+ *       asio::buffer(header), asio::buffer(body))); @endcode
+ */
+/*@{*/
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+namespace detail {
+
+template <typename... Buffers>
+struct buffer_array_value
+{
+  typedef mutable_buffer type;
+};
+
+template <typename Buffer, typename... Buffers>
+struct buffer_array_value<Buffer, Buffers...>
+{
+  typedef typename conditional<
+      is_convertible<Buffer, mutable_buffer>::value,
+      typename buffer_array_value<Buffers...>::type,
+      const_buffer>::type type;
+};
+
+} // namespace detail
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+/// Create a fixed-length buffer sequence from individual buffers.
+/**
+ * @returns A @c std::array containing one element for each argument, in
+ * order.
+ */
+template <typename... Buffers>
+inline std::array<typename detail::buffer_array_value<Buffers...>::type,
+    sizeof...(Buffers)> buffer_array(const Buffers&... buffers) ASIO_NOEXCEPT
+{
+  typedef typename detail::buffer_array_value<Buffers...>::type value_type;
+  std::array<value_type, sizeof...(Buffers)> result = {{
+    value_type(buffers)... }};
+  return result;
+}
+
+/*@}*/
+
+#endif // (defined(ASIO_HAS_VARIADIC_TEMPLATES)
+       //     && defined(ASIO_HAS_STD_ARRAY))
+       //   || defined(GENERATING_DOCUMENTATION)
+
 /// Adapt a basic_string to the DynamicBuffer requirements.
 /**
  * Requires that <tt>sizeof(Elem) == 1</tt>.
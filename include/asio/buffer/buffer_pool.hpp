@@ -0,0 +1,715 @@
+#ifndef ASIO_BUFFER_POOL_HPP
+#define ASIO_BUFFER_POOL_HPP
+
+#include "asio/detail/config.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include "asio/buffer/buffer.hpp"
+#include "asio/detail/base/global.hpp"
+#include "asio/detail/base/mutex.hpp"
+#include "asio/detail/base/scoped_lock.hpp"
+#include "asio/detail/base/tss_ptr.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error/throw_exception.hpp"
+
+#if defined(ASIO_HAS_HUGEPAGES)
+# include <sys/mman.h>
+#endif // defined(ASIO_HAS_HUGEPAGES)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+class buffer_pool;
+
+namespace detail {
+
+// A free slab, linked through its first bytes.
+struct buffer_pool_slab
+{
+  buffer_pool_slab* next;
+};
+
+// A thread's cache of free slabs for one pool.
+struct buffer_pool_cache
+{
+  // The free slabs, which only the owning thread uses.
+  buffer_pool_slab* head;
+  std::size_t count;
+
+  // Identifies the pool. Identifiers are never reused, so that the owning
+  // thread can find the cache without taking a lock.
+  std::size_t pool_id;
+
+  // The pool, or 0 once the pool has been destroyed. Protected by the
+  // registry's mutex.
+  buffer_pool* pool;
+
+  // The next cache belonging to the same thread.
+  buffer_pool_cache* thread_next;
+
+  // The other caches of the same pool. Protected by the registry's mutex.
+  buffer_pool_cache* pool_prev;
+  buffer_pool_cache* pool_next;
+};
+
+// Tracks the caches of all buffer pools. A single thread-specific storage key
+// holds each thread's list of caches, however many pools there are, and a
+// thread's caches are returned to their pools when the thread exits.
+class buffer_pool_registry
+  : private noncopyable
+{
+public:
+  buffer_pool_registry()
+    : next_id_(0),
+      caches_(&buffer_pool_registry::thread_exit)
+  {
+  }
+
+  // Get the registry shared by all pools.
+  static buffer_pool_registry& instance()
+  {
+    return global<buffer_pool_registry>();
+  }
+
+  // Get a new pool identifier.
+  std::size_t new_pool_id()
+  {
+    mutex::scoped_lock lock(mutex_);
+    return ++next_id_;
+  }
+
+  // Find the calling thread's cache for a pool, or return 0 if it has none.
+  buffer_pool_cache* find(std::size_t pool_id)
+  {
+    buffer_pool_cache* first = caches_;
+    for (buffer_pool_cache* c = first, *prev = 0; c;
+        prev = c, c = c->thread_next)
+    {
+      if (c->pool_id == pool_id)
+      {
+        // Keep the most recently used cache at the front of the list.
+        if (prev)
+        {
+          prev->thread_next = c->thread_next;
+          c->thread_next = first;
+          caches_ = c;
+        }
+        return c;
+      }
+    }
+    return 0;
+  }
+
+  // Add a new cache for the calling thread, and forget any of the thread's
+  // caches whose pools have been destroyed.
+  void add(buffer_pool_cache* c, buffer_pool_cache*& pool_caches)
+  {
+    mutex::scoped_lock lock(mutex_);
+
+    buffer_pool_cache* remaining = 0;
+    buffer_pool_cache* next = caches_;
+    while (buffer_pool_cache* old = next)
+    {
+      next = old->thread_next;
+      if (old->pool)
+      {
+        old->thread_next = remaining;
+        remaining = old;
+      }
+      else
+        delete old;
+    }
+
+    c->thread_next = remaining;
+    caches_ = c;
+
+    c->pool_prev = 0;
+    c->pool_next = pool_caches;
+    if (pool_caches)
+      pool_caches->pool_prev = c;
+    pool_caches = c;
+  }
+
+  // Detach the caches of a pool that is being destroyed. Each cache is deleted
+  // by its thread.
+  void remove_pool(buffer_pool_cache*& pool_caches)
+  {
+    mutex::scoped_lock lock(mutex_);
+    while (buffer_pool_cache* c = pool_caches)
+    {
+      pool_caches = c->pool_next;
+      c->pool = 0;
+      c->pool_prev = 0;
+      c->pool_next = 0;
+    }
+  }
+
+private:
+  // Return a thread's caches to their pools when the thread exits.
+  static void thread_exit(void* p);
+
+  mutex mutex_;
+  std::size_t next_id_;
+  tss_ptr<buffer_pool_cache> caches_;
+};
+
+} // namespace detail
+
+/// A shared pool of fixed-size memory slabs.
+/**
+ * The buffer_pool class hands out memory in slabs of a single size, for use
+ * as short-lived read buffers. Slabs are carved from large chunks which are
+ * only returned to the system when the pool is destroyed. Where the platform
+ * supports it, the chunks are mapped with transparent huge pages enabled, so
+ * that the slabs in use occupy fewer TLB entries.
+ *
+ * Each thread that uses the pool keeps a small cache of free slabs, so that
+ * most calls to allocate() and deallocate() take no lock. The caches are
+ * refilled from, and drained to, the shared free list in batches. When a
+ * thread exits, the slabs in its cache are returned to the shared free list.
+ * The caches of all pools are found through a single thread-specific storage
+ * key, so any number of pools may be created.
+ *
+ * The pool is intended to be shared by many connections that each borrow a
+ * slab only while a read is in progress or a partial message is held. See
+ * pooled_buffer and async_read_when_ready.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+class buffer_pool
+  : private detail::noncopyable
+{
+public:
+  /// Construct a pool of slabs of the given size.
+  /**
+   * @param slab_size The size of each slab. It is rounded up to a non-zero
+   * multiple of 64 bytes.
+   *
+   * @param chunk_size The amount of memory to obtain from the system whenever
+   * the pool runs out of free slabs. It is rounded up to a whole number of
+   * slabs.
+   */
+  explicit buffer_pool(std::size_t slab_size = 8192,
+      std::size_t chunk_size = 2097152)
+    : slab_size_(((slab_size ? slab_size : 1) + 63) & ~std::size_t(63)),
+      slabs_per_chunk_((std::max)(chunk_size / slab_size_, std::size_t(1))),
+      registry_(detail::buffer_pool_registry::instance()),
+      id_(registry_.new_pool_id()),
+      free_(0),
+      chunks_(0),
+      caches_(0)
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Frees all memory obtained by the pool. All slabs must have been returned
+   * to the pool before it is destroyed.
+   */
+  ~buffer_pool()
+  {
+    registry_.remove_pool(caches_);
+
+    while (chunks_)
+    {
+      chunk* c = chunks_;
+      chunks_ = c->next;
+      free_chunk(c);
+    }
+  }
+
+  /// Get the size of each slab.
+  std::size_t slab_size() const ASIO_NOEXCEPT
+  {
+    return slab_size_;
+  }
+
+  /// Borrow a slab from the pool.
+  /**
+   * @returns A pointer to a block of slab_size() bytes.
+   *
+   * @throws std::bad_alloc Thrown if the pool has no free slabs and more
+   * memory cannot be obtained.
+   */
+  void* allocate()
+  {
+    cache* c = this_thread_cache();
+    if (!c->head)
+      refill(c);
+
+    slab* s = c->head;
+    c->head = s->next;
+    --c->count;
+    return s;
+  }
+
+  /// Return a slab to the pool.
+  void deallocate(void* p)
+  {
+    cache* c = this_thread_cache();
+    slab* s = static_cast<slab*>(p);
+    s->next = c->head;
+    c->head = s;
+    if (++c->count > cache_size)
+      drain(c);
+  }
+
+private:
+  friend class detail::buffer_pool_registry;
+
+  // The number of free slabs kept by each thread, and the number moved between
+  // a thread's cache and the shared free list at a time.
+  enum { cache_size = 32, batch_size = cache_size / 2 };
+
+  // The alignment of chunks mapped from the system, so that they can be backed
+  // by transparent huge pages.
+  enum { huge_page_size = 2097152 };
+
+  typedef detail::buffer_pool_slab slab;
+  typedef detail::buffer_pool_cache cache;
+
+  struct chunk
+  {
+    chunk* next;
+    char* data;
+    std::size_t size;
+    bool mapped;
+  };
+
+  // Get the calling thread's cache, creating it if necessary.
+  cache* this_thread_cache()
+  {
+    cache* c = registry_.find(id_);
+    if (!c)
+    {
+      c = new cache;
+      c->head = 0;
+      c->count = 0;
+      c->pool_id = id_;
+      c->pool = this;
+      registry_.add(c, caches_);
+    }
+    return c;
+  }
+
+  // Return all of the slabs in an exiting thread's cache to the shared free
+  // list, and forget the cache. The caller must hold the registry's mutex.
+  void reclaim(cache* c)
+  {
+    if (c->pool_prev)
+      c->pool_prev->pool_next = c->pool_next;
+    else
+      caches_ = c->pool_next;
+    if (c->pool_next)
+      c->pool_next->pool_prev = c->pool_prev;
+
+    if (slab* first = c->head)
+    {
+      slab* last = first;
+      while (last->next)
+        last = last->next;
+
+      detail::mutex::scoped_lock lock(mutex_);
+      last->next = free_;
+      free_ = first;
+    }
+  }
+
+  // Move a batch of slabs from the shared free list to a thread's cache.
+  void refill(cache* c)
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    if (!free_)
+      new_chunk();
+
+    while (free_ && c->count < batch_size)
+    {
+      slab* s = free_;
+      free_ = s->next;
+      s->next = c->head;
+      c->head = s;
+      ++c->count;
+    }
+  }
+
+  // Move a batch of slabs from a thread's cache to the shared free list.
+  void drain(cache* c)
+  {
+    slab* first = c->head;
+    slab* last = first;
+    for (std::size_t i = 1; i < batch_size; ++i)
+      last = last->next;
+    c->head = last->next;
+    c->count -= batch_size;
+
+    detail::mutex::scoped_lock lock(mutex_);
+    last->next = free_;
+    free_ = first;
+  }
+
+  // Obtain a chunk from the system and add its slabs to the shared free list.
+  // The caller must hold the mutex.
+  void new_chunk()
+  {
+    std::size_t size = slab_size_ * slabs_per_chunk_;
+    chunk* c = new chunk;
+    c->size = size;
+    c->mapped = false;
+    c->data = 0;
+
+#if defined(ASIO_HAS_HUGEPAGES)
+    // A chunk of at least one huge page is mapped in whole huge pages, starting
+    // on a huge page boundary. Enough is mapped to find a boundary, and the
+    // excess on either side is trimmed.
+    if (size >= huge_page_size)
+    {
+      std::size_t aligned_size = (size + huge_page_size - 1)
+        & ~std::size_t(huge_page_size - 1);
+      std::size_t mapped_size = aligned_size + huge_page_size;
+      void* addr = ::mmap(0, mapped_size, PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (addr != MAP_FAILED)
+      {
+        char* begin = static_cast<char*>(addr);
+        char* end = begin + mapped_size;
+        std::size_t offset = reinterpret_cast<std::size_t>(begin)
+          & (huge_page_size - 1);
+        char* data = offset ? begin + (huge_page_size - offset) : begin;
+        if (data != begin)
+          ::munmap(begin, data - begin);
+        if (data + aligned_size != end)
+          ::munmap(data + aligned_size, end - (data + aligned_size));
+
+        ::madvise(data, aligned_size, MADV_HUGEPAGE);
+        c->data = data;
+        c->size = aligned_size;
+        c->mapped = true;
+      }
+    }
+#endif // defined(ASIO_HAS_HUGEPAGES)
+
+    if (!c->data)
+    {
+      c->data = static_cast<char*>(::operator new(size, std::nothrow));
+      if (!c->data)
+      {
+        delete c;
+        std::bad_alloc ex;
+        asio::detail::throw_exception(ex);
+      }
+    }
+
+    c->next = chunks_;
+    chunks_ = c;
+
+    for (std::size_t i = slabs_per_chunk_; i > 0; --i)
+    {
+      slab* s = reinterpret_cast<slab*>(c->data + (i - 1) * slab_size_);
+      s->next = free_;
+      free_ = s;
+    }
+  }
+
+  static void free_chunk(chunk* c)
+  {
+#if defined(ASIO_HAS_HUGEPAGES)
+    if (c->mapped)
+      ::munmap(c->data, c->size);
+    else
+#endif // defined(ASIO_HAS_HUGEPAGES)
+      ::operator delete(c->data);
+    delete c;
+  }
+
+  const std::size_t slab_size_;
+  const std::size_t slabs_per_chunk_;
+  detail::buffer_pool_registry& registry_;
+  const std::size_t id_;
+  detail::mutex mutex_;
+  slab* free_;
+  chunk* chunks_;
+
+  // The threads' caches for the pool. Protected by the registry's mutex.
+  cache* caches_;
+};
+
+namespace detail {
+
+inline void buffer_pool_registry::thread_exit(void* p)
+{
+  buffer_pool_registry& r = instance();
+  mutex::scoped_lock lock(r.mutex_);
+  buffer_pool_cache* next = static_cast<buffer_pool_cache*>(p);
+  while (buffer_pool_cache* c = next)
+  {
+    next = c->thread_next;
+    if (c->pool)
+      c->pool->reclaim(c);
+    delete c;
+  }
+}
+
+} // namespace detail
+
+/// Byte storage that borrows a slab from a buffer_pool only while it is in
+/// use.
+/**
+ * The pooled_buffer class provides the storage for a dynamic_pooled_buffer.
+ * It holds no memory while it is empty. A slab is borrowed from the pool when
+ * space is first prepared for a read, and is returned as soon as all data has
+ * been consumed, so that a connection which is idle between messages does not
+ * keep a buffer. The maximum size of the data is the slab size of the pool.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::buffer_pool pool; // Shared by all connections.
+ * ...
+ * asio::pooled_buffer storage(pool);
+ * asio::async_read_when_ready(socket, asio::dynamic_buffer(storage),
+ *     [&](asio::error_code ec, std::size_t n)
+ *     {
+ *       ...
+ *       asio::dynamic_buffer(storage).consume(n);
+ *     });
+ * @endcode
+ */
+class pooled_buffer
+  : private detail::noncopyable
+{
+public:
+  /// Construct an empty buffer that borrows its storage from the given pool.
+  /**
+   * The object stores a reference to the pool and the user is responsible for
+   * ensuring that the pool remains valid until the pooled_buffer object is
+   * destroyed.
+   */
+  explicit pooled_buffer(buffer_pool& pool) ASIO_NOEXCEPT
+    : pool_(pool),
+      data_(0),
+      begin_(0),
+      size_(0),
+      prepared_(0)
+  {
+  }
+
+  /// Destructor. Returns any borrowed slab to the pool.
+  ~pooled_buffer()
+  {
+    release();
+  }
+
+  /// Get the size of the input sequence.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// Get the capacity of the buffer, which is the slab size of the pool.
+  std::size_t capacity() const ASIO_NOEXCEPT
+  {
+    return pool_.slab_size();
+  }
+
+  /// Determine whether the buffer currently holds a slab from the pool.
+  bool borrowed() const ASIO_NOEXCEPT
+  {
+    return data_ != 0;
+  }
+
+  /// Get a buffer that represents the input sequence.
+  asio::const_buffer data() const ASIO_NOEXCEPT
+  {
+    return asio::const_buffer(data_ + begin_, size_);
+  }
+
+  /// Get a buffer that represents the output sequence, with the given size.
+  /**
+   * Borrows a slab from the pool if the buffer does not already hold one.
+   *
+   * @throws std::length_error If <tt>size() + n > capacity()</tt>.
+   */
+  asio::mutable_buffer prepare(std::size_t n)
+  {
+    std::size_t capacity = pool_.slab_size();
+    if (capacity - size_ < n)
+    {
+      std::length_error ex("pooled_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+
+    if (!data_)
+      data_ = static_cast<char*>(pool_.allocate());
+
+    // Make room after the input sequence.
+    if (capacity - begin_ - size_ < n)
+    {
+      std::memmove(data_, data_ + begin_, size_);
+      begin_ = 0;
+    }
+
+    prepared_ = n;
+    return asio::mutable_buffer(data_ + begin_ + size_, n);
+  }
+
+  /// Move bytes from the output sequence to the input sequence.
+  /**
+   * If the input sequence is still empty, the slab is returned to the pool.
+   *
+   * @note If @c n is greater than the size of the output sequence, the entire
+   * output sequence is moved to the input sequence and no error is issued.
+   */
+  void commit(std::size_t n) ASIO_NOEXCEPT
+  {
+    size_ += (std::min)(n, prepared_);
+    prepared_ = 0;
+    if (size_ == 0)
+      release();
+  }
+
+  /// Remove bytes from the beginning of the input sequence.
+  /**
+   * If the input sequence becomes empty, the slab is returned to the pool.
+   *
+   * @note If @c n is greater than the size of the input sequence, the entire
+   * input sequence is consumed and no error is issued.
+   */
+  void consume(std::size_t n) ASIO_NOEXCEPT
+  {
+    n = (std::min)(n, size_);
+    size_ -= n;
+    begin_ += n;
+    if (size_ == 0)
+      release();
+  }
+
+private:
+  void release() ASIO_NOEXCEPT
+  {
+    if (data_)
+    {
+      pool_.deallocate(data_);
+      data_ = 0;
+    }
+    begin_ = 0;
+    size_ = 0;
+    prepared_ = 0;
+  }
+
+  buffer_pool& pool_;
+  char* data_;
+  std::size_t begin_;
+  std::size_t size_;
+  std::size_t prepared_;
+};
+
+/// Adapt a pooled_buffer to the DynamicBuffer requirements.
+class dynamic_pooled_buffer
+{
+public:
+  /// The type used to represent the input sequence as a list of buffers.
+  typedef ASIO_CONST_BUFFER const_buffers_type;
+
+  /// The type used to represent the output sequence as a list of buffers.
+  typedef ASIO_MUTABLE_BUFFER mutable_buffers_type;
+
+  /// Construct a dynamic buffer from a pooled buffer.
+  /**
+   * @param p The pooled buffer to be used as backing storage for the dynamic
+   * buffer. The object stores a reference to the pooled buffer and the user is
+   * responsible for ensuring that the pooled buffer remains valid until the
+   * dynamic_pooled_buffer object is destroyed.
+   */
+  explicit dynamic_pooled_buffer(pooled_buffer& p) ASIO_NOEXCEPT
+    : pooled_(p)
+  {
+  }
+
+  /// Get the size of the input sequence.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return pooled_.size();
+  }
+
+  /// Get the maximum size of the dynamic buffer, which is the slab size of the
+  /// pool.
+  std::size_t max_size() const ASIO_NOEXCEPT
+  {
+    return pooled_.capacity();
+  }
+
+  /// Get the current capacity of the dynamic buffer.
+  std::size_t capacity() const ASIO_NOEXCEPT
+  {
+    return pooled_.capacity();
+  }
+
+  /// Get a list of buffers that represents the input sequence.
+  /**
+   * @note The returned object is invalidated by any @c dynamic_pooled_buffer
+   * or @c pooled_buffer member function that modifies the input sequence or
+   * output sequence.
+   */
+  const_buffers_type data() const ASIO_NOEXCEPT
+  {
+    return const_buffers_type(pooled_.data());
+  }
+
+  /// Get a list of buffers that represents the output sequence, with the given
+  /// size.
+  /**
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   *
+   * @note The returned object is invalidated by any @c dynamic_pooled_buffer
+   * or @c pooled_buffer member function that modifies the input sequence or
+   * output sequence.
+   */
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    return mutable_buffers_type(pooled_.prepare(n));
+  }
+
+  /// Move bytes from the output sequence to the input sequence.
+  void commit(std::size_t n)
+  {
+    pooled_.commit(n);
+  }
+
+  /// Remove characters from the input sequence.
+  void consume(std::size_t n)
+  {
+    pooled_.consume(n);
+  }
+
+private:
+  pooled_buffer& pooled_;
+};
+
+/** @addtogroup dynamic_buffer */
+/*@{*/
+
+/// Create a new dynamic buffer that represents the given pooled buffer.
+/**
+ * @returns <tt>dynamic_pooled_buffer(data)</tt>.
+ */
+inline dynamic_pooled_buffer dynamic_buffer(pooled_buffer& data) ASIO_NOEXCEPT
+{
+  return dynamic_pooled_buffer(data);
+}
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BUFFER_POOL_HPP
@@ -0,0 +1,126 @@
+#ifndef ASIO_DETAIL_BUFFER_SEARCH_HPP
+#define ASIO_DETAIL_BUFFER_SEARCH_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include "asio/buffer/buffer.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Searches the data in a buffer sequence, starting at a given offset, for a
+// delimiter. Each contiguous buffer is scanned with memchr or memmem, which the
+// C library implements with vector instructions, rather than stepping through
+// the sequence a byte at a time with buffers_iterator.
+
+// Find a single byte. Returns (offset,true) if found, where offset is the
+// position of the byte. Otherwise returns (size,false), where size is the
+// total size of the buffers.
+template <typename Iterator>
+std::pair<std::size_t, bool> buffer_search(Iterator begin, Iterator end,
+    std::size_t position, char c)
+{
+  std::size_t offset = 0;
+  for (Iterator iter = begin; iter != end; ++iter)
+  {
+    asio::const_buffer b(*iter);
+    std::size_t size = b.size();
+    if (position < offset + size)
+    {
+      const char* data = static_cast<const char*>(b.data());
+      std::size_t skip = position > offset ? position - offset : 0;
+      if (const void* p = std::memchr(data + skip, c, size - skip))
+        return std::make_pair(
+            offset + (static_cast<const char*>(p) - data), true);
+    }
+    offset += size;
+  }
+  return std::make_pair(offset, false);
+}
+
+// Compare the bytes starting at the given position in a buffer with a
+// pattern, continuing into the following buffers as required. Returns the
+// number of bytes matched, which is less than length only if the data ran out
+// first. Returns 0 if there is a mismatch.
+template <typename Iterator>
+std::size_t buffer_search_match(Iterator iter, Iterator end,
+    std::size_t skip, const char* pattern, std::size_t length)
+{
+  std::size_t matched = 0;
+  for (; iter != end && matched < length; ++iter, skip = 0)
+  {
+    asio::const_buffer b(*iter);
+    std::size_t n = b.size() - skip;
+    if (n > length - matched)
+      n = length - matched;
+    if (std::memcmp(static_cast<const char*>(b.data()) + skip,
+          pattern + matched, n) != 0)
+      return 0;
+    matched += n;
+  }
+  return matched;
+}
+
+// Find a sequence of bytes, which may span buffer boundaries. Returns
+// (offset,true) if a full match was found, in which case offset is the
+// beginning of the match. Returns (offset,false) if a partial match was found
+// at the end of the data, in which case offset is the beginning of the
+// partial match. Returns (size,false) if no full or partial match was found,
+// where size is the total size of the buffers.
+template <typename Iterator>
+std::pair<std::size_t, bool> buffer_search(Iterator begin, Iterator end,
+    std::size_t position, const char* delim, std::size_t length)
+{
+  std::size_t offset = 0;
+  for (Iterator iter = begin; iter != end; ++iter)
+  {
+    asio::const_buffer b(*iter);
+    std::size_t size = b.size();
+    const char* data = static_cast<const char*>(b.data());
+    std::size_t skip = position > offset ? position - offset : 0;
+    if (skip < size && length == 0)
+      return std::make_pair(offset + skip, true);
+
+#if defined(ASIO_HAS_MEMMEM)
+    // Look for a match that lies entirely within this buffer. Failing that,
+    // only a match spanning into the following buffers remains possible.
+    if (skip < size && skip + length <= size)
+    {
+      if (const void* p = ::memmem(data + skip, size - skip, delim, length))
+        return std::make_pair(
+            offset + (static_cast<const char*>(p) - data), true);
+      skip = size - length + 1;
+    }
+#endif // defined(ASIO_HAS_MEMMEM)
+
+    while (skip < size)
+    {
+      // Find the next candidate using the first byte of the delimiter.
+      const void* p = std::memchr(data + skip, delim[0], size - skip);
+      if (!p)
+        break;
+      skip = static_cast<const char*>(p) - data;
+
+      std::size_t matched = buffer_search_match(
+          iter, end, skip, delim, length);
+      if (matched == length)
+        return std::make_pair(offset + skip, true);
+      else if (matched > 0)
+        return std::make_pair(offset + skip, false);
+      ++skip;
+    }
+    offset += size;
+  }
+  return std::make_pair(offset, false);
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_BUFFER_SEARCH_HPP
@@ -46,6 +46,24 @@ protected:
   }
 };
 
+template <typename Buffer, std::size_t MaxBuffers>
+struct prepared_buffers;
+
+// Helper template to determine the largest number of native buffers that a
+// buffer sequence can need, so that the native array is no larger than that.
+template <typename Buffers>
+struct buffer_sequence_capacity
+{
+  enum { value = buffer_sequence_adapter_base::max_buffers };
+};
+
+template <typename Buffer, std::size_t MaxBuffers>
+struct buffer_sequence_capacity<prepared_buffers<Buffer, MaxBuffers> >
+{
+  enum { value = MaxBuffers < buffer_sequence_adapter_base::max_buffers
+    ? MaxBuffers : std::size_t(buffer_sequence_adapter_base::max_buffers) };
+};
+
 // Helper class to translate buffers into the native buffer representation.
 template <typename Buffer, typename Buffers>
 class buffer_sequence_adapter
@@ -106,7 +124,7 @@ private:
   void init(Iterator begin, Iterator end)
   {
     Iterator iter = begin;
-    for (; iter != end && count_ < max_buffers; ++iter, ++count_)
+    for (; iter != end && count_ < capacity; ++iter, ++count_)
     {
       Buffer buffer(*iter);
       init_native_buffer(buffers_[count_], buffer);
@@ -119,7 +137,7 @@ private:
   {
     Iterator iter = begin;
     std::size_t i = 0;
-    for (; iter != end && i < max_buffers; ++iter, ++i)
+    for (; iter != end && i < capacity; ++iter, ++i)
       if (Buffer(*iter).size() > 0)
         return false;
     return true;
@@ -149,7 +167,8 @@ private:
     return Buffer();
   }
 
-  native_buffer_type buffers_[max_buffers];
+  enum { capacity = buffer_sequence_capacity<Buffers>::value };
+  native_buffer_type buffers_[capacity];
   std::size_t count_;
   std::size_t total_buffer_size_;
 };
@@ -258,17 +277,23 @@ private:
   std::size_t total_buffer_size_;
 };
 
-template <typename Buffer, typename Elem>
-class buffer_sequence_adapter<Buffer, boost::array<Elem, 2> >
+// Helper class to translate a buffer sequence whose length is known at compile
+// time into the native buffer representation. The native array is sized
+// exactly, and the buffers are converted without walking any iterators.
+template <typename Buffer, typename Buffers, std::size_t N>
+class fixed_buffer_sequence_adapter
   : buffer_sequence_adapter_base
 {
 public:
-  explicit buffer_sequence_adapter(
-      const boost::array<Elem, 2>& buffer_sequence)
+  explicit fixed_buffer_sequence_adapter(const Buffers& buffer_sequence)
+    : total_buffer_size_(0)
   {
-    init_native_buffer(buffers_[0], Buffer(buffer_sequence[0]));
-    init_native_buffer(buffers_[1], Buffer(buffer_sequence[1]));
-    total_buffer_size_ = buffer_sequence[0].size() + buffer_sequence[1].size();
+    for (std::size_t i = 0; i < native_count; ++i)
+    {
+      Buffer buffer(buffer_sequence[i]);
+      init_native_buffer(buffers_[i], buffer);
+      total_buffer_size_ += buffer.size();
+    }
   }
 
   native_buffer_type* buffers()
@@ -278,7 +303,7 @@ public:
 
   std::size_t count() const
   {
-    return 2;
+    return native_count;
   }
 
   std::size_t total_size() const
@@ -291,83 +316,63 @@ public:
     return total_buffer_size_ == 0;
   }
 
-  static bool all_empty(const boost::array<Elem, 2>& buffer_sequence)
+  static bool all_empty(const Buffers& buffer_sequence)
   {
-    return buffer_sequence[0].size() == 0 && buffer_sequence[1].size() == 0;
+    for (std::size_t i = 0; i < native_count; ++i)
+      if (Buffer(buffer_sequence[i]).size() > 0)
+        return false;
+    return true;
   }
 
-  static void validate(const boost::array<Elem, 2>& buffer_sequence)
+  static void validate(const Buffers& buffer_sequence)
   {
-    buffer_sequence[0].data();
-    buffer_sequence[1].data();
+    for (std::size_t i = 0; i < N; ++i)
+      Buffer(buffer_sequence[i]).data();
   }
 
-  static Buffer first(const boost::array<Elem, 2>& buffer_sequence)
+  static Buffer first(const Buffers& buffer_sequence)
   {
-    return Buffer(buffer_sequence[0].size() != 0
-        ? buffer_sequence[0] : buffer_sequence[1]);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      Buffer buffer(buffer_sequence[i]);
+      if (buffer.size() != 0)
+        return buffer;
+    }
+    return Buffer();
   }
 
 private:
-  native_buffer_type buffers_[2];
+  enum { native_count = N < max_buffers ? N : std::size_t(max_buffers) };
+  native_buffer_type buffers_[native_count > 0 ? native_count : 1];
   std::size_t total_buffer_size_;
 };
 
-#if defined(ASIO_HAS_STD_ARRAY)
-
-template <typename Buffer, typename Elem>
-class buffer_sequence_adapter<Buffer, std::array<Elem, 2> >
-  : buffer_sequence_adapter_base
+template <typename Buffer, typename Elem, std::size_t N>
+class buffer_sequence_adapter<Buffer, boost::array<Elem, N> >
+  : public fixed_buffer_sequence_adapter<Buffer, boost::array<Elem, N>, N>
 {
 public:
   explicit buffer_sequence_adapter(
-      const std::array<Elem, 2>& buffer_sequence)
-  {
-    init_native_buffer(buffers_[0], Buffer(buffer_sequence[0]));
-    init_native_buffer(buffers_[1], Buffer(buffer_sequence[1]));
-    total_buffer_size_ = buffer_sequence[0].size() + buffer_sequence[1].size();
-  }
-
-  native_buffer_type* buffers()
+      const boost::array<Elem, N>& buffer_sequence)
+    : fixed_buffer_sequence_adapter<Buffer,
+        boost::array<Elem, N>, N>(buffer_sequence)
   {
-    return buffers_;
-  }
-
-  std::size_t count() const
-  {
-    return 2;
-  }
-
-  std::size_t total_size() const
-  {
-    return total_buffer_size_;
-  }
-
-  bool all_empty() const
-  {
-    return total_buffer_size_ == 0;
-  }
-
-  static bool all_empty(const std::array<Elem, 2>& buffer_sequence)
-  {
-    return buffer_sequence[0].size() == 0 && buffer_sequence[1].size() == 0;
   }
+};
 
-  static void validate(const std::array<Elem, 2>& buffer_sequence)
-  {
-    buffer_sequence[0].data();
-    buffer_sequence[1].data();
-  }
+#if defined(ASIO_HAS_STD_ARRAY)
 
-  static Buffer first(const std::array<Elem, 2>& buffer_sequence)
+template <typename Buffer, typename Elem, std::size_t N>
+class buffer_sequence_adapter<Buffer, std::array<Elem, N> >
+  : public fixed_buffer_sequence_adapter<Buffer, std::array<Elem, N>, N>
+{
+public:
+  explicit buffer_sequence_adapter(
+      const std::array<Elem, N>& buffer_sequence)
+    : fixed_buffer_sequence_adapter<Buffer,
+        std::array<Elem, N>, N>(buffer_sequence)
   {
-    return Buffer(buffer_sequence[0].size() != 0
-        ? buffer_sequence[0] : buffer_sequence[1]);
   }
-
-private:
-  native_buffer_type buffers_[2];
-  std::size_t total_buffer_size_;
 };
 
 #endif // defined(ASIO_HAS_STD_ARRAY)
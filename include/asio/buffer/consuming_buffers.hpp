@@ -52,6 +52,9 @@ struct prepared_buffers
   typedef Buffer value_type;
   typedef const Buffer* const_iterator;
 
+  // Kept small so that operations holding a prepared sequence, and the
+  // composed operations holding a consuming_buffers window of the same size,
+  // still fit in the thread's recycled handler memory.
   enum { max_buffers = MaxBuffers < 16 ? MaxBuffers : 16 };
 
   prepared_buffers() : count(0) {}
@@ -63,6 +66,14 @@ struct prepared_buffers
 };
 
 // A proxy for a sub-range in a list of buffers.
+//
+// Rather than walking the underlying sequence from the start on every call,
+// a window of up to max_buffers non-empty buffers is kept ahead of the
+// consumption point. A partial transfer is applied to the window in place,
+// and the window is only topped up from the underlying sequence once it has
+// drained to half full or less. The cost of writing a long sequence of
+// small buffers is therefore proportional to the number of bytes and buffers
+// transferred.
 template <typename Buffer, typename Buffers, typename Buffer_Iterator>
 class consuming_buffers
 {
@@ -75,7 +86,9 @@ public:
     : buffers_(buffers),
       total_consumed_(0),
       next_elem_(0),
-      next_elem_offset_(0)
+      more_elems_(true),
+      window_begin_(0),
+      window_end_(0)
   {
     using asio::buffer_size;
     total_size_ = buffer_size(buffers);
@@ -90,22 +103,15 @@ public:
   // Get the buffer for a single transfer, with a size.
   prepared_buffers_type prepare(std::size_t max_size)
   {
-    prepared_buffers_type result;
-
-    Buffer_Iterator next = asio::buffer_sequence_begin(buffers_);
-    Buffer_Iterator end = asio::buffer_sequence_end(buffers_);
+    if (more_elems_ && window_end_ - window_begin_ <= window_size / 2)
+      refill();
 
-    std::advance(next, next_elem_);
-    std::size_t elem_offset = next_elem_offset_;
-    while (next != end && max_size > 0 && (result.count) < result.max_buffers)
+    prepared_buffers_type result;
+    for (std::size_t i = window_begin_;
+        i != window_end_ && max_size > 0; ++i, ++result.count)
     {
-      Buffer next_buf = Buffer(*next) + elem_offset;
-      result.elems[result.count] = asio::buffer(next_buf, max_size);
+      result.elems[result.count] = asio::buffer(window_[i], max_size);
       max_size -= result.elems[result.count].size();
-      elem_offset = 0;
-      if (result.elems[result.count].size() > 0)
-        ++result.count;
-      ++next;
     }
 
     return result;
@@ -116,24 +122,17 @@ public:
   {
     total_consumed_ += size;
 
-    Buffer_Iterator next = asio::buffer_sequence_begin(buffers_);
-    Buffer_Iterator end = asio::buffer_sequence_end(buffers_);
-
-    std::advance(next, next_elem_);
-    while (next != end && size > 0)
+    while (window_begin_ != window_end_ && size > 0)
     {
-      Buffer next_buf = Buffer(*next) + next_elem_offset_;
-      if (size < next_buf.size())
+      if (size < window_[window_begin_].size())
       {
-        next_elem_offset_ += size;
+        window_[window_begin_] += size;
         size = 0;
       }
       else
       {
-        size -= next_buf.size();
-        next_elem_offset_ = 0;
-        ++next_elem_;
-        ++next;
+        size -= window_[window_begin_].size();
+        ++window_begin_;
       }
     }
   }
@@ -145,11 +144,40 @@ public:
   }
 
 private:
+  enum { window_size = prepared_buffers_type::max_buffers };
+
+  // Move the unconsumed part of the window to the front, and fill the
+  // remainder with the next non-empty buffers from the underlying sequence.
+  void refill()
+  {
+    std::size_t count = 0;
+    for (; window_begin_ != window_end_; ++window_begin_, ++count)
+      window_[count] = window_[window_begin_];
+    window_begin_ = 0;
+
+    Buffer_Iterator next = asio::buffer_sequence_begin(buffers_);
+    Buffer_Iterator end = asio::buffer_sequence_end(buffers_);
+
+    std::advance(next, next_elem_);
+    for (; next != end && count < window_size; ++next, ++next_elem_)
+    {
+      Buffer next_buf(*next);
+      if (next_buf.size() > 0)
+        window_[count++] = next_buf;
+    }
+
+    more_elems_ = (next != end);
+    window_end_ = count;
+  }
+
   Buffers buffers_;
   std::size_t total_size_;
   std::size_t total_consumed_;
   std::size_t next_elem_;
-  std::size_t next_elem_offset_;
+  bool more_elems_;
+  Buffer window_[window_size];
+  std::size_t window_begin_;
+  std::size_t window_end_;
 };
 
 // Base class of all consuming_buffers specialisations for single buffers.
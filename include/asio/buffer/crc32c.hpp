@@ -0,0 +1,196 @@
+#ifndef ASIO_CRC32C_HPP
+#define ASIO_CRC32C_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
+#include "asio/detail/base/stdcpp/cstdint.hpp"
+
+#if defined(ASIO_HAS_SSE42_CRC32C)
+# include <nmmintrin.h>
+#elif defined(ASIO_HAS_ARM_CRC32C)
+# include <arm_acle.h>
+#endif // defined(ASIO_HAS_ARM_CRC32C)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Extends a CRC32C (Castagnoli polynomial) with more data. The CRC is held
+// inverted, as the hardware instructions expect. The hardware instructions
+// are used where available, and otherwise a slicing-by-8 table lookup.
+class crc32c_ops
+{
+public:
+  static uint32_t extend(uint32_t crc,
+      const unsigned char* data, std::size_t size)
+  {
+#if defined(ASIO_HAS_SSE42_CRC32C)
+    if (has_sse42())
+      return extend_sse42(crc, data, size);
+#elif defined(ASIO_HAS_ARM_CRC32C)
+    return extend_arm(crc, data, size);
+#endif // defined(ASIO_HAS_ARM_CRC32C)
+    return extend_table(crc, data, size);
+  }
+
+private:
+  struct tables
+  {
+    tables()
+    {
+      for (uint32_t i = 0; i < 256; ++i)
+      {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+          crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+        table[0][i] = crc;
+      }
+
+      for (int k = 1; k < 8; ++k)
+        for (int i = 0; i < 256; ++i)
+          table[k][i] = (table[k - 1][i] >> 8)
+            ^ table[0][table[k - 1][i] & 0xFF];
+    }
+
+    uint32_t table[8][256];
+  };
+
+  static uint32_t extend_table(uint32_t crc,
+      const unsigned char* p, std::size_t n)
+  {
+    static const tables t;
+
+    for (; n >= 8; p += 8, n -= 8)
+    {
+      uint32_t lo = crc ^ (uint32_t(p[0]) | (uint32_t(p[1]) << 8)
+          | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24));
+      crc = t.table[7][lo & 0xFF] ^ t.table[6][(lo >> 8) & 0xFF]
+        ^ t.table[5][(lo >> 16) & 0xFF] ^ t.table[4][lo >> 24]
+        ^ t.table[3][p[4]] ^ t.table[2][p[5]]
+        ^ t.table[1][p[6]] ^ t.table[0][p[7]];
+    }
+
+    for (; n > 0; ++p, --n)
+      crc = t.table[0][(crc ^ *p) & 0xFF] ^ (crc >> 8);
+
+    return crc;
+  }
+
+#if defined(ASIO_HAS_SSE42_CRC32C)
+  static bool has_sse42()
+  {
+    static const bool supported = (__builtin_cpu_init(),
+        __builtin_cpu_supports("sse4.2") != 0);
+    return supported;
+  }
+
+  __attribute__((target("sse4.2")))
+  static uint32_t extend_sse42(uint32_t crc,
+      const unsigned char* p, std::size_t n)
+  {
+# if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    for (; n >= 8; p += 8, n -= 8)
+    {
+      uint64_t value;
+      std::memcpy(&value, p, 8);
+      crc64 = _mm_crc32_u64(crc64, value);
+    }
+    crc = static_cast<uint32_t>(crc64);
+# endif // defined(__x86_64__)
+
+    for (; n >= 4; p += 4, n -= 4)
+    {
+      uint32_t value;
+      std::memcpy(&value, p, 4);
+      crc = _mm_crc32_u32(crc, value);
+    }
+
+    for (; n > 0; ++p, --n)
+      crc = _mm_crc32_u8(crc, *p);
+
+    return crc;
+  }
+#elif defined(ASIO_HAS_ARM_CRC32C)
+  static uint32_t extend_arm(uint32_t crc,
+      const unsigned char* p, std::size_t n)
+  {
+    for (; n >= 8; p += 8, n -= 8)
+    {
+      uint64_t value;
+      std::memcpy(&value, p, 8);
+      crc = __crc32cd(crc, value);
+    }
+
+    for (; n > 0; ++p, --n)
+      crc = __crc32cb(crc, *p);
+
+    return crc;
+  }
+#endif // defined(ASIO_HAS_ARM_CRC32C)
+};
+
+} // namespace detail
+
+/// Incrementally computes a CRC32C checksum.
+/**
+ * The crc32c class computes the CRC-32 with the Castagnoli polynomial, as used
+ * by iSCSI, SCTP and many storage formats. Data may be supplied in any number
+ * of pieces. Where the processor provides CRC32C instructions (SSE4.2 on x86,
+ * or the CRC extension on ARMv8) they are used, otherwise a table-driven
+ * implementation is used.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::crc32c crc;
+ * crc.update(header, header_size);
+ * crc.update(body, body_size);
+ * asio::uint32_t checksum = crc.value();
+ * @endcode
+ */
+class crc32c
+{
+public:
+  /// The type of the checksum value.
+  typedef uint32_t value_type;
+
+  /// Construct with the checksum of no data.
+  crc32c() ASIO_NOEXCEPT
+    : crc_(0xFFFFFFFF)
+  {
+  }
+
+  /// Add some data to the checksum.
+  void update(const void* data, std::size_t size)
+  {
+    crc_ = detail::crc32c_ops::extend(crc_,
+        static_cast<const unsigned char*>(data), size);
+  }
+
+  /// Get the checksum of all data added so far.
+  value_type value() const ASIO_NOEXCEPT
+  {
+    return crc_ ^ 0xFFFFFFFF;
+  }
+
+  /// Reset to the checksum of no data.
+  void reset() ASIO_NOEXCEPT
+  {
+    crc_ = 0xFFFFFFFF;
+  }
+
+private:
+  uint32_t crc_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_CRC32C_HPP
@@ -0,0 +1,341 @@
+#ifndef ASIO_RING_BUFFER_HPP
+#define ASIO_RING_BUFFER_HPP
+
+#include "asio/detail/config.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include "asio/buffer/buffer.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/base/stdcpp/limits.hpp"
+#include "asio/error/throw_exception.hpp"
+
+#if defined(ASIO_HAS_MEMFD)
+# include <sys/mman.h>
+# include <unistd.h>
+#endif // defined(ASIO_HAS_MEMFD)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Fixed-size byte storage for use as a dynamic buffer.
+/**
+ * The ring_buffer class provides the storage for a dynamic_ring_buffer. Unlike
+ * dynamic_string_buffer and dynamic_vector_buffer, which erase consumed data
+ * from the front of their container, a ring buffer consumes data by
+ * advancing an offset, so that the cost of @c consume does not depend on the
+ * amount of data that remains. The capacity is fixed when the ring buffer is
+ * constructed.
+ *
+ * Where the platform supports it, the storage is mapped twice at adjacent
+ * virtual addresses, so that both the input sequence and the output sequence
+ * are always contiguous even when they wrap around the end of the storage.
+ * Otherwise, the input sequence is moved back to the start of the storage
+ * when there is no room left after it, which happens at most once per
+ * capacity's worth of data.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::ring_buffer storage(65536);
+ * std::size_t n = asio::read_until(socket,
+ *     asio::dynamic_buffer(storage), '\n');
+ * ...
+ * asio::dynamic_buffer(storage).consume(n);
+ * @endcode
+ */
+class ring_buffer
+  : private detail::noncopyable
+{
+public:
+  /// Construct a ring buffer with at least the given capacity.
+  /**
+   * The capacity is rounded up to a power of two, and to a whole number of
+   * pages if the storage is mapped.
+   *
+   * @throws std::length_error Thrown if @c min_capacity is greater than
+   * max_size().
+   *
+   * @throws std::bad_alloc Thrown if the storage cannot be allocated.
+   */
+  explicit ring_buffer(std::size_t min_capacity)
+    : data_(0),
+      capacity_(1),
+      begin_(0),
+      size_(0),
+      prepared_(0),
+      mapped_(false)
+  {
+#if defined(ASIO_HAS_MEMFD)
+    long page_size = ::sysconf(_SC_PAGESIZE);
+    if (page_size > 0 && min_capacity < static_cast<std::size_t>(page_size))
+      min_capacity = static_cast<std::size_t>(page_size);
+#endif // defined(ASIO_HAS_MEMFD)
+    if (min_capacity > max_size())
+    {
+      std::length_error ex("ring_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+    while (capacity_ < min_capacity)
+      capacity_ <<= 1;
+
+#if defined(ASIO_HAS_MEMFD)
+    data_ = map_storage(capacity_);
+    mapped_ = (data_ != 0);
+#endif // defined(ASIO_HAS_MEMFD)
+    if (!data_)
+      data_ = new char[capacity_];
+  }
+
+  /// Destructor.
+  ~ring_buffer()
+  {
+#if defined(ASIO_HAS_MEMFD)
+    if (mapped_)
+    {
+      ::munmap(data_, capacity_ * 2);
+      return;
+    }
+#endif // defined(ASIO_HAS_MEMFD)
+    delete[] data_;
+  }
+
+  /// Get the size of the input sequence.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// Get the capacity of the ring buffer, which is also its maximum size.
+  std::size_t capacity() const ASIO_NOEXCEPT
+  {
+    return capacity_;
+  }
+
+  /// Get the largest capacity that a ring buffer can have.
+  /**
+   * This is the largest power of two for which twice the capacity, the size
+   * of the address range used by mapped storage, is representable.
+   */
+  static std::size_t max_size() ASIO_NOEXCEPT
+  {
+    return ((std::numeric_limits<std::size_t>::max)() >> 2) + 1;
+  }
+
+  /// Determine whether the storage is mapped twice, so that no data is ever
+  /// moved.
+  bool mapped() const ASIO_NOEXCEPT
+  {
+    return mapped_;
+  }
+
+  /// Get a buffer that represents the input sequence.
+  asio::const_buffer data() const ASIO_NOEXCEPT
+  {
+    return asio::const_buffer(data_ + begin_, size_);
+  }
+
+  /// Get a buffer that represents the output sequence, with the given size.
+  /**
+   * @throws std::length_error If <tt>size() + n > capacity()</tt>.
+   */
+  asio::mutable_buffer prepare(std::size_t n)
+  {
+    if (capacity_ - size_ < n)
+    {
+      std::length_error ex("ring_buffer too long");
+      asio::detail::throw_exception(ex);
+    }
+
+    prepared_ = n;
+    if (mapped_)
+      return asio::mutable_buffer(
+          data_ + ((begin_ + size_) & (capacity_ - 1)), n);
+
+    // Make room after the input sequence.
+    if (capacity_ - begin_ - size_ < n)
+    {
+      std::memmove(data_, data_ + begin_, size_);
+      begin_ = 0;
+    }
+
+    return asio::mutable_buffer(data_ + begin_ + size_, n);
+  }
+
+  /// Move bytes from the output sequence to the input sequence.
+  /**
+   * @note If @c n is greater than the size of the output sequence, the entire
+   * output sequence is moved to the input sequence and no error is issued.
+   */
+  void commit(std::size_t n) ASIO_NOEXCEPT
+  {
+    size_ += (std::min)(n, prepared_);
+    prepared_ = 0;
+  }
+
+  /// Remove bytes from the beginning of the input sequence.
+  /**
+   * @note If @c n is greater than the size of the input sequence, the entire
+   * input sequence is consumed and no error is issued.
+   */
+  void consume(std::size_t n) ASIO_NOEXCEPT
+  {
+    n = (std::min)(n, size_);
+    size_ -= n;
+    if (size_ == 0)
+      begin_ = 0;
+    else if (mapped_)
+      begin_ = (begin_ + n) & (capacity_ - 1);
+    else
+      begin_ += n;
+  }
+
+private:
+#if defined(ASIO_HAS_MEMFD)
+  // Map the same memory at two adjacent addresses. Returns 0 on failure.
+  static char* map_storage(std::size_t capacity)
+  {
+    int fd = ::memfd_create("asio-ring-buffer", MFD_CLOEXEC);
+    if (fd == -1)
+      return 0;
+
+    void* addr = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(capacity)) == 0)
+    {
+      // Reserve the address range, then place both views of the file in it.
+      addr = ::mmap(0, capacity * 2, PROT_NONE,
+          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (addr != MAP_FAILED)
+      {
+        char* base = static_cast<char*>(addr);
+        if (::mmap(base, capacity, PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+            || ::mmap(base + capacity, capacity, PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+        {
+          ::munmap(addr, capacity * 2);
+          addr = MAP_FAILED;
+        }
+      }
+    }
+
+    ::close(fd);
+    return addr == MAP_FAILED ? 0 : static_cast<char*>(addr);
+  }
+#endif // defined(ASIO_HAS_MEMFD)
+
+  char* data_;
+  std::size_t capacity_;
+  std::size_t begin_;
+  std::size_t size_;
+  std::size_t prepared_;
+  bool mapped_;
+};
+
+/// Adapt a ring_buffer to the DynamicBuffer requirements.
+class dynamic_ring_buffer
+{
+public:
+  /// The type used to represent the input sequence as a list of buffers.
+  typedef ASIO_CONST_BUFFER const_buffers_type;
+
+  /// The type used to represent the output sequence as a list of buffers.
+  typedef ASIO_MUTABLE_BUFFER mutable_buffers_type;
+
+  /// Construct a dynamic buffer from a ring buffer.
+  /**
+   * @param r The ring buffer to be used as backing storage for the dynamic
+   * buffer. The object stores a reference to the ring buffer and the user is
+   * responsible for ensuring that the ring buffer remains valid until the
+   * dynamic_ring_buffer object is destroyed.
+   */
+  explicit dynamic_ring_buffer(ring_buffer& r) ASIO_NOEXCEPT
+    : ring_(r)
+  {
+  }
+
+  /// Get the size of the input sequence.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return ring_.size();
+  }
+
+  /// Get the maximum size of the dynamic buffer, which is the capacity of the
+  /// ring buffer.
+  std::size_t max_size() const ASIO_NOEXCEPT
+  {
+    return ring_.capacity();
+  }
+
+  /// Get the current capacity of the dynamic buffer.
+  std::size_t capacity() const ASIO_NOEXCEPT
+  {
+    return ring_.capacity();
+  }
+
+  /// Get a list of buffers that represents the input sequence.
+  /**
+   * @note The returned object is invalidated by any @c dynamic_ring_buffer
+   * or @c ring_buffer member function that modifies the input sequence or
+   * output sequence.
+   */
+  const_buffers_type data() const ASIO_NOEXCEPT
+  {
+    return const_buffers_type(ring_.data());
+  }
+
+  /// Get a list of buffers that represents the output sequence, with the given
+  /// size.
+  /**
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   *
+   * @note The returned object is invalidated by any @c dynamic_ring_buffer
+   * or @c ring_buffer member function that modifies the input sequence or
+   * output sequence.
+   */
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    return mutable_buffers_type(ring_.prepare(n));
+  }
+
+  /// Move bytes from the output sequence to the input sequence.
+  void commit(std::size_t n)
+  {
+    ring_.commit(n);
+  }
+
+  /// Remove characters from the input sequence.
+  void consume(std::size_t n)
+  {
+    ring_.consume(n);
+  }
+
+private:
+  ring_buffer& ring_;
+};
+
+/** @addtogroup dynamic_buffer */
+/*@{*/
+
+/// Create a new dynamic buffer that represents the given ring buffer.
+/**
+ * @returns <tt>dynamic_ring_buffer(data)</tt>.
+ */
+inline dynamic_ring_buffer dynamic_buffer(ring_buffer& data) ASIO_NOEXCEPT
+{
+  return dynamic_ring_buffer(data);
+}
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_RING_BUFFER_HPP
@@ -41,6 +41,14 @@ public:
         associated_allocator<Handler>::get(handler));
   }
 
+  // Complete using the given allocator for any memory that the executor needs
+  // to run the function.
+  template <typename Function, typename Allocator>
+  void complete(Function& function, Handler&, const Allocator& a)
+  {
+    executor_.dispatch(static_cast<Function&&>(function), a);
+  }
+
 private:
   // Disallow copying and assignment.
   handler_work(const handler_work&);
@@ -67,6 +75,12 @@ public:
     asio_handler_invoke_helpers::invoke(function, handler);
   }
 
+  template <typename Function, typename Allocator>
+  void complete(Function& function, Handler& handler, const Allocator&)
+  {
+    asio_handler_invoke_helpers::invoke(function, handler);
+  }
+
 private:
   // Disallow copying and assignment.
   handler_work(const handler_work&);
@@ -11,6 +11,10 @@
 
 # include "asio/core/scheduler/scheduler.hpp"
 
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+# include "asio/detail/reactor/reactor.hpp"
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -93,6 +97,15 @@ void io_context::restart()
   impl_.restart();
 }
 
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+timer_metrics io_context::get_timer_metrics()
+{
+  timer_metrics m;
+  asio::use_service<asio::detail::reactor>(*this).collect_timer_metrics(m);
+  return m;
+}
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
 io_context::service::service(asio::io_context& owner)
   : execution_context::service(owner)
 {
@@ -11,6 +11,10 @@
 #include "asio/error/error_code.hpp"
 #include "asio/core/execution_context.hpp"
 
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+# include "asio/core/timer_metrics.hpp"
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
 # include "asio/detail/base/stdcpp/chrono.hpp"
 
 # include "asio/detail/base/signal_init.hpp"
@@ -79,6 +83,11 @@ public:
 
   ASIO_DECL void restart();
 
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+  // Get a snapshot of the sizes and counters of the io_context's timers.
+  ASIO_DECL timer_metrics get_timer_metrics();
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
 private:
   // Helper function to add the implementation.
   ASIO_DECL impl_type& add_impl(impl_type* impl);
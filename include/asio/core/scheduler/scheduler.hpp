@@ -25,6 +25,13 @@
 
 #include "asio/detail/push_options.hpp"
 
+// This #define may be overridden at compile time to specify the maximum number
+// of nested handler invocations performed by sockets in immediate completion
+// mode, before further completions are queued instead.
+#if !defined(ASIO_IMMEDIATE_COMPLETION_MAX_DEPTH)
+# define ASIO_IMMEDIATE_COMPLETION_MAX_DEPTH 8
+#endif // !defined(ASIO_IMMEDIATE_COMPLETION_MAX_DEPTH)
+
 namespace asio {
 namespace detail {
 
@@ -101,6 +108,14 @@ public:
   ASIO_DECL void post_immediate_completion(
       operation* op, bool is_continuation);
 
+  // Invoke the given operation, which has already completed, from within the
+  // calling function. The invocation only happens inline when called from a
+  // thread running the scheduler and fewer than
+  // ASIO_IMMEDIATE_COMPLETION_MAX_DEPTH such invocations are already active on
+  // the stack; otherwise the operation is queued. Assumes that work_started()
+  // has not yet been called for the operation.
+  ASIO_DECL void dispatch_immediate_completion(operation* op);
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() was previously called for the operation.
   ASIO_DECL void post_deferred_completion(operation* op);
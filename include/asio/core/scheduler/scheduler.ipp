@@ -10,6 +10,7 @@
 #include "asio/detail/reactor/reactor.hpp"
 #include "asio/core/scheduler/scheduler.hpp"
 #include "asio/core/scheduler/scheduler_thread_info.hpp"
+#include "asio/service/timer/helper/cached_steady_clock.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -135,7 +136,9 @@ std::size_t scheduler::run(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.immediate_completion_depth = 0;
   thread_call_stack::context ctx(this, this_thread);
+  refresh_cached_clock();
 
   mutex::scoped_lock lock(mutex_);
 
@@ -157,7 +160,9 @@ std::size_t scheduler::run_one(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.immediate_completion_depth = 0;
   thread_call_stack::context ctx(this, this_thread);
+  refresh_cached_clock();
 
   mutex::scoped_lock lock(mutex_);
 
@@ -175,7 +180,9 @@ std::size_t scheduler::wait_one(long usec, asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.immediate_completion_depth = 0;
   thread_call_stack::context ctx(this, this_thread);
+  refresh_cached_clock();
 
   mutex::scoped_lock lock(mutex_);
 
@@ -193,7 +200,9 @@ std::size_t scheduler::poll(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.immediate_completion_depth = 0;
   thread_call_stack::context ctx(this, this_thread);
+  refresh_cached_clock();
 
   mutex::scoped_lock lock(mutex_);
 
@@ -224,7 +233,9 @@ std::size_t scheduler::poll_one(asio::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.immediate_completion_depth = 0;
   thread_call_stack::context ctx(this, this_thread);
+  refresh_cached_clock();
 
   mutex::scoped_lock lock(mutex_);
 
@@ -287,6 +298,35 @@ void scheduler::post_immediate_completion(
   wake_one_thread_and_unlock(lock);
 }
 
+void scheduler::dispatch_immediate_completion(scheduler::operation* op)
+{
+  if (thread_info_base* base = thread_call_stack::contains(this))
+  {
+    thread_info* this_thread = static_cast<thread_info*>(base);
+    if (this_thread->immediate_completion_depth
+        < ASIO_IMMEDIATE_COMPLETION_MAX_DEPTH)
+    {
+      struct depth_cleanup
+      {
+        ~depth_cleanup() { --*depth_; }
+        long* depth_;
+      } on_exit = { &this_thread->immediate_completion_depth };
+
+      ++this_thread->immediate_completion_depth;
+      op->complete(this, asio::error_code(), 0);
+      return;
+    }
+
+    // Too deeply nested, so defer the handler to the thread's private queue.
+    // It is run after the current handler returns, without taking the lock.
+    ++this_thread->private_outstanding_work;
+    this_thread->private_op_queue.push(op);
+    return;
+  }
+
+  post_immediate_completion(op, false);
+}
+
 void scheduler::post_deferred_completion(scheduler::operation* op)
 {
 #if defined(ASIO_HAS_THREADS)
@@ -396,6 +436,7 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
     {
       wakeup_event_.clear(lock);
       wakeup_event_.wait(lock);
+      refresh_cached_clock();
     }
   }
 
@@ -414,6 +455,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   {
     wakeup_event_.clear(lock);
     wakeup_event_.wait_for_usec(lock, usec);
+    refresh_cached_clock();
     usec = 0; // Wait at most once.
     o = op_queue_.front();
   }
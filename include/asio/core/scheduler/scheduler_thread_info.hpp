@@ -16,6 +16,7 @@ struct scheduler_thread_info : public thread_info_base
 {
   op_queue<scheduler_operation> private_op_queue;
   long private_outstanding_work;
+  long immediate_completion_depth;
 };
 
 } // namespace detail
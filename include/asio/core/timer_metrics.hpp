@@ -0,0 +1,74 @@
+#ifndef ASIO_TIMER_METRICS_HPP
+#define ASIO_TIMER_METRICS_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <vector>
+#include "asio/detail/base/stdcpp/cstdint.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A snapshot of the state of an io_context's timers.
+/**
+ * Timer metrics are collected only when @c ASIO_ENABLE_TIMER_METRICS is
+ * defined, and are obtained by calling io_context::get_timer_metrics(). The
+ * counters are cumulative from the time at which each timer queue was created.
+ *
+ * Lateness is measured when the reactor dequeues an expired timer, as the time
+ * elapsed since the timer's expiry time. It does not include the time that the
+ * handler then waits for a thread to run it. A high lateness indicates that
+ * the threads running the io_context are saturated, or that the reactor is
+ * not woken promptly when a timer expires.
+ */
+struct timer_metrics
+{
+  /// The number of buckets in the lateness histogram.
+  static const std::size_t lateness_buckets = 32;
+
+  /// The number of timers in all queues that are waiting to expire.
+  std::size_t timer_count;
+
+  /// The number of timers waiting to expire in each timer queue.
+  std::vector<std::size_t> queue_sizes;
+
+  /// The number of wait operations that completed because their timer expired.
+  uint64_t fired;
+
+  /// The number of wait operations that were cancelled.
+  uint64_t cancelled;
+
+  /// A histogram of the lateness of the operations that have fired. Bucket 0
+  /// counts lateness of less than one microsecond. Bucket n counts lateness of
+  /// at least 2^(n-1) and less than 2^n microseconds, except that the last
+  /// bucket also counts all greater lateness.
+  uint64_t lateness[lateness_buckets];
+
+  /// The number of times a timer descriptor has been armed by calling
+  /// @c timerfd_settime.
+  uint64_t timerfd_settime_calls;
+
+  /// Constructor.
+  timer_metrics()
+    : timer_count(0),
+      fired(0),
+      cancelled(0),
+      timerfd_settime_calls(0)
+  {
+    for (std::size_t i = 0; i < lateness_buckets; ++i)
+      lateness[i] = 0;
+  }
+
+  /// Get the number of operations cancelled for each operation that fired.
+  double cancel_fire_ratio() const
+  {
+    return fired ? static_cast<double>(cancelled) / fired : 0.0;
+  }
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_TIMER_METRICS_HPP
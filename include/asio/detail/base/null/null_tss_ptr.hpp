@@ -23,6 +23,13 @@ public:
   {
   }
 
+  // Construct with a function to be called when a thread exits. There is only
+  // one thread, so the function is never called.
+  explicit null_tss_ptr(void (*)(void*))
+    : value_(0)
+  {
+  }
+
   // Destructor.
   ~null_tss_ptr()
   {
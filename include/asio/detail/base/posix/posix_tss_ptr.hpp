@@ -13,8 +13,10 @@
 namespace asio {
 namespace detail {
 
-// Helper function to create thread-specific storage.
-ASIO_DECL void posix_tss_ptr_create(pthread_key_t& key);
+// Helper function to create thread-specific storage. The cleanup function, if
+// any, is called with a thread's non-null value when the thread exits.
+ASIO_DECL void posix_tss_ptr_create(pthread_key_t& key,
+    void (*cleanup)(void*) = 0);
 
 template <typename T>
 class posix_tss_ptr
@@ -27,6 +29,13 @@ public:
     posix_tss_ptr_create(tss_key_);
   }
 
+  // Construct with a function to be called with a thread's value when the
+  // thread exits.
+  explicit posix_tss_ptr(void (*cleanup)(void*))
+  {
+    posix_tss_ptr_create(tss_key_, cleanup);
+  }
+
   // Destructor.
   ~posix_tss_ptr()
   {
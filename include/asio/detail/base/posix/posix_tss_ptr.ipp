@@ -14,9 +14,9 @@
 namespace asio {
 namespace detail {
 
-void posix_tss_ptr_create(pthread_key_t& key)
+void posix_tss_ptr_create(pthread_key_t& key, void (*cleanup)(void*))
 {
-  int error = ::pthread_key_create(&key, 0);
+  int error = ::pthread_key_create(&key, cleanup);
   asio::error_code ec(error,
       asio::error::get_system_category());
   asio::detail::throw_error(ec, "tss");
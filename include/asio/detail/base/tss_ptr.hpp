@@ -25,6 +25,21 @@ class tss_ptr
 #endif
 {
 public:
+  tss_ptr()
+  {
+  }
+
+  // Construct with a function to be called with a thread's non-null value
+  // when the thread exits.
+  explicit tss_ptr(void (*cleanup)(void*))
+#if !defined(ASIO_HAS_THREADS)
+    : null_tss_ptr<T>(cleanup)
+#elif defined(ASIO_HAS_PTHREADS)
+    : posix_tss_ptr<T>(cleanup)
+#endif
+  {
+  }
+
   void operator=(T* value)
   {
 #if !defined(ASIO_HAS_THREADS)
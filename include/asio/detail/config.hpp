@@ -14,6 +14,7 @@
 // for study
 #include <iostream>
 // #define ASIO_ENABLE_HANDLER_TRACKING
+// #define ASIO_ENABLE_TIMER_METRICS
 #define ASIO_ENABLE_STUDY
 
 #if defined(ASIO_STANDALONE)
@@ -1013,7 +1014,7 @@
 # include <unistd.h>
 #endif // defined(ASIO_HAS_UNISTD_H)
 
-// Linux: epoll, eventfd and timerfd.
+// Linux: epoll, eventfd, timerfd, sendfile, memfd and transparent huge pages.
 #if defined(__linux__)
 # include <linux/version.h>
 # if !defined(ASIO_HAS_EPOLL)
@@ -1037,6 +1038,29 @@
 #   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 #  endif // defined(ASIO_HAS_EPOLL)
 # endif // !defined(ASIO_HAS_TIMERFD)
+# if !defined(ASIO_HAS_SENDFILE)
+#  if !defined(ASIO_DISABLE_SENDFILE)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,17)
+#    define ASIO_HAS_SENDFILE 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,17)
+#  endif // !defined(ASIO_DISABLE_SENDFILE)
+# endif // !defined(ASIO_HAS_SENDFILE)
+# if !defined(ASIO_HAS_MEMFD)
+#  if !defined(ASIO_DISABLE_MEMFD)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(3,17,0)
+#    if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27)
+#     define ASIO_HAS_MEMFD 1
+#    endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27)
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(3,17,0)
+#  endif // !defined(ASIO_DISABLE_MEMFD)
+# endif // !defined(ASIO_HAS_MEMFD)
+# if !defined(ASIO_HAS_HUGEPAGES)
+#  if !defined(ASIO_DISABLE_HUGEPAGES)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,38)
+#    define ASIO_HAS_HUGEPAGES 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,38)
+#  endif // !defined(ASIO_DISABLE_HUGEPAGES)
+# endif // !defined(ASIO_HAS_HUGEPAGES)
 #endif // defined(__linux__)
 
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
@@ -1189,6 +1213,36 @@
 # endif // !defined(ASIO_DISABLE_GETADDRINFO)
 #endif // !defined(ASIO_HAS_GETADDRINFO)
 
+// Can use memmem().
+#if !defined(ASIO_HAS_MEMMEM)
+# if !defined(ASIO_DISABLE_MEMMEM)
+#  if defined(__linux__) \
+    || (defined(__MACH__) && defined(__APPLE__)) \
+    || defined(__FreeBSD__) \
+    || defined(__NetBSD__) \
+    || defined(__OpenBSD__)
+#   define ASIO_HAS_MEMMEM 1
+#  endif // defined(__linux__) || ...
+# endif // !defined(ASIO_DISABLE_MEMMEM)
+#endif // !defined(ASIO_HAS_MEMMEM)
+
+// Hardware CRC32C instructions. On x86 they are used only if the processor
+// reports SSE4.2 support at run time.
+#if !defined(ASIO_DISABLE_CRC32C_INTRINSICS)
+# if !defined(ASIO_HAS_SSE42_CRC32C)
+#  if (defined(__GNUC__) && (__GNUC__ >= 5)) || defined(__clang__)
+#   if defined(__x86_64__) || defined(__i386__)
+#    define ASIO_HAS_SSE42_CRC32C 1
+#   endif // defined(__x86_64__) || defined(__i386__)
+#  endif // (defined(__GNUC__) && (__GNUC__ >= 5)) || defined(__clang__)
+# endif // !defined(ASIO_HAS_SSE42_CRC32C)
+# if !defined(ASIO_HAS_ARM_CRC32C)
+#  if defined(__ARM_FEATURE_CRC32)
+#   define ASIO_HAS_ARM_CRC32C 1
+#  endif // defined(__ARM_FEATURE_CRC32)
+# endif // !defined(ASIO_HAS_ARM_CRC32C)
+#endif // !defined(ASIO_DISABLE_CRC32C_INTRINSICS)
+
 // Whether standard iostreams are disabled.
 #if !defined(ASIO_NO_IOSTREAM)
 # if defined(ASIO_HAS_BOOST_CONFIG) && defined(BOOST_NO_IOSTREAM)
@@ -5,6 +5,7 @@
 
 #if defined(ASIO_HAS_EPOLL)
 
+#include <atomic>
 #include "asio/detail/base/stdcpp/atomic_count.hpp"
 #include "asio/detail/base/conditionally_enabled_mutex.hpp"
 // #include "asio/detail/base/stdcpp/stdcpp/limits.hpp"
@@ -112,6 +113,15 @@ public:
       per_descriptor_data& descriptor_data, reactor_op* op,
       bool is_continuation, bool allow_speculative);
 
+  // Start a new operation, performing it immediately if no other operations
+  // of the same type are pending on the descriptor. If the operation
+  // finishes, its handler is dispatched through the scheduler's immediate
+  // completion path. Otherwise the operation is queued, without releasing the
+  // descriptor's lock, as if by start_op().
+  ASIO_DECL void start_immediate_op(int op_type, socket_type descriptor,
+      per_descriptor_data& descriptor_data, reactor_op* op,
+      bool is_continuation);
+
   // Cancel all operations associated with the given descriptor. The
   // handlers associated with the descriptor will be invoked with the
   // operation_aborted error.
@@ -157,6 +167,13 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel the timer operations associated with a batch of timers linked by
+  // set_batch_next(). Returns the number of operations that have been posted
+  // or dispatched.
+  template <typename Time_Traits>
+  std::size_t cancel_timers(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data* batch);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
@@ -169,6 +186,11 @@ public:
   // Interrupt the select loop.
   ASIO_DECL void interrupt();
 
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+  // Add the sizes and counters of the reactor's timer queues to the metrics.
+  ASIO_DECL void collect_timer_metrics(timer_metrics& m);
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
 private:
   // The hint to pass to epoll_create to size its data structures.
   enum { epoll_size = 20000 };
@@ -177,8 +199,18 @@ private:
   // cannot be created.
   ASIO_DECL static int do_epoll_create();
 
-  // Create the timerfd file descriptor. Does not throw.
-  ASIO_DECL static int do_timerfd_create();
+  // Helper function to start an operation. If immediate is true, an
+  // operation that is performed speculatively is dispatched rather than
+  // posted.
+  ASIO_DECL void do_start_op(int op_type, socket_type descriptor,
+      per_descriptor_data& descriptor_data, reactor_op* op,
+      bool is_continuation, bool allow_speculative, bool immediate);
+
+  // Create a timerfd file descriptor for the given clock. Does not throw.
+  ASIO_DECL static int do_timerfd_create(int clock_id);
+
+  // Register a timerfd file descriptor with epoll.
+  ASIO_DECL void register_timerfd(int& fd);
 
   // Allocate a new descriptor state object.
   ASIO_DECL descriptor_state* allocate_descriptor_state();
@@ -192,7 +224,8 @@ private:
   // Helper function to remove a timer queue.
   ASIO_DECL void do_remove_timer_queue(timer_queue_base& queue);
 
-  // Called to recalculate and update the timeout.
+  // Called to recalculate and update the timeout. Must not be called with the
+  // mutex or any timer queue lock held.
   ASIO_DECL void update_timeout();
 
   // Get the timeout value for the epoll_wait call. The timeout value is
@@ -204,12 +237,22 @@ private:
   // Get the timeout value for the timer descriptor. The return value is the
   // flag argument to be used when calling timerfd_settime.
   ASIO_DECL int get_timeout(itimerspec& ts);
+
+  // Get the timeout value for the realtime timer descriptor. The return value
+  // is the flag argument to be used when calling timerfd_settime.
+  ASIO_DECL int get_realtime_timeout(itimerspec& ts);
+
+  // Arm the timer descriptors for the earliest timers. The mutex must be held.
+  ASIO_DECL void arm_timer_fds();
 #endif // defined(ASIO_HAS_TIMERFD)
 
   // The scheduler implementation used to post completions.
   scheduler& scheduler_;
 
-  // Mutex to protect access to internal data.
+  // Mutex to protect access to internal data. Each timer queue has its own
+  // lock, so that arming and cancelling timers does not contend with the
+  // reactor or with timers in other queues. The mutex only guards membership
+  // of the set of queues and the computation of the reactor's timeout.
   mutex mutex_;
 
   // The interrupter is used to break a blocking epoll_wait call.
@@ -218,14 +261,28 @@ private:
   // The epoll file descriptor.
   int epoll_fd_;
 
-  // The timer file descriptor.
+  // The timer file descriptor. It is armed at an absolute time on the
+  // monotonic clock, so that timers measured by that clock fire precisely.
   int timer_fd_;
 
+  // The timer file descriptor for timers measured by the realtime clock,
+  // created when the first queue of such timers is added. It is armed at an
+  // absolute time and is cancelled when the system clock is changed, so that
+  // the timers follow changes to the wall clock.
+  int realtime_timer_fd_;
+
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+  // The number of times the timer descriptors have been armed. Protected by
+  // the mutex.
+  uint64_t timerfd_settime_calls_;
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
   // The timer queues.
   timer_queue_set timer_queues_;
 
-  // Whether the service has been shut down.
-  bool shutdown_;
+  // Whether the service has been shut down. Timers are scheduled under their
+  // queue's lock rather than the mutex, so the flag is atomic.
+  std::atomic<bool> shutdown_;
 
   // Mutex to protect access to the registered descriptors.
   mutex registered_descriptors_mutex_;
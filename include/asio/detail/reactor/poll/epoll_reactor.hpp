@@ -26,16 +26,21 @@ void epoll_reactor::schedule_timer(timer_queue<Time_Traits>& queue,
     const typename Time_Traits::time_type& time,
     typename timer_queue<Time_Traits>::per_timer_data& timer, wait_op* op)
 {
-  mutex::scoped_lock lock(mutex_);
+  timer_queue_set::scoped_queue_lock lock(timer_queues_, queue);
 
+  // The shutdown flag is set before shutdown() drains the queues, each under
+  // its queue's lock, so a timer added after the queue is drained sees it.
   if (shutdown_)
   {
+    lock.unlock();
     scheduler_.post_immediate_completion(op, false);
     return;
   }
 
   bool earliest = queue.enqueue_timer(time, timer, op);
   scheduler_.work_started();
+  lock.unlock();
+
   if (earliest)
     update_timeout();
 }
@@ -45,7 +50,7 @@ std::size_t epoll_reactor::cancel_timer(timer_queue<Time_Traits>& queue,
     typename timer_queue<Time_Traits>::per_timer_data& timer,
     std::size_t max_cancelled)
 {
-  mutex::scoped_lock lock(mutex_);
+  timer_queue_set::scoped_queue_lock lock(timer_queues_, queue);
   op_queue<operation> ops;
   std::size_t n = queue.cancel_timer(timer, ops, max_cancelled);
   lock.unlock();
@@ -53,12 +58,24 @@ std::size_t epoll_reactor::cancel_timer(timer_queue<Time_Traits>& queue,
   return n;
 }
 
+template <typename Time_Traits>
+std::size_t epoll_reactor::cancel_timers(timer_queue<Time_Traits>& queue,
+    typename timer_queue<Time_Traits>::per_timer_data* batch)
+{
+  timer_queue_set::scoped_queue_lock lock(timer_queues_, queue);
+  op_queue<operation> ops;
+  std::size_t n = queue.cancel_timers(batch, ops);
+  lock.unlock();
+  scheduler_.post_deferred_completions(ops);
+  return n;
+}
+
 template <typename Time_Traits>
 void epoll_reactor::move_timer(timer_queue<Time_Traits>& queue,
     typename timer_queue<Time_Traits>::per_timer_data& target,
     typename timer_queue<Time_Traits>::per_timer_data& source)
 {
-  mutex::scoped_lock lock(mutex_);
+  timer_queue_set::scoped_queue_lock lock(timer_queues_, queue);
   op_queue<operation> ops;
   queue.cancel_timer(target, ops);
   queue.move_timer(target, source);
@@ -10,6 +10,7 @@
 #include "asio/detail/reactor/epoll_reactor.hpp"
 #include "asio/error/throw_error.hpp"
 #include "asio/error/error.hpp"
+#include "asio/service/timer/helper/cached_steady_clock.hpp"
 
 #if defined(ASIO_HAS_TIMERFD)
 # include <sys/timerfd.h>
@@ -27,7 +28,12 @@ epoll_reactor::epoll_reactor(asio::execution_context& ctx)
           REACTOR_REGISTRATION, scheduler_.concurrency_hint())),
     interrupter_(),
     epoll_fd_(do_epoll_create()),
-    timer_fd_(do_timerfd_create()),
+    timer_fd_(do_timerfd_create(CLOCK_MONOTONIC)),
+    realtime_timer_fd_(-1),
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+    timerfd_settime_calls_(0),
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+    timer_queues_(mutex_.enabled()),
     shutdown_(false),
     registered_descriptors_mutex_(mutex_.enabled())
 {
@@ -42,12 +48,7 @@ epoll_reactor::epoll_reactor(asio::execution_context& ctx)
   interrupter_.interrupt();
 
   // Add the timer descriptor to epoll.
-  if (timer_fd_ != -1)
-  {
-    ev.events = EPOLLIN | EPOLLERR;
-    ev.data.ptr = &timer_fd_;
-    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &ev);
-  }
+  register_timerfd(timer_fd_);
 }
 
 epoll_reactor::~epoll_reactor()
@@ -56,6 +57,8 @@ epoll_reactor::~epoll_reactor()
     close(epoll_fd_);
   if (timer_fd_ != -1)
     close(timer_fd_);
+  if (realtime_timer_fd_ != -1)
+    close(realtime_timer_fd_);
 }
 
 void epoll_reactor::shutdown()
@@ -92,7 +95,14 @@ void epoll_reactor::notify_fork(
     if (timer_fd_ != -1)
       ::close(timer_fd_);
     timer_fd_ = -1;
-    timer_fd_ = do_timerfd_create();
+    timer_fd_ = do_timerfd_create(CLOCK_MONOTONIC);
+
+    if (realtime_timer_fd_ != -1)
+    {
+      ::close(realtime_timer_fd_);
+      realtime_timer_fd_ = -1;
+      realtime_timer_fd_ = do_timerfd_create(CLOCK_REALTIME);
+    }
 
     interrupter_.recreate();
 
@@ -103,13 +113,9 @@ void epoll_reactor::notify_fork(
     epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, interrupter_.read_descriptor(), &ev);
     interrupter_.interrupt();
 
-    // Add the timer descriptor to epoll.
-    if (timer_fd_ != -1)
-    {
-      ev.events = EPOLLIN | EPOLLERR;
-      ev.data.ptr = &timer_fd_;
-      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &ev);
-    }
+    // Add the timer descriptors to epoll.
+    register_timerfd(timer_fd_);
+    register_timerfd(realtime_timer_fd_);
 
     update_timeout();
 
@@ -212,6 +218,22 @@ void epoll_reactor::move_descriptor(socket_type,
 void epoll_reactor::start_op(int op_type, socket_type descriptor,
     epoll_reactor::per_descriptor_data& descriptor_data, reactor_op* op,
     bool is_continuation, bool allow_speculative)
+{
+  do_start_op(op_type, descriptor, descriptor_data,
+      op, is_continuation, allow_speculative, false);
+}
+
+void epoll_reactor::start_immediate_op(int op_type, socket_type descriptor,
+    epoll_reactor::per_descriptor_data& descriptor_data, reactor_op* op,
+    bool is_continuation)
+{
+  do_start_op(op_type, descriptor, descriptor_data,
+      op, is_continuation, true, true);
+}
+
+void epoll_reactor::do_start_op(int op_type, socket_type descriptor,
+    epoll_reactor::per_descriptor_data& descriptor_data, reactor_op* op,
+    bool is_continuation, bool allow_speculative, bool immediate)
 {
   if (!descriptor_data)
   {
@@ -242,7 +264,10 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
             if (descriptor_data->registered_events_ != 0)
               descriptor_data->try_speculative_[op_type] = false;
           descriptor_lock.unlock();
-          scheduler_.post_immediate_completion(op, is_continuation);
+          if (immediate)
+            scheduler_.dispatch_immediate_completion(op);
+          else
+            scheduler_.post_immediate_completion(op, is_continuation);
           return;
         }
       }
@@ -433,6 +458,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
     timeout = (usec < 0) ? -1 : ((usec - 1) / 1000 + 1);
     if (timer_fd_ == -1)
     {
+      refresh_cached_clock();
       mutex::scoped_lock lock(mutex_);
       timeout = get_timeout(timeout);
     }
@@ -441,6 +467,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   // Block on the epoll descriptor.
   epoll_event events[128];
   int num_events = epoll_wait(epoll_fd_, events, 128, timeout);
+  refresh_cached_clock();
 
 #if defined(ASIO_HAS_TIMERFD)
   bool check_timers = (timer_fd_ == -1);
@@ -467,7 +494,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
 #endif // defined(ASIO_HAS_TIMERFD)
     }
 #if defined(ASIO_HAS_TIMERFD)
-    else if (ptr == &timer_fd_)
+    else if (ptr == &timer_fd_ || ptr == &realtime_timer_fd_)
     {
       check_timers = true;
     }
@@ -497,12 +524,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
 
 #if defined(ASIO_HAS_TIMERFD)
     if (timer_fd_ != -1)
-    {
-      itimerspec new_timeout;
-      itimerspec old_timeout;
-      int flags = get_timeout(new_timeout);
-      timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
-    }
+      arm_timer_fds();
 #endif // defined(ASIO_HAS_TIMERFD)
   }
 }
@@ -515,6 +537,15 @@ void epoll_reactor::interrupt()
   epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, interrupter_.read_descriptor(), &ev);
 }
 
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+void epoll_reactor::collect_timer_metrics(timer_metrics& m)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.collect_metrics(m);
+  m.timerfd_settime_calls += timerfd_settime_calls_;
+}
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
 int epoll_reactor::do_epoll_create()
 {
 #if defined(EPOLL_CLOEXEC)
@@ -541,11 +572,11 @@ int epoll_reactor::do_epoll_create()
   return fd;
 }
 
-int epoll_reactor::do_timerfd_create()
+int epoll_reactor::do_timerfd_create(int clock_id)
 {
 #if defined(ASIO_HAS_TIMERFD)
 # if defined(TFD_CLOEXEC)
-  int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+  int fd = timerfd_create(clock_id, TFD_CLOEXEC);
 # else // defined(TFD_CLOEXEC)
   int fd = -1;
   errno = EINVAL;
@@ -553,17 +584,29 @@ int epoll_reactor::do_timerfd_create()
 
   if (fd == -1 && errno == EINVAL)
   {
-    fd = timerfd_create(CLOCK_MONOTONIC, 0);
+    fd = timerfd_create(clock_id, 0);
     if (fd != -1)
       ::fcntl(fd, F_SETFD, FD_CLOEXEC);
   }
 
   return fd;
 #else // defined(ASIO_HAS_TIMERFD)
+  (void)clock_id;
   return -1;
 #endif // defined(ASIO_HAS_TIMERFD)
 }
 
+void epoll_reactor::register_timerfd(int& fd)
+{
+  if (fd != -1)
+  {
+    epoll_event ev = { 0, { 0 } };
+    ev.events = EPOLLIN | EPOLLERR;
+    ev.data.ptr = &fd;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+  }
+}
+
 epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
 {
   mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
@@ -581,6 +624,16 @@ void epoll_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
   timer_queues_.insert(&queue);
+
+  // Timers measured by the realtime clock are given their own timer
+  // descriptor. Without one, they are armed relative to the monotonic clock
+  // along with all other timers.
+  if (queue.native_clock() == timer_queue_base::realtime_clock
+      && timer_fd_ != -1 && realtime_timer_fd_ == -1)
+  {
+    realtime_timer_fd_ = do_timerfd_create(CLOCK_REALTIME);
+    register_timerfd(realtime_timer_fd_);
+  }
 }
 
 void epoll_reactor::do_remove_timer_queue(timer_queue_base& queue)
@@ -594,10 +647,8 @@ void epoll_reactor::update_timeout()
 #if defined(ASIO_HAS_TIMERFD)
   if (timer_fd_ != -1)
   {
-    itimerspec new_timeout;
-    itimerspec old_timeout;
-    int flags = get_timeout(new_timeout);
-    timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
+    mutex::scoped_lock lock(mutex_);
+    arm_timer_fds();
     return;
   }
 #endif // defined(ASIO_HAS_TIMERFD)
@@ -619,11 +670,74 @@ int epoll_reactor::get_timeout(itimerspec& ts)
   ts.it_interval.tv_sec = 0;
   ts.it_interval.tv_nsec = 0;
 
-  long usec = timer_queues_.wait_duration_usec(5 * 60 * 1000 * 1000);
-  ts.it_value.tv_sec = usec / 1000000;
-  ts.it_value.tv_nsec = usec ? (usec % 1000000) * 1000 : 1;
+  // Timers measured by the monotonic clock are armed at their exact expiry
+  // time. The others are armed relative to now, except for those measured by
+  // the realtime clock when they have a timer descriptor of their own.
+  int excluded_clocks = timer_queue_base::monotonic_clock;
+  if (realtime_timer_fd_ != -1)
+    excluded_clocks |= timer_queue_base::realtime_clock;
+  long usec = timer_queues_.wait_duration_usec(
+      5 * 60 * 1000 * 1000, excluded_clocks);
+
+  timespec now = { 0, 0 };
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  ts.it_value.tv_sec = now.tv_sec + usec / 1000000;
+  ts.it_value.tv_nsec = now.tv_nsec + (usec % 1000000) * 1000;
+  if (ts.it_value.tv_nsec >= 1000000000)
+  {
+    ts.it_value.tv_sec += 1;
+    ts.it_value.tv_nsec -= 1000000000;
+  }
+
+  timespec expiry;
+  if (timer_queues_.earliest_expiry(timer_queue_base::monotonic_clock, expiry)
+      && (expiry.tv_sec < ts.it_value.tv_sec
+        || (expiry.tv_sec == ts.it_value.tv_sec
+          && expiry.tv_nsec < ts.it_value.tv_nsec)))
+    ts.it_value = expiry;
+
+  return TFD_TIMER_ABSTIME;
+}
+
+int epoll_reactor::get_realtime_timeout(itimerspec& ts)
+{
+  ts.it_interval.tv_sec = 0;
+  ts.it_interval.tv_nsec = 0;
+
+  // With no timers the descriptor is disarmed, but a change to the system
+  // clock still wakes the reactor.
+  if (!timer_queues_.earliest_expiry(
+        timer_queue_base::realtime_clock, ts.it_value))
+  {
+    ts.it_value.tv_sec = 0;
+    ts.it_value.tv_nsec = 0;
+  }
+
+#if defined(TFD_TIMER_CANCEL_ON_SET)
+  return TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET;
+#else // defined(TFD_TIMER_CANCEL_ON_SET)
+  return TFD_TIMER_ABSTIME;
+#endif // defined(TFD_TIMER_CANCEL_ON_SET)
+}
 
-  return usec ? 0 : TFD_TIMER_ABSTIME;
+void epoll_reactor::arm_timer_fds()
+{
+  itimerspec new_timeout;
+  itimerspec old_timeout;
+  int flags = get_timeout(new_timeout);
+  timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+  ++timerfd_settime_calls_;
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
+  if (realtime_timer_fd_ != -1)
+  {
+    flags = get_realtime_timeout(new_timeout);
+    timerfd_settime(realtime_timer_fd_, flags, &new_timeout, &old_timeout);
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+    ++timerfd_settime_calls_;
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+  }
 }
 #endif // defined(ASIO_HAS_TIMERFD)
 
@@ -8,6 +8,7 @@
 #include "asio/detail/reactor/select_reactor.hpp"
 #include "asio/detail/base/signal_blocker.hpp"
 #include "asio/network/socket_ops.hpp"
+#include "asio/service/timer/helper/cached_steady_clock.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -19,13 +20,33 @@ select_reactor::select_reactor(asio::execution_context& ctx)
     scheduler_(use_service<scheduler_type>(ctx)),
     mutex_(),
     interrupter_(),
+    timer_queues_(true),
+#if defined(ASIO_HAS_TIMERFD)
+    timer_fd_(do_timerfd_create(CLOCK_MONOTONIC)),
+    realtime_timer_fd_(-1),
+# if defined(ASIO_ENABLE_TIMER_METRICS)
+    timerfd_settime_calls_(0),
+# endif // defined(ASIO_ENABLE_TIMER_METRICS)
+#endif // defined(ASIO_HAS_TIMERFD)
     shutdown_(false)
 {
+#if defined(ASIO_HAS_TIMERFD)
+  timer_fd_armed_.tv_sec = 0;
+  timer_fd_armed_.tv_nsec = 0;
+  realtime_timer_fd_armed_ = timer_fd_armed_;
+#endif // defined(ASIO_HAS_TIMERFD)
 }
 
 select_reactor::~select_reactor()
 {
   shutdown();
+
+#if defined(ASIO_HAS_TIMERFD)
+  if (timer_fd_ != -1)
+    ::close(timer_fd_);
+  if (realtime_timer_fd_ != -1)
+    ::close(realtime_timer_fd_);
+#endif // defined(ASIO_HAS_TIMERFD)
 }
 
 void select_reactor::shutdown()
@@ -48,7 +69,30 @@ void select_reactor::notify_fork(
     asio::execution_context::fork_event fork_ev)
 {
   if (fork_ev == asio::execution_context::fork_child)
+  {
     interrupter_.recreate();
+
+#if defined(ASIO_HAS_TIMERFD)
+    // The timer descriptors are shared with the parent process, so the child
+    // needs descriptors of its own.
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    if (timer_fd_ != -1)
+    {
+      ::close(timer_fd_);
+      timer_fd_ = -1;
+      timer_fd_ = do_timerfd_create(CLOCK_MONOTONIC);
+    }
+    if (realtime_timer_fd_ != -1)
+    {
+      ::close(realtime_timer_fd_);
+      realtime_timer_fd_ = -1;
+      realtime_timer_fd_ = do_timerfd_create(CLOCK_REALTIME);
+    }
+    timer_fd_armed_.tv_sec = 0;
+    timer_fd_armed_.tv_nsec = 0;
+    realtime_timer_fd_armed_ = timer_fd_armed_;
+#endif // defined(ASIO_HAS_TIMERFD)
+  }
 }
 
 void select_reactor::init_task()
@@ -98,6 +142,34 @@ void select_reactor::start_op(int op_type, socket_type descriptor,
     interrupter_.interrupt();
 }
 
+void select_reactor::start_immediate_op(int op_type, socket_type descriptor,
+    select_reactor::per_descriptor_data&, reactor_op* op,
+    bool is_continuation)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  if (shutdown_)
+  {
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  if (!op_queue_[op_type].has_operation(descriptor)
+      && (op_type != read_op
+        || !op_queue_[except_op].has_operation(descriptor))
+      && op->perform())
+  {
+    lock.unlock();
+    scheduler_.dispatch_immediate_completion(op);
+    return;
+  }
+
+  bool first = op_queue_[op_type].enqueue_operation(descriptor, op);
+  scheduler_.work_started();
+  if (first)
+    interrupter_.interrupt();
+}
+
 void select_reactor::cancel_ops(socket_type descriptor,
     select_reactor::per_descriptor_data&)
 {
@@ -134,6 +206,19 @@ void select_reactor::run(long usec, op_queue<operation>& ops)
   for (int i = 0; i < max_select_ops; ++i)
     fd_sets_[i].reset();
   fd_sets_[read_op].set(interrupter_.read_descriptor());
+#if defined(ASIO_HAS_TIMERFD)
+  if (timer_fd_ != -1)
+    arm_timer_fd(timer_fd_, timer_queue_base::monotonic_clock,
+        TFD_TIMER_ABSTIME, timer_fd_armed_);
+  if (realtime_timer_fd_ != -1)
+# if defined(TFD_TIMER_CANCEL_ON_SET)
+    arm_timer_fd(realtime_timer_fd_, timer_queue_base::realtime_clock,
+        TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET, realtime_timer_fd_armed_);
+# else // defined(TFD_TIMER_CANCEL_ON_SET)
+    arm_timer_fd(realtime_timer_fd_, timer_queue_base::realtime_clock,
+        TFD_TIMER_ABSTIME, realtime_timer_fd_armed_);
+# endif // defined(TFD_TIMER_CANCEL_ON_SET)
+#endif // defined(ASIO_HAS_TIMERFD)
   socket_type max_fd = 0;
   bool have_work_to_do = !timer_queues_.all_empty();
   for (int i = 0; i < max_select_ops; ++i)
@@ -149,7 +234,10 @@ void select_reactor::run(long usec, op_queue<operation>& ops)
   if (!usec && !have_work_to_do)
     return;
 
-  // Determine how long to block while waiting for events.
+  // Determine how long to block while waiting for events. The cached clock
+  // may have fallen behind while handlers ran, so it is refreshed first.
+  if (usec)
+    refresh_cached_clock();
   timeval tv_buf = { 0, 0 };
   timeval* tv = usec ? get_timeout(usec, tv_buf) : &tv_buf;
 
@@ -159,6 +247,7 @@ void select_reactor::run(long usec, op_queue<operation>& ops)
   asio::error_code ec;
   int retval = socket_ops::select(static_cast<int>(max_fd + 1),
       fd_sets_[read_op], fd_sets_[write_op], fd_sets_[except_op], tv, ec);
+  refresh_cached_clock();
 
   // Reset the interrupter.
   if (retval > 0 && fd_sets_[read_op].is_set(interrupter_.read_descriptor()))
@@ -169,6 +258,23 @@ void select_reactor::run(long usec, op_queue<operation>& ops)
 
   lock.lock();
 
+#if defined(ASIO_HAS_TIMERFD)
+  // A ready timer descriptor stays ready until it is armed again, even if the
+  // earliest timer is unchanged, as when the system clock has been changed.
+  if (retval > 0 && timer_fd_ != -1
+      && fd_sets_[read_op].is_set(timer_fd_))
+  {
+    timer_fd_armed_.tv_sec = -1;
+    --retval;
+  }
+  if (retval > 0 && realtime_timer_fd_ != -1
+      && fd_sets_[read_op].is_set(realtime_timer_fd_))
+  {
+    realtime_timer_fd_armed_.tv_sec = -1;
+    --retval;
+  }
+#endif // defined(ASIO_HAS_TIMERFD)
+
   // Dispatch all ready operations.
   if (retval > 0)
   {
@@ -185,10 +291,30 @@ void select_reactor::interrupt()
   interrupter_.interrupt();
 }
 
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+void select_reactor::collect_timer_metrics(timer_metrics& m)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  timer_queues_.collect_metrics(m);
+# if defined(ASIO_HAS_TIMERFD)
+  m.timerfd_settime_calls += timerfd_settime_calls_;
+# endif // defined(ASIO_HAS_TIMERFD)
+}
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
 void select_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
   timer_queues_.insert(&queue);
+
+#if defined(ASIO_HAS_TIMERFD)
+  // Timers measured by the realtime clock are given their own timer
+  // descriptor. Without one, they are waited for using the select timeout
+  // along with all other timers.
+  if (queue.native_clock() == timer_queue_base::realtime_clock
+      && realtime_timer_fd_ == -1)
+    realtime_timer_fd_ = do_timerfd_create(CLOCK_REALTIME);
+#endif // defined(ASIO_HAS_TIMERFD)
 }
 
 void select_reactor::do_remove_timer_queue(timer_queue_base& queue)
@@ -202,13 +328,66 @@ timeval* select_reactor::get_timeout(long usec, timeval& tv)
   // By default we will wait no longer than 5 minutes. This will ensure that
   // any changes to the system clock are detected after no longer than this.
   const long max_usec = 5 * 60 * 1000 * 1000;
+
+  // Timers measured by a clock that has a timer descriptor are waited for
+  // using that descriptor instead.
+  int excluded_clocks = timer_queue_base::other_clock;
+#if defined(ASIO_HAS_TIMERFD)
+  if (timer_fd_ != -1)
+    excluded_clocks |= timer_queue_base::monotonic_clock;
+  if (realtime_timer_fd_ != -1)
+    excluded_clocks |= timer_queue_base::realtime_clock;
+#endif // defined(ASIO_HAS_TIMERFD)
+
   usec = timer_queues_.wait_duration_usec(
-      (usec < 0 || max_usec < usec) ? max_usec : usec);
+      (usec < 0 || max_usec < usec) ? max_usec : usec, excluded_clocks);
   tv.tv_sec = usec / 1000000;
   tv.tv_usec = usec % 1000000;
   return &tv;
 }
 
+#if defined(ASIO_HAS_TIMERFD)
+int select_reactor::do_timerfd_create(int clock_id)
+{
+# if defined(TFD_CLOEXEC)
+  int fd = timerfd_create(clock_id, TFD_CLOEXEC);
+# else // defined(TFD_CLOEXEC)
+  int fd = -1;
+  errno = EINVAL;
+# endif // defined(TFD_CLOEXEC)
+
+  if (fd == -1 && errno == EINVAL)
+  {
+    fd = timerfd_create(clock_id, 0);
+    if (fd != -1)
+      ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+  }
+
+  return fd;
+}
+
+void select_reactor::arm_timer_fd(int fd,
+    timer_queue_base::clock_type clock, int flags, timespec& armed)
+{
+  // With no timers the descriptor is disarmed.
+  itimerspec new_timeout = { { 0, 0 }, { 0, 0 } };
+  timer_queues_.earliest_expiry(clock, new_timeout.it_value);
+
+  if (new_timeout.it_value.tv_sec != armed.tv_sec
+      || new_timeout.it_value.tv_nsec != armed.tv_nsec)
+  {
+    itimerspec old_timeout;
+    timerfd_settime(fd, flags, &new_timeout, &old_timeout);
+    armed = new_timeout.it_value;
+# if defined(ASIO_ENABLE_TIMER_METRICS)
+    ++timerfd_settime_calls_;
+# endif // defined(ASIO_ENABLE_TIMER_METRICS)
+  }
+
+  fd_sets_[read_op].set(fd);
+}
+#endif // defined(ASIO_HAS_TIMERFD)
+
 void select_reactor::cancel_ops_unlocked(socket_type descriptor,
     const asio::error_code& ec)
 {
@@ -3,6 +3,7 @@
 
 #include "asio/detail/config.hpp"
 
+#include <atomic>
 #include <cstddef>
 #include "asio/detail/base/fd_set_adapter.hpp"
 // #include "asio/detail/base/stdcpp/stdcpp/limits.hpp"
@@ -18,6 +19,10 @@
 #include "asio/detail/reactor/wait_op.hpp"
 #include "asio/core/execution_context.hpp"
 
+#if defined(ASIO_HAS_TIMERFD)
+# include <sys/timerfd.h>
+#endif // defined(ASIO_HAS_TIMERFD)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -72,6 +77,14 @@ public:
   ASIO_DECL void start_op(int op_type, socket_type descriptor,
       per_descriptor_data&, reactor_op* op, bool is_continuation, bool);
 
+  // Start a new operation, performing it immediately if no other operations
+  // of the same type are pending on the descriptor. If the operation
+  // finishes, its handler is dispatched through the scheduler's immediate
+  // completion path. Otherwise the operation is queued, without releasing the
+  // reactor's lock, as if by start_op().
+  ASIO_DECL void start_immediate_op(int op_type, socket_type descriptor,
+      per_descriptor_data&, reactor_op* op, bool is_continuation);
+
   // Cancel all operations associated with the given descriptor. The
   // handlers associated with the descriptor will be invoked with the
   // operation_aborted error.
@@ -120,6 +133,13 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel the timer operations associated with a batch of timers linked by
+  // set_batch_next(). Returns the number of operations that have been posted
+  // or dispatched.
+  template <typename Time_Traits>
+  std::size_t cancel_timers(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data* batch);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
@@ -132,6 +152,11 @@ public:
   // Interrupt the select loop.
   ASIO_DECL void interrupt();
 
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+  // Add the sizes and counters of the reactor's timer queues to the metrics.
+  ASIO_DECL void collect_timer_metrics(timer_metrics& m);
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
 private:
   // Helper function to add a new timer queue.
   ASIO_DECL void do_add_timer_queue(timer_queue_base& queue);
@@ -142,6 +167,16 @@ private:
   // Get the timeout value for the select call.
   ASIO_DECL timeval* get_timeout(long usec, timeval& tv);
 
+#if defined(ASIO_HAS_TIMERFD)
+  // Create a timerfd file descriptor for the given clock. Does not throw.
+  ASIO_DECL static int do_timerfd_create(int clock_id);
+
+  // Arm a timer descriptor for the earliest timer measured by its clock, if
+  // that has changed, and add the descriptor to the read set.
+  ASIO_DECL void arm_timer_fd(int fd, timer_queue_base::clock_type clock,
+      int flags, timespec& armed);
+#endif // defined(ASIO_HAS_TIMERFD)
+
   // Cancel all operations associated with the given descriptor. This function
   // does not acquire the select_reactor's mutex.
   ASIO_DECL void cancel_ops_unlocked(socket_type descriptor,
@@ -151,7 +186,10 @@ private:
   typedef class scheduler scheduler_type;
   scheduler_type& scheduler_;
 
-  // Mutex to protect access to internal data.
+  // Mutex to protect access to internal data. Each timer queue has its own
+  // lock, so that arming and cancelling timers does not contend with the
+  // reactor or with timers in other queues. The mutex only guards membership
+  // of the set of queues and the state used by select.
   asio::detail::mutex mutex_;
 
   // The interrupter is used to break a blocking select call.
@@ -166,8 +204,31 @@ private:
   // The timer queues.
   timer_queue_set timer_queues_;
 
-  // Whether the service has been shut down.
-  bool shutdown_;
+#if defined(ASIO_HAS_TIMERFD)
+  // The timer file descriptor for timers measured by the monotonic clock. It
+  // is armed at the absolute expiry time of the earliest such timer, so that
+  // the timer fires precisely.
+  int timer_fd_;
+
+  // The timer file descriptor for timers measured by the realtime clock,
+  // created when the first queue of such timers is added. It is armed at an
+  // absolute time and becomes ready when the system clock is changed, so that
+  // the timers follow changes to the wall clock.
+  int realtime_timer_fd_;
+
+  // The times to which the timer descriptors are armed.
+  timespec timer_fd_armed_;
+  timespec realtime_timer_fd_armed_;
+
+# if defined(ASIO_ENABLE_TIMER_METRICS)
+  // The number of times the timer descriptors have been armed.
+  uint64_t timerfd_settime_calls_;
+# endif // defined(ASIO_ENABLE_TIMER_METRICS)
+#endif // defined(ASIO_HAS_TIMERFD)
+
+  // Whether the service has been shut down. Timers are scheduled under their
+  // queue's lock rather than the mutex, so the flag is atomic.
+  std::atomic<bool> shutdown_;
 };
 
 } // namespace detail
@@ -0,0 +1,95 @@
+#ifndef ASIO_DETAIL_TIMER_NATIVE_CLOCK_HPP
+#define ASIO_DETAIL_TIMER_NATIVE_CLOCK_HPP
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/reactor/timeQueue/timer_queue_base.hpp"
+
+#if defined(ASIO_HAS_TIMERFD)
+# include <time.h>
+# include "asio/detail/base/stdcpp/chrono.hpp"
+# include "asio/service/timer/helper/chrono_time_traits.hpp"
+# include "asio/service/timer/helper/wait_traits.hpp"
+#endif // defined(ASIO_HAS_TIMERFD)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Identifies the clock by which a timer queue's times are measured, when a
+// timer descriptor can be armed against that clock directly.
+template <typename Time_Traits>
+struct timer_native_clock
+{
+  static const timer_queue_base::clock_type value
+    = timer_queue_base::other_clock;
+
+#if defined(ASIO_HAS_TIMERFD)
+  static timespec to_timespec(const typename Time_Traits::time_type&)
+  {
+    timespec ts = { 0, 0 };
+    return ts;
+  }
+#endif // defined(ASIO_HAS_TIMERFD)
+};
+
+#if defined(ASIO_HAS_TIMERFD)
+
+// Converts a std::chrono time point to a timespec. The time must be measured
+// from the epoch of the POSIX clock to which it corresponds.
+template <typename Time>
+timespec chrono_to_timespec(const Time& t)
+{
+  typedef typename Time::duration duration;
+  duration d = t.time_since_epoch();
+  timespec ts = { 0, 1 };
+  if (d > duration::zero())
+  {
+    // Split the time into seconds first so that the largest time points do
+    // not overflow when converted to nanoseconds.
+    chrono::seconds s = chrono::duration_cast<chrono::seconds>(d);
+    ts.tv_sec = static_cast<time_t>(s.count());
+    ts.tv_nsec = static_cast<long>(
+        chrono::duration_cast<chrono::nanoseconds>(d - s).count());
+  }
+  return ts;
+}
+
+// The standard library implementations on platforms with timerfd measure the
+// steady clock with CLOCK_MONOTONIC and the system clock with CLOCK_REALTIME.
+// Only the default wait traits are mapped, as custom traits may change the
+// durations that the timer waits for.
+template <>
+struct timer_native_clock<chrono_time_traits<chrono::steady_clock,
+    asio::wait_traits<chrono::steady_clock> > >
+{
+  static const timer_queue_base::clock_type value
+    = timer_queue_base::monotonic_clock;
+
+  static timespec to_timespec(const chrono::steady_clock::time_point& t)
+  {
+    return chrono_to_timespec(t);
+  }
+};
+
+template <>
+struct timer_native_clock<chrono_time_traits<chrono::system_clock,
+    asio::wait_traits<chrono::system_clock> > >
+{
+  static const timer_queue_base::clock_type value
+    = timer_queue_base::realtime_clock;
+
+  static timespec to_timespec(const chrono::system_clock::time_point& t)
+  {
+    return chrono_to_timespec(t);
+  }
+};
+
+#endif // defined(ASIO_HAS_TIMERFD)
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_TIMER_NATIVE_CLOCK_HPP
@@ -8,6 +8,7 @@
 #include "asio/detail/base/boost/date_time_fwd.hpp"
 #include "asio/detail/base/stdcpp/limits.hpp"
 #include "asio/detail/container/op_queue.hpp"
+#include "asio/detail/reactor/timeQueue/timer_native_clock.hpp"
 #include "asio/detail/reactor/timeQueue/timer_queue_base.hpp"
 #include "asio/detail/reactor/wait_op.hpp"
 #include "asio/error/error.hpp"
@@ -34,10 +35,17 @@ public:
   public:
     per_timer_data() :
       heap_index_((std::numeric_limits<std::size_t>::max)()),
-      next_(0), prev_(0)
+      next_(0), prev_(0), batch_next_(0)
     {
     }
 
+    // Link the timer to the next timer in a batch that is to be cancelled
+    // with a single call to cancel_timers().
+    void set_batch_next(per_timer_data* next)
+    {
+      batch_next_ = next;
+    }
+
   private:
     friend class timer_queue;
 
@@ -50,6 +58,9 @@ public:
     // Pointers to adjacent timers in a linked list.
     per_timer_data* next_;
     per_timer_data* prev_;
+
+    // The next timer in a batch to be cancelled.
+    per_timer_data* batch_next_;
   };
 
   // Constructor.
@@ -127,6 +138,25 @@ public:
         max_duration);
   }
 
+  // Get the clock by which the queue's times are measured.
+  virtual clock_type native_clock() const
+  {
+    return timer_native_clock<Time_Traits>::value;
+  }
+
+#if defined(ASIO_HAS_TIMERFD)
+  // Get the expiry time of the earliest timer as an absolute time on the
+  // queue's native clock.
+  virtual bool earliest_expiry(timespec& ts) const
+  {
+    if (heap_.empty() || native_clock() == other_clock)
+      return false;
+
+    ts = timer_native_clock<Time_Traits>::to_timespec(heap_[0].time_);
+    return true;
+  }
+#endif // defined(ASIO_HAS_TIMERFD)
+
   // Dequeue all timers not later than the current time.
   virtual void get_ready_timers(op_queue<operation>& ops)
   {
@@ -136,6 +166,13 @@ public:
       while (!heap_.empty() && !Time_Traits::less_than(now, heap_[0].time_))
       {
         per_timer_data* timer = heap_[0].timer_;
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+        int64_t lateness = Time_Traits::to_posix_duration(
+            Time_Traits::subtract(now, heap_[0].time_)).total_microseconds();
+        for (wait_op* op = timer->op_queue_.front();
+            op; op = op_queue_access::next(op))
+          this->record_fired(lateness);
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
         ops.push(timer->op_queue_);
         remove_timer(*timer);
       }
@@ -157,6 +194,14 @@ public:
     heap_.clear();
   }
 
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+  // Get the number of timers in the heap.
+  virtual std::size_t heap_size() const
+  {
+    return heap_.size();
+  }
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
   // Cancel and dequeue operations for the given timer.
   std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
@@ -175,6 +220,19 @@ public:
       if (timer.op_queue_.empty())
         remove_timer(timer);
     }
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+    this->record_cancelled(num_cancelled);
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+    return num_cancelled;
+  }
+
+  // Cancel and dequeue operations for a batch of timers linked by
+  // set_batch_next().
+  std::size_t cancel_timers(per_timer_data* batch, op_queue<operation>& ops)
+  {
+    std::size_t num_cancelled = 0;
+    for (; batch; batch = batch->batch_next_)
+      num_cancelled += cancel_timer(*batch, ops);
     return num_cancelled;
   }
 
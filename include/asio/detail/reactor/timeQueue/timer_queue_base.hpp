@@ -2,10 +2,20 @@
 #define ASIO_DETAIL_TIMER_QUEUE_BASE_HPP
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/base/mutex.hpp"
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/container/op_queue.hpp"
 #include "asio/core/operation.hpp"
 
+#if defined(ASIO_HAS_TIMERFD)
+# include <time.h>
+#endif // defined(ASIO_HAS_TIMERFD)
+
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+# include <cstddef>
+# include "asio/core/timer_metrics.hpp"
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -15,6 +25,16 @@ class timer_queue_base
   : private noncopyable
 {
 public:
+  // The clocks that a timer descriptor may be armed against directly. A queue
+  // whose times are measured by one of these clocks is able to report the
+  // absolute expiry time of its earliest timer.
+  enum clock_type
+  {
+    other_clock = 0,
+    monotonic_clock = 1,
+    realtime_clock = 2
+  };
+
   // Constructor.
   timer_queue_base() : next_(0) {}
 
@@ -30,17 +50,59 @@ public:
   // Get the time to wait until the next timer.
   virtual long wait_duration_usec(long max_duration) const = 0;
 
+  // Get the clock by which the queue's times are measured.
+  virtual clock_type native_clock() const = 0;
+
+#if defined(ASIO_HAS_TIMERFD)
+  // Get the expiry time of the earliest timer as an absolute time on the
+  // queue's native clock. Returns false if there is no such timer.
+  virtual bool earliest_expiry(timespec& ts) const = 0;
+#endif // defined(ASIO_HAS_TIMERFD)
+
   // Dequeue all ready timers.
   virtual void get_ready_timers(op_queue<operation>& ops) = 0;
 
   // Dequeue all timers.
   virtual void get_all_timers(op_queue<operation>& ops) = 0;
 
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+  // Get the number of timers in the heap.
+  virtual std::size_t heap_size() const = 0;
+
+protected:
+  // Record that an operation has fired the given number of microseconds
+  // after its timer's expiry time.
+  void record_fired(int64_t lateness_usec)
+  {
+    std::size_t bucket = 0;
+    for (; lateness_usec > 0 && bucket + 1 < timer_metrics::lateness_buckets;
+        lateness_usec >>= 1)
+      ++bucket;
+    ++metrics_.lateness[bucket];
+    ++metrics_.fired;
+  }
+
+  // Record that operations have been cancelled.
+  void record_cancelled(std::size_t n)
+  {
+    metrics_.cancelled += n;
+  }
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
 private:
   friend class timer_queue_set;
 
   // Next timer queue in the set.
   timer_queue_base* next_;
+
+  // Protects the queue when the set is locking.
+  asio::detail::mutex mutex_;
+
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+  // The counters for the queue. Only the counters are used, and they are
+  // protected in the same way as the queue itself.
+  timer_metrics metrics_;
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
 };
 
 template <typename Time_Traits>
@@ -2,6 +2,7 @@
 #define ASIO_DETAIL_TIMER_QUEUE_SET_HPP
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/noncopyable.hpp"
 #include "asio/detail/reactor/timeQueue/timer_queue_base.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -12,8 +13,39 @@ namespace detail {
 class timer_queue_set
 {
 public:
-  // Constructor.
-  ASIO_DECL timer_queue_set();
+  // Lock a queue in the set, if the set is locking.
+  class scoped_queue_lock
+    : private noncopyable
+  {
+  public:
+    scoped_queue_lock(const timer_queue_set& set, timer_queue_base& q)
+      : mutex_(set.locking_ ? &q.mutex_ : 0)
+    {
+      if (mutex_)
+        mutex_->lock();
+    }
+
+    ~scoped_queue_lock()
+    {
+      if (mutex_)
+        mutex_->unlock();
+    }
+
+    void unlock()
+    {
+      if (mutex_)
+        mutex_->unlock();
+      mutex_ = 0;
+    }
+
+  private:
+    asio::detail::mutex* mutex_;
+  };
+
+  // Constructor. If locking, each queue is protected by its own mutex, which
+  // the set acquires while examining the queue. Otherwise the caller must
+  // serialise all access to the queues.
+  ASIO_DECL explicit timer_queue_set(bool locking = false);
 
   // Add a timer queue to the set.
   ASIO_DECL void insert(timer_queue_base* q);
@@ -27,8 +59,22 @@ public:
   // Get the wait duration in milliseconds.
   ASIO_DECL long wait_duration_msec(long max_duration) const;
 
-  // Get the wait duration in microseconds.
-  ASIO_DECL long wait_duration_usec(long max_duration) const;
+  // Get the wait duration in microseconds, ignoring the queues whose native
+  // clock is one of the excluded clocks.
+  ASIO_DECL long wait_duration_usec(long max_duration,
+      int excluded_clocks = timer_queue_base::other_clock) const;
+
+#if defined(ASIO_HAS_TIMERFD)
+  // Get the earliest expiry time of the queues with the given native clock, as
+  // an absolute time on that clock. Returns false if there is no such timer.
+  ASIO_DECL bool earliest_expiry(
+      timer_queue_base::clock_type clock, timespec& ts) const;
+#endif // defined(ASIO_HAS_TIMERFD)
+
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+  // Add the sizes and counters of the queues to the metrics.
+  ASIO_DECL void collect_metrics(timer_metrics& m) const;
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
 
   // Dequeue all ready timers.
   ASIO_DECL void get_ready_timers(op_queue<operation>& ops);
@@ -38,6 +84,7 @@ public:
 
 private:
   timer_queue_base* first_;
+  bool locking_;
 };
 
 } // namespace detail
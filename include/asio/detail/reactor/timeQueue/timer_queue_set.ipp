@@ -9,8 +9,9 @@
 namespace asio {
 namespace detail {
 
-timer_queue_set::timer_queue_set()
-  : first_(0)
+timer_queue_set::timer_queue_set(bool locking)
+  : first_(0),
+    locking_(locking)
 {
 }
 
@@ -46,8 +47,11 @@ void timer_queue_set::erase(timer_queue_base* q)
 bool timer_queue_set::all_empty() const
 {
   for (timer_queue_base* p = first_; p; p = p->next_)
+  {
+    scoped_queue_lock lock(*this, *p);
     if (!p->empty())
       return false;
+  }
   return true;
 }
 
@@ -55,28 +59,85 @@ long timer_queue_set::wait_duration_msec(long max_duration) const
 {
   long min_duration = max_duration;
   for (timer_queue_base* p = first_; p; p = p->next_)
+  {
+    scoped_queue_lock lock(*this, *p);
     min_duration = p->wait_duration_msec(min_duration);
+  }
   return min_duration;
 }
 
-long timer_queue_set::wait_duration_usec(long max_duration) const
+long timer_queue_set::wait_duration_usec(
+    long max_duration, int excluded_clocks) const
 {
   long min_duration = max_duration;
   for (timer_queue_base* p = first_; p; p = p->next_)
-    min_duration = p->wait_duration_usec(min_duration);
+  {
+    if ((p->native_clock() & excluded_clocks) == 0)
+    {
+      scoped_queue_lock lock(*this, *p);
+      min_duration = p->wait_duration_usec(min_duration);
+    }
+  }
   return min_duration;
 }
 
+#if defined(ASIO_HAS_TIMERFD)
+bool timer_queue_set::earliest_expiry(
+    timer_queue_base::clock_type clock, timespec& ts) const
+{
+  bool found = false;
+  for (timer_queue_base* p = first_; p; p = p->next_)
+  {
+    if (p->native_clock() == clock)
+    {
+      scoped_queue_lock lock(*this, *p);
+      timespec expiry;
+      if (p->earliest_expiry(expiry) && (!found
+            || expiry.tv_sec < ts.tv_sec || (expiry.tv_sec == ts.tv_sec
+              && expiry.tv_nsec < ts.tv_nsec)))
+      {
+        ts = expiry;
+        found = true;
+      }
+    }
+  }
+  return found;
+}
+#endif // defined(ASIO_HAS_TIMERFD)
+
+#if defined(ASIO_ENABLE_TIMER_METRICS)
+void timer_queue_set::collect_metrics(timer_metrics& m) const
+{
+  for (timer_queue_base* p = first_; p; p = p->next_)
+  {
+    scoped_queue_lock lock(*this, *p);
+    std::size_t size = p->heap_size();
+    m.timer_count += size;
+    m.queue_sizes.push_back(size);
+    m.fired += p->metrics_.fired;
+    m.cancelled += p->metrics_.cancelled;
+    for (std::size_t i = 0; i < timer_metrics::lateness_buckets; ++i)
+      m.lateness[i] += p->metrics_.lateness[i];
+  }
+}
+#endif // defined(ASIO_ENABLE_TIMER_METRICS)
+
 void timer_queue_set::get_ready_timers(op_queue<operation>& ops)
 {
   for (timer_queue_base* p = first_; p; p = p->next_)
+  {
+    scoped_queue_lock lock(*this, *p);
     p->get_ready_timers(ops);
+  }
 }
 
 void timer_queue_set::get_all_timers(op_queue<operation>& ops)
 {
   for (timer_queue_base* p = first_; p; p = p->next_)
+  {
+    scoped_queue_lock lock(*this, *p);
     p->get_all_timers(ops);
+  }
 }
 
 } // namespace detail
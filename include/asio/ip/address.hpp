@@ -20,6 +20,7 @@
 #include "asio/ip/address_v4.hpp"
 #include "asio/ip/address_v6.hpp"
 #include "asio/ip/bad_address_cast.hpp"
+#include "asio/ip/chars_result.hpp"
 
 #if !defined(ASIO_NO_IOSTREAM)
 # include <iosfwd>
@@ -98,6 +99,14 @@ public:
   /// Get the address as a string.
   ASIO_DECL std::string to_string() const;
 
+  /// Write the address to a character buffer.
+  /**
+   * The address is written in the same form as to_string(). No terminating
+   * null character is written and no memory is allocated.
+   */
+  ASIO_DECL to_chars_result to_chars(
+      char* first, char* last) const ASIO_NOEXCEPT;
+
   /// Determine whether the address is a loopback address.
   ASIO_DECL bool is_loopback() const ASIO_NOEXCEPT;
 
@@ -205,6 +214,17 @@ ASIO_DECL address make_address(string_view str,
 #endif // defined(ASIO_HAS_STRING_VIEW)
        //  || defined(GENERATING_DOCUMENTATION)
 
+/// Parse an IPv4 address in dotted decimal form or an IPv6 address in
+/// hexadecimal notation from a character buffer.
+/**
+ * Parsing stops at the first character that is not part of the address, which
+ * need not be the end of the buffer. No memory is allocated.
+ *
+ * @relates address
+ */
+ASIO_DECL from_chars_result from_chars(const char* first,
+    const char* last, address& addr) ASIO_NOEXCEPT;
+
 #if !defined(ASIO_NO_IOSTREAM)
 
 /// Output an address as a string.
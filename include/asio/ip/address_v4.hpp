@@ -9,6 +9,7 @@
 #include "asio/detail/base/stdcpp/string_view.hpp"
 // #include "asio/detail/winsock_init.hpp"
 #include "asio/error/error_code.hpp"
+#include "asio/ip/chars_result.hpp"
 
 #if !defined(ASIO_NO_IOSTREAM)
 # include <iosfwd>
@@ -92,6 +93,14 @@ public:
   /// Get the address as a string in dotted decimal format.
   ASIO_DECL std::string to_string() const;
 
+  /// Write the address in dotted decimal format to a character buffer.
+  /**
+   * At most 15 characters are written. No terminating null character is
+   * written and no memory is allocated.
+   */
+  ASIO_DECL to_chars_result to_chars(
+      char* first, char* last) const ASIO_NOEXCEPT;
+
   /// Determine whether the address is a loopback address.
   ASIO_DECL bool is_loopback() const ASIO_NOEXCEPT;
 
@@ -229,6 +238,16 @@ ASIO_DECL address_v4 make_address_v4(string_view str,
 #endif // defined(ASIO_HAS_STRING_VIEW)
        //  || defined(GENERATING_DOCUMENTATION)
 
+/// Parse an IPv4 address in dotted decimal form from a character buffer.
+/**
+ * Parsing stops at the first character that is not part of the address, which
+ * need not be the end of the buffer. No memory is allocated.
+ *
+ * @relates address_v4
+ */
+ASIO_DECL from_chars_result from_chars(const char* first,
+    const char* last, address_v4& addr) ASIO_NOEXCEPT;
+
 #if !defined(ASIO_NO_IOSTREAM)
 
 /// Output an address as a string.
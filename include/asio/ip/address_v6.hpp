@@ -9,6 +9,7 @@
 // #include "asio/detail/winsock_init.hpp"
 #include "asio/error/error_code.hpp"
 #include "asio/ip/address_v4.hpp"
+#include "asio/ip/chars_result.hpp"
 
 #if !defined(ASIO_NO_IOSTREAM)
 # include <iosfwd>
@@ -88,6 +89,15 @@ public:
   /// Get the address as a string.
   ASIO_DECL std::string to_string() const;
 
+  /// Write the address to a character buffer.
+  /**
+   * The address is written in the same form as to_string(), including any
+   * scope id. No terminating null character is written and no memory is
+   * allocated.
+   */
+  ASIO_DECL to_chars_result to_chars(
+      char* first, char* last) const ASIO_NOEXCEPT;
+
   /// Determine whether the address is a loopback address.
   ASIO_DECL bool is_loopback() const ASIO_NOEXCEPT;
 
@@ -231,6 +241,18 @@ ASIO_DECL address_v6 make_address_v6(string_view str,
 #endif // defined(ASIO_HAS_STRING_VIEW)
        //  || defined(GENERATING_DOCUMENTATION)
 
+/// Parse an IPv6 address from a character buffer.
+/**
+ * The address may be followed by a scope id, introduced by @c %, consisting
+ * of letters, digits, @c _, @c - and @c . characters. Parsing stops at the
+ * first character that is not part of the address, which need not be the end
+ * of the buffer. No memory is allocated.
+ *
+ * @relates address_v6
+ */
+ASIO_DECL from_chars_result from_chars(const char* first,
+    const char* last, address_v6& addr) ASIO_NOEXCEPT;
+
 /// Tag type used for distinguishing overloads that deal in IPv4-mapped IPv6
 /// addresses.
 enum v4_mapped_t { v4_mapped };
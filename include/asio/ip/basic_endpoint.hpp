@@ -3,6 +3,7 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/ip/address.hpp"
+#include "asio/ip/chars_result.hpp"
 #include "asio/ip/detail/endpoint.hpp"
 
 #if !defined(ASIO_NO_IOSTREAM)
@@ -168,6 +169,17 @@ public:
     impl_.address(addr);
   }
 
+  /// Write the endpoint to a character buffer.
+  /**
+   * IPv4 endpoints are written as @c a.b.c.d:port and IPv6 endpoints as
+   * @c [address]:port. No terminating null character is written and no memory
+   * is allocated.
+   */
+  to_chars_result to_chars(char* first, char* last) const ASIO_NOEXCEPT
+  {
+    return impl_.to_chars(first, last);
+  }
+
   /// Compare two endpoints for equality.
   friend bool operator==(const basic_endpoint<InternetProtocol>& e1,
       const basic_endpoint<InternetProtocol>& e2) ASIO_NOEXCEPT
@@ -215,6 +227,28 @@ private:
   asio::ip::detail::endpoint impl_;
 };
 
+/// Parse an endpoint from a character buffer.
+/**
+ * Accepts endpoints in the form written by basic_endpoint::to_chars(), that
+ * is @c a.b.c.d:port or @c [address]:port. Parsing stops at the first
+ * character that is not part of the endpoint, which need not be the end of
+ * the buffer. No memory is allocated.
+ *
+ * @relates asio::ip::basic_endpoint
+ */
+template <typename InternetProtocol>
+inline from_chars_result from_chars(const char* first, const char* last,
+    basic_endpoint<InternetProtocol>& endpoint) ASIO_NOEXCEPT
+{
+  asio::ip::detail::endpoint tmp_ep;
+  from_chars_result result =
+    asio::ip::detail::endpoint::parse(first, last, tmp_ep);
+  if (!result.ec)
+    endpoint = basic_endpoint<InternetProtocol>(
+        tmp_ep.address(), tmp_ep.port());
+  return result;
+}
+
 #if !defined(ASIO_NO_IOSTREAM)
 
 /// Output an endpoint as a string.
@@ -33,6 +33,17 @@ namespace ip {
  * The basic_resolver class template provides the ability to resolve a query
  * to a list of endpoints.
  *
+ * Concurrent asynchronous operations for an identical query share a single
+ * resolution, and distinct queries are resolved in parallel on a small pool of
+ * background threads, limited by ASIO_RESOLVER_MAX_THREADS.
+ *
+ * Resolvers of the same protocol on an io_context may also remember the
+ * outcome of each host resolution for a short time. This cache is disabled by
+ * default and is enabled by defining ASIO_RESOLVER_CACHE_TTL and
+ * ASIO_RESOLVER_NEGATIVE_CACHE_TTL as the number of seconds for which
+ * successful and unsuccessful resolutions are remembered. Its size is limited
+ * by ASIO_RESOLVER_CACHE_MAX_ENTRIES.
+ *
  * @par Thread Safety
  * @e Distinct @e objects: Safe.@n
  * @e Shared @e objects: Unsafe.
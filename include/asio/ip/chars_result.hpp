@@ -0,0 +1,48 @@
+#ifndef ASIO_IP_CHARS_RESULT_HPP
+#define ASIO_IP_CHARS_RESULT_HPP
+
+#include "asio/detail/config.hpp"
+#include "asio/error/error_code.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+/// The result of formatting an address or endpoint into a character buffer.
+/**
+ * On success, @c ptr points one past the last character written and @c ec is
+ * clear. If the buffer is too small, @c ptr is the end of the buffer and
+ * @c ec is asio::error::no_buffer_space. No terminating null
+ * character is written.
+ */
+struct to_chars_result
+{
+  /// One past the last character written.
+  char* ptr;
+
+  /// The error, if any.
+  asio::error_code ec;
+};
+
+/// The result of parsing an address or endpoint from a character buffer.
+/**
+ * On success, @c ptr points to the first character that is not part of the
+ * parsed value and @c ec is clear. Otherwise, @c ptr is the start of the input
+ * and @c ec is asio::error::invalid_argument.
+ */
+struct from_chars_result
+{
+  /// The first character that was not parsed.
+  const char* ptr;
+
+  /// The error, if any.
+  asio::error_code ec;
+};
+
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_CHARS_RESULT_HPP
@@ -0,0 +1,61 @@
+#ifndef ASIO_IP_DETAIL_ADDRESS_CHARS_HPP
+#define ASIO_IP_DETAIL_ADDRESS_CHARS_HPP
+
+#include "asio/detail/config.hpp"
+#include "asio/ip/chars_result.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+// The maximum number of characters written by format_address_v4.
+const int max_address_v4_chars = 15;
+
+// The maximum number of characters written by format_address_v6.
+const int max_address_v6_chars = 45;
+
+// Write a 4-byte address in network byte order in dotted decimal form.
+// Returns one past the last character written.
+ASIO_DECL char* format_address_v4(
+    const unsigned char* bytes, char* out) ASIO_NOEXCEPT;
+
+// Write a 16-byte address in network byte order in the textual form described
+// in RFC 5952, with the same output as inet_ntop. Returns one past the last
+// character written.
+ASIO_DECL char* format_address_v6(
+    const unsigned char* bytes, char* out) ASIO_NOEXCEPT;
+
+// Write an unsigned integer in decimal. Returns one past the last character
+// written.
+ASIO_DECL char* format_decimal(unsigned long value, char* out) ASIO_NOEXCEPT;
+
+// Parse a dotted decimal address from the start of the range, accepting the
+// same forms as inet_pton. Returns one past the last character parsed, or 0 if
+// the range does not start with a valid address.
+ASIO_DECL const char* parse_address_v4(const char* first,
+    const char* last, unsigned char* bytes) ASIO_NOEXCEPT;
+
+// Parse an IPv6 address, without a scope id, from the start of the range,
+// accepting the same forms as inet_pton. Returns one past the last character
+// parsed, or 0 if the range does not start with a valid address.
+ASIO_DECL const char* parse_address_v6(const char* first,
+    const char* last, unsigned char* bytes) ASIO_NOEXCEPT;
+
+// Copy formatted characters into the caller's buffer, reporting
+// no_buffer_space if they do not fit.
+ASIO_DECL to_chars_result copy_chars(const char* begin,
+    const char* end, char* first, char* last) ASIO_NOEXCEPT;
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ip/detail/impl/address_chars.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_IP_DETAIL_ADDRESS_CHARS_HPP
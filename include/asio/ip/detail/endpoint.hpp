@@ -7,6 +7,7 @@
 // #include "asio/detail/winsock_init.hpp"
 #include "asio/error/error_code.hpp"
 #include "asio/ip/address.hpp"
+#include "asio/ip/chars_result.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -104,6 +105,14 @@ public:
   ASIO_DECL std::string to_string() const;
 #endif // !defined(ASIO_NO_IOSTREAM)
 
+  // Write the endpoint to a character buffer without allocating.
+  ASIO_DECL to_chars_result to_chars(
+      char* first, char* last) const ASIO_NOEXCEPT;
+
+  // Parse an endpoint of the form "a.b.c.d:port" or "[v6-address]:port".
+  ASIO_DECL static from_chars_result parse(const char* first,
+      const char* last, endpoint& e) ASIO_NOEXCEPT;
+
 private:
   // The underlying IP socket address.
   union data_union
@@ -0,0 +1,277 @@
+#ifndef ASIO_IP_DETAIL_IMPL_ADDRESS_CHARS_IPP
+#define ASIO_IP_DETAIL_IMPL_ADDRESS_CHARS_IPP
+
+#include "asio/detail/config.hpp"
+#include <cstring>
+#include "asio/error/error.hpp"
+#include "asio/ip/detail/address_chars.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+inline int hex_digit_value(char ch)
+{
+  if (ch >= '0' && ch <= '9')
+    return ch - '0';
+  if (ch >= 'a' && ch <= 'f')
+    return ch - 'a' + 10;
+  if (ch >= 'A' && ch <= 'F')
+    return ch - 'A' + 10;
+  return -1;
+}
+
+inline bool is_decimal_digit(char ch)
+{
+  return ch >= '0' && ch <= '9';
+}
+
+inline char* format_octet(unsigned int value, char* out)
+{
+  if (value >= 100)
+  {
+    *out++ = static_cast<char>('0' + value / 100);
+    value %= 100;
+    *out++ = static_cast<char>('0' + value / 10);
+  }
+  else if (value >= 10)
+    *out++ = static_cast<char>('0' + value / 10);
+  *out++ = static_cast<char>('0' + value % 10);
+  return out;
+}
+
+inline char* format_hex_word(unsigned int value, char* out)
+{
+  static const char digits[] = "0123456789abcdef";
+  int shift = 12;
+  while (shift > 0 && ((value >> shift) & 0xF) == 0)
+    shift -= 4;
+  for (; shift >= 0; shift -= 4)
+    *out++ = digits[(value >> shift) & 0xF];
+  return out;
+}
+
+char* format_address_v4(const unsigned char* bytes, char* out) ASIO_NOEXCEPT
+{
+  out = format_octet(bytes[0], out);
+  *out++ = '.';
+  out = format_octet(bytes[1], out);
+  *out++ = '.';
+  out = format_octet(bytes[2], out);
+  *out++ = '.';
+  return format_octet(bytes[3], out);
+}
+
+char* format_address_v6(const unsigned char* bytes, char* out) ASIO_NOEXCEPT
+{
+  unsigned int words[8];
+  for (int i = 0; i < 8; ++i)
+    words[i] = (static_cast<unsigned int>(bytes[2 * i]) << 8)
+      | bytes[2 * i + 1];
+
+  // Find the longest run of zero words, preferring the first of equal runs.
+  int best_base = -1, best_len = 0, cur_base = -1, cur_len = 0;
+  for (int i = 0; i <= 8; ++i)
+  {
+    if (i < 8 && words[i] == 0)
+    {
+      if (cur_base == -1)
+        cur_base = i, cur_len = 0;
+      ++cur_len;
+    }
+    else if (cur_base != -1)
+    {
+      if (cur_len > best_len)
+        best_base = cur_base, best_len = cur_len;
+      cur_base = -1;
+    }
+  }
+  if (best_len < 2)
+    best_base = -1;
+
+  for (int i = 0; i < 8; ++i)
+  {
+    if (best_base != -1 && i >= best_base && i < best_base + best_len)
+    {
+      if (i == best_base)
+        *out++ = ':';
+      continue;
+    }
+
+    if (i != 0)
+      *out++ = ':';
+
+    // Write IPv4-compatible and IPv4-mapped addresses with a dotted decimal
+    // tail, as inet_ntop does.
+    if (i == 6 && best_base == 0
+        && (best_len == 6 || (best_len == 5 && words[5] == 0xFFFF)))
+      return format_address_v4(bytes + 12, out);
+
+    out = format_hex_word(words[i], out);
+  }
+
+  if (best_base != -1 && best_base + best_len == 8)
+    *out++ = ':';
+  return out;
+}
+
+char* format_decimal(unsigned long value, char* out) ASIO_NOEXCEPT
+{
+  char tmp[24];
+  char* p = tmp;
+  do
+  {
+    *p++ = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (p != tmp)
+    *out++ = *--p;
+  return out;
+}
+
+const char* parse_address_v4(const char* first,
+    const char* last, unsigned char* bytes) ASIO_NOEXCEPT
+{
+  const char* p = first;
+  for (int octet = 0; octet < 4; ++octet)
+  {
+    if (octet > 0)
+    {
+      if (p == last || *p != '.')
+        return 0;
+      ++p;
+    }
+
+    if (p == last || !is_decimal_digit(*p))
+      return 0;
+    unsigned int value = *p++ - '0';
+
+    // Leading zeros are not permitted.
+    if (value != 0)
+      for (int n = 1; n < 3 && p != last && is_decimal_digit(*p); ++n)
+        value = value * 10 + (*p++ - '0');
+    if (value > 255 || (p != last && is_decimal_digit(*p)))
+      return 0;
+
+    bytes[octet] = static_cast<unsigned char>(value);
+  }
+  return p;
+}
+
+const char* parse_address_v6(const char* first,
+    const char* last, unsigned char* bytes) ASIO_NOEXCEPT
+{
+  unsigned char tmp[16] = { 0 };
+  int tp = 0;
+  int colonp = -1;
+  const char* p = first;
+
+  // A leading colon must be part of a "::".
+  if (p != last && *p == ':')
+    if (++p == last || *p != ':')
+      return 0;
+
+  const char* curtok = p;
+  bool saw_xdigit = false;
+  unsigned int value = 0;
+  int digits = 0;
+  while (p != last)
+  {
+    int d = hex_digit_value(*p);
+    if (d >= 0)
+    {
+      if (++digits > 4)
+        return 0;
+      value = (value << 4) | static_cast<unsigned int>(d);
+      saw_xdigit = true;
+      ++p;
+    }
+    else if (*p == ':')
+    {
+      curtok = ++p;
+      if (!saw_xdigit)
+      {
+        if (colonp != -1)
+          return 0;
+        colonp = tp;
+        continue;
+      }
+
+      // A single colon must be followed by another group.
+      if (p == last || (hex_digit_value(*p) < 0 && *p != ':'))
+        return 0;
+      if (tp + 2 > 16)
+        return 0;
+      tmp[tp++] = static_cast<unsigned char>(value >> 8);
+      tmp[tp++] = static_cast<unsigned char>(value & 0xFF);
+      saw_xdigit = false;
+      value = 0;
+      digits = 0;
+    }
+    else if (*p == '.' && tp + 4 <= 16)
+    {
+      // The final 32 bits may be written in dotted decimal form.
+      p = parse_address_v4(curtok, last, tmp + tp);
+      if (p == 0)
+        return 0;
+      tp += 4;
+      saw_xdigit = false;
+      break;
+    }
+    else
+      break;
+  }
+
+  if (saw_xdigit)
+  {
+    if (tp + 2 > 16)
+      return 0;
+    tmp[tp++] = static_cast<unsigned char>(value >> 8);
+    tmp[tp++] = static_cast<unsigned char>(value & 0xFF);
+  }
+
+  if (colonp != -1)
+  {
+    // The "::" must stand for at least one group of zeros.
+    if (tp == 16)
+      return 0;
+    using namespace std; // For memmove and memset.
+    int n = tp - colonp;
+    memmove(tmp + 16 - n, tmp + colonp, n);
+    memset(tmp + colonp, 0, 16 - n - colonp);
+    tp = 16;
+  }
+
+  if (tp != 16)
+    return 0;
+
+  using namespace std; // For memcpy.
+  memcpy(bytes, tmp, 16);
+  return p;
+}
+
+to_chars_result copy_chars(const char* begin,
+    const char* end, char* first, char* last) ASIO_NOEXCEPT
+{
+  to_chars_result result = { last, asio::error_code() };
+  if (end - begin > last - first)
+  {
+    result.ec = asio::error::no_buffer_space;
+    return result;
+  }
+
+  using namespace std; // For memcpy.
+  memcpy(first, begin, end - begin);
+  result.ptr = first + (end - begin);
+  return result;
+}
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_DETAIL_IMPL_ADDRESS_CHARS_IPP
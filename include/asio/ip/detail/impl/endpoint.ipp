@@ -3,12 +3,10 @@
 
 #include "asio/detail/config.hpp"
 #include <cstring>
-#if !defined(ASIO_NO_IOSTREAM)
-# include <sstream>
-#endif // !defined(ASIO_NO_IOSTREAM)
 #include "asio/network/socket_ops.hpp"
 #include "asio/error/throw_error.hpp"
 #include "asio/error/error.hpp"
+#include "asio/ip/detail/address_chars.hpp"
 #include "asio/ip/detail/endpoint.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -164,17 +162,96 @@ bool operator<(const endpoint& e1, const endpoint& e2) ASIO_NOEXCEPT
 #if !defined(ASIO_NO_IOSTREAM)
 std::string endpoint::to_string() const
 {
-  std::ostringstream tmp_os;
-  tmp_os.imbue(std::locale::classic());
+  char str[asio::detail::max_addr_v6_str_len + 8];
+  to_chars_result result = to_chars(str, str + sizeof(str));
+  if (result.ec)
+    asio::detail::throw_error(result.ec);
+  return std::string(str, result.ptr);
+}
+#endif // !defined(ASIO_NO_IOSTREAM)
+
+to_chars_result endpoint::to_chars(
+    char* first, char* last) const ASIO_NOEXCEPT
+{
+  // Room for the brackets, the colon and a five digit port.
+  char str[asio::detail::max_addr_v6_str_len + 8];
+  char* p = str;
+  to_chars_result result;
   if (is_v4())
-    tmp_os << address();
+  {
+    result = address().to_chars(p, str + sizeof(str));
+  }
   else
-    tmp_os << '[' << address() << ']';
-  tmp_os << ':' << port();
+  {
+    *p++ = '[';
+    result = address().to_chars(p, str + sizeof(str) - 1);
+    if (!result.ec)
+      *result.ptr++ = ']';
+  }
+  if (result.ec)
+  {
+    result.ptr = first;
+    return result;
+  }
 
-  return tmp_os.str();
+  p = result.ptr;
+  *p++ = ':';
+  p = asio::ip::detail::format_decimal(port(), p);
+  return asio::ip::detail::copy_chars(str, p, first, last);
+}
+
+from_chars_result endpoint::parse(const char* first,
+    const char* last, endpoint& e) ASIO_NOEXCEPT
+{
+  from_chars_result result = { first, asio::error_code() };
+  from_chars_result addr_result;
+  asio::ip::address addr;
+  if (first != last && *first == '[')
+  {
+    asio::ip::address_v6 ipv6_address;
+    addr_result = asio::ip::from_chars(first + 1, last, ipv6_address);
+    if (addr_result.ec || addr_result.ptr == last || *addr_result.ptr != ']')
+    {
+      result.ec = asio::error::invalid_argument;
+      return result;
+    }
+    ++addr_result.ptr;
+    addr = ipv6_address;
+  }
+  else
+  {
+    asio::ip::address_v4 ipv4_address;
+    addr_result = asio::ip::from_chars(first, last, ipv4_address);
+    if (addr_result.ec)
+    {
+      result.ec = asio::error::invalid_argument;
+      return result;
+    }
+    addr = ipv4_address;
+  }
+
+  const char* p = addr_result.ptr;
+  if (p == last || *p != ':' || ++p == last || *p < '0' || *p > '9')
+  {
+    result.ec = asio::error::invalid_argument;
+    return result;
+  }
+
+  unsigned long port_num = 0;
+  for (; p != last && *p >= '0' && *p <= '9'; ++p)
+  {
+    port_num = port_num * 10 + (*p - '0');
+    if (port_num > 0xFFFF)
+    {
+      result.ec = asio::error::invalid_argument;
+      return result;
+    }
+  }
+
+  e = endpoint(addr, static_cast<unsigned short>(port_num));
+  result.ptr = p;
+  return result;
 }
-#endif // !defined(ASIO_NO_IOSTREAM)
 
 } // namespace detail
 } // namespace ip
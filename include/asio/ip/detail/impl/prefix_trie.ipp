@@ -0,0 +1,191 @@
+#ifndef ASIO_IP_DETAIL_IMPL_PREFIX_TRIE_IPP
+#define ASIO_IP_DETAIL_IMPL_PREFIX_TRIE_IPP
+
+#include "asio/detail/config.hpp"
+#include "asio/ip/detail/prefix_trie.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+inline unsigned int count_leading_zeros(uint64_t x)
+{
+#if defined(__GNUC__)
+  return x == 0 ? 64 : static_cast<unsigned int>(__builtin_clzll(x));
+#else // defined(__GNUC__)
+  unsigned int n = 0;
+  for (unsigned int shift = 32; shift > 0; shift >>= 1)
+  {
+    if ((x >> (64 - shift)) == 0)
+    {
+      n += shift;
+      x <<= shift;
+    }
+  }
+  return x == 0 ? 64 : n;
+#endif // defined(__GNUC__)
+}
+
+// The number of leading bits that two keys have in common.
+inline unsigned int common_prefix_length(
+    const prefix_trie::key_type& a, const prefix_trie::key_type& b)
+{
+  if (uint64_t x = a.hi ^ b.hi)
+    return count_leading_zeros(x);
+  return 64 + count_leading_zeros(a.lo ^ b.lo);
+}
+
+// The bit of the key at the given position, counting from the most
+// significant bit.
+inline std::size_t key_bit(const prefix_trie::key_type& key, unsigned int pos)
+{
+  if (pos < 64)
+    return static_cast<std::size_t>((key.hi >> (63 - pos)) & 1);
+  return static_cast<std::size_t>((key.lo >> (127 - pos)) & 1);
+}
+
+// Clear all bits of the key beyond the prefix length.
+inline prefix_trie::key_type mask_key(
+    const prefix_trie::key_type& key, unsigned int prefix_length)
+{
+  prefix_trie::key_type masked = key;
+  if (prefix_length < 64)
+  {
+    masked.hi = prefix_length == 0
+      ? 0 : masked.hi & (~uint64_t(0) << (64 - prefix_length));
+    masked.lo = 0;
+  }
+  else if (prefix_length < 128)
+  {
+    masked.lo = prefix_length == 64
+      ? 0 : masked.lo & (~uint64_t(0) << (128 - prefix_length));
+  }
+  return masked;
+}
+
+prefix_trie::key_type prefix_trie::make_key(
+    const unsigned char* bytes, std::size_t size) ASIO_NOEXCEPT
+{
+  key_type key = { 0, 0 };
+  for (std::size_t i = 0; i < 16; ++i)
+  {
+    uint64_t byte = i < size ? bytes[i] : 0;
+    if (i < 8)
+      key.hi |= byte << (56 - 8 * i);
+    else
+      key.lo |= byte << (120 - 8 * i);
+  }
+  return key;
+}
+
+std::size_t prefix_trie::insert(const key_type& key,
+    unsigned int prefix_length, std::size_t value)
+{
+  key_type masked = mask_key(key, prefix_length);
+
+  std::size_t parent = npos;
+  std::size_t parent_bit = 0;
+  std::size_t current = root_;
+  for (;;)
+  {
+    if (current == npos)
+    {
+      // Attach a new leaf where the search fell off the trie.
+      std::size_t leaf = new_node(masked, prefix_length, value);
+      if (parent == npos)
+        root_ = leaf;
+      else
+        nodes_[parent].child[parent_bit] = leaf;
+      return value;
+    }
+
+    const node& n = nodes_[current];
+    unsigned int common = common_prefix_length(masked, n.key);
+    if (common > prefix_length)
+      common = prefix_length;
+    if (common > n.prefix_length)
+      common = n.prefix_length;
+
+    if (common == n.prefix_length && common == prefix_length)
+    {
+      // The prefix already has a node, which may be a branch with no value.
+      if (n.value == npos)
+        nodes_[current].value = value;
+      return nodes_[current].value;
+    }
+
+    if (common == n.prefix_length)
+    {
+      // The new prefix is below this node.
+      parent = current;
+      parent_bit = key_bit(masked, n.prefix_length);
+      current = n.child[parent_bit];
+      continue;
+    }
+
+    // The new prefix diverges from this node, or is a prefix of it, so a node
+    // must be inserted above it.
+    std::size_t split;
+    if (common == prefix_length)
+    {
+      std::size_t n_bit = key_bit(n.key, common);
+      split = new_node(masked, prefix_length, value);
+      nodes_[split].child[n_bit] = current;
+    }
+    else
+    {
+      std::size_t n_bit = key_bit(n.key, common);
+      std::size_t leaf = new_node(masked, prefix_length, value);
+      split = new_node(mask_key(masked, common), common, npos);
+      nodes_[split].child[n_bit] = current;
+      nodes_[split].child[n_bit ^ 1] = leaf;
+    }
+
+    if (parent == npos)
+      root_ = split;
+    else
+      nodes_[parent].child[parent_bit] = split;
+    return value;
+  }
+}
+
+std::size_t prefix_trie::find(const key_type& key) const ASIO_NOEXCEPT
+{
+  std::size_t best = npos;
+  std::size_t current = root_;
+  while (current != npos)
+  {
+    const node& n = nodes_[current];
+    if (common_prefix_length(key, n.key) < n.prefix_length)
+      break;
+    if (n.value != npos)
+      best = n.value;
+    if (n.prefix_length >= 128)
+      break;
+    current = n.child[key_bit(key, n.prefix_length)];
+  }
+  return best;
+}
+
+std::size_t prefix_trie::new_node(const key_type& key,
+    unsigned int prefix_length, std::size_t value)
+{
+  node n;
+  n.key = key;
+  n.prefix_length = prefix_length;
+  n.value = value;
+  n.child[0] = npos;
+  n.child[1] = npos;
+  nodes_.push_back(n);
+  return nodes_.size() - 1;
+}
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_DETAIL_IMPL_PREFIX_TRIE_IPP
@@ -0,0 +1,85 @@
+#ifndef ASIO_IP_DETAIL_PREFIX_TRIE_HPP
+#define ASIO_IP_DETAIL_PREFIX_TRIE_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <vector>
+#include "asio/detail/base/stdcpp/cstdint.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+namespace detail {
+
+// A path-compressed binary trie mapping address prefixes of up to 128 bits to
+// value indexes. Nodes are held in a single vector and linked by index, so
+// that a lookup touches one contiguous block of memory and the whole trie can
+// be copied cheaply.
+class prefix_trie
+{
+public:
+  // The value returned when there is no value.
+  static const std::size_t npos = static_cast<std::size_t>(-1);
+
+  // An address in network byte order, with the most significant bit first.
+  struct key_type
+  {
+    uint64_t hi;
+    uint64_t lo;
+  };
+
+  // Make a key from the bytes of an address. Bytes beyond the end of the
+  // address are taken to be zero.
+  ASIO_DECL static key_type make_key(
+      const unsigned char* bytes, std::size_t size) ASIO_NOEXCEPT;
+
+  // Constructor.
+  prefix_trie()
+    : root_(npos)
+  {
+  }
+
+  // Associate the value index with the prefix unless the prefix already has
+  // one. Returns the index that is associated with the prefix.
+  ASIO_DECL std::size_t insert(const key_type& key,
+      unsigned int prefix_length, std::size_t value);
+
+  // Find the value index of the longest prefix that matches the key, or npos.
+  ASIO_DECL std::size_t find(const key_type& key) const ASIO_NOEXCEPT;
+
+  // Remove all prefixes.
+  void clear() ASIO_NOEXCEPT
+  {
+    nodes_.clear();
+    root_ = npos;
+  }
+
+private:
+  struct node
+  {
+    key_type key;
+    unsigned int prefix_length;
+    std::size_t value;
+    std::size_t child[2];
+  };
+
+  // Create a node and return its index.
+  ASIO_DECL std::size_t new_node(const key_type& key,
+      unsigned int prefix_length, std::size_t value);
+
+  std::vector<node> nodes_;
+  std::size_t root_;
+};
+
+} // namespace detail
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/ip/detail/impl/prefix_trie.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_IP_DETAIL_PREFIX_TRIE_HPP
@@ -2,6 +2,7 @@
 #define ASIO_IP_IMPL_ADDRESS_IPP
 
 #include "asio/detail/config.hpp"
+#include <cstring>
 #include <typeinfo>
 #include "asio/error/throw_error.hpp"
 #include "asio/error/throw_exception.hpp"
@@ -98,20 +99,27 @@ address make_address(const char* str)
   return addr;
 }
 
-address make_address(const char* str,
-    asio::error_code& ec) ASIO_NOEXCEPT
+namespace detail {
+
+// Parse an address that must occupy the whole of the given range.
+inline address make_address(const char* first,
+    const char* last, asio::error_code& ec) ASIO_NOEXCEPT
 {
-  asio::ip::address_v6 ipv6_address =
-    asio::ip::make_address_v6(str, ec);
-  if (!ec)
-    return address(ipv6_address);
+  address addr;
+  from_chars_result result = from_chars(first, last, addr);
+  if (!result.ec && result.ptr != last)
+    result.ec = asio::error::invalid_argument;
+  ec = result.ec;
+  return result.ec ? address() : addr;
+}
 
-  asio::ip::address_v4 ipv4_address =
-    asio::ip::make_address_v4(str, ec);
-  if (!ec)
-    return address(ipv4_address);
+} // namespace detail
 
-  return address();
+address make_address(const char* str,
+    asio::error_code& ec) ASIO_NOEXCEPT
+{
+  using namespace std; // For strlen.
+  return asio::ip::detail::make_address(str, str + strlen(str), ec);
 }
 
 address make_address(const std::string& str)
@@ -122,24 +130,49 @@ address make_address(const std::string& str)
 address make_address(const std::string& str,
     asio::error_code& ec) ASIO_NOEXCEPT
 {
-  return make_address(str.c_str(), ec);
+  return asio::ip::detail::make_address(
+      str.data(), str.data() + str.size(), ec);
 }
 
 #if defined(ASIO_HAS_STRING_VIEW)
 
 address make_address(string_view str)
 {
-  return make_address(static_cast<std::string>(str));
+  asio::error_code ec;
+  address addr = make_address(str, ec);
+  asio::detail::throw_error(ec);
+  return addr;
 }
 
 address make_address(string_view str,
     asio::error_code& ec) ASIO_NOEXCEPT
 {
-  return make_address(static_cast<std::string>(str), ec);
+  return asio::ip::detail::make_address(
+      str.data(), str.data() + str.size(), ec);
 }
 
 #endif // defined(ASIO_HAS_STRING_VIEW)
 
+from_chars_result from_chars(const char* first,
+    const char* last, address& addr) ASIO_NOEXCEPT
+{
+  // A dotted decimal address can never be the start of an IPv6 address, so
+  // the cheaper IPv4 parse is tried first.
+  address_v4 ipv4_address;
+  from_chars_result result = from_chars(first, last, ipv4_address);
+  if (!result.ec)
+  {
+    addr = address(ipv4_address);
+    return result;
+  }
+
+  address_v6 ipv6_address;
+  result = from_chars(first, last, ipv6_address);
+  if (!result.ec)
+    addr = address(ipv6_address);
+  return result;
+}
+
 asio::ip::address_v4 address::to_v4() const
 {
   if (type_ != ipv4)
@@ -167,6 +200,14 @@ std::string address::to_string() const
   return ipv4_address_.to_string();
 }
 
+to_chars_result address::to_chars(
+    char* first, char* last) const ASIO_NOEXCEPT
+{
+  if (type_ == ipv6)
+    return ipv6_address_.to_chars(first, last);
+  return ipv4_address_.to_chars(first, last);
+}
+
 bool address::is_loopback() const ASIO_NOEXCEPT
 {
   return (type_ == ipv4)
@@ -3,6 +3,7 @@
 
 #include "asio/detail/config.hpp"
 #include <climits>
+#include <cstring>
 #include <limits>
 #include <stdexcept>
 #include "asio/error/error.hpp"
@@ -10,6 +11,7 @@
 #include "asio/error/throw_error.hpp"
 #include "asio/error/throw_exception.hpp"
 #include "asio/ip/address_v4.hpp"
+#include "asio/ip/detail/address_chars.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -62,15 +64,18 @@ address_v4::uint_type address_v4::to_uint() const ASIO_NOEXCEPT
 
 std::string address_v4::to_string() const
 {
-  asio::error_code ec;
-  char addr_str[asio::detail::max_addr_v4_str_len];
-  const char* addr =
-    asio::detail::socket_ops::inet_ntop(
-        ASIO_OS_DEF(AF_INET), &addr_, addr_str,
-        asio::detail::max_addr_v4_str_len, 0, ec);
-  if (addr == 0)
-    asio::detail::throw_error(ec);
-  return addr;
+  char addr_str[asio::ip::detail::max_address_v4_chars];
+  return std::string(addr_str, asio::ip::detail::format_address_v4(
+        reinterpret_cast<const unsigned char*>(&addr_.s_addr), addr_str));
+}
+
+to_chars_result address_v4::to_chars(
+    char* first, char* last) const ASIO_NOEXCEPT
+{
+  char addr_str[asio::ip::detail::max_address_v4_chars];
+  char* addr_end = asio::ip::detail::format_address_v4(
+      reinterpret_cast<const unsigned char*>(&addr_.s_addr), addr_str);
+  return asio::ip::detail::copy_chars(addr_str, addr_end, first, last);
 }
 
 bool address_v4::is_loopback() const ASIO_NOEXCEPT
@@ -96,14 +101,27 @@ address_v4 make_address_v4(const char* str)
   return addr;
 }
 
+namespace detail {
+
+// Parse an address that must occupy the whole of the given range.
+inline address_v4 make_address_v4(const char* first,
+    const char* last, asio::error_code& ec) ASIO_NOEXCEPT
+{
+  address_v4 addr;
+  from_chars_result result = from_chars(first, last, addr);
+  if (!result.ec && result.ptr != last)
+    result.ec = asio::error::invalid_argument;
+  ec = result.ec;
+  return result.ec ? address_v4() : addr;
+}
+
+} // namespace detail
+
 address_v4 make_address_v4(const char* str,
     asio::error_code& ec) ASIO_NOEXCEPT
 {
-  address_v4::bytes_type bytes;
-  if (asio::detail::socket_ops::inet_pton(
-        ASIO_OS_DEF(AF_INET), str, &bytes, 0, ec) <= 0)
-    return address_v4();
-  return address_v4(bytes);
+  using namespace std; // For strlen.
+  return asio::ip::detail::make_address_v4(str, str + strlen(str), ec);
 }
 
 address_v4 make_address_v4(const std::string& str)
@@ -114,24 +132,47 @@ address_v4 make_address_v4(const std::string& str)
 address_v4 make_address_v4(const std::string& str,
     asio::error_code& ec) ASIO_NOEXCEPT
 {
-  return make_address_v4(str.c_str(), ec);
+  return asio::ip::detail::make_address_v4(
+      str.data(), str.data() + str.size(), ec);
 }
 
 #if defined(ASIO_HAS_STRING_VIEW)
 
 address_v4 make_address_v4(string_view str)
 {
-  return make_address_v4(static_cast<std::string>(str));
+  asio::error_code ec;
+  address_v4 addr = make_address_v4(str, ec);
+  asio::detail::throw_error(ec);
+  return addr;
 }
 
 address_v4 make_address_v4(string_view str,
     asio::error_code& ec) ASIO_NOEXCEPT
 {
-  return make_address_v4(static_cast<std::string>(str), ec);
+  return asio::ip::detail::make_address_v4(
+      str.data(), str.data() + str.size(), ec);
 }
 
 #endif // defined(ASIO_HAS_STRING_VIEW)
 
+from_chars_result from_chars(const char* first,
+    const char* last, address_v4& addr) ASIO_NOEXCEPT
+{
+  from_chars_result result = { first, asio::error_code() };
+  address_v4::bytes_type bytes;
+  const char* end = asio::ip::detail::parse_address_v4(
+      first, last, bytes.data());
+  if (end == 0)
+  {
+    result.ec = asio::error::invalid_argument;
+    return result;
+  }
+
+  addr = address_v4(bytes);
+  result.ptr = end;
+  return result;
+}
+
 } // namespace ip
 } // namespace asio
 
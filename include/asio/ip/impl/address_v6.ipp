@@ -11,6 +11,7 @@
 #include "asio/error/error.hpp"
 #include "asio/ip/address_v6.hpp"
 #include "asio/ip/bad_address_cast.hpp"
+#include "asio/ip/detail/address_chars.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -86,6 +87,13 @@ address_v6::bytes_type address_v6::to_bytes() const ASIO_NOEXCEPT
 
 std::string address_v6::to_string() const
 {
+  if (scope_id_ == 0)
+  {
+    char addr_str[asio::ip::detail::max_address_v6_chars];
+    return std::string(addr_str, asio::ip::detail::format_address_v6(
+          addr_.s6_addr, addr_str));
+  }
+
   asio::error_code ec;
   char addr_str[asio::detail::max_addr_v6_str_len];
   const char* addr =
@@ -97,6 +105,34 @@ std::string address_v6::to_string() const
   return addr;
 }
 
+to_chars_result address_v6::to_chars(
+    char* first, char* last) const ASIO_NOEXCEPT
+{
+  if (scope_id_ == 0)
+  {
+    char addr_str[asio::ip::detail::max_address_v6_chars];
+    char* addr_end = asio::ip::detail::format_address_v6(
+        addr_.s6_addr, addr_str);
+    return asio::ip::detail::copy_chars(addr_str, addr_end, first, last);
+  }
+
+  // Scope ids may need an interface name lookup, so leave them to inet_ntop.
+  asio::error_code ec;
+  char addr_str[asio::detail::max_addr_v6_str_len];
+  const char* addr =
+    asio::detail::socket_ops::inet_ntop(
+        ASIO_OS_DEF(AF_INET6), &addr_, addr_str,
+        asio::detail::max_addr_v6_str_len, scope_id_, ec);
+  if (addr == 0)
+  {
+    to_chars_result result = { first, ec };
+    return result;
+  }
+
+  using namespace std; // For strlen.
+  return asio::ip::detail::copy_chars(addr, addr + strlen(addr), first, last);
+}
+
 bool address_v6::is_loopback() const ASIO_NOEXCEPT
 {
   return ((addr_.s6_addr[0] == 0) && (addr_.s6_addr[1] == 0)
@@ -206,15 +242,33 @@ address_v6 make_address_v6(const char* str)
   return addr;
 }
 
+namespace detail {
+
+// Parse an address that must occupy the whole of the given range.
+inline address_v6 make_address_v6(const char* first,
+    const char* last, asio::error_code& ec) ASIO_NOEXCEPT
+{
+  address_v6 addr;
+  from_chars_result result = from_chars(first, last, addr);
+  if (!result.ec && result.ptr != last)
+    result.ec = asio::error::invalid_argument;
+  ec = result.ec;
+  return result.ec ? address_v6() : addr;
+}
+
+inline bool is_scope_id_char(char ch)
+{
+  return (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z')
+    || (ch >= 'A' && ch <= 'Z') || ch == '_' || ch == '-' || ch == '.';
+}
+
+} // namespace detail
+
 address_v6 make_address_v6(const char* str,
     asio::error_code& ec) ASIO_NOEXCEPT
 {
-  address_v6::bytes_type bytes;
-  unsigned long scope_id = 0;
-  if (asio::detail::socket_ops::inet_pton(
-        ASIO_OS_DEF(AF_INET6), str, &bytes[0], &scope_id, ec) <= 0)
-    return address_v6();
-  return address_v6(bytes, scope_id);
+  using namespace std; // For strlen.
+  return asio::ip::detail::make_address_v6(str, str + strlen(str), ec);
 }
 
 address_v6 make_address_v6(const std::string& str)
@@ -225,24 +279,76 @@ address_v6 make_address_v6(const std::string& str)
 address_v6 make_address_v6(const std::string& str,
     asio::error_code& ec) ASIO_NOEXCEPT
 {
-  return make_address_v6(str.c_str(), ec);
+  return asio::ip::detail::make_address_v6(
+      str.data(), str.data() + str.size(), ec);
 }
 
 #if defined(ASIO_HAS_STRING_VIEW)
 
 address_v6 make_address_v6(string_view str)
 {
-  return make_address_v6(static_cast<std::string>(str));
+  asio::error_code ec;
+  address_v6 addr = make_address_v6(str, ec);
+  asio::detail::throw_error(ec);
+  return addr;
 }
 
 address_v6 make_address_v6(string_view str,
     asio::error_code& ec) ASIO_NOEXCEPT
 {
-  return make_address_v6(static_cast<std::string>(str), ec);
+  return asio::ip::detail::make_address_v6(
+      str.data(), str.data() + str.size(), ec);
 }
 
 #endif // defined(ASIO_HAS_STRING_VIEW)
 
+from_chars_result from_chars(const char* first,
+    const char* last, address_v6& addr) ASIO_NOEXCEPT
+{
+  from_chars_result result = { first, asio::error_code() };
+  address_v6::bytes_type bytes;
+  const char* end = asio::ip::detail::parse_address_v6(
+      first, last, bytes.data());
+  if (end == 0)
+  {
+    result.ec = asio::error::invalid_argument;
+    return result;
+  }
+
+  unsigned long scope_id = 0;
+  if (end != last && *end == '%')
+  {
+    const char* scope_end = end + 1;
+    while (scope_end != last && asio::ip::detail::is_scope_id_char(*scope_end))
+      ++scope_end;
+
+    // Interface names are resolved by inet_pton, which needs a null terminated
+    // copy of the whole address.
+    char addr_str[asio::detail::max_addr_v6_str_len];
+    if (scope_end - first >= asio::detail::max_addr_v6_str_len)
+    {
+      result.ec = asio::error::invalid_argument;
+      return result;
+    }
+
+    using namespace std; // For memcpy.
+    memcpy(addr_str, first, scope_end - first);
+    addr_str[scope_end - first] = 0;
+    asio::error_code ec;
+    if (asio::detail::socket_ops::inet_pton(ASIO_OS_DEF(AF_INET6),
+          addr_str, bytes.data(), &scope_id, ec) <= 0)
+    {
+      result.ec = asio::error::invalid_argument;
+      return result;
+    }
+    end = scope_end;
+  }
+
+  addr = address_v6(bytes, scope_id);
+  result.ptr = end;
+  return result;
+}
+
 address_v4 make_address_v4(
     v4_mapped_t, const address_v6& v6_addr)
 {
@@ -0,0 +1,220 @@
+#ifndef ASIO_IP_NETWORK_MAP_HPP
+#define ASIO_IP_NETWORK_MAP_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <vector>
+#include "asio/detail/memory/memory.hpp"
+#include "asio/ip/address.hpp"
+#include "asio/ip/detail/prefix_trie.hpp"
+#include "asio/ip/network_v4.hpp"
+#include "asio/ip/network_v6.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+/// Maps IPv4 and IPv6 networks to values, with longest prefix matching.
+/**
+ * The asio::ip::network_map class template associates values with
+ * networks and finds the value of the most specific network that contains a
+ * given address. It is intended for applying allow and deny lists, or per
+ * subnet policies, to incoming connections.
+ *
+ * The networks are held in a path-compressed binary trie, so a lookup
+ * examines at most one node per bit of the longest matching prefix,
+ * regardless of the number of networks in the map.
+ *
+ * A lookup of an IPv4-mapped IPv6 address, as reported by a dual-stack
+ * socket, first searches the IPv4 networks using the embedded IPv4 address,
+ * and only then the IPv6 networks.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe for concurrent lookups. Unsafe if the map is
+ * modified. Use snapshot() to share an immutable copy of the map between
+ * threads while the original continues to be modified.
+ *
+ * @par Example
+ * @code asio::ip::network_map<bool> allowed;
+ * allowed.insert(asio::ip::make_network_v4("10.0.0.0/8"), true);
+ * allowed.insert(asio::ip::make_network_v4("10.1.0.0/16"), false);
+ * asio::ip::network_map<bool>::snapshot_type rules = allowed.snapshot();
+ * ...
+ * const bool* allow = rules->find(peer.address());
+ * if (!allow || !*allow)
+ *   socket.close(); @endcode
+ */
+template <typename T>
+class network_map
+{
+public:
+  /// The type of the values associated with the networks.
+  typedef T mapped_type;
+
+  /// The type of an immutable snapshot of the map.
+  typedef asio::detail::shared_ptr<const network_map> snapshot_type;
+
+  /// Construct an empty map.
+  network_map()
+  {
+  }
+
+  /// Construct a map from a sequence of network and value pairs.
+  /**
+   * The iterator's value type must be a pair, such as @c std::pair, whose
+   * @c first member is a network_v4 or network_v6 and whose @c second member
+   * is convertible to @c T. If a network appears more than once, the last
+   * value wins.
+   */
+  template <typename Iterator>
+  network_map(Iterator first, Iterator last)
+  {
+    for (; first != last; ++first)
+      insert(first->first, first->second);
+  }
+
+  /// Associate a value with an IPv4 network.
+  /**
+   * Any host bits in the network's address are ignored. If the network is
+   * already present in the map, its value is replaced.
+   */
+  void insert(const network_v4& net, const T& value)
+  {
+    address_v4::bytes_type bytes = net.address().to_bytes();
+    insert(v4_, asio::ip::detail::prefix_trie::make_key(&bytes[0], 4),
+        net.prefix_length(), value);
+  }
+
+  /// Associate a value with an IPv6 network.
+  /**
+   * Any host bits in the network's address are ignored. If the network is
+   * already present in the map, its value is replaced.
+   */
+  void insert(const network_v6& net, const T& value)
+  {
+    address_v6::bytes_type bytes = net.address().to_bytes();
+    insert(v6_, asio::ip::detail::prefix_trie::make_key(&bytes[0], 16),
+        net.prefix_length(), value);
+  }
+
+  /// Find the value of the longest network that contains an IPv4 address.
+  /**
+   * @returns A pointer to the value, or a null pointer if no network in the
+   * map contains the address.
+   */
+  const T* find(const address_v4& addr) const ASIO_NOEXCEPT
+  {
+    address_v4::bytes_type bytes = addr.to_bytes();
+    return value_at(v4_.find(
+          asio::ip::detail::prefix_trie::make_key(&bytes[0], 4)));
+  }
+
+  /// Find the value of the longest network that contains an IPv6 address.
+  /**
+   * @returns A pointer to the value, or a null pointer if no network in the
+   * map contains the address.
+   */
+  const T* find(const address_v6& addr) const ASIO_NOEXCEPT
+  {
+    address_v6::bytes_type bytes = addr.to_bytes();
+    if (addr.is_v4_mapped())
+    {
+      std::size_t index = v4_.find(
+          asio::ip::detail::prefix_trie::make_key(&bytes[12], 4));
+      if (index != asio::ip::detail::prefix_trie::npos)
+        return &values_[index].value_;
+    }
+    return value_at(v6_.find(
+          asio::ip::detail::prefix_trie::make_key(&bytes[0], 16)));
+  }
+
+  /// Find the value of the longest network that contains an address.
+  /**
+   * @returns A pointer to the value, or a null pointer if no network in the
+   * map contains the address.
+   */
+  const T* find(const address& addr) const ASIO_NOEXCEPT
+  {
+    if (addr.is_v6())
+      return find(addr.to_v6());
+    return find(addr.to_v4());
+  }
+
+  /// Create an immutable copy of the map that may be shared between threads.
+  /**
+   * Lookups on the snapshot need no locking, and the snapshot is unaffected
+   * by later changes to this map. A typical use is to rebuild the rules on
+   * one thread and publish each new snapshot to the threads that accept
+   * connections.
+   */
+  snapshot_type snapshot() const
+  {
+    return snapshot_type(new network_map(*this));
+  }
+
+  /// Get the number of networks in the map.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return values_.size();
+  }
+
+  /// Determine whether the map is empty.
+  bool empty() const ASIO_NOEXCEPT
+  {
+    return values_.empty();
+  }
+
+  /// Remove all networks from the map.
+  void clear() ASIO_NOEXCEPT
+  {
+    v4_.clear();
+    v6_.clear();
+    values_.clear();
+  }
+
+private:
+  // Add a prefix to one of the tries, replacing any existing value.
+  void insert(asio::ip::detail::prefix_trie& trie,
+      const asio::ip::detail::prefix_trie::key_type& key,
+      unsigned int prefix_length, const T& value)
+  {
+    // Copy the value and grow the storage before changing the trie, so that a
+    // failure leaves the map unchanged. The capacity is doubled, so that a
+    // sequence of insertions takes amortised constant time.
+    entry e = { value };
+    if (values_.size() == values_.capacity())
+      values_.reserve(values_.size() * 2 + 1);
+
+    std::size_t index = trie.insert(key, prefix_length, values_.size());
+    if (index == values_.size())
+      values_.push_back(e);
+    else
+      values_[index] = e;
+  }
+
+  const T* value_at(std::size_t index) const ASIO_NOEXCEPT
+  {
+    return index == asio::ip::detail::prefix_trie::npos
+      ? 0 : &values_[index].value_;
+  }
+
+  // Each value is wrapped so that find() can return a pointer to it, even for
+  // types such as bool that std::vector would otherwise pack.
+  struct entry
+  {
+    T value_;
+  };
+
+  asio::ip::detail::prefix_trie v4_;
+  asio::ip::detail::prefix_trie v6_;
+  std::vector<entry> values_;
+};
+
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_NETWORK_MAP_HPP
@@ -107,6 +107,147 @@ public:
   typedef asio::detail::socket_option::boolean<
     ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_NODELAY)> no_delay;
 
+#if defined(ASIO_OS_DEF_TCP_QUICKACK)
+  /// Socket option for sending acknowledgements without delay.
+  /**
+   * Implements the IPPROTO_TCP/TCP_QUICKACK socket option. The kernel may
+   * return to delayed acknowledgement mode after subsequent processing, so
+   * the option is not permanent.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(io_context);
+   * ...
+   * asio::ip::tcp::quick_ack option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_QUICKACK)> quick_ack;
+#endif // defined(ASIO_OS_DEF_TCP_QUICKACK)
+
+#if defined(ASIO_OS_DEF_TCP_CORK)
+  /// Socket option for holding back partial frames.
+  /**
+   * Implements the IPPROTO_TCP/TCP_CORK socket option. While set, only full
+   * frames are sent. Clearing the option flushes any pending partial frame.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(io_context);
+   * ...
+   * asio::ip::tcp::cork option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_CORK)> cork;
+#endif // defined(ASIO_OS_DEF_TCP_CORK)
+
+#if defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+  /// Socket option for the unsent data low watermark.
+  /**
+   * Implements the IPPROTO_TCP/TCP_NOTSENT_LOWAT socket option. The socket is
+   * only reported as writable while the amount of unsent data in the send
+   * queue is below the given number of bytes, bounding the data buffered in
+   * the kernel without limiting throughput.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(io_context);
+   * ...
+   * asio::ip::tcp::notsent_low_watermark option(16384);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_NOTSENT_LOWAT)>
+      notsent_low_watermark;
+#endif // defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+
+#if defined(ASIO_OS_DEF_TCP_DEFER_ACCEPT)
+  /// Socket option for deferring accept until data arrives.
+  /**
+   * Implements the IPPROTO_TCP/TCP_DEFER_ACCEPT socket option. Set on an
+   * acceptor, a new connection is only reported once data has arrived on it,
+   * or after the given number of seconds.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(io_context);
+   * ...
+   * asio::ip::tcp::defer_accept option(5);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_DEFER_ACCEPT)> defer_accept;
+#endif // defined(ASIO_OS_DEF_TCP_DEFER_ACCEPT)
+
+#if defined(ASIO_OS_DEF_TCP_FASTOPEN)
+  /// Socket option for accepting TCP Fast Open connections.
+  /**
+   * Implements the IPPROTO_TCP/TCP_FASTOPEN socket option. Set on an acceptor
+   * before it starts listening, the value is the maximum number of pending
+   * Fast Open requests.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(io_context);
+   * ...
+   * asio::ip::tcp::fast_open option(256);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_FASTOPEN)> fast_open;
+#endif // defined(ASIO_OS_DEF_TCP_FASTOPEN)
+
+#if defined(ASIO_OS_DEF_TCP_FASTOPEN_CONNECT)
+  /// Socket option for making TCP Fast Open connections.
+  /**
+   * Implements the IPPROTO_TCP/TCP_FASTOPEN_CONNECT socket option. Set on a
+   * socket before connecting, the first write is sent with the SYN when a
+   * Fast Open cookie for the server is available.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(io_context);
+   * socket.open(asio::ip::tcp::v4());
+   * asio::ip::tcp::fast_open_connect option(true);
+   * socket.set_option(option);
+   * socket.connect(endpoint);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_FASTOPEN_CONNECT)>
+      fast_open_connect;
+#endif // defined(ASIO_OS_DEF_TCP_FASTOPEN_CONNECT)
+
   /// Compare two protocols for equality.
   friend bool operator==(const tcp& p1, const tcp& p2)
   {
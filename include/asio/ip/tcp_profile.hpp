@@ -0,0 +1,349 @@
+#ifndef ASIO_IP_TCP_PROFILE_HPP
+#define ASIO_IP_TCP_PROFILE_HPP
+
+#include "asio/detail/config.hpp"
+#include "asio/error/error.hpp"
+#include "asio/network/basic_socket_acceptor.hpp"
+#include "asio/network/basic_stream_socket.hpp"
+#include "asio/network/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+/// A bundle of TCP tuning options to be applied to sockets as a unit.
+/**
+ * The tcp_profile class records a set of socket option values. Options that
+ * have not been given a value are left untouched when the profile is applied.
+ * A profile is applied to a connection with basic_stream_socket::set_profile,
+ * or to a listening socket with basic_socket_acceptor::set_profile.
+ *
+ * Applying a profile to an acceptor sets the per-connection options on the
+ * listening socket, together with the listener-only options defer_accept and
+ * fast_open. Whether accepted sockets inherit an option from the listener is
+ * platform-specific. On Linux, no_delay, cork, notsent_low_watermark and
+ * busy_poll are inherited. quick_ack and incoming_cpu are not: the kernel
+ * resets quick_ack for each new connection, and incoming_cpu on a listener
+ * only steers connections between listeners that share a port. Apply the
+ * profile to each accepted socket with basic_stream_socket::set_profile when
+ * those options are needed on the connection.
+ *
+ * Applying a profile to a socket sets the per-connection options, together
+ * with the connect-only option fast_open_connect, which only takes effect
+ * when the profile is applied before connecting. When the profile currently
+ * in effect on the socket is supplied, only the options whose values differ
+ * are set, and a failure part way through restores the options already
+ * changed to their values in the current profile.
+ *
+ * Options not supported by the platform fail with
+ * asio::error::operation_not_supported when applied.
+ *
+ * @par Example
+ * @code
+ * asio::ip::tcp::acceptor acceptor(io_context, endpoint);
+ * acceptor.set_profile(asio::ip::tcp_profile::low_latency());
+ * ...
+ * asio::ip::tcp::socket peer = acceptor.accept();
+ * // Set the options that accepted sockets do not inherit.
+ * peer.set_profile(asio::ip::tcp_profile::low_latency());
+ * ...
+ * asio::ip::tcp::socket socket(io_context);
+ * socket.open(asio::ip::tcp::v4());
+ * socket.set_profile(asio::ip::tcp_profile::low_latency());
+ * socket.connect(endpoint);
+ * ...
+ * // Switch the connection to bulk transfer.
+ * socket.set_profile(asio::ip::tcp_profile::bulk(),
+ *     asio::ip::tcp_profile::low_latency());
+ * @endcode
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class tcp_profile
+{
+public:
+  /// Construct a profile that sets no options.
+  tcp_profile()
+    : mask_(0)
+  {
+    for (int i = 0; i < max_settings; ++i)
+      values_[i] = 0;
+  }
+
+  /// A profile for interactive request/response traffic.
+  /**
+   * Disables the Nagle algorithm and delayed acknowledgements, and limits the
+   * unsent data queued in the kernel to 16KB so that the latest writes are not
+   * stuck behind a deep send queue.
+   */
+  static tcp_profile low_latency()
+  {
+    tcp_profile p;
+    p.no_delay(true).quick_ack(true).notsent_low_watermark(16384);
+    return p;
+  }
+
+  /// A profile for bulk transfers.
+  /**
+   * Restores the Nagle algorithm and delayed acknowledgements, and allows up
+   * to 1MB of unsent data to be queued in the kernel.
+   */
+  static tcp_profile bulk()
+  {
+    tcp_profile p;
+    p.no_delay(false).quick_ack(false).notsent_low_watermark(1048576);
+    return p;
+  }
+
+  /// Set the value of the TCP_NODELAY option.
+  tcp_profile& no_delay(bool value)
+  {
+    return set(no_delay_setting, value ? 1 : 0);
+  }
+
+  /// Set the value of the TCP_QUICKACK option.
+  tcp_profile& quick_ack(bool value)
+  {
+    return set(quick_ack_setting, value ? 1 : 0);
+  }
+
+  /// Set the value of the TCP_CORK option.
+  tcp_profile& cork(bool value)
+  {
+    return set(cork_setting, value ? 1 : 0);
+  }
+
+  /// Set the value of the TCP_NOTSENT_LOWAT option, in bytes.
+  tcp_profile& notsent_low_watermark(int value)
+  {
+    return set(notsent_low_watermark_setting, value);
+  }
+
+  /// Set the value of the SO_BUSY_POLL option, in microseconds.
+  tcp_profile& busy_poll(int value)
+  {
+    return set(busy_poll_setting, value);
+  }
+
+  /// Set the value of the SO_INCOMING_CPU option.
+  tcp_profile& incoming_cpu(int value)
+  {
+    return set(incoming_cpu_setting, value);
+  }
+
+  /// Set the value of the TCP_FASTOPEN_CONNECT option. Connect-only.
+  tcp_profile& fast_open_connect(bool value)
+  {
+    return set(fast_open_connect_setting, value ? 1 : 0);
+  }
+
+  /// Set the value of the TCP_DEFER_ACCEPT option, in seconds. Listener-only.
+  tcp_profile& defer_accept(int value)
+  {
+    return set(defer_accept_setting, value);
+  }
+
+  /// Set the value of the TCP_FASTOPEN option, as the maximum number of
+  /// pending Fast Open requests. Listener-only.
+  tcp_profile& fast_open(int value)
+  {
+    return set(fast_open_setting, value);
+  }
+
+  /// Determine whether the profile sets any options.
+  bool empty() const
+  {
+    return mask_ == 0;
+  }
+
+  /// Apply the profile to a connection. Normally called through
+  /// basic_stream_socket::set_profile.
+  template <typename Protocol>
+  void apply(basic_stream_socket<Protocol>& s,
+      const tcp_profile* current, asio::error_code& ec) const
+  {
+    apply_settings(s, ~listener_only_mask, current, ec);
+  }
+
+  /// Apply the profile to a listening socket. Normally called through
+  /// basic_socket_acceptor::set_profile.
+  template <typename Protocol>
+  void apply(basic_socket_acceptor<Protocol>& a,
+      const tcp_profile* current, asio::error_code& ec) const
+  {
+    apply_settings(a, ~connect_only_mask, current, ec);
+  }
+
+private:
+  enum setting
+  {
+    no_delay_setting,
+    quick_ack_setting,
+    cork_setting,
+    notsent_low_watermark_setting,
+    busy_poll_setting,
+    incoming_cpu_setting,
+    fast_open_connect_setting,
+    defer_accept_setting,
+    fast_open_setting,
+    max_settings
+  };
+
+  enum
+  {
+    connect_only_mask = 1u << fast_open_connect_setting,
+    listener_only_mask = (1u << defer_accept_setting)
+      | (1u << fast_open_setting)
+  };
+
+  // A socket option whose level and name are determined at runtime.
+  class setting_option
+  {
+  public:
+    setting_option(int level, int name, int value)
+      : level_(level), name_(name), value_(value)
+    {
+    }
+
+    template <typename Protocol>
+    int level(const Protocol&) const
+    {
+      return level_;
+    }
+
+    template <typename Protocol>
+    int name(const Protocol&) const
+    {
+      return name_;
+    }
+
+    template <typename Protocol>
+    const int* data(const Protocol&) const
+    {
+      return &value_;
+    }
+
+    template <typename Protocol>
+    std::size_t size(const Protocol&) const
+    {
+      return sizeof(value_);
+    }
+
+  private:
+    int level_;
+    int name_;
+    int value_;
+  };
+
+  tcp_profile& set(setting s, int value)
+  {
+    mask_ |= 1u << s;
+    values_[s] = value;
+    return *this;
+  }
+
+  // Get the level and name of a setting. Returns false if the option is not
+  // supported by the platform.
+  static bool describe(int s, int& level, int& name)
+  {
+    level = ASIO_OS_DEF(IPPROTO_TCP);
+    switch (s)
+    {
+    case no_delay_setting: name = ASIO_OS_DEF(TCP_NODELAY); return true;
+#if defined(ASIO_OS_DEF_TCP_QUICKACK)
+    case quick_ack_setting: name = ASIO_OS_DEF(TCP_QUICKACK); return true;
+#endif // defined(ASIO_OS_DEF_TCP_QUICKACK)
+#if defined(ASIO_OS_DEF_TCP_CORK)
+    case cork_setting: name = ASIO_OS_DEF(TCP_CORK); return true;
+#endif // defined(ASIO_OS_DEF_TCP_CORK)
+#if defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+    case notsent_low_watermark_setting:
+      name = ASIO_OS_DEF(TCP_NOTSENT_LOWAT);
+      return true;
+#endif // defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+#if defined(ASIO_OS_DEF_SO_BUSY_POLL)
+    case busy_poll_setting:
+      level = ASIO_OS_DEF(SOL_SOCKET);
+      name = ASIO_OS_DEF(SO_BUSY_POLL);
+      return true;
+#endif // defined(ASIO_OS_DEF_SO_BUSY_POLL)
+#if defined(ASIO_OS_DEF_SO_INCOMING_CPU)
+    case incoming_cpu_setting:
+      level = ASIO_OS_DEF(SOL_SOCKET);
+      name = ASIO_OS_DEF(SO_INCOMING_CPU);
+      return true;
+#endif // defined(ASIO_OS_DEF_SO_INCOMING_CPU)
+#if defined(ASIO_OS_DEF_TCP_FASTOPEN_CONNECT)
+    case fast_open_connect_setting:
+      name = ASIO_OS_DEF(TCP_FASTOPEN_CONNECT);
+      return true;
+#endif // defined(ASIO_OS_DEF_TCP_FASTOPEN_CONNECT)
+#if defined(ASIO_OS_DEF_TCP_DEFER_ACCEPT)
+    case defer_accept_setting: name = ASIO_OS_DEF(TCP_DEFER_ACCEPT); return true;
+#endif // defined(ASIO_OS_DEF_TCP_DEFER_ACCEPT)
+#if defined(ASIO_OS_DEF_TCP_FASTOPEN)
+    case fast_open_setting: name = ASIO_OS_DEF(TCP_FASTOPEN); return true;
+#endif // defined(ASIO_OS_DEF_TCP_FASTOPEN)
+    default: return false;
+    }
+  }
+
+  template <typename Socket>
+  static void set_one(Socket& s, int setting,
+      int value, asio::error_code& ec)
+  {
+    int level = 0, name = 0;
+    if (describe(setting, level, name))
+      s.set_option(setting_option(level, name, value), ec);
+    else
+      ec = asio::error::operation_not_supported;
+  }
+
+  template <typename Socket>
+  void apply_settings(Socket& s, unsigned int roles,
+      const tcp_profile* current, asio::error_code& ec) const
+  {
+    ec = asio::error_code();
+
+    unsigned int changed = 0;
+    for (int i = 0; i < max_settings; ++i)
+    {
+      unsigned int bit = 1u << i;
+      if ((mask_ & roles & bit) == 0)
+        continue;
+
+      // Nothing to do if the option already has the required value.
+      if (current && (current->mask_ & bit)
+          && current->values_[i] == values_[i])
+        continue;
+
+      set_one(s, i, values_[i], ec);
+      if (ec)
+      {
+        if (current)
+        {
+          asio::error_code ignored_ec;
+          for (int j = 0; j < i; ++j)
+            if (changed & current->mask_ & (1u << j))
+              set_one(s, j, current->values_[j], ignored_ec);
+        }
+        return;
+      }
+
+      changed |= bit;
+    }
+  }
+
+  unsigned int mask_;
+  int values_[max_settings];
+};
+
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_TCP_PROFILE_HPP
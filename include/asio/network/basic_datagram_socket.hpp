@@ -298,10 +298,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes sent.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The async_send operation can only be used with a connected socket.
    * Use the async_send_to function to send data on an unconnected datagram
@@ -354,10 +355,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes sent.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The async_send operation can only be used with a connected socket.
    * Use the async_send_to function to send data on an unconnected datagram
@@ -491,10 +493,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes sent.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @par Example
    * To send a single data buffer use the @ref buffer function as follows:
@@ -551,10 +554,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes sent.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    */
   template <typename ConstBufferSequence, typename WriteHandler>
   ASIO_INITFN_RESULT_TYPE(WriteHandler,
@@ -683,10 +687,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes received.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The async_receive operation can only be used with a connected socket.
    * Use the async_receive_from function to receive data on an unconnected
@@ -740,10 +745,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes received.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The async_receive operation can only be used with a connected socket.
    * Use the async_receive_from function to receive data on an unconnected
@@ -880,10 +886,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes received.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @par Example
    * To receive into a single data buffer use the @ref buffer function as
@@ -939,10 +946,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes received.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    */
   template <typename MutableBufferSequence, typename ReadHandler>
   ASIO_INITFN_RESULT_TYPE(ReadHandler,
@@ -290,10 +290,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes sent.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The async_send operation can only be used with a connected socket.
    * Use the async_send_to function to send data on an unconnected raw
@@ -346,10 +347,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes sent.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The async_send operation can only be used with a connected socket.
    * Use the async_send_to function to send data on an unconnected raw
@@ -483,10 +485,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes sent.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @par Example
    * To send a single data buffer use the @ref buffer function as follows:
@@ -542,10 +545,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes sent.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    */
   template <typename ConstBufferSequence, typename WriteHandler>
   ASIO_INITFN_RESULT_TYPE(WriteHandler,
@@ -674,10 +678,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes received.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The async_receive operation can only be used with a connected socket.
    * Use the async_receive_from function to receive data on an unconnected
@@ -731,10 +736,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes received.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The async_receive operation can only be used with a connected socket.
    * Use the async_receive_from function to receive data on an unconnected
@@ -871,10 +877,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes received.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @par Example
    * To receive into a single data buffer use the @ref buffer function as
@@ -930,10 +937,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes received.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    */
   template <typename MutableBufferSequence, typename ReadHandler>
   ASIO_INITFN_RESULT_TYPE(ReadHandler,
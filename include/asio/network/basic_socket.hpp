@@ -1102,6 +1102,46 @@ public:
     return;
   }
 
+  /// Gets the immediate completion mode of the socket.
+  /**
+   * @returns @c true if asynchronous send and receive operations that can be
+   * completed without waiting may invoke their handlers from within the
+   * initiating function.
+   */
+  bool immediate_completion() const
+  {
+    return this->get_service().immediate_completion(
+        this->get_implementation());
+  }
+
+  /// Sets the immediate completion mode of the socket.
+  /**
+   * By default, the handler of an asynchronous operation is never invoked from
+   * within the initiating function, even when the operation could be
+   * completed straight away. In immediate completion mode, an asynchronous
+   * send or receive is attempted as soon as it is started and, if it
+   * succeeds, its handler is invoked inline when the operation is initiated
+   * from a thread that is running the io_context. This removes the queueing
+   * and possible thread wake-up from request/response loops on sockets that
+   * are already readable or writable.
+   *
+   * To bound stack growth, at most @c ASIO_IMMEDIATE_COMPLETION_MAX_DEPTH
+   * (default 8) such handlers may be nested on a thread. Beyond that, and
+   * when initiated from outside the io_context, handlers are queued as usual.
+   *
+   * @param mode If @c true, enables immediate completion.
+   *
+   * @note The mode is reset when the socket is opened or assigned. It must
+   * only be enabled when the program's handlers do not depend on deferred
+   * invocation, e.g. when a handler that initiates an operation does not hold
+   * a lock also taken by the operation's handler.
+   */
+  void immediate_completion(bool mode)
+  {
+    this->get_service().immediate_completion(
+        this->get_implementation(), mode);
+  }
+
   /// Gets the non-blocking mode of the native socket implementation.
   /**
    * This function is used to retrieve the non-blocking mode of the underlying
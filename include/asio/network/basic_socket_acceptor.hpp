@@ -642,6 +642,49 @@ public:
     return;
   }
 
+  /// Apply a profile of socket options to the acceptor.
+  /**
+   * This function is used to set a bundle of socket options, such as an
+   * asio::ip::tcp_profile, on the listening socket. Accepted sockets inherit
+   * some per-connection options from the listener, depending on the option
+   * and the platform. Apply the profile to each accepted socket when its
+   * options must be in effect on the connection. Options that affect how the
+   * acceptor listens must be applied before calling listen.
+   *
+   * @param profile The profile to be applied.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @par Example
+   * @code
+   * asio::ip::tcp::acceptor acceptor(io_context);
+   * ...
+   * acceptor.set_profile(asio::ip::tcp_profile::low_latency());
+   * @endcode
+   */
+  template <typename SocketProfile>
+  void set_profile(const SocketProfile& profile)
+  {
+    asio::error_code ec;
+    profile.apply(*this, 0, ec);
+    asio::detail::throw_error(ec, "set_profile");
+  }
+
+  /// Apply a profile of socket options to the acceptor.
+  /**
+   * This function is used to set a bundle of socket options, such as an
+   * asio::ip::tcp_profile, on the listening socket.
+   *
+   * @param profile The profile to be applied.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  template <typename SocketProfile>
+  void set_profile(const SocketProfile& profile, asio::error_code& ec)
+  {
+    profile.apply(*this, 0, ec);
+  }
+
   /// Get an option from the acceptor.
   /**
    * This function is used to get the current value of an option on the
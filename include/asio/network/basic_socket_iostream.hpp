@@ -8,6 +8,7 @@
 #include <istream>
 #include <ostream>
 #include "asio/network/basic_socket_streambuf.hpp"
+#include "asio/detail/base/stdcpp/type_traits.hpp"
 
 #if !defined(ASIO_HAS_VARIADIC_TEMPLATES)
 
@@ -87,6 +88,12 @@ protected:
   {
   }
 
+  socket_iostream_base(basic_stream_socket<Protocol> s,
+      std::size_t buffer_size)
+    : streambuf_(std::move(s), buffer_size)
+  {
+  }
+
   socket_iostream_base& operator=(socket_iostream_base&& other)
   {
     streambuf_ = std::move(other.streambuf_);
@@ -178,6 +185,36 @@ public:
     this->setf(std::ios_base::unitbuf);
   }
 
+  /// Construct a basic_socket_iostream from the supplied socket, with stream
+  /// buffers of the given size.
+  /**
+   * @param s The socket.
+   *
+   * @param buffer_size The size of each of the streambuf's get and put
+   * buffers. The default is 512 bytes.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  basic_socket_iostream(basic_stream_socket<protocol_type> s,
+      std::size_t buffer_size);
+#else // defined(GENERATING_DOCUMENTATION)
+  // A template is used so that this is a better match than the constructor
+  // that connects using resolver arguments.
+  template <typename SizeType>
+  basic_socket_iostream(basic_stream_socket<protocol_type> s,
+      SizeType buffer_size, typename enable_if<
+        is_convertible<SizeType, std::size_t>::value>::type* = 0)
+    : detail::socket_iostream_base<
+        Protocol, Clock,
+        WaitTraits>(std::move(s), static_cast<std::size_t>(buffer_size)),
+      std::basic_iostream<char>(
+        &this->detail::socket_iostream_base<
+          Protocol, Clock,
+          WaitTraits>::streambuf_)
+  {
+    this->setf(std::ios_base::unitbuf);
+  }
+#endif // defined(GENERATING_DOCUMENTATION)
+
 #if defined(ASIO_HAS_STD_IOSTREAM_MOVE) \
   || defined(GENERATING_DOCUMENTATION)
   /// Move-construct a basic_socket_iostream from another.
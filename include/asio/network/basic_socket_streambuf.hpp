@@ -5,6 +5,9 @@
 
 #if !defined(ASIO_NO_IOSTREAM)
 
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
 #include <streambuf>
 #include <vector>
 #include "asio/network/basic_socket.hpp"
@@ -12,6 +15,7 @@
 #include "asio/buffer/buffer_sequence_adapter.hpp"
 #include "asio/detail/memory/memory.hpp"
 #include "asio/error/throw_error.hpp"
+#include "asio/error/throw_exception.hpp"
 #include "asio/core/io_context.hpp"
 
 # include "asio/service/timer/steady_timer.hpp"
@@ -78,15 +82,52 @@ protected:
 class socket_streambuf_buffers
 {
 protected:
-  socket_streambuf_buffers()
-    : get_buffer_(buffer_size),
-      put_buffer_(buffer_size)
+  enum { default_buffer_size = 512, putback_max = 8 };
+
+  // Allocate both buffers together. The get buffer always has room for at
+  // least one character after the putback area.
+  explicit socket_streambuf_buffers(
+      std::size_t buffer_size = default_buffer_size)
+    : storage_((std::max<std::size_t>)(buffer_size, putback_max + 1)
+        + buffer_size),
+      get_buffer_(&storage_[0]),
+      get_size_(storage_.size() - buffer_size),
+      put_buffer_(buffer_size > 0 ? get_buffer_ + get_size_ : 0),
+      put_size_(buffer_size)
   {
   }
 
-  enum { buffer_size = 512 };
-  std::vector<char> get_buffer_;
-  std::vector<char> put_buffer_;
+  // Use buffers supplied by the user, which are not owned.
+  socket_streambuf_buffers(char* get_buffer, std::size_t get_size,
+      char* put_buffer, std::size_t put_size)
+    : get_buffer_(get_buffer),
+      get_size_(get_size),
+      put_buffer_(put_size > 0 ? put_buffer : 0),
+      put_size_(put_buffer ? put_size : 0)
+  {
+    if (!get_buffer || get_size <= putback_max)
+    {
+      std::invalid_argument ex("socket_streambuf get buffer too small");
+      asio::detail::throw_exception(ex);
+    }
+  }
+
+  void swap_buffers(socket_streambuf_buffers& other)
+  {
+    // Swapping the vectors leaves their data where it is, so the pointers into
+    // the storage remain valid.
+    storage_.swap(other.storage_);
+    std::swap(get_buffer_, other.get_buffer_);
+    std::swap(get_size_, other.get_size_);
+    std::swap(put_buffer_, other.put_buffer_);
+    std::swap(put_size_, other.put_size_);
+  }
+
+  std::vector<char> storage_;
+  char* get_buffer_;
+  std::size_t get_size_;
+  char* put_buffer_;
+  std::size_t put_size_;
 };
 
 } // namespace detail
@@ -155,6 +196,51 @@ public:
     init_buffers();
   }
 
+  /// Construct a basic_socket_streambuf with buffers of the given size,
+  /// without establishing a connection.
+  /**
+   * @param buffer_size The size of each of the get and put buffers. Larger
+   * buffers mean fewer system calls when data is transferred a character or a
+   * few characters at a time. A size of 0 makes output unbuffered.
+   */
+  explicit basic_socket_streambuf(std::size_t buffer_size)
+    : detail::socket_streambuf_io_context(new io_context),
+      detail::socket_streambuf_buffers(buffer_size),
+      basic_socket<Protocol>(*default_io_context_),
+      expiry_time_(max_expiry_time())
+  {
+    init_buffers();
+  }
+
+  /// Construct a basic_socket_streambuf that uses the supplied buffers, without
+  /// establishing a connection.
+  /**
+   * No buffer memory is allocated. The streambuf stores pointers to the
+   * buffers, and the user is responsible for ensuring that they remain valid
+   * until the streambuf is destroyed.
+   *
+   * @param get_buffer The buffer for input.
+   *
+   * @param get_size The size of the input buffer, which must be larger than
+   * the 8 characters reserved for putback.
+   *
+   * @param put_buffer The buffer for output, or 0 to make output unbuffered.
+   *
+   * @param put_size The size of the output buffer.
+   *
+   * @throws std::invalid_argument Thrown if the input buffer is too small.
+   */
+  basic_socket_streambuf(char* get_buffer, std::size_t get_size,
+      char* put_buffer, std::size_t put_size)
+    : detail::socket_streambuf_io_context(new io_context),
+      detail::socket_streambuf_buffers(get_buffer,
+          get_size, put_buffer, put_size),
+      basic_socket<Protocol>(*default_io_context_),
+      expiry_time_(max_expiry_time())
+  {
+    init_buffers();
+  }
+
 #if defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
   /// Construct a basic_socket_streambuf from the supplied socket.
   explicit basic_socket_streambuf(basic_stream_socket<protocol_type> s)
@@ -165,6 +251,18 @@ public:
     init_buffers();
   }
 
+  /// Construct a basic_socket_streambuf from the supplied socket, with buffers
+  /// of the given size.
+  basic_socket_streambuf(basic_stream_socket<protocol_type> s,
+      std::size_t buffer_size)
+    : detail::socket_streambuf_io_context(0),
+      detail::socket_streambuf_buffers(buffer_size),
+      basic_socket<Protocol>(std::move(s)),
+      expiry_time_(max_expiry_time())
+  {
+    init_buffers();
+  }
+
   /// Move-construct a basic_socket_streambuf from another.
   basic_socket_streambuf(basic_socket_streambuf&& other)
     : detail::socket_streambuf_io_context(other),
@@ -172,8 +270,7 @@ public:
       ec_(other.ec_),
       expiry_time_(other.expiry_time_)
   {
-    get_buffer_.swap(other.get_buffer_);
-    put_buffer_.swap(other.put_buffer_);
+    swap_buffers(other);
     setg(other.eback(), other.gptr(), other.egptr());
     setp(other.pptr(), other.epptr());
     other.ec_ = asio::error_code();
@@ -189,13 +286,11 @@ public:
     detail::socket_streambuf_io_context::operator=(other);
     ec_ = other.ec_;
     expiry_time_ = other.expiry_time_;
-    get_buffer_.swap(other.get_buffer_);
-    put_buffer_.swap(other.put_buffer_);
+    swap_buffers(other);
     setg(other.eback(), other.gptr(), other.egptr());
     setp(other.pptr(), other.epptr());
     other.ec_ = asio::error_code();
     other.expiry_time_ = max_expiry_time();
-    other.put_buffer_.resize(buffer_size);
     other.init_buffers();
     return *this;
   }
@@ -323,48 +418,14 @@ protected:
     if (gptr() != egptr())
       return traits_type::eof();
 
-    for (;;)
-    {
-      // Check if we are past the expiry time.
-      if (traits_helper::less_than(expiry_time_, traits_helper::now()))
-      {
-        ec_ = asio::error::timed_out;
-        return traits_type::eof();
-      }
-
-      // Try to complete the operation without blocking.
-      if (!socket().native_non_blocking())
-        socket().native_non_blocking(true, ec_);
-      detail::buffer_sequence_adapter<mutable_buffer, mutable_buffer>
-        bufs(asio::buffer(get_buffer_) + putback_max);
-      detail::signed_size_type bytes = detail::socket_ops::recv(
-          socket().native_handle(), bufs.buffers(), bufs.count(), 0, ec_);
-
-      // Check if operation succeeded.
-      if (bytes > 0)
-      {
-        setg(&get_buffer_[0], &get_buffer_[0] + putback_max,
-            &get_buffer_[0] + putback_max + bytes);
-        return traits_type::to_int_type(*gptr());
-      }
-
-      // Check for EOF.
-      if (bytes == 0)
-      {
-        ec_ = asio::error::eof;
-        return traits_type::eof();
-      }
-
-      // Operation failed.
-      if (ec_ != asio::error::would_block
-          && ec_ != asio::error::try_again)
-        return traits_type::eof();
+    std::size_t bytes = receive_some(asio::buffer(
+          get_buffer_ + putback_max, get_size_ - putback_max));
+    if (bytes == 0)
+      return traits_type::eof();
 
-      // Wait for socket to become ready.
-      if (detail::socket_ops::poll_read(
-            socket().native_handle(), 0, timeout(), ec_) < 0)
-        return traits_type::eof();
-    }
+    setg(get_buffer_, get_buffer_ + putback_max,
+        get_buffer_ + putback_max + bytes);
+    return traits_type::to_int_type(*gptr());
   }
 
   int_type overflow(int_type c)
@@ -373,7 +434,7 @@ protected:
 
     // Determine what needs to be sent.
     const_buffer output_buffer;
-    if (put_buffer_.empty())
+    if (put_size_ == 0)
     {
       if (traits_type::eq_int_type(c, traits_type::eof()))
         return traits_type::not_eof(c); // Nothing to do.
@@ -385,44 +446,12 @@ protected:
           (pptr() - pbase()) * sizeof(char_type));
     }
 
-    while (output_buffer.size() > 0)
-    {
-      // Check if we are past the expiry time.
-      if (traits_helper::less_than(expiry_time_, traits_helper::now()))
-      {
-        ec_ = asio::error::timed_out;
-        return traits_type::eof();
-      }
-
-      // Try to complete the operation without blocking.
-      if (!socket().native_non_blocking())
-        socket().native_non_blocking(true, ec_);
-      detail::buffer_sequence_adapter<
-        const_buffer, const_buffer> bufs(output_buffer);
-      detail::signed_size_type bytes = detail::socket_ops::send(
-          socket().native_handle(), bufs.buffers(), bufs.count(), 0, ec_);
-
-      // Check if operation succeeded.
-      if (bytes > 0)
-      {
-        output_buffer += static_cast<std::size_t>(bytes);
-        continue;
-      }
-
-      // Operation failed.
-      if (ec_ != asio::error::would_block
-          && ec_ != asio::error::try_again)
-        return traits_type::eof();
-
-      // Wait for socket to become ready.
-      if (detail::socket_ops::poll_write(
-            socket().native_handle(), 0, timeout(), ec_) < 0)
-        return traits_type::eof();
-    }
+    if (!send_all(&output_buffer, 1))
+      return traits_type::eof();
 
-    if (!put_buffer_.empty())
+    if (put_size_ > 0)
     {
-      setp(&put_buffer_[0], &put_buffer_[0] + put_buffer_.size());
+      setp(put_buffer_, put_buffer_ + put_size_);
 
       // If the new character is eof then our work here is done.
       if (traits_type::eq_int_type(c, traits_type::eof()))
@@ -436,6 +465,77 @@ protected:
     return c;
   }
 
+  std::streamsize xsgetn(char_type* s, std::streamsize n)
+  {
+    // Take whatever is already buffered.
+    std::streamsize count = (std::min<std::streamsize>)(egptr() - gptr(), n);
+    traits_type::copy(s, gptr(), static_cast<std::size_t>(count));
+    setg(eback(), gptr() + count, egptr());
+
+    // Receive directly into the caller's memory while the remainder is at
+    // least as large as the get buffer, as copying through it would only
+    // split the data into more system calls.
+    std::streamsize direct = 0;
+    while (n - count >= static_cast<std::streamsize>(get_size_ - putback_max))
+    {
+      std::size_t bytes = receive_some(asio::buffer(
+            s + count, static_cast<std::size_t>(n - count)));
+      if (bytes == 0)
+        break;
+      count += static_cast<std::streamsize>(bytes);
+      direct += static_cast<std::streamsize>(bytes);
+    }
+
+    if (direct > 0)
+    {
+      // Keep the last characters received available for putback.
+      std::size_t putback = (std::min<std::size_t>)(
+          static_cast<std::size_t>(count), putback_max);
+      traits_type::copy(get_buffer_ + putback_max - putback,
+          s + count - putback, putback);
+      setg(get_buffer_ + putback_max - putback,
+          get_buffer_ + putback_max, get_buffer_ + putback_max);
+
+      if (ec_)
+        return count;
+    }
+
+    if (count < n)
+      count += std::streambuf::xsgetn(s + count, n - count);
+    return count;
+  }
+
+  std::streamsize xsputn(const char_type* s, std::streamsize n)
+  {
+    // Data that fits the put buffer is copied into it as usual.
+    if (n < static_cast<std::streamsize>(put_size_))
+      return std::streambuf::xsputn(s, n);
+
+    // Larger writes are sent directly from the caller's memory, together with
+    // any data already buffered, using a single gather operation.
+    const_buffer output_buffers[2] = {
+      asio::buffer(pbase(), (pptr() - pbase()) * sizeof(char_type)),
+      asio::buffer(s, static_cast<std::size_t>(n) * sizeof(char_type))
+    };
+
+    bool ok = send_all(output_buffers, 2);
+
+    // On failure, keep any buffered data that was not sent so that it is not
+    // lost, and report how much of the caller's data was accepted.
+    std::size_t unsent = output_buffers[0].size() / sizeof(char_type);
+    if (put_size_ > 0)
+    {
+      if (unsent > 0)
+        traits_type::move(put_buffer_, pptr() - unsent, unsent);
+      setp(put_buffer_, put_buffer_ + put_size_);
+      pbump(static_cast<int>(unsent));
+    }
+    if (ok)
+      return n;
+    return n - static_cast<std::streamsize>(
+        output_buffers[1].size() / sizeof(char_type));
+  }
+
   int sync()
   {
     return overflow(traits_type::eof());
@@ -445,12 +545,21 @@ protected:
   {
     if (pptr() == pbase() && s == 0 && n == 0)
     {
-      put_buffer_.clear();
+      put_size_ = 0;
       setp(0, 0);
       sync();
       return this;
     }
 
+    // Use the supplied memory as the put buffer. It is not owned.
+    if (pptr() == pbase() && s != 0 && n > 0)
+    {
+      put_buffer_ = s;
+      put_size_ = static_cast<std::size_t>(n);
+      setp(put_buffer_, put_buffer_ + put_size_);
+      return this;
+    }
+
     return 0;
   }
 
@@ -462,14 +571,112 @@ private:
 
   void init_buffers()
   {
-    setg(&get_buffer_[0],
-        &get_buffer_[0] + putback_max,
-        &get_buffer_[0] + putback_max);
+    setg(get_buffer_,
+        get_buffer_ + putback_max,
+        get_buffer_ + putback_max);
 
-    if (put_buffer_.empty())
+    if (put_size_ == 0)
       setp(0, 0);
     else
-      setp(&put_buffer_[0], &put_buffer_[0] + put_buffer_.size());
+      setp(put_buffer_, put_buffer_ + put_size_);
+  }
+
+  // Receive some data into the given buffer, waiting until data is available.
+  // Returns 0 on end of file or error.
+  std::size_t receive_some(const mutable_buffer& buffer)
+  {
+    for (;;)
+    {
+      // Check if we are past the expiry time.
+      if (traits_helper::less_than(expiry_time_, traits_helper::now()))
+      {
+        ec_ = asio::error::timed_out;
+        return 0;
+      }
+
+      // Try to complete the operation without blocking.
+      if (!socket().native_non_blocking())
+        socket().native_non_blocking(true, ec_);
+      detail::buffer_sequence_adapter<mutable_buffer, mutable_buffer>
+        bufs(buffer);
+      detail::signed_size_type bytes = detail::socket_ops::recv(
+          socket().native_handle(), bufs.buffers(), bufs.count(), 0, ec_);
+
+      // Check if operation succeeded.
+      if (bytes > 0)
+        return static_cast<std::size_t>(bytes);
+
+      // Check for EOF.
+      if (bytes == 0)
+      {
+        ec_ = asio::error::eof;
+        return 0;
+      }
+
+      // Operation failed.
+      if (ec_ != asio::error::would_block
+          && ec_ != asio::error::try_again)
+        return 0;
+
+      // Wait for socket to become ready.
+      if (detail::socket_ops::poll_read(
+            socket().native_handle(), 0, timeout(), ec_) < 0)
+        return 0;
+    }
+  }
+
+  // Send all of the data in up to two buffers, waiting as necessary. Returns
+  // false if an error occurred.
+  bool send_all(const_buffer* buffers, std::size_t count)
+  {
+    for (;;)
+    {
+      // Skip the buffers that have been sent.
+      while (count > 0 && buffers[0].size() == 0)
+        ++buffers, --count;
+      if (count == 0)
+        return true;
+
+      // Check if we are past the expiry time.
+      if (traits_helper::less_than(expiry_time_, traits_helper::now()))
+      {
+        ec_ = asio::error::timed_out;
+        return false;
+      }
+
+      // Try to complete the operation without blocking.
+      if (!socket().native_non_blocking())
+        socket().native_non_blocking(true, ec_);
+      detail::socket_ops::buf bufs[2];
+      for (std::size_t i = 0; i < count; ++i)
+        detail::socket_ops::init_buf(bufs[i],
+            buffers[i].data(), buffers[i].size());
+      detail::signed_size_type bytes = detail::socket_ops::send(
+          socket().native_handle(), bufs, count, 0, ec_);
+
+      // Check if operation succeeded.
+      if (bytes > 0)
+      {
+        std::size_t sent = static_cast<std::size_t>(bytes);
+        for (std::size_t i = 0; i < count && sent > 0; ++i)
+        {
+          std::size_t n = (std::min)(sent, buffers[i].size());
+          buffers[i] += n;
+          sent -= n;
+        }
+        continue;
+      }
+
+      // Operation failed.
+      if (ec_ != asio::error::would_block
+          && ec_ != asio::error::try_again)
+        return false;
+
+      // Wait for socket to become ready.
+      if (detail::socket_ops::poll_write(
+            socket().native_handle(), 0, timeout(), ec_) < 0)
+        return false;
+    }
   }
 
   int timeout() const
@@ -562,7 +769,6 @@ private:
        // && defined(ASIO_USE_BOOST_DATE_TIME_FOR_SOCKET_IOSTREAM)
   }
 
-  enum { putback_max = 8 };
   asio::error_code ec_;
   time_point expiry_time_;
 };
@@ -194,6 +194,89 @@ public:
   {
   }
 
+  /// Apply a profile of socket options to the socket.
+  /**
+   * This function is used to set a bundle of socket options, such as an
+   * asio::ip::tcp_profile, on the socket. Options that are only meaningful
+   * before connecting must be applied to an open, unconnected socket.
+   *
+   * @param profile The profile to be applied.
+   *
+   * @throws asio::system_error Thrown on failure.
+   *
+   * @par Example
+   * @code
+   * asio::ip::tcp::socket socket(io_context);
+   * ...
+   * socket.set_profile(asio::ip::tcp_profile::low_latency());
+   * @endcode
+   */
+  template <typename SocketProfile>
+  void set_profile(const SocketProfile& profile)
+  {
+    asio::error_code ec;
+    profile.apply(*this, 0, ec);
+    asio::detail::throw_error(ec, "set_profile");
+  }
+
+  /// Apply a profile of socket options to the socket.
+  /**
+   * This function is used to set a bundle of socket options, such as an
+   * asio::ip::tcp_profile, on the socket.
+   *
+   * @param profile The profile to be applied.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  template <typename SocketProfile>
+  void set_profile(const SocketProfile& profile, asio::error_code& ec)
+  {
+    profile.apply(*this, 0, ec);
+  }
+
+  /// Change the profile of socket options applied to the socket.
+  /**
+   * This function is used to switch the socket from one bundle of socket
+   * options to another. Only the options whose values differ between the two
+   * profiles are set, so no system calls are made when nothing changes. If
+   * setting an option fails, the options already changed are restored to
+   * their values in @c current.
+   *
+   * @param profile The profile to be applied.
+   *
+   * @param current The profile currently in effect on the socket.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  template <typename SocketProfile>
+  void set_profile(const SocketProfile& profile, const SocketProfile& current)
+  {
+    asio::error_code ec;
+    profile.apply(*this, &current, ec);
+    asio::detail::throw_error(ec, "set_profile");
+  }
+
+  /// Change the profile of socket options applied to the socket.
+  /**
+   * This function is used to switch the socket from one bundle of socket
+   * options to another. Only the options whose values differ between the two
+   * profiles are set, so no system calls are made when nothing changes. If
+   * setting an option fails, the options already changed are restored to
+   * their values in @c current.
+   *
+   * @param profile The profile to be applied.
+   *
+   * @param current The profile currently in effect on the socket.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  template <typename SocketProfile>
+  void set_profile(const SocketProfile& profile,
+      const SocketProfile& current, asio::error_code& ec)
+  {
+    profile.apply(*this, &current, ec);
+  }
+
   /// Send some data on the socket.
   /**
    * This function is used to send data on the stream socket. The function
@@ -310,10 +393,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes sent.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The send operation may not transmit all of the data to the peer.
    * Consider using the @ref async_write function if you need to ensure that all
@@ -367,10 +451,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes sent.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The send operation may not transmit all of the data to the peer.
    * Consider using the @ref async_write function if you need to ensure that all
@@ -528,10 +613,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes received.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The receive operation may not receive all of the requested number of
    * bytes. Consider using the @ref async_read function if you need to ensure
@@ -586,10 +672,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes received.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The receive operation may not receive all of the requested number of
    * bytes. Consider using the @ref async_read function if you need to ensure
@@ -703,10 +790,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes written.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The write operation may not transmit all of the data to the peer.
    * Consider using the @ref async_write function if you need to ensure that all
@@ -820,10 +908,11 @@ public:
    *   const asio::error_code& error, // Result of operation.
    *   std::size_t bytes_transferred           // Number of bytes read.
    * ); @endcode
-   * Regardless of whether the asynchronous operation completes immediately or
-   * not, the handler will not be invoked from within this function. Invocation
-   * of the handler will be performed in a manner equivalent to using
-   * asio::io_context::post().
+   * Unless immediate completion is enabled on the socket, the handler will not
+   * be invoked from within this function, regardless of whether the
+   * asynchronous operation completes immediately or not, and invocation of
+   * the handler will be performed in a manner equivalent to using
+   * asio::io_context::post(). See immediate_completion().
    *
    * @note The read operation may not read all of the requested number of bytes.
    * Consider using the @ref async_read function if you need to ensure that the
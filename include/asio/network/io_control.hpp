@@ -11,18 +11,19 @@ namespace asio {
 namespace detail {
 namespace io_control {
 
-// I/O control command for getting number of bytes available.
-class bytes_readable
+// Helper template for implementing I/O control commands that get a size.
+template <int Name>
+class size_command
 {
 public:
   // Default constructor.
-  bytes_readable()
+  size_command()
     : value_(0)
   {
   }
 
   // Construct with a specific command value.
-  bytes_readable(std::size_t value)
+  size_command(std::size_t value)
     : value_(static_cast<detail::ioctl_arg_type>(value))
   {
   }
@@ -30,7 +31,7 @@ public:
   // Get the name of the IO control command.
   int name() const
   {
-    return static_cast<int>(ASIO_OS_DEF(FIONREAD));
+    return static_cast<int>(Name);
   }
 
   // Set the value of the I/O control command.
@@ -61,6 +62,14 @@ private:
   detail::ioctl_arg_type value_;
 };
 
+// I/O control command for getting number of bytes available.
+typedef size_command<ASIO_OS_DEF(FIONREAD)> bytes_readable;
+
+#if defined(ASIO_OS_DEF_SIOCOUTQNSD)
+// I/O control command for getting number of bytes not yet sent.
+typedef size_command<ASIO_OS_DEF(SIOCOUTQNSD)> bytes_unsent;
+#endif // defined(ASIO_OS_DEF_SIOCOUTQNSD)
+
 } // namespace io_control
 } // namespace detail
 } // namespace asio
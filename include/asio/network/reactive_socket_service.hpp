@@ -247,8 +247,11 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_send_to"));
 
-    start_op(impl, reactor::write_op, p.p, is_continuation, true, false);
+    // Release ownership of the operation first. In immediate completion mode
+    // the handler may run, and free the operation, before start_op() returns.
+    reactor_op* o = p.p;
     p.v = p.p = 0;
+    start_op(impl, reactor::write_op, o, is_continuation, true, false);
   }
 
   // Start an asynchronous wait until data can be sent without blocking.
@@ -331,11 +334,14 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_receive_from"));
 
+    // Release ownership of the operation first. In immediate completion mode
+    // the handler may run, and free the operation, before start_op() returns.
+    reactor_op* o = p.p;
+    p.v = p.p = 0;
     start_op(impl,
         (flags & socket_base::message_out_of_band)
           ? reactor::except_op : reactor::read_op,
-        p.p, is_continuation, true, false);
-    p.v = p.p = 0;
+        o, is_continuation, true, false);
   }
 
   // Wait until data can be received without blocking.
@@ -443,8 +449,11 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_accept"));
 
-    start_accept_op(impl, p.p, is_continuation, peer.is_open());
+    // Release ownership of the operation first. In immediate completion mode
+    // the handler may run, and free the operation, before start_op() returns.
+    reactor_op* o = p.p;
     p.v = p.p = 0;
+    start_accept_op(impl, o, is_continuation, peer.is_open());
   }
 
 #if defined(ASIO_HAS_MOVE)
@@ -468,8 +477,11 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_accept"));
 
-    start_accept_op(impl, p.p, is_continuation, false);
+    // Release ownership of the operation first. In immediate completion mode
+    // the handler may run, and free the operation, before start_op() returns.
+    reactor_op* o = p.p;
     p.v = p.p = 0;
+    start_accept_op(impl, o, is_continuation, false);
   }
 #endif // defined(ASIO_HAS_MOVE)
 
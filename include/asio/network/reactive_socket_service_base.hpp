@@ -139,6 +139,21 @@ public:
     return ec;
   }
 
+  // Gets the immediate completion mode of the socket.
+  bool immediate_completion(const base_implementation_type& impl) const
+  {
+    return (impl.state_ & socket_ops::immediate_completion) != 0;
+  }
+
+  // Sets the immediate completion mode of the socket.
+  void immediate_completion(base_implementation_type& impl, bool mode)
+  {
+    if (mode)
+      impl.state_ |= socket_ops::immediate_completion;
+    else
+      impl.state_ &= ~socket_ops::immediate_completion;
+  }
+
   // Gets the non-blocking mode of the native socket implementation.
   bool native_non_blocking(const base_implementation_type& impl) const
   {
@@ -260,11 +275,14 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_send"));
 
-    start_op(impl, reactor::write_op, p.p, is_continuation, true,
+    // Release ownership of the operation first. In immediate completion mode
+    // the handler may run, and free the operation, before start_op() returns.
+    reactor_op* o = p.p;
+    p.v = p.p = 0;
+    start_op(impl, reactor::write_op, o, is_continuation, true,
         ((impl.state_ & socket_ops::stream_oriented)
           && buffer_sequence_adapter<asio::const_buffer,
             ConstBufferSequence>::all_empty(buffers)));
-    p.v = p.p = 0;
   }
 
   // Start an asynchronous wait until data can be sent without blocking.
@@ -330,15 +348,18 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_receive"));
 
+    // Release ownership of the operation first. In immediate completion mode
+    // the handler may run, and free the operation, before start_op() returns.
+    reactor_op* o = p.p;
+    p.v = p.p = 0;
     start_op(impl,
         (flags & socket_base::message_out_of_band)
           ? reactor::except_op : reactor::read_op,
-        p.p, is_continuation,
+        o, is_continuation,
         (flags & socket_base::message_out_of_band) == 0,
         ((impl.state_ & socket_ops::stream_oriented)
           && buffer_sequence_adapter<asio::mutable_buffer,
             MutableBufferSequence>::all_empty(buffers)));
-    p.v = p.p = 0;
   }
 
   // Wait until data can be received without blocking.
@@ -414,12 +435,15 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_receive_with_flags"));
 
+    // Release ownership of the operation first. In immediate completion mode
+    // the handler may run, and free the operation, before start_op() returns.
+    reactor_op* o = p.p;
+    p.v = p.p = 0;
     start_op(impl,
         (in_flags & socket_base::message_out_of_band)
           ? reactor::except_op : reactor::read_op,
-        p.p, is_continuation,
+        o, is_continuation,
         (in_flags & socket_base::message_out_of_band) == 0, false);
-    p.v = p.p = 0;
   }
 
   // Wait until data can be received without blocking.
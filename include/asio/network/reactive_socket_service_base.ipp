@@ -228,6 +228,15 @@ void reactive_socket_service_base::start_op(
         || socket_ops::set_internal_non_blocking(
           impl.socket_, impl.state_, true, op->ec_))
     {
+      // In immediate completion mode, a speculative attempt that succeeds
+      // hands its handler straight to the scheduler rather than the queue.
+      if (is_non_blocking && (impl.state_ & socket_ops::immediate_completion))
+      {
+        reactor_.start_immediate_op(op_type, impl.socket_,
+            impl.reactor_data_, op, is_continuation);
+        return;
+      }
+
       reactor_.start_op(op_type, impl.socket_,
           impl.reactor_data_, op, is_continuation, is_non_blocking);
       return;
@@ -0,0 +1,178 @@
+#ifndef ASIO_DETAIL_RESOLVER_CACHE_HPP
+#define ASIO_DETAIL_RESOLVER_CACHE_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <map>
+#include <string>
+#include "asio/error/error.hpp"
+#include "asio/ip/basic_resolver_query.hpp"
+#include "asio/ip/basic_resolver_results.hpp"
+#include "asio/detail/base/stdcpp/chrono.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+// These #defines may be overridden at compile time to specify, in seconds, how
+// long successful and unsuccessful host resolutions are remembered. A value of
+// zero disables the corresponding part of the cache. The cache is disabled by
+// default, so that every resolution observes the current state of the name
+// service.
+#if !defined(ASIO_RESOLVER_CACHE_TTL)
+# define ASIO_RESOLVER_CACHE_TTL 0
+#endif // !defined(ASIO_RESOLVER_CACHE_TTL)
+#if !defined(ASIO_RESOLVER_NEGATIVE_CACHE_TTL)
+# define ASIO_RESOLVER_NEGATIVE_CACHE_TTL 0
+#endif // !defined(ASIO_RESOLVER_NEGATIVE_CACHE_TTL)
+
+// This #define may be overridden at compile time to specify the maximum number
+// of queries held in a resolver cache.
+#if !defined(ASIO_RESOLVER_CACHE_MAX_ENTRIES)
+# define ASIO_RESOLVER_CACHE_MAX_ENTRIES 256
+#endif // !defined(ASIO_RESOLVER_CACHE_MAX_ENTRIES)
+
+namespace asio {
+namespace detail {
+
+// Remembers the outcome of recent host resolutions. The cache does not perform
+// any locking of its own; the owning service is responsible for serialising
+// access to it.
+template <typename Protocol>
+class resolver_cache
+  : private noncopyable
+{
+public:
+  // The query type.
+  typedef asio::ip::basic_resolver_query<Protocol> query_type;
+
+  // The results type.
+  typedef asio::ip::basic_resolver_results<Protocol> results_type;
+
+  // Identifies a query. Two queries with the same key produce the same results.
+  class key_type
+  {
+  public:
+    explicit key_type(const query_type& query)
+      : host_name_(query.host_name()),
+        service_name_(query.service_name()),
+        flags_(query.hints().ai_flags),
+        family_(query.hints().ai_family),
+        socktype_(query.hints().ai_socktype),
+        protocol_(query.hints().ai_protocol)
+    {
+    }
+
+    friend bool operator<(const key_type& a, const key_type& b)
+    {
+      if (a.flags_ != b.flags_)
+        return a.flags_ < b.flags_;
+      if (a.family_ != b.family_)
+        return a.family_ < b.family_;
+      if (a.socktype_ != b.socktype_)
+        return a.socktype_ < b.socktype_;
+      if (a.protocol_ != b.protocol_)
+        return a.protocol_ < b.protocol_;
+      if (int c = a.host_name_.compare(b.host_name_))
+        return c < 0;
+      return a.service_name_ < b.service_name_;
+    }
+
+  private:
+    std::string host_name_;
+    std::string service_name_;
+    int flags_;
+    int family_;
+    int socktype_;
+    int protocol_;
+  };
+
+  // Find the unexpired outcome of an earlier resolution. Returns true if one
+  // was found.
+  bool find(const key_type& key, results_type& results,
+      asio::error_code& ec)
+  {
+    typename entry_map::iterator iter = entries_.find(key);
+    if (iter == entries_.end())
+      return false;
+
+    if (iter->second.expiry_ <= clock_type::now())
+    {
+      entries_.erase(iter);
+      return false;
+    }
+
+    results = iter->second.results_;
+    ec = iter->second.ec_;
+    return true;
+  }
+
+  // Record the outcome of a resolution. Only successful resolutions and
+  // definitive failures are recorded.
+  void insert(const key_type& key, const results_type& results,
+      const asio::error_code& ec)
+  {
+    long ttl = 0;
+    if (!ec)
+      ttl = ASIO_RESOLVER_CACHE_TTL;
+    else if (ec == asio::error::host_not_found
+        || ec == asio::error::service_not_found)
+      ttl = ASIO_RESOLVER_NEGATIVE_CACHE_TTL;
+    if (ttl <= 0)
+      return;
+
+    clock_type::time_point now = clock_type::now();
+    if (entries_.size() >= ASIO_RESOLVER_CACHE_MAX_ENTRIES
+        && entries_.find(key) == entries_.end())
+    {
+      purge(now);
+      if (entries_.size() >= ASIO_RESOLVER_CACHE_MAX_ENTRIES)
+        return;
+    }
+
+    entry& e = entries_[key];
+    e.results_ = results;
+    e.ec_ = ec;
+    e.expiry_ = now + asio::chrono::seconds(ttl);
+  }
+
+  // Forget all recorded resolutions.
+  void clear()
+  {
+    entries_.clear();
+  }
+
+private:
+  typedef asio::chrono::steady_clock clock_type;
+
+  struct entry
+  {
+    results_type results_;
+    asio::error_code ec_;
+    clock_type::time_point expiry_;
+  };
+
+  typedef std::map<key_type, entry> entry_map;
+
+  // Remove all expired entries.
+  void purge(clock_type::time_point now)
+  {
+    typename entry_map::iterator iter = entries_.begin();
+    while (iter != entries_.end())
+    {
+      if (iter->second.expiry_ <= now)
+        entries_.erase(iter++);
+      else
+        ++iter;
+    }
+  }
+
+  // The recorded resolutions.
+  entry_map entries_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_RESOLVER_CACHE_HPP
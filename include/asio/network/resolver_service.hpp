@@ -8,9 +8,11 @@
 #include "asio/ip/basic_resolver_query.hpp"
 #include "asio/ip/basic_resolver_results.hpp"
 #include "asio/detail/concurrency_hint.hpp"
+#include "asio/detail/container/op_queue.hpp"
 #include "asio/detail/memory/memory.hpp"
 #include "asio/network/resolve_endpoint_op.hpp"
 #include "asio/network/resolve_query_op.hpp"
+#include "asio/network/resolver_cache.hpp"
 #include "asio/network/resolver_service_base.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -48,6 +50,17 @@ public:
   void shutdown()
   {
     this->base_shutdown();
+
+    op_queue<operation> ops;
+    asio::detail::mutex::scoped_lock lock(resolutions_mutex_);
+    typename resolution_map::iterator iter = resolutions_.begin();
+    for (; iter != resolutions_.end(); ++iter)
+      ops.push(iter->second);
+    resolutions_.clear();
+    cache_.clear();
+    lock.unlock();
+
+    io_context_impl_.abandon_operations(ops);
   }
 
   // Perform any fork-related housekeeping.
@@ -56,18 +69,54 @@ public:
     this->base_notify_fork(fork_ev);
   }
 
+  // Cancel pending asynchronous operations. Operations waiting for a
+  // resolution that is shared with other resolvers are completed immediately,
+  // rather than when that resolution finishes.
+  void cancel(implementation_type& impl)
+  {
+    op_queue<operation> ops;
+    asio::detail::mutex::scoped_lock lock(resolutions_mutex_);
+    typename resolution_map::iterator iter = resolutions_.begin();
+    for (; iter != resolutions_.end(); ++iter)
+    {
+      op_queue<query_op_base> remaining;
+      while (query_op_base* op = iter->second.front())
+      {
+        iter->second.pop();
+        if (!op->cancel_token_.owner_before(impl)
+            && !impl.owner_before(op->cancel_token_))
+        {
+          op->ec_ = asio::error::operation_aborted;
+          ops.push(op);
+        }
+        else
+          remaining.push(op);
+      }
+      iter->second.push(remaining);
+    }
+    resolver_service_base::cancel(impl);
+    lock.unlock();
+
+    io_context_impl_.post_deferred_completions(ops);
+  }
+
   // Resolve a query to a list of entries.
   results_type resolve(implementation_type&, const query_type& query,
       asio::error_code& ec)
   {
-    asio::detail::addrinfo_type* address_info = 0;
+    typename cache_type::key_type key(query);
+    results_type results;
 
-    socket_ops::getaddrinfo(query.host_name().c_str(),
-        query.service_name().c_str(), query.hints(), &address_info, ec);
-    auto_addrinfo auto_address_info(address_info);
+    asio::detail::mutex::scoped_lock lock(resolutions_mutex_);
+    if (cache_.find(key, results, ec))
+      return results;
+    lock.unlock();
 
-    return ec ? results_type() : results_type::create(
-        address_info, query.host_name(), query.service_name());
+    results = do_resolve(query, ec);
+
+    lock.lock();
+    cache_.insert(key, results, ec);
+    return results;
   }
 
   // Asynchronously resolve a query to a list of entries.
@@ -79,12 +128,12 @@ public:
     typedef resolve_query_op<Protocol, Handler> op;
     typename op::ptr p = { asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
-    p.p = new (p.v) op(impl, query, io_context_impl_, handler);
+    p.p = new (p.v) op(impl, handler);
 
     ASIO_HANDLER_CREATION((io_context_impl_.context(),
           *p.p, "resolver", &impl, 0, "async_resolve"));
 
-    start_resolve_op(p.p);
+    start_query_op(query, p.p);
     p.v = p.p = 0;
   }
 
@@ -119,6 +168,157 @@ public:
     start_resolve_op(p.p);
     p.v = p.p = 0;
   }
+
+private:
+  typedef resolver_cache<Protocol> cache_type;
+  typedef resolve_query_op_base<Protocol> query_op_base;
+  typedef std::map<typename cache_type::key_type,
+      op_queue<query_op_base> > resolution_map;
+
+  // Operation run on the work io_context to perform one host resolution on
+  // behalf of all pending operations with the same query.
+  class query_resolution : public operation
+  {
+  public:
+    query_resolution(resolver_service* service, const query_type& query)
+      : operation(&query_resolution::do_complete),
+        service_(service),
+        query_(query)
+    {
+    }
+
+    static void do_complete(void* owner, operation* base,
+        const asio::error_code& /*ec*/,
+        std::size_t /*bytes_transferred*/)
+    {
+      asio::detail::scoped_ptr<query_resolution> r(
+          static_cast<query_resolution*>(base));
+      if (owner)
+        r->service_->complete_resolution(r->query_);
+    }
+
+  private:
+    resolver_service* service_;
+    query_type query_;
+  };
+
+  // Perform a blocking host resolution.
+  results_type do_resolve(const query_type& query, asio::error_code& ec)
+  {
+    asio::detail::addrinfo_type* address_info = 0;
+
+    socket_ops::getaddrinfo(query.host_name().c_str(),
+        query.service_name().c_str(), query.hints(), &address_info, ec);
+    auto_addrinfo auto_address_info(address_info);
+
+    return ec ? results_type() : results_type::create(
+        address_info, query.host_name(), query.service_name());
+  }
+
+  // Start an asynchronous query operation. The operation is completed from the
+  // cache if possible. Otherwise it waits for an identical resolution that is
+  // already in progress, or starts a new one in the background.
+  void start_query_op(const query_type& query, query_op_base* op)
+  {
+    if (!ASIO_CONCURRENCY_HINT_IS_LOCKING(SCHEDULER,
+          io_context_impl_.concurrency_hint()))
+    {
+      op->ec_ = asio::error::operation_not_supported;
+      io_context_impl_.post_immediate_completion(op, false);
+      return;
+    }
+
+    typename cache_type::key_type key(query);
+    asio::detail::scoped_ptr<query_resolution> resolution;
+
+    asio::detail::mutex::scoped_lock lock(resolutions_mutex_);
+    if (cache_.find(key, op->results_, op->ec_))
+    {
+      lock.unlock();
+      io_context_impl_.post_immediate_completion(op, false);
+      return;
+    }
+
+    if (resolutions_.find(key) == resolutions_.end())
+      resolution.reset(new query_resolution(this, query));
+    op_queue<query_op_base>& waiters = resolutions_[key];
+    io_context_impl_.work_started();
+    waiters.push(op);
+    std::size_t concurrency = resolutions_.size();
+    lock.unlock();
+
+    if (resolution.get())
+      start_background_op(resolution.release(), concurrency);
+  }
+
+  // Called on the work io_context to resolve a query and complete all of the
+  // operations waiting for it.
+  void complete_resolution(const query_type& query)
+  {
+    typename cache_type::key_type key(query);
+    op_queue<operation> ops;
+
+    // There is no need to perform the resolution if all of the waiting
+    // operations have been cancelled.
+    asio::detail::mutex::scoped_lock lock(resolutions_mutex_);
+    typename resolution_map::iterator iter = resolutions_.find(key);
+    if (iter == resolutions_.end())
+      return;
+    bool wanted = false;
+    for (query_op_base* op = iter->second.front();
+        op && !wanted; op = op_queue_access::next(op))
+      wanted = !op->cancel_token_.expired();
+    if (wanted)
+    {
+      lock.unlock();
+      asio::error_code ec;
+      results_type results = do_resolve(query, ec);
+      lock.lock();
+
+      cache_.insert(key, results, ec);
+      iter = resolutions_.find(key);
+      if (iter != resolutions_.end())
+        complete_waiters(iter, ec, results, ops);
+    }
+    else
+    {
+      complete_waiters(iter, asio::error::operation_aborted,
+          results_type(), ops);
+    }
+    lock.unlock();
+
+    io_context_impl_.post_deferred_completions(ops);
+  }
+
+  // Hand the outcome of a resolution to the operations waiting for it. Must be
+  // called with the mutex held.
+  void complete_waiters(typename resolution_map::iterator iter,
+      const asio::error_code& ec, const results_type& results,
+      op_queue<operation>& ops)
+  {
+    while (query_op_base* op = iter->second.front())
+    {
+      iter->second.pop();
+      if (op->cancel_token_.expired())
+        op->ec_ = asio::error::operation_aborted;
+      else
+      {
+        op->ec_ = ec;
+        op->results_ = results;
+      }
+      ops.push(op);
+    }
+    resolutions_.erase(iter);
+  }
+
+  // Mutex to protect access to the cache and the resolutions in progress.
+  asio::detail::mutex resolutions_mutex_;
+
+  // The outcome of recent resolutions.
+  cache_type cache_;
+
+  // The resolutions in progress, and the operations waiting for each of them.
+  resolution_map resolutions_;
 };
 
 } // namespace detail
@@ -11,10 +11,16 @@
 #include "asio/network/socket_ops.hpp"
 #include "asio/network/socket_types.hpp"
 #include "asio/detail/base/scoped_ptr.hpp"
-#include "asio/detail/thread/thread.hpp"
+#include "asio/detail/thread/thread_group.hpp"
 
 #include "asio/detail/push_options.hpp"
 
+// This #define may be overridden at compile time to specify the maximum number
+// of threads used to perform blocking host resolution in the background.
+#if !defined(ASIO_RESOLVER_MAX_THREADS)
+# define ASIO_RESOLVER_MAX_THREADS 4
+#endif // !defined(ASIO_RESOLVER_MAX_THREADS)
+
 namespace asio {
 namespace detail {
 
@@ -60,6 +66,10 @@ protected:
   // Helper function to start an asynchronous resolve operation.
   ASIO_DECL void start_resolve_op(resolve_op* op);
 
+  // Helper function to run an operation on the work io_context, starting
+  // enough work threads for the given number of concurrent resolutions.
+  ASIO_DECL void start_background_op(operation* op, std::size_t concurrency);
+
 #if !defined(ASIO_WINDOWS_RUNTIME)
   // Helper class to perform exception-safe cleanup of addrinfo objects.
   class auto_addrinfo
@@ -93,6 +103,10 @@ protected:
   // Start the work thread if it's not already running.
   ASIO_DECL void start_work_thread();
 
+  // Start additional work threads so that the given number of blocking
+  // resolutions can run concurrently, up to ASIO_RESOLVER_MAX_THREADS.
+  ASIO_DECL void start_work_threads(std::size_t concurrency);
+
   // The io_context implementation used to post completions.
   io_context_impl& io_context_impl_;
 
@@ -110,8 +124,11 @@ private:
   asio::executor_work_guard<
       asio::io_context::executor_type> work_;
 
-  // Thread used for running the work io_context's run loop.
-  asio::detail::scoped_ptr<asio::detail::thread> work_thread_;
+  // Threads used for running the work io_context's run loop.
+  asio::detail::thread_group work_threads_;
+
+  // The number of threads in the work thread group.
+  std::size_t num_work_threads_;
 };
 
 } // namespace detail
@@ -26,7 +26,7 @@ resolver_service_base::resolver_service_base(
     work_io_context_impl_(asio::use_service<
         io_context_impl>(*work_io_context_)),
     work_(asio::make_work_guard(*work_io_context_)),
-    work_thread_(0)
+    num_work_threads_(0)
 {
 }
 
@@ -41,11 +41,8 @@ void resolver_service_base::base_shutdown()
   if (work_io_context_.get())
   {
     work_io_context_->stop();
-    if (work_thread_.get())
-    {
-      work_thread_->join();
-      work_thread_.reset();
-    }
+    work_threads_.join();
+    num_work_threads_ = 0;
     work_io_context_.reset();
   }
 }
@@ -53,18 +50,18 @@ void resolver_service_base::base_shutdown()
 void resolver_service_base::base_notify_fork(
     asio::io_context::fork_event fork_ev)
 {
-  if (work_thread_.get())
+  if (num_work_threads_ > 0)
   {
     if (fork_ev == asio::io_context::fork_prepare)
     {
       work_io_context_->stop();
-      work_thread_->join();
+      work_threads_.join();
     }
     else
     {
       work_io_context_->restart();
-      work_thread_.reset(new asio::detail::thread(
-            work_io_context_runner(*work_io_context_)));
+      work_threads_.create_threads(
+          work_io_context_runner(*work_io_context_), num_work_threads_);
     }
   }
 }
@@ -122,13 +119,30 @@ void resolver_service_base::start_resolve_op(resolve_op* op)
   }
 }
 
+void resolver_service_base::start_background_op(
+    operation* op, std::size_t concurrency)
+{
+  start_work_threads(concurrency);
+  work_io_context_impl_.post_immediate_completion(op, false);
+}
+
 void resolver_service_base::start_work_thread()
 {
+  start_work_threads(1);
+}
+
+void resolver_service_base::start_work_threads(std::size_t concurrency)
+{
+  const std::size_t max_threads = ASIO_RESOLVER_MAX_THREADS > 0
+    ? static_cast<std::size_t>(ASIO_RESOLVER_MAX_THREADS) : 1;
+  if (concurrency > max_threads)
+    concurrency = max_threads;
+
   asio::detail::mutex::scoped_lock lock(mutex_);
-  if (!work_thread_.get())
+  while (num_work_threads_ < concurrency)
   {
-    work_thread_.reset(new asio::detail::thread(
-          work_io_context_runner(*work_io_context_)));
+    work_threads_.create_thread(work_io_context_runner(*work_io_context_));
+    ++num_work_threads_;
   }
 }
 
@@ -290,6 +290,57 @@ public:
     ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_RCVLOWAT)>
       receive_low_watermark;
 
+#if defined(ASIO_OS_DEF_SO_BUSY_POLL)
+  /// Socket option for the busy poll timeout of a socket.
+  /**
+   * Implements the SOL_SOCKET/SO_BUSY_POLL socket option. The value is the
+   * number of microseconds for which a blocking receive may busy poll the
+   * device queue for new packets. Raising the value above the system default
+   * requires the CAP_NET_ADMIN capability.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(io_context);
+   * ...
+   * asio::socket_base::busy_poll option(50);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_BUSY_POLL)>
+      busy_poll;
+#endif // defined(ASIO_OS_DEF_SO_BUSY_POLL)
+
+#if defined(ASIO_OS_DEF_SO_INCOMING_CPU)
+  /// Socket option for the CPU on which a socket's packets are processed.
+  /**
+   * Implements the SOL_SOCKET/SO_INCOMING_CPU socket option. Getting the
+   * option returns the CPU that last processed a packet for the socket. Setting
+   * it on a listening socket whose port is shared using SO_REUSEPORT steers
+   * new connections handled on that CPU to the socket.
+   *
+   * @par Examples
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(io_context);
+   * ...
+   * asio::socket_base::incoming_cpu option;
+   * socket.get_option(option);
+   * int cpu = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_INCOMING_CPU)>
+      incoming_cpu;
+#endif // defined(ASIO_OS_DEF_SO_INCOMING_CPU)
+
   /// Socket option to allow the socket to be bound to an address that is
   /// already in use.
   /**
@@ -435,6 +486,27 @@ public:
    */
   typedef asio::detail::io_control::bytes_readable bytes_readable;
 
+#if defined(ASIO_OS_DEF_SIOCOUTQNSD)
+  /// IO control command to get the amount of data in the send queue that has
+  /// not yet been sent.
+  /**
+   * Implements the SIOCOUTQNSD IO control command.
+   *
+   * @par Example
+   * @code
+   * asio::ip::tcp::socket socket(io_context);
+   * ...
+   * asio::socket_base::bytes_unsent command;
+   * socket.io_control(command);
+   * std::size_t bytes_unsent = command.get();
+   * @endcode
+   *
+   * @par Concepts:
+   * IO_Control_Command, Size_IO_Control_Command.
+   */
+  typedef asio::detail::io_control::bytes_unsent bytes_unsent;
+#endif // defined(ASIO_OS_DEF_SIOCOUTQNSD)
+
   /// The maximum length of the queue of pending incoming connections.
   ASIO_STATIC_CONSTANT(int, max_listen_connections
       = ASIO_OS_DEF(SOMAXCONN));
@@ -4,6 +4,7 @@
 #include "asio/detail/config.hpp"
 
 #include "asio/error/error_code.hpp"
+#include "asio/detail/base/stdcpp/cstdint.hpp"
 #include "asio/detail/memory/memory.hpp"
 #include "asio/network/socket_types.hpp"
 
@@ -38,7 +39,11 @@ enum
   datagram_oriented = 32,
 
   // The socket may have been dup()-ed.
-  possible_dup = 64
+  possible_dup = 64,
+
+  // The user wants asynchronous operations that complete immediately to
+  // invoke their handlers inline.
+  immediate_completion = 128
 };
 
 typedef unsigned char state_type;
@@ -159,6 +164,33 @@ ASIO_DECL bool non_blocking_sendto(socket_type s,
     const socket_addr_type* addr, std::size_t addrlen,
     asio::error_code& ec, size_t& bytes_transferred);
 
+#if defined(ASIO_HAS_SENDFILE)
+
+ASIO_DECL bool is_regular_file(int fd, asio::error_code& ec);
+
+ASIO_DECL bool is_pipe(int fd, asio::error_code& ec);
+
+ASIO_DECL signed_size_type sendfile(socket_type s, int fd,
+    uint64_t& offset, size_t size, asio::error_code& ec);
+
+ASIO_DECL size_t sync_sendfile(socket_type s, state_type state, int fd,
+    uint64_t& offset, size_t size, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_sendfile(socket_type s, int fd,
+    uint64_t& offset, size_t size,
+    asio::error_code& ec, size_t& bytes_transferred);
+
+ASIO_DECL signed_size_type splice(socket_type s, int fd,
+    size_t size, asio::error_code& ec);
+
+ASIO_DECL size_t sync_splice(socket_type s, state_type state, int fd,
+    size_t size, asio::error_code& ec);
+
+ASIO_DECL bool non_blocking_splice(socket_type s, int fd, size_t size,
+    asio::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
 ASIO_DECL socket_type socket(int af, int type, int protocol,
     asio::error_code& ec);
 
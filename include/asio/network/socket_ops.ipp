@@ -9,6 +9,12 @@
 #include <cstring>
 #include <cerrno>
 #include <new>
+#if defined(ASIO_HAS_SENDFILE)
+# include <signal.h>
+# include <time.h>
+# include <fcntl.h>
+# include <sys/sendfile.h>
+#endif // defined(ASIO_HAS_SENDFILE)
 #include "asio/detail/base/stdcpp/assert.hpp"
 #include "asio/network/socket_ops.hpp"
 #include "asio/error/error.hpp"
@@ -936,6 +942,250 @@ size_t sync_sendto(socket_type s, state_type state, const buf* bufs,
   }
 }
 
+#if defined(ASIO_HAS_SENDFILE)
+
+bool is_regular_file(int fd, asio::error_code& ec)
+{
+  clear_last_error();
+  struct stat st;
+  if (error_wrapper(::fstat(fd, &st), ec) != 0)
+    return false;
+  ec = asio::error_code();
+  return S_ISREG(st.st_mode);
+}
+
+bool is_pipe(int fd, asio::error_code& ec)
+{
+  clear_last_error();
+  struct stat st;
+  if (error_wrapper(::fstat(fd, &st), ec) != 0)
+    return false;
+  ec = asio::error_code();
+  return S_ISFIFO(st.st_mode);
+}
+
+// There is no MSG_NOSIGNAL for sendfile or splice, so SIGPIPE is blocked for
+// the duration of the call. If the call raises SIGPIPE, the signal is consumed
+// before it is unblocked, unless one was already pending.
+class sigpipe_blocker
+{
+public:
+  sigpipe_blocker()
+  {
+    sigemptyset(&pipe_set_);
+    sigaddset(&pipe_set_, SIGPIPE);
+    ::pthread_sigmask(SIG_BLOCK, &pipe_set_, &old_set_);
+    sigset_t pending_set;
+    sigpending(&pending_set);
+    was_pending_ = sigismember(&pending_set, SIGPIPE) == 1;
+  }
+
+  ~sigpipe_blocker()
+  {
+    ::pthread_sigmask(SIG_SETMASK, &old_set_, 0);
+  }
+
+  void consume(const asio::error_code& ec)
+  {
+    if (ec == asio::error::broken_pipe && !was_pending_
+        && sigismember(&old_set_, SIGPIPE) != 1)
+    {
+      timespec zero = { 0, 0 };
+      while (::sigtimedwait(&pipe_set_, 0, &zero) == -1 && errno == EINTR)
+      {
+      }
+    }
+  }
+
+private:
+  sigset_t pipe_set_;
+  sigset_t old_set_;
+  bool was_pending_;
+};
+
+signed_size_type sendfile(socket_type s, int fd, uint64_t& offset,
+    size_t size, asio::error_code& ec)
+{
+  sigpipe_blocker blocker;
+
+  clear_last_error();
+  off_t off = static_cast<off_t>(offset);
+  signed_size_type result = error_wrapper(
+      ::sendfile(s, fd, &off, size), ec);
+  if (result > 0)
+    offset = static_cast<uint64_t>(off);
+
+  if (result < 0)
+    blocker.consume(ec);
+  else
+    ec = asio::error_code();
+  return result;
+}
+
+signed_size_type splice(socket_type s, int fd,
+    size_t size, asio::error_code& ec)
+{
+  sigpipe_blocker blocker;
+
+  // The pipe side never blocks. Whether the socket side does is determined by
+  // the socket's own non-blocking mode.
+  clear_last_error();
+  signed_size_type result = error_wrapper(::splice(fd, 0, s, 0,
+        size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK), ec);
+
+  if (result < 0)
+    blocker.consume(ec);
+  else
+    ec = asio::error_code();
+  return result;
+}
+
+size_t sync_sendfile(socket_type s, state_type state, int fd,
+    uint64_t& offset, size_t size, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to write 0 bytes to a stream is a no-op.
+  if (size == 0)
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+
+  // Write some data.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type bytes = socket_ops::sendfile(
+        s, fd, offset, size, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+      return bytes;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_write(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_sendfile(socket_type s, int fd,
+    uint64_t& offset, size_t size,
+    asio::error_code& ec, size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Write some data.
+    signed_size_type bytes = socket_ops::sendfile(
+        s, fd, offset, size, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (bytes >= 0)
+    {
+      ec = asio::error_code();
+      bytes_transferred = bytes;
+    }
+    else
+      bytes_transferred = 0;
+
+    return true;
+  }
+}
+
+size_t sync_splice(socket_type s, state_type state, int fd,
+    size_t size, asio::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to write 0 bytes to a stream is a no-op.
+  if (size == 0)
+  {
+    ec = asio::error_code();
+    return 0;
+  }
+
+  // Write some data.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type bytes = socket_ops::splice(s, fd, size, ec);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+      return bytes;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != asio::error::would_block
+          && ec != asio::error::try_again))
+      return 0;
+
+    // Wait for the pipe to have data, then for the socket to become ready.
+    if (socket_ops::poll_read(fd, 0, 0, ec) == 0)
+    {
+      if (socket_ops::poll_read(fd, 0, -1, ec) < 0)
+        return 0;
+    }
+    else if (socket_ops::poll_write(s, 0, -1, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_splice(socket_type s, int fd, size_t size,
+    asio::error_code& ec, size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Write some data.
+    signed_size_type bytes = socket_ops::splice(s, fd, size, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (bytes >= 0)
+    {
+      ec = asio::error_code();
+      bytes_transferred = bytes;
+    }
+    else
+      bytes_transferred = 0;
+
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
 socket_type socket(int af, int type, int protocol,
     asio::error_code& ec)
 {
@@ -36,6 +36,9 @@
 #  include <sys/filio.h>
 #  include <sys/sockio.h>
 # endif
+# if defined(__linux__)
+#  include <linux/sockios.h>
+# endif
 
 #if defined(__VXWORKS__)
 # include <ipcom_sock2.h>
@@ -99,6 +102,9 @@ typedef int signed_size_type;
 # define ASIO_OS_DEF_IPPROTO_ICMPV6 IPPROTO_ICMPV6
 # define ASIO_OS_DEF_FIONBIO FIONBIO
 # define ASIO_OS_DEF_FIONREAD FIONREAD
+# if defined(SIOCOUTQNSD)
+#  define ASIO_OS_DEF_SIOCOUTQNSD SIOCOUTQNSD
+# endif
 # define ASIO_OS_DEF_INADDR_ANY INADDR_ANY
 # define ASIO_OS_DEF_MSG_OOB MSG_OOB
 # define ASIO_OS_DEF_MSG_PEEK MSG_PEEK
@@ -121,6 +127,30 @@ typedef int signed_size_type;
 # define ASIO_OS_DEF_SO_RCVLOWAT SO_RCVLOWAT
 # define ASIO_OS_DEF_SO_REUSEADDR SO_REUSEADDR
 # define ASIO_OS_DEF_TCP_NODELAY TCP_NODELAY
+# if defined(SO_BUSY_POLL)
+#  define ASIO_OS_DEF_SO_BUSY_POLL SO_BUSY_POLL
+# endif
+# if defined(SO_INCOMING_CPU)
+#  define ASIO_OS_DEF_SO_INCOMING_CPU SO_INCOMING_CPU
+# endif
+# if defined(TCP_QUICKACK)
+#  define ASIO_OS_DEF_TCP_QUICKACK TCP_QUICKACK
+# endif
+# if defined(TCP_CORK)
+#  define ASIO_OS_DEF_TCP_CORK TCP_CORK
+# endif
+# if defined(TCP_NOTSENT_LOWAT)
+#  define ASIO_OS_DEF_TCP_NOTSENT_LOWAT TCP_NOTSENT_LOWAT
+# endif
+# if defined(TCP_DEFER_ACCEPT)
+#  define ASIO_OS_DEF_TCP_DEFER_ACCEPT TCP_DEFER_ACCEPT
+# endif
+# if defined(TCP_FASTOPEN)
+#  define ASIO_OS_DEF_TCP_FASTOPEN TCP_FASTOPEN
+# endif
+# if defined(TCP_FASTOPEN_CONNECT)
+#  define ASIO_OS_DEF_TCP_FASTOPEN_CONNECT TCP_FASTOPEN_CONNECT
+# endif
 # define ASIO_OS_DEF_IP_MULTICAST_IF IP_MULTICAST_IF
 # define ASIO_OS_DEF_IP_MULTICAST_TTL IP_MULTICAST_TTL
 # define ASIO_OS_DEF_IP_MULTICAST_LOOP IP_MULTICAST_LOOP
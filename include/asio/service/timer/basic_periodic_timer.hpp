@@ -0,0 +1,242 @@
+#ifndef ASIO_BASIC_PERIODIC_TIMER_HPP
+#define ASIO_BASIC_PERIODIC_TIMER_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <utility>
+#include "asio/service/basic_io_object.hpp"
+#include "asio/error/throw_error.hpp"
+#include "asio/error/error.hpp"
+#include "asio/detail/base/stdcpp/type_traits.hpp"
+#include "asio/service/timer/helper/wait_traits.hpp"
+#include "asio/service/timer/helper/chrono_time_traits.hpp"
+#include "asio/service/timer/deadline_timer_service.hpp"
+
+#define ASIO_SVC_T \
+    detail::deadline_timer_service< \
+      detail::chrono_time_traits<Clock, WaitTraits> >
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Provides a timer that ticks at a fixed period.
+/**
+ * The basic_periodic_timer class template invokes a handler once for each
+ * period, until the timer is cancelled. Tick times are calculated from the
+ * time of the first tick rather than from the time at which each handler ran,
+ * so the ticks do not drift however late the handlers are invoked.
+ *
+ * A single asynchronous operation is created when the timer is started and is
+ * reused for every tick, so that a running periodic timer performs no memory
+ * allocation. This includes ticks that the handler's associated executor
+ * cannot run inline, as the memory for them is kept in the operation.
+ *
+ * The handler must be callable as:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *   std::size_t ticks // Number of periods accounted for by the tick.
+ * ); @endcode
+ * It is invoked with a default-constructed error for each tick. When the timer
+ * is cancelled, or started again, it is invoked one final time with
+ * asio::error::operation_aborted and is then destroyed. If the handler exits
+ * with an exception, or a tick is destroyed without being run, the timer
+ * stops and the handler is destroyed without a final invocation.
+ *
+ * If a tick is invoked after the next tick is due, the missed_tick_policy
+ * determines what happens. With skip_missed_ticks, the timer moves on to the
+ * next tick that is still in the future and the handler's @c ticks argument
+ * reports how many periods were covered. With catch_up_missed_ticks, every
+ * missed tick is delivered, one after the other, and @c ticks is always one.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. Calls to the timer's member functions must not
+ * run concurrently with the handler, for example by using a strand to call
+ * them when the io_context is run from more than one thread. The handler
+ * itself may call cancel() or start().
+ *
+ * @par Example
+ * @code asio::steady_periodic_timer timer(io_context,
+ *     std::chrono::milliseconds(100));
+ * timer.start([](const asio::error_code& error, std::size_t ticks)
+ *     {
+ *       if (!error)
+ *       {
+ *         // Called every 100ms.
+ *       }
+ *     }); @endcode
+ */
+template <typename Clock, typename WaitTraits = asio::wait_traits<Clock>>
+class basic_periodic_timer
+  : ASIO_SVC_ACCESS basic_io_object<ASIO_SVC_T>
+{
+public:
+  /// The type of the executor associated with the object.
+  typedef io_context::executor_type executor_type;
+
+  /// The clock type.
+  typedef Clock clock_type;
+
+  /// The duration type of the clock.
+  typedef typename clock_type::duration duration;
+
+  /// The time point type of the clock.
+  typedef typename clock_type::time_point time_point;
+
+  /// The wait traits type.
+  typedef WaitTraits traits_type;
+
+  /// What to do about ticks that are due before the handler has run.
+  enum missed_tick_policy
+  {
+    /// Resume at the next tick that is in the future.
+    skip_missed_ticks,
+
+    /// Deliver every tick, however late.
+    catch_up_missed_ticks
+  };
+
+  /// Constructor.
+  /**
+   * This constructor creates a timer that is not running.
+   *
+   * @param io_context The io_context object that the timer will use to
+   * dispatch handlers.
+   *
+   * @param period The time between ticks. Must be greater than zero.
+   *
+   * @param policy What to do about ticks that are missed.
+   *
+   * @throws asio::system_error Thrown if the period is not greater than zero.
+   */
+  basic_periodic_timer(asio::io_context& io_context, const duration& period,
+      missed_tick_policy policy = skip_missed_ticks)
+    : basic_io_object<ASIO_SVC_T>(io_context),
+      period_(period),
+      policy_(policy)
+  {
+    if (period <= duration::zero())
+    {
+      asio::detail::throw_error(
+          asio::error::invalid_argument, "period");
+    }
+  }
+
+  /// Move-construct a basic_periodic_timer from another.
+  /**
+   * A running timer keeps running, and its handler continues to be invoked.
+   */
+  basic_periodic_timer(basic_periodic_timer&& other)
+    : basic_io_object<ASIO_SVC_T>(std::move(other)),
+      period_(other.period_),
+      policy_(other.policy_)
+  {
+  }
+
+  /// Move-assign a basic_periodic_timer from another.
+  /**
+   * This timer is cancelled first. If the other timer uses the same io_context
+   * and is running, it continues to run. Otherwise, it is cancelled.
+   */
+  basic_periodic_timer& operator=(basic_periodic_timer&& other)
+  {
+    basic_io_object<ASIO_SVC_T>::operator=(std::move(other));
+    period_ = other.period_;
+    policy_ = other.policy_;
+    return *this;
+  }
+
+  /// Destroys the timer.
+  /**
+   * A running timer is cancelled, as if by calling cancel().
+   */
+  ~basic_periodic_timer()
+  {
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() ASIO_NOEXCEPT
+  {
+    return basic_io_object<ASIO_SVC_T>::get_executor();
+  }
+
+  /// Get the time between ticks.
+  duration period() const
+  {
+    return period_;
+  }
+
+  /// Get the policy for missed ticks.
+  missed_tick_policy policy() const
+  {
+    return policy_;
+  }
+
+  /// Get the time of the next tick.
+  /**
+   * Within the handler, this is the time of the tick that follows the one
+   * being handled.
+   */
+  time_point expiry() const
+  {
+    return this->get_service().expiry(this->get_implementation());
+  }
+
+  /// Start the timer, with the first tick one period from now.
+  /**
+   * If the timer is already running, it is cancelled first.
+   */
+  template <typename TickHandler>
+  void start(TickHandler&& handler)
+  {
+    start(clock_type::now() + period_, static_cast<TickHandler&&>(handler));
+  }
+
+  /// Start the timer, with the first tick at the given time.
+  /**
+   * Later ticks are due at whole periods after @c first_tick. If the timer is
+   * already running, it is cancelled first.
+   */
+  template <typename TickHandler>
+  void start(const time_point& first_tick, TickHandler&& handler)
+  {
+    typename decay<TickHandler>::type h(
+        static_cast<TickHandler&&>(handler));
+    this->get_service().start_periodic(this->get_implementation(),
+        first_tick, period_, policy_ == catch_up_missed_ticks, h);
+  }
+
+  /// Stop the timer.
+  /**
+   * The handler is invoked one final time with the
+   * asio::error::operation_aborted error. If the handler is running when
+   * cancel() is called, no further ticks are delivered once it returns.
+   */
+  void cancel()
+  {
+    asio::error_code ec;
+    this->get_service().cancel(this->get_implementation(), ec);
+    asio::detail::throw_error(ec, "cancel");
+  }
+
+private:
+  // Disallow copying and assignment.
+  basic_periodic_timer(const basic_periodic_timer&) ASIO_DELETED;
+  basic_periodic_timer& operator=(
+      const basic_periodic_timer&) ASIO_DELETED;
+
+  // The time between ticks.
+  duration period_;
+
+  // The policy for missed ticks.
+  missed_tick_policy policy_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#undef ASIO_SVC_T
+
+#endif // ASIO_BASIC_PERIODIC_TIMER_HPP
@@ -0,0 +1,170 @@
+#ifndef ASIO_BASIC_TIMER_GROUP_HPP
+#define ASIO_BASIC_TIMER_GROUP_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/core/io_context.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error/throw_error.hpp"
+#include "asio/error/error.hpp"
+#include "asio/service/timer/helper/wait_traits.hpp"
+#include "asio/service/timer/helper/chrono_time_traits.hpp"
+#include "asio/service/timer/deadline_timer_service.hpp"
+
+#define ASIO_SVC_T \
+    detail::deadline_timer_service< \
+      detail::chrono_time_traits<Clock, WaitTraits> >
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+#if !defined(ASIO_BASIC_WAITABLE_TIMER_FWD_DECL)
+#define ASIO_BASIC_WAITABLE_TIMER_FWD_DECL
+
+// Forward declaration with defaulted arguments.
+template <typename Clock, typename WaitTraits = asio::wait_traits<Clock>>
+class basic_waitable_timer;
+
+#endif // !defined(ASIO_BASIC_WAITABLE_TIMER_FWD_DECL)
+
+/// Provides cancellation and rescheduling of many timers at once.
+/**
+ * The basic_timer_group class template is a handle that timers join using
+ * basic_waitable_timer::join(). Cancelling the group, or setting the expiry
+ * time of all of its members, takes the group's lock once and the timer
+ * queue's lock once, and the cancelled handlers are handed to the io_context
+ * as a single batch. This is much cheaper than cancelling each timer in turn
+ * when, for example, all of the timeouts for a connection must be abandoned.
+ *
+ * Members that start their waits while in the group share one timer queue, so
+ * that the group can be cancelled under one lock regardless of the number of
+ * queues configured by @c ASIO_TIMER_QUEUE_SHARDS.
+ *
+ * A timer leaves its group when it is destroyed, when it calls
+ * basic_waitable_timer::leave_group() or when it joins another group. If the
+ * group is destroyed first, its members are removed from it and are otherwise
+ * unaffected.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: cancel() and size() may be called concurrently with
+ * each other and with operations on the member timers. expires_at() and
+ * expires_after() modify the members' expiry times, and so are unsafe if the
+ * members are used concurrently. The group must not be destroyed while its
+ * members are in use on other threads.
+ *
+ * @par Example
+ * @code asio::steady_timer_group timeouts(io_context);
+ * read_timer.join(timeouts);
+ * write_timer.join(timeouts);
+ * ...
+ * // Abandon all of the connection's timeouts at once.
+ * timeouts.cancel(); @endcode
+ */
+template <typename Clock, typename WaitTraits = asio::wait_traits<Clock>>
+class basic_timer_group
+  : private asio::detail::noncopyable
+{
+public:
+  /// The clock type.
+  typedef Clock clock_type;
+
+  /// The duration type of the clock.
+  typedef typename clock_type::duration duration;
+
+  /// The time point type of the clock.
+  typedef typename clock_type::time_point time_point;
+
+  /// The wait traits type.
+  typedef WaitTraits traits_type;
+
+  /// The type of the timers that may join the group.
+  typedef basic_waitable_timer<Clock, WaitTraits> timer_type;
+
+  /// Constructor.
+  /**
+   * This constructor creates an empty group for timers that use the given
+   * io_context.
+   */
+  explicit basic_timer_group(asio::io_context& io_context)
+    : service_(asio::use_service<ASIO_SVC_T>(io_context))
+  {
+    service_.construct_group(group_);
+  }
+
+  /// Destroys the group, removing all timers from it.
+  ~basic_timer_group()
+  {
+    service_.destroy_group(group_);
+  }
+
+  /// Get the number of timers in the group.
+  std::size_t size()
+  {
+    return service_.group_size(group_);
+  }
+
+  /// Cancel any asynchronous operations that are waiting on the timers in the
+  /// group.
+  /**
+   * The handlers of the cancelled operations are invoked with the
+   * asio::error::operation_aborted error code.
+   *
+   * @return The number of asynchronous operations that were cancelled.
+   */
+  std::size_t cancel()
+  {
+    asio::error_code ec;
+    std::size_t s = service_.cancel_group(group_, ec);
+    asio::detail::throw_error(ec, "cancel");
+    return s;
+  }
+
+  /// Set the expiry time of all timers in the group as an absolute time.
+  /**
+   * Any pending asynchronous waits on the timers are cancelled, as for
+   * basic_waitable_timer::expires_at().
+   *
+   * @return The number of asynchronous operations that were cancelled.
+   */
+  std::size_t expires_at(const time_point& expiry_time)
+  {
+    asio::error_code ec;
+    std::size_t s = service_.expires_at_group(group_, expiry_time, ec);
+    asio::detail::throw_error(ec, "expires_at");
+    return s;
+  }
+
+  /// Set the expiry time of all timers in the group relative to now.
+  /**
+   * Any pending asynchronous waits on the timers are cancelled, as for
+   * basic_waitable_timer::expires_after().
+   *
+   * @return The number of asynchronous operations that were cancelled.
+   */
+  std::size_t expires_after(const duration& expiry_time)
+  {
+    asio::error_code ec;
+    std::size_t s = service_.expires_after_group(group_, expiry_time, ec);
+    asio::detail::throw_error(ec, "expires_after");
+    return s;
+  }
+
+private:
+  friend class basic_waitable_timer<Clock, WaitTraits>;
+
+  // The service that owns the group's timers.
+  ASIO_SVC_T& service_;
+
+  // The group's implementation.
+  typename ASIO_SVC_T::group_type group_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#undef ASIO_SVC_T
+
+#endif // ASIO_BASIC_TIMER_GROUP_HPP
@@ -8,6 +8,7 @@
 #include "asio/error/throw_error.hpp"
 #include "asio/error/error.hpp"
 #include "asio/service/timer/helper/wait_traits.hpp"
+#include "asio/service/timer/basic_timer_group.hpp"
 
 # include <utility>
 
@@ -147,6 +148,28 @@ public:
     return s;
   }
 
+  /// Add the timer to a group.
+  /**
+   * The timer leaves any group that it already belongs to. Its pending
+   * asynchronous waits, if any, are not affected.
+   *
+   * @throws asio::system_error Thrown on failure. The group must have been
+   * created with the same io_context as the timer.
+   */
+  void join(basic_timer_group<Clock, WaitTraits>& group)
+  {
+    asio::error_code ec;
+    this->get_service().join_group(
+        this->get_implementation(), group.group_, ec);
+    asio::detail::throw_error(ec, "join");
+  }
+
+  /// Remove the timer from its group, if any.
+  void leave_group()
+  {
+    this->get_service().leave_group(this->get_implementation());
+  }
+
   /// Perform a blocking wait on the timer.
   void wait()
   {
@@ -6,6 +6,8 @@
 #include "asio/error/error.hpp"
 #include "asio/core/io_context.hpp"
 #include "asio/core/handler/bind_handler.hpp"
+#include "asio/detail/base/mutex.hpp"
+#include "asio/detail/base/stdcpp/atomic_count.hpp"
 #include "asio/detail/thread/fenced_block.hpp"
 #include "asio/detail/memory/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
@@ -14,11 +16,21 @@
 #include "asio/detail/reactor/timeQueue/timer_queue.hpp"
 #include "asio/detail/reactor/timeQueue/timer_queue_ptime.hpp"
 #include "asio/service/timer/helper/timer_scheduler.hpp"
+#include "asio/service/timer/helper/periodic_wait_handler.hpp"
 #include "asio/service/timer/helper/wait_handler.hpp"
 #include "asio/detail/reactor/wait_op.hpp"
 
 #include "asio/detail/push_options.hpp"
 
+#if !defined(ASIO_TIMER_QUEUE_SHARDS)
+// The number of timer queues used for each timer type. This #define may be
+// overridden at compile time to give each thread that starts waits its own
+// queue, so that threads arming and cancelling timers do not contend with one
+// another. It should be at least the number of threads running the
+// io_context.
+# define ASIO_TIMER_QUEUE_SHARDS 1
+#endif // !defined(ASIO_TIMER_QUEUE_SHARDS)
+
 namespace asio {
 namespace detail {
 
@@ -33,6 +45,9 @@ public:
   // The duration type.
   typedef typename Time_Traits::duration_type duration_type;
 
+  struct group_type;
+  class periodic_op;
+
   // The implementation type of the timer. This type is dependent on the
   // underlying implementation of the timer service.
   struct implementation_type
@@ -40,7 +55,80 @@ public:
   {
     time_type expiry;
     bool might_have_pending_waits;
+    std::size_t queue_index;
     typename timer_queue<Time_Traits>::per_timer_data timer_data;
+    group_type* group;
+    implementation_type* group_prev;
+    implementation_type* group_next;
+    periodic_op* periodic;
+  };
+
+  // The base of the operation used by a periodic timer. A single operation is
+  // reused for every tick, so that a running periodic timer does not allocate.
+  // The operation is linked to the timer's implementation until the timer is
+  // stopped.
+  class periodic_op
+    : public wait_op
+  {
+  public:
+    // Whether the timer has stopped, so that no further ticks will occur.
+    bool stopped() const
+    {
+      return impl_ == 0;
+    }
+
+    // Advance the timer to its next expiry time. Returns the number of periods
+    // that the tick accounts for, which is greater than one if missed ticks
+    // are being skipped.
+    std::size_t begin_tick()
+    {
+      return service_->begin_periodic_tick(*this);
+    }
+
+    // Wait for the next tick.
+    void end_tick()
+    {
+      service_->end_periodic_tick(*this);
+    }
+
+    // Unlink the operation from the timer's implementation.
+    void detach()
+    {
+      if (impl_)
+        impl_->periodic = 0;
+      impl_ = 0;
+    }
+
+  protected:
+    periodic_op(func_type func, const duration_type& period, bool catch_up)
+      : wait_op(func),
+        service_(0),
+        impl_(0),
+        period_(period),
+        catch_up_(catch_up)
+    {
+    }
+
+  private:
+    friend class deadline_timer_service;
+
+    deadline_timer_service* service_;
+    implementation_type* impl_;
+    duration_type period_;
+    bool catch_up_;
+  };
+
+  // A group of timers that are cancelled or have their expiry time set
+  // together. Members are linked into an intrusive list that is protected by
+  // the group's mutex.
+  struct group_type
+    : private asio::detail::noncopyable
+  {
+    deadline_timer_service* service;
+    asio::detail::mutex mutex;
+    implementation_type* members;
+    std::size_t size;
+    std::size_t queue_index;
   };
 
   // Constructor.
@@ -52,13 +140,15 @@ public:
   std::cout << "deadline_timer_service" << std::endl;
 #endif
     scheduler_.init_task();
-    scheduler_.add_timer_queue(timer_queue_);
+    for (std::size_t i = 0; i < num_queues; ++i)
+      scheduler_.add_timer_queue(timer_queues_[i]);
   }
 
   // Destructor.
   ~deadline_timer_service()
   {
-    scheduler_.remove_timer_queue(timer_queue_);
+    for (std::size_t i = 0; i < num_queues; ++i)
+      scheduler_.remove_timer_queue(timer_queues_[i]);
   }
 
   // Destroy all user-defined handler objects owned by the service.
@@ -71,11 +161,17 @@ public:
   {
     impl.expiry = time_type();
     impl.might_have_pending_waits = false;
+    impl.queue_index = 0;
+    impl.group = 0;
+    impl.group_prev = 0;
+    impl.group_next = 0;
+    impl.periodic = 0;
   }
 
   // Destroy a timer implementation.
   void destroy(implementation_type& impl)
   {
+    leave_group(impl);
     asio::error_code ec;
     cancel(impl, ec);
   }
@@ -84,13 +180,25 @@ public:
   void move_construct(implementation_type& impl,
       implementation_type& other_impl)
   {
-    scheduler_.move_timer(timer_queue_, impl.timer_data, other_impl.timer_data);
+    scheduler_.move_timer(timer_queues_[other_impl.queue_index],
+        impl.timer_data, other_impl.timer_data);
+    impl.queue_index = other_impl.queue_index;
 
     impl.expiry = other_impl.expiry;
     other_impl.expiry = time_type();
 
     impl.might_have_pending_waits = other_impl.might_have_pending_waits;
     other_impl.might_have_pending_waits = false;
+
+    impl.group = 0;
+    impl.group_prev = 0;
+    impl.group_next = 0;
+    take_group_membership(impl, other_impl);
+
+    impl.periodic = other_impl.periodic;
+    other_impl.periodic = 0;
+    if (impl.periodic)
+      impl.periodic->impl_ = &impl;
   }
 
   // Move-assign from another serial port implementation.
@@ -98,23 +206,51 @@ public:
       deadline_timer_service& other_service,
       implementation_type& other_impl)
   {
-    if (this != &other_service)
+    // A periodic timer is stopped when it is moved to another service, as its
+    // operation rearms itself in its own service's queue.
+    if (impl.periodic)
+      impl.periodic->detach();
+    if (this != &other_service && other_impl.periodic)
+    {
+      asio::error_code ec;
+      other_service.cancel(other_impl, ec);
+    }
+
+    if (this != &other_service || impl.queue_index != other_impl.queue_index)
       if (impl.might_have_pending_waits)
-        scheduler_.cancel_timer(timer_queue_, impl.timer_data);
+        scheduler_.cancel_timer(timer_queues_[impl.queue_index],
+            impl.timer_data);
 
-    other_service.scheduler_.move_timer(other_service.timer_queue_,
+    other_service.scheduler_.move_timer(
+        other_service.timer_queues_[other_impl.queue_index],
         impl.timer_data, other_impl.timer_data);
+    impl.queue_index = other_impl.queue_index;
 
     impl.expiry = other_impl.expiry;
     other_impl.expiry = time_type();
 
     impl.might_have_pending_waits = other_impl.might_have_pending_waits;
     other_impl.might_have_pending_waits = false;
+
+    // A group only holds timers that belong to the group's service.
+    leave_group(impl);
+    if (this == &other_service)
+      take_group_membership(impl, other_impl);
+    else
+      other_service.leave_group(other_impl);
+
+    impl.periodic = other_impl.periodic;
+    other_impl.periodic = 0;
+    if (impl.periodic)
+      impl.periodic->impl_ = &impl;
   }
 
   // Cancel any asynchronous wait operations associated with the timer.
   std::size_t cancel(implementation_type& impl, asio::error_code& ec)
   {
+    if (impl.periodic)
+      impl.periodic->detach();
+
     if (!impl.might_have_pending_waits)
     {
       ec = asio::error_code();
@@ -124,7 +260,8 @@ public:
     ASIO_HANDLER_OPERATION((scheduler_.context(),
           "deadline_timer", &impl, 0, "cancel"));
 
-    std::size_t count = scheduler_.cancel_timer(timer_queue_, impl.timer_data);
+    std::size_t count = scheduler_.cancel_timer(
+        timer_queues_[impl.queue_index], impl.timer_data);
     impl.might_have_pending_waits = false;
     ec = asio::error_code();
     return count;
@@ -144,7 +281,7 @@ public:
           "deadline_timer", &impl, 0, "cancel_one"));
 
     std::size_t count = scheduler_.cancel_timer(
-        timer_queue_, impl.timer_data, 1);
+        timer_queues_[impl.queue_index], impl.timer_data, 1);
     if (count == 0)
       impl.might_have_pending_waits = false;
     ec = asio::error_code();
@@ -218,16 +355,268 @@ public:
       op::ptr::allocate(handler), 0 };
     p.p = new (p.v) op(handler);
 
+    // A timer with no pending waits may move to another queue.
+    if (!impl.might_have_pending_waits)
+      impl.queue_index = select_queue_index(impl);
     impl.might_have_pending_waits = true;
 
     ASIO_HANDLER_CREATION((scheduler_.context(),
           *p.p, "deadline_timer", &impl, 0, "async_wait"));
 
-    scheduler_.schedule_timer(timer_queue_, impl.expiry, impl.timer_data, p.p);
+    scheduler_.schedule_timer(timer_queues_[impl.queue_index],
+        impl.expiry, impl.timer_data, p.p);
     p.v = p.p = 0;
   }
 
+  // Start a periodic timer with its first tick at the given time. Any wait
+  // that is already pending on the timer is cancelled.
+  template <typename Handler>
+  void start_periodic(implementation_type& impl, const time_type& first_tick,
+      const duration_type& period, bool catch_up, Handler& handler)
+  {
+    asio::error_code ec;
+    cancel(impl, ec);
+
+    // Allocate and construct the operation that is used for every tick.
+    typedef periodic_wait_handler<Handler, deadline_timer_service> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(handler, period, catch_up);
+
+    impl.expiry = first_tick;
+    impl.queue_index = select_queue_index(impl);
+    impl.might_have_pending_waits = true;
+    impl.periodic = p.p;
+    p.p->service_ = this;
+    p.p->impl_ = &impl;
+
+    ASIO_HANDLER_CREATION((scheduler_.context(),
+          *p.p, "deadline_timer", &impl, 0, "start_periodic"));
+
+    scheduler_.schedule_timer(timer_queues_[impl.queue_index],
+        impl.expiry, impl.timer_data, p.p);
+    p.v = p.p = 0;
+  }
+
+  // Construct a new timer group.
+  void construct_group(group_type& group)
+  {
+    group.service = this;
+    group.members = 0;
+    group.size = 0;
+    group.queue_index = this_thread_queue_index();
+  }
+
+  // Destroy a timer group. The member timers are removed from the group but
+  // are otherwise unaffected.
+  void destroy_group(group_type& group)
+  {
+    asio::detail::mutex::scoped_lock lock(group.mutex);
+    while (implementation_type* impl = group.members)
+    {
+      group.members = impl->group_next;
+      impl->group = 0;
+      impl->group_prev = 0;
+      impl->group_next = 0;
+    }
+    group.size = 0;
+  }
+
+  // Add a timer to a group, removing it from any group it already belongs to.
+  void join_group(implementation_type& impl,
+      group_type& group, asio::error_code& ec)
+  {
+    if (group.service != this)
+    {
+      ec = asio::error::invalid_argument;
+      return;
+    }
+
+    if (impl.group != &group)
+    {
+      leave_group(impl);
+
+      asio::detail::mutex::scoped_lock lock(group.mutex);
+      impl.group = &group;
+      impl.group_prev = 0;
+      impl.group_next = group.members;
+      if (group.members)
+        group.members->group_prev = &impl;
+      group.members = &impl;
+      ++group.size;
+    }
+
+    ec = asio::error_code();
+  }
+
+  // Remove a timer from its group, if any.
+  void leave_group(implementation_type& impl)
+  {
+    if (group_type* group = impl.group)
+    {
+      asio::detail::mutex::scoped_lock lock(group->mutex);
+      if (group->members == &impl)
+        group->members = impl.group_next;
+      if (impl.group_prev)
+        impl.group_prev->group_next = impl.group_next;
+      if (impl.group_next)
+        impl.group_next->group_prev = impl.group_prev;
+      impl.group = 0;
+      impl.group_prev = 0;
+      impl.group_next = 0;
+      --group->size;
+    }
+  }
+
+  // Get the number of timers in a group.
+  std::size_t group_size(group_type& group)
+  {
+    asio::detail::mutex::scoped_lock lock(group.mutex);
+    return group.size;
+  }
+
+  // Cancel any asynchronous wait operations associated with the timers in a
+  // group.
+  std::size_t cancel_group(group_type& group, asio::error_code& ec)
+  {
+    ASIO_HANDLER_OPERATION((scheduler_.context(),
+          "deadline_timer_group", &group, 0, "cancel"));
+
+    asio::detail::mutex::scoped_lock lock(group.mutex);
+    std::size_t count = cancel_members(group);
+    ec = asio::error_code();
+    return count;
+  }
+
+  // Set the expiry time for all timers in a group as an absolute time.
+  std::size_t expires_at_group(group_type& group,
+      const time_type& expiry_time, asio::error_code& ec)
+  {
+    asio::detail::mutex::scoped_lock lock(group.mutex);
+    for (implementation_type* impl = group.members; impl;
+        impl = impl->group_next)
+      impl->expiry = expiry_time;
+    std::size_t count = cancel_members(group);
+    ec = asio::error_code();
+    return count;
+  }
+
+  // Set the expiry time for all timers in a group relative to now.
+  std::size_t expires_after_group(group_type& group,
+      const duration_type& expiry_time, asio::error_code& ec)
+  {
+    return expires_at_group(group,
+        Time_Traits::add(Time_Traits::now(), expiry_time), ec);
+  }
+
 private:
+  // Advance a periodic timer to the expiry time of its next tick, keeping to
+  // the phase of the first tick. Returns the number of periods that the
+  // current tick accounts for.
+  std::size_t begin_periodic_tick(periodic_op& op)
+  {
+    implementation_type& impl = *op.impl_;
+    std::size_t ticks = 1;
+    time_type next = Time_Traits::add(impl.expiry, op.period_);
+    if (!op.catch_up_)
+    {
+      time_type now = Time_Traits::now();
+      if (!Time_Traits::less_than(now, next))
+      {
+        // Skip every tick that has already been missed.
+        typedef typename duration_type::rep rep;
+        rep missed = Time_Traits::subtract(now, impl.expiry) / op.period_;
+        ticks += static_cast<std::size_t>(missed);
+        next = Time_Traits::add(impl.expiry, op.period_ * (missed + 1));
+      }
+    }
+    impl.expiry = next;
+    return ticks;
+  }
+
+  // Wait for the next tick of a periodic timer.
+  void end_periodic_tick(periodic_op& op)
+  {
+    implementation_type& impl = *op.impl_;
+    scheduler_.schedule_timer(timer_queues_[impl.queue_index],
+        impl.expiry, impl.timer_data, &op);
+  }
+
+  // Replace a timer in its group with a timer that has been moved from it.
+  void take_group_membership(implementation_type& impl,
+      implementation_type& other_impl)
+  {
+    if (group_type* group = other_impl.group)
+    {
+      asio::detail::mutex::scoped_lock lock(group->mutex);
+      impl.group = group;
+      impl.group_prev = other_impl.group_prev;
+      impl.group_next = other_impl.group_next;
+      if (group->members == &other_impl)
+        group->members = &impl;
+      if (impl.group_prev)
+        impl.group_prev->group_next = &impl;
+      if (impl.group_next)
+        impl.group_next->group_prev = &impl;
+      other_impl.group = 0;
+      other_impl.group_prev = 0;
+      other_impl.group_next = 0;
+    }
+  }
+
+  // Cancel the waits of all timers in a group, with one batch of timers for
+  // each queue that the members are using. The group's mutex must be held.
+  std::size_t cancel_members(group_type& group)
+  {
+    typedef typename timer_queue<Time_Traits>::per_timer_data per_timer_data;
+    per_timer_data* batches[num_queues] = { 0 };
+    for (implementation_type* impl = group.members; impl;
+        impl = impl->group_next)
+    {
+      impl->timer_data.set_batch_next(batches[impl->queue_index]);
+      batches[impl->queue_index] = &impl->timer_data;
+    }
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < num_queues; ++i)
+      if (batches[i])
+        count += scheduler_.cancel_timers(timer_queues_[i], batches[i]);
+    return count;
+  }
+
+  // The number of timer queues.
+  static const std::size_t num_queues = ASIO_TIMER_QUEUE_SHARDS;
+
+  // Get the index of the queue for a timer that is starting a wait. This is
+  // the calling thread's queue, or the group's queue for a member of a group
+  // so that the group can be cancelled under one lock.
+  std::size_t select_queue_index(implementation_type& impl)
+  {
+    if (group_type* group = impl.group)
+    {
+      asio::detail::mutex::scoped_lock lock(group->mutex);
+      return group->queue_index;
+    }
+    return this_thread_queue_index();
+  }
+
+  // Get the index of the queue owned by the calling thread. Threads are given
+  // queues in turn the first time they start a wait.
+  static std::size_t this_thread_queue_index()
+  {
+#if ASIO_TIMER_QUEUE_SHARDS > 1
+    static ASIO_THREAD_KEYWORD std::size_t index_plus_one = 0;
+    if (index_plus_one == 0)
+    {
+      static atomic_count next_index(0);
+      index_plus_one = static_cast<std::size_t>(next_index++) % num_queues + 1;
+    }
+    return index_plus_one - 1;
+#else // ASIO_TIMER_QUEUE_SHARDS > 1
+    return 0;
+#endif // ASIO_TIMER_QUEUE_SHARDS > 1
+  }
+
   // Helper function to wait given a duration type. The duration type should
   // either be of type boost::posix_time::time_duration, or implement the
   // required subset of its interface.
@@ -240,8 +629,8 @@ private:
     socket_ops::select(0, 0, 0, 0, &tv, ec);
   }
 
-  // The queue of timers.
-  timer_queue<Time_Traits> timer_queue_;
+  // The queues of timers.
+  timer_queue<Time_Traits> timer_queues_[num_queues];
 
   // The object that schedules and executes timers. Usually a reactor.
   timer_scheduler& scheduler_;
@@ -0,0 +1,152 @@
+#ifndef ASIO_CACHED_STEADY_CLOCK_HPP
+#define ASIO_CACHED_STEADY_CLOCK_HPP
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include <atomic>
+#include "asio/detail/base/stdcpp/chrono.hpp"
+
+#if defined(ASIO_ENABLE_COARSE_CACHED_CLOCK)
+# include <time.h>
+#endif // defined(ASIO_ENABLE_COARSE_CACHED_CLOCK)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A steady clock that returns a cached time.
+/**
+ * The cached_steady_clock class meets the requirements of a steady chrono
+ * clock, and measures time from the same epoch as chrono::steady_clock. Its
+ * time points are chrono::steady_clock time points.
+ *
+ * Calling now() does not read the system clock. It returns the time that was
+ * cached when a reactor last returned from waiting for events, when a thread
+ * last entered io_context::run(), io_context::poll() or similar, or when such a
+ * thread last woke up. Timers that use the clock, such as cached_steady_timer,
+ * compare their expiry times against the cached time, as can handlers that
+ * need a cheap timestamp. The clock is read once per reactor iteration rather
+ * than once per timer operation.
+ *
+ * The cached time lags the true time by up to the duration of the handlers run
+ * since the last refresh. An io_context that has no timers or I/O objects has
+ * no reactor to refresh the cache between handlers. Code that needs an exact
+ * time should use chrono::steady_clock.
+ *
+ * The cache is process-wide rather than per io_context. Every reactor and
+ * scheduler in the process refreshes the same cached time, so an io_context
+ * whose threads are idle still sees the time cached by busier ones.
+ *
+ * Caching begins the first time now() is called. Until then, reactors do not
+ * refresh the cache.
+ *
+ * If @c ASIO_ENABLE_COARSE_CACHED_CLOCK is defined, the cache is refreshed
+ * from @c CLOCK_MONOTONIC_COARSE where it is available. This is cheaper to read
+ * than the steady clock, but has a resolution of only a few milliseconds.
+ */
+class cached_steady_clock
+{
+public:
+  /// The representation type of the clock's durations.
+  typedef chrono::steady_clock::rep rep;
+
+  /// The tick period of the clock.
+  typedef chrono::steady_clock::period period;
+
+  /// The duration type of the clock.
+  typedef chrono::steady_clock::duration duration;
+
+  /// The time point type of the clock.
+  typedef chrono::steady_clock::time_point time_point;
+
+  /// The clock is steady.
+  ASIO_STATIC_CONSTANT(bool, is_steady = true);
+
+  /// Get the cached time.
+  static time_point now() ASIO_NOEXCEPT
+  {
+    rep t = cache().load(std::memory_order_relaxed);
+    if (t == 0)
+      return refresh();
+    return time_point(duration(t));
+  }
+
+  /// Read the clock and update the cached time.
+  /**
+   * The cached time only moves forwards. If another thread has cached a later
+   * time, that time is kept and returned.
+   */
+  static time_point refresh() ASIO_NOEXCEPT
+  {
+#if defined(ASIO_ENABLE_COARSE_CACHED_CLOCK) && defined(CLOCK_MONOTONIC_COARSE)
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    time_point t(chrono::duration_cast<duration>(
+          chrono::seconds(ts.tv_sec) + chrono::nanoseconds(ts.tv_nsec)));
+#else // defined(ASIO_ENABLE_COARSE_CACHED_CLOCK) && ...
+    time_point t(chrono::steady_clock::now());
+#endif // defined(ASIO_ENABLE_COARSE_CACHED_CLOCK) && ...
+
+    // A clock that is never zero ensures the cache is not mistaken for unused.
+    rep r = t.time_since_epoch().count();
+    if (r == 0)
+      r = 1;
+
+    // Threads may refresh the cache concurrently, and a thread that read the
+    // clock earlier may store last. Only store a later time, so that now()
+    // never goes backwards.
+    rep cur = cache().load(std::memory_order_relaxed);
+    while (cur < r && !cache().compare_exchange_weak(
+          cur, r, std::memory_order_relaxed))
+    {
+    }
+    return time_point(duration(cur < r ? r : cur));
+  }
+
+  /// Determine whether the clock is in use, so that the cache is refreshed.
+  static bool in_use() ASIO_NOEXCEPT
+  {
+    return cache().load(std::memory_order_relaxed) != 0;
+  }
+
+private:
+  // The cached time, or zero if the clock has not been used.
+  static std::atomic<rep>& cache() ASIO_NOEXCEPT
+  {
+    static std::atomic<rep> c(0);
+    return c;
+  }
+};
+
+namespace detail {
+
+// Refresh the cached clock if it is in use. Called by the reactors and the
+// scheduler whenever they return from waiting.
+inline void refresh_cached_clock()
+{
+  if (cached_steady_clock::in_use())
+    cached_steady_clock::refresh();
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#else // defined(ASIO_HAS_CHRONO)
+
+namespace asio {
+namespace detail {
+
+inline void refresh_cached_clock()
+{
+}
+
+} // namespace detail
+} // namespace asio
+
+#endif // defined(ASIO_HAS_CHRONO)
+
+#endif // ASIO_CACHED_STEADY_CLOCK_HPP
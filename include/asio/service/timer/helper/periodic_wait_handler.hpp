@@ -0,0 +1,261 @@
+#ifndef ASIO_DETAIL_PERIODIC_WAIT_HANDLER_HPP
+#define ASIO_DETAIL_PERIODIC_WAIT_HANDLER_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/memory/associated_allocator.hpp"
+#include "asio/core/executor/helper/associated_executor.hpp"
+#include "asio/core/handler/bind_handler.hpp"
+#include "asio/core/handler/handler_work.hpp"
+#include "asio/detail/thread/fenced_block.hpp"
+#include "asio/detail/memory/handler_alloc_helpers.hpp"
+#include "asio/detail/memory/memory.hpp"
+#include "asio/error/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// The operation of a periodic timer. Unlike wait_handler, the operation is
+// not destroyed when a tick completes. The handler is invoked in place and
+// the operation then returns itself to the timer queue for the next tick. It
+// is destroyed, and the handler is invoked for the last time, when the timer
+// is stopped.
+template <typename Handler, typename Service>
+class periodic_wait_handler
+  : public Service::periodic_op
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(periodic_wait_handler);
+
+  periodic_wait_handler(Handler& h,
+      const typename Service::duration_type& period, bool catch_up)
+    : Service::periodic_op(&periodic_wait_handler::do_complete,
+        period, catch_up),
+      handler_(ASIO_MOVE_CAST(Handler)(h)),
+      tick_allocations_(0),
+      orphaned_(false)
+  {
+    handler_work<Handler>::start(handler_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    periodic_wait_handler* h(static_cast<periodic_wait_handler*>(base));
+
+    if (owner && !h->ec_)
+    {
+      // Run the tick through the handler's executor, or its invocation hook,
+      // as for any other completion. The work counted here is finished once
+      // the tick has been handed over, leaving the work that lasts for the
+      // lifetime of the operation.
+      handler_work<Handler>::start(h->handler_);
+      handler_work<Handler> w(h->handler_);
+      tick_function f(h);
+      w.complete(f, h->handler_, tick_allocator<void>(h));
+      return;
+    }
+
+    complete(h, owner);
+  }
+
+private:
+  // Runs one tick. The function owns the operation until it is invoked, so
+  // that an operation whose tick is destroyed without running, such as when
+  // an executor is shut down, is destroyed along with it.
+  class tick_function
+  {
+  public:
+    explicit tick_function(periodic_wait_handler* h)
+      : h_(h)
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    tick_function(tick_function&& other)
+      : h_(other.h_)
+    {
+      other.h_ = 0;
+    }
+#else // defined(ASIO_HAS_MOVE)
+    // Without move support, copying transfers ownership.
+    tick_function(const tick_function& other)
+      : h_(other.h_)
+    {
+      const_cast<tick_function&>(other).h_ = 0;
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    ~tick_function()
+    {
+      if (h_)
+        h_->destroy();
+    }
+
+    void operator()()
+    {
+      // The function keeps ownership while the handler runs, so that the
+      // operation is destroyed if the handler exits with an exception. Once
+      // the operation is rearmed it belongs to the timer queue again.
+      periodic_wait_handler* h = h_;
+      bool rearmed = h->tick();
+      h_ = 0;
+      if (!rearmed)
+      {
+        h->ec_ = asio::error::operation_aborted;
+        complete(h, h);
+      }
+    }
+
+  private:
+    tick_function& operator=(const tick_function&);
+
+    periodic_wait_handler* h_;
+  };
+
+  // Provides the memory that an executor needs to run a tick when it cannot
+  // run it inline. Only one tick is outstanding at a time, so the memory is
+  // normally taken from storage in the operation and a running periodic timer
+  // does not allocate. Anything larger is obtained from the handler's
+  // associated allocator.
+  template <typename T>
+  class tick_allocator
+  {
+  public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+      typedef tick_allocator<U> other;
+    };
+
+    explicit tick_allocator(periodic_wait_handler* h)
+      : h_(h)
+    {
+    }
+
+    template <typename U>
+    tick_allocator(const tick_allocator<U>& other)
+      : h_(other.h_)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+      if (h_->tick_allocations_++ == 0
+          && sizeof(T) * n <= sizeof(h_->tick_storage_))
+        return static_cast<T*>(static_cast<void*>(&h_->tick_storage_));
+
+      typedef typename associated_allocator<Handler>::type allocator_type;
+      ASIO_REBIND_ALLOC(allocator_type, T) a(
+          associated_allocator<Handler>::get(h_->handler_));
+      return a.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+      if (static_cast<void*>(p) != static_cast<void*>(&h_->tick_storage_))
+      {
+        typedef typename associated_allocator<Handler>::type allocator_type;
+        ASIO_REBIND_ALLOC(allocator_type, T) a(
+            associated_allocator<Handler>::get(h_->handler_));
+        a.deallocate(p, n);
+      }
+
+      if (--h_->tick_allocations_ == 0 && h_->orphaned_)
+        complete(h_, 0);
+    }
+
+    friend bool operator==(const tick_allocator& a, const tick_allocator& b)
+    {
+      return a.h_ == b.h_;
+    }
+
+    friend bool operator!=(const tick_allocator& a, const tick_allocator& b)
+    {
+      return a.h_ != b.h_;
+    }
+
+  private:
+    template <typename> friend class tick_allocator;
+    periodic_wait_handler* h_;
+  };
+
+  // Invoke the handler for a tick and wait for the next one. Returns false if
+  // the timer was stopped before or during the upcall.
+  bool tick()
+  {
+    if (this->stopped())
+      return false;
+
+    std::size_t ticks = this->begin_tick();
+    fenced_block b(fenced_block::half);
+    handler_(asio::error_code(), ticks);
+    if (this->stopped())
+      return false;
+
+    this->end_tick();
+    return true;
+  }
+
+  // Destroy the operation without an upcall once the executor has released
+  // any memory it obtained for the tick.
+  void destroy()
+  {
+    if (tick_allocations_ == 0)
+      complete(this, 0);
+    else
+      orphaned_ = true;
+  }
+
+  // Destroy the operation, making the final upcall if required.
+  static void complete(periodic_wait_handler* h, void* owner)
+  {
+    // Take ownership of the handler object.
+    ptr p = { asio::detail::addressof(h->handler_), h, h };
+    handler_work<Handler> w(h->handler_);
+    h->detach();
+
+    ASIO_HANDLER_COMPLETION((*h));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(h->handler_, h->ec_, 0);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      w.complete(handler, handler.handler_);
+    }
+  }
+
+  Handler handler_;
+
+  // Storage for the memory used to run a tick, and the number of allocations
+  // made for ticks that are yet to be released.
+  union
+  {
+    void* align_;
+    long double align_ld_;
+    unsigned char data_[8 * sizeof(void*)];
+  } tick_storage_;
+  std::size_t tick_allocations_;
+
+  // Whether the operation is to be destroyed when its tick memory is released.
+  bool orphaned_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_PERIODIC_WAIT_HANDLER_HPP
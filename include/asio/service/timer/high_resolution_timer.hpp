@@ -0,0 +1,41 @@
+#ifndef ASIO_HIGH_RESOLUTION_TIMER_HPP
+#define ASIO_HIGH_RESOLUTION_TIMER_HPP
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include "asio/service/timer/basic_timer_group.hpp"
+#include "asio/service/timer/basic_waitable_timer.hpp"
+#include "asio/detail/base/stdcpp/chrono.hpp"
+
+namespace asio {
+
+/// Typedef for a timer based on the high resolution clock.
+/**
+ * This typedef uses the C++11 @c &lt;chrono&gt; standard library facility, if
+ * available. Otherwise, it may use the Boost.Chrono library. To explicitly
+ * utilise Boost.Chrono, use the basic_waitable_timer template directly:
+ * @code
+ * typedef basic_waitable_timer<
+ *   boost::chrono::high_resolution_clock> timer;
+ * @endcode
+ *
+ * The high resolution clock is an alias of the steady or system clock in
+ * common standard library implementations, and such timers are armed at their
+ * exact expiry time in the same way as steady_timer or system_timer.
+ */
+typedef basic_waitable_timer<
+    chrono::high_resolution_clock>
+  high_resolution_timer;
+
+/// Typedef for a group of timers based on the high resolution clock.
+typedef basic_timer_group<
+    chrono::high_resolution_clock>
+  high_resolution_timer_group;
+
+} // namespace asio
+
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_HIGH_RESOLUTION_TIMER_HPP
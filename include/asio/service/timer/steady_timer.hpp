@@ -5,7 +5,10 @@
 
 #if defined(ASIO_HAS_CHRONO)
 
+#include "asio/service/timer/basic_periodic_timer.hpp"
+#include "asio/service/timer/basic_timer_group.hpp"
 #include "asio/service/timer/basic_waitable_timer.hpp"
+#include "asio/service/timer/helper/cached_steady_clock.hpp"
 #include "asio/detail/base/stdcpp/chrono.hpp"
 
 namespace asio {
@@ -21,6 +24,21 @@ namespace asio {
  */
 typedef basic_waitable_timer<chrono::steady_clock> steady_timer;
 
+/// Typedef for a group of timers based on the steady clock.
+typedef basic_timer_group<chrono::steady_clock> steady_timer_group;
+
+/// Typedef for a periodic timer based on the steady clock.
+typedef basic_periodic_timer<chrono::steady_clock> steady_periodic_timer;
+
+/// Typedef for a timer based on the cached steady clock.
+/**
+ * The timer's expiry times are compared against cached_steady_clock::now(),
+ * which is refreshed once per reactor iteration instead of reading the clock
+ * for each operation. Expiry times set relative to now are measured from the
+ * cached time.
+ */
+typedef basic_waitable_timer<cached_steady_clock> cached_steady_timer;
+
 } // namespace asio
 
 #endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
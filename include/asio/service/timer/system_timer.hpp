@@ -0,0 +1,40 @@
+#ifndef ASIO_SYSTEM_TIMER_HPP
+#define ASIO_SYSTEM_TIMER_HPP
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include "asio/service/timer/basic_periodic_timer.hpp"
+#include "asio/service/timer/basic_timer_group.hpp"
+#include "asio/service/timer/basic_waitable_timer.hpp"
+#include "asio/detail/base/stdcpp/chrono.hpp"
+
+namespace asio {
+
+/// Typedef for a timer based on the system clock.
+/**
+ * This typedef uses the C++11 @c &lt;chrono&gt; standard library facility, if
+ * available. Otherwise, it may use the Boost.Chrono library. To explicitly
+ * utilise Boost.Chrono, use the basic_waitable_timer template directly:
+ * @code
+ * typedef basic_waitable_timer<boost::chrono::system_clock> timer;
+ * @endcode
+ *
+ * Where timerfd is available, the expiry times of system timers are armed
+ * against @c CLOCK_REALTIME, so that a timer set to a wall clock time fires at
+ * that time even if the system clock is changed while it waits.
+ */
+typedef basic_waitable_timer<chrono::system_clock> system_timer;
+
+/// Typedef for a group of timers based on the system clock.
+typedef basic_timer_group<chrono::system_clock> system_timer_group;
+
+/// Typedef for a periodic timer based on the system clock.
+typedef basic_periodic_timer<chrono::system_clock> system_periodic_timer;
+
+} // namespace asio
+
+#endif // defined(ASIO_HAS_CHRONO) || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_SYSTEM_TIMER_HPP
@@ -0,0 +1,532 @@
+#ifndef ASIO_BACKPRESSURE_WRITER_HPP
+#define ASIO_BACKPRESSURE_WRITER_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include "asio/buffer/buffer_sequence_adapter.hpp"
+#include "asio/core/executor/helper/async_result.hpp"
+#include "asio/core/handler/handler_type_requirements.hpp"
+#include "asio/core/io_context.hpp"
+#include "asio/detail/container/op_queue.hpp"
+#include "asio/detail/memory/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error/error.hpp"
+#include "asio/network/basic_stream_socket.hpp"
+#include "asio/network/socket_ops.hpp"
+#include "asio/network/socket_option.hpp"
+#include "asio/service/timer/helper/wait_handler.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Queues messages for a stream socket with bounded memory use.
+/**
+ * The backpressure_writer class owns the queue of outgoing messages for a
+ * stream socket. Messages are written in order, as many at a time as the
+ * socket will accept, using the reactor's write readiness rather than a chain
+ * of async_write calls.
+ *
+ * The number of bytes queued in user space is bounded by a high watermark.
+ * When a new message would take the queue above it, the writer's policy
+ * decides what happens:
+ *
+ * @li @c block_producer: the message is rejected and the producer should wait,
+ * using async_wait_ready, until the queue has drained to the low watermark.
+ *
+ * @li @c drop_oldest: queued messages that have not started to be sent are
+ * discarded, oldest first, to make room. If the message still does not fit,
+ * because the message at the front of the queue has been partly sent, the new
+ * message is discarded instead.
+ *
+ * @li @c disconnect: the socket is closed and the writer fails with
+ * asio::error::no_buffer_space.
+ *
+ * A message larger than the high watermark is always rejected, with the
+ * asio::error::message_size error, so that the high watermark is a bound on
+ * the queue under every policy.
+ *
+ * The data buffered in the kernel can be bounded too, by setting a kernel low
+ * watermark (TCP_NOTSENT_LOWAT). The socket then only reports as writable
+ * while less than that amount of data is unsent, and each write is limited to
+ * the room remaining, so that a slow consumer cannot pin large socket buffers.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. The writer must only be used from the threads
+ * running the socket's io_context, or through a strand.
+ *
+ * @par Example
+ * @code
+ * asio::backpressure_writer<asio::ip::tcp> writer(socket,
+ *     1024 * 1024, 256 * 1024, asio::backpressure_writer<
+ *       asio::ip::tcp>::drop_oldest);
+ * asio::error_code ec;
+ * writer.kernel_low_watermark(16384, ec);
+ * ...
+ * writer.write(msg);
+ * @endcode
+ */
+template <typename Protocol>
+class backpressure_writer
+  : private detail::noncopyable
+{
+public:
+  /// The type of the socket written to.
+  typedef basic_stream_socket<Protocol> socket_type;
+
+  /// What to do when a message would exceed the high watermark.
+  enum overflow_policy
+  {
+    /// Reject the message. The producer should wait for async_wait_ready.
+    block_producer,
+
+    /// Discard the oldest messages that have not started to be sent.
+    drop_oldest,
+
+    /// Close the socket.
+    disconnect
+  };
+
+  /// Construct a writer for the given socket.
+  /**
+   * @param socket The socket to be written to. The socket must remain valid
+   * until the writer is destroyed, and the program must not perform any other
+   * write operations on it.
+   *
+   * @param high_watermark The maximum number of bytes to be queued.
+   *
+   * @param low_watermark The queue size at or below which waiting producers
+   * are resumed.
+   *
+   * @param policy What to do when a message would exceed the high watermark.
+   */
+  backpressure_writer(socket_type& socket, std::size_t high_watermark,
+      std::size_t low_watermark, overflow_policy policy = block_producer)
+    : impl_(new impl(socket, high_watermark,
+          low_watermark < high_watermark ? low_watermark : high_watermark,
+          policy))
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Handlers waiting in async_wait_ready are completed with the
+   * asio::error::operation_aborted error. Queued data that has not been
+   * written is discarded.
+   */
+  ~backpressure_writer()
+  {
+    impl_->shutdown();
+  }
+
+  /// Limit the unsent data buffered in the kernel.
+  /**
+   * This function sets the TCP_NOTSENT_LOWAT option on the socket, and limits
+   * each subsequent write to the room left below it.
+   *
+   * @param bytes The maximum number of unsent bytes to be buffered in the
+   * kernel.
+   *
+   * @param ec Set to indicate what error occurred, if any. Set to
+   * asio::error::operation_not_supported if the platform does not support
+   * the option.
+   */
+  void kernel_low_watermark(std::size_t bytes, asio::error_code& ec)
+  {
+    impl_->set_kernel_low_watermark(bytes, ec);
+  }
+
+  /// Get the number of bytes the kernel will currently accept.
+  /**
+   * @returns The room left below the kernel low watermark, or the high
+   * watermark if no kernel low watermark is set or the amount of unsent data
+   * cannot be determined.
+   */
+  std::size_t kernel_room() const
+  {
+    return impl_->kernel_room();
+  }
+
+  /// Queue a message to be written.
+  /**
+   * An empty message is accepted and not queued, as there is nothing to write.
+   *
+   * @returns @c true if the message was queued. @c false if it was rejected
+   * because it is larger than the high watermark, or under the overflow
+   * policy, or the writer has failed.
+   */
+  bool write(const std::string& msg)
+  {
+    asio::error_code ec;
+    return impl_->write(msg, ec);
+  }
+
+  /// Queue a message to be written.
+  /**
+   * @param msg The message to be written.
+   *
+   * @param ec Set to indicate why the message was not queued, if it was not.
+   * Set to asio::error::message_size if the message is larger than the high
+   * watermark, asio::error::would_block if it was rejected under the
+   * @c block_producer policy, asio::error::no_buffer_space if it was discarded
+   * under the @c drop_oldest policy or the socket was closed under the
+   * @c disconnect policy, or to the error that stopped the writer.
+   *
+   * @returns @c true if the message was queued.
+   */
+  bool write(const std::string& msg, asio::error_code& ec)
+  {
+    return impl_->write(msg, ec);
+  }
+
+  /// Get the number of bytes queued and not yet written.
+  std::size_t queued_bytes() const
+  {
+    return impl_->queued_bytes_;
+  }
+
+  /// Get the number of messages discarded by the @c drop_oldest policy.
+  std::size_t dropped_messages() const
+  {
+    return impl_->dropped_messages_;
+  }
+
+  /// Get the error that stopped the writer, if any.
+  asio::error_code error() const
+  {
+    return impl_->error_;
+  }
+
+  /// Wait until the queue has room for more messages.
+  /**
+   * The handler is called once the queue has drained to the low watermark,
+   * or the writer fails. The function signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function.
+   */
+  template <typename WaitHandler>
+  ASIO_INITFN_RESULT_TYPE(WaitHandler,
+      void (asio::error_code))
+  async_wait_ready(WaitHandler&& handler)
+  {
+    // If you get an error on the following line it means that your handler
+    // does not meet the documented type requirements for a WaitHandler.
+    ASIO_WAIT_HANDLER_CHECK(WaitHandler, handler) type_check;
+
+    async_completion<WaitHandler,
+      void (asio::error_code)> init(handler);
+
+    typedef detail::wait_handler<ASIO_HANDLER_TYPE(
+        WaitHandler, void (asio::error_code))> op;
+    typename op::ptr p = { asio::detail::addressof(init.completion_handler),
+      op::ptr::allocate(init.completion_handler), 0 };
+    p.p = new (p.v) op(init.completion_handler);
+    impl_->add_waiter(p.p);
+    p.v = p.p = 0;
+
+    return init.result.get();
+  }
+
+private:
+  struct impl;
+
+  // Resumes writing when the socket becomes writable.
+  struct write_ready_handler
+  {
+    void operator()(const asio::error_code& ec)
+    {
+      impl_->on_writable(ec);
+    }
+
+    detail::shared_ptr<impl> impl_;
+  };
+
+  struct impl
+    : std::enable_shared_from_this<impl>
+  {
+    impl(socket_type& socket, std::size_t high_watermark,
+        std::size_t low_watermark, overflow_policy policy)
+      : socket_(&socket),
+        scheduler_(asio::use_service<detail::io_context_impl>(
+              socket.get_executor().context())),
+        high_watermark_(high_watermark),
+        low_watermark_(low_watermark),
+        kernel_low_watermark_(0),
+        policy_(policy),
+        queued_bytes_(0),
+        front_offset_(0),
+        dropped_messages_(0),
+        writing_(false)
+    {
+    }
+
+    void set_kernel_low_watermark(std::size_t bytes, asio::error_code& ec)
+    {
+#if defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+      socket_->set_option(detail::socket_option::integer<
+          ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_NOTSENT_LOWAT)>(
+            static_cast<int>(bytes)), ec);
+      if (!ec)
+        kernel_low_watermark_ = bytes;
+#else // defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+      (void)bytes;
+      ec = asio::error::operation_not_supported;
+#endif // defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+    }
+
+    std::size_t kernel_room() const
+    {
+#if defined(ASIO_OS_DEF_SIOCOUTQNSD)
+      if (kernel_low_watermark_ > 0 && socket_)
+      {
+        socket_base::bytes_unsent command;
+        asio::error_code ec;
+        socket_->io_control(command, ec);
+        if (!ec)
+          return command.get() < kernel_low_watermark_
+            ? kernel_low_watermark_ - command.get() : 0;
+      }
+#endif // defined(ASIO_OS_DEF_SIOCOUTQNSD)
+      return high_watermark_;
+    }
+
+    bool write(const std::string& msg, asio::error_code& ec)
+    {
+      if (error_ || !socket_)
+      {
+        ec = socket_ ? error_ : asio::error::operation_aborted;
+        return false;
+      }
+
+      // No policy can make room for a message larger than the whole queue.
+      if (msg.size() > high_watermark_)
+      {
+        ec = asio::error::message_size;
+        return false;
+      }
+
+      if (queued_bytes_ + msg.size() > high_watermark_)
+      {
+        switch (policy_)
+        {
+        case block_producer:
+          ec = asio::error::would_block;
+          return false;
+        case drop_oldest:
+          if (!drop_until_fits(msg.size()))
+          {
+            ++dropped_messages_;
+            ec = asio::error::no_buffer_space;
+            return false;
+          }
+          break;
+        case disconnect:
+        default:
+          {
+            asio::error_code ignored_ec;
+            socket_->close(ignored_ec);
+            fail(asio::error::no_buffer_space);
+            ec = error_;
+          }
+          return false;
+        }
+      }
+
+      // An empty message has nothing to send. Queueing it would leave an
+      // entry at the front of the queue that no write can consume.
+      ec = asio::error_code();
+      if (msg.empty())
+        return true;
+
+      queue_.push_back(msg);
+      queued_bytes_ += msg.size();
+      if (!writing_)
+        flush();
+      if (error_)
+      {
+        ec = error_;
+        return false;
+      }
+      return true;
+    }
+
+    // Discard queued messages, oldest first, until the new message fits. The
+    // front message is kept if part of it has already been sent. Returns
+    // false if the message still does not fit.
+    bool drop_until_fits(std::size_t size)
+    {
+      typename std::deque<std::string>::iterator iter = queue_.begin();
+      if (front_offset_ > 0)
+        ++iter;
+      while (iter != queue_.end() && queued_bytes_ + size > high_watermark_)
+      {
+        queued_bytes_ -= iter->size();
+        iter = queue_.erase(iter);
+        ++dropped_messages_;
+      }
+      return queued_bytes_ + size <= high_watermark_;
+    }
+
+    void add_waiter(detail::wait_op* op)
+    {
+      if (error_ || !socket_ || queued_bytes_ <= low_watermark_)
+      {
+        op->ec_ = socket_ ? error_ : asio::error::operation_aborted;
+        scheduler_.post_immediate_completion(op, false);
+        return;
+      }
+
+      scheduler_.work_started();
+      waiters_.push(op);
+    }
+
+    void notify_waiters(const asio::error_code& ec)
+    {
+      while (detail::wait_op* op = waiters_.front())
+      {
+        waiters_.pop();
+        op->ec_ = ec;
+        scheduler_.post_deferred_completion(op);
+      }
+    }
+
+    void on_writable(const asio::error_code& ec)
+    {
+      writing_ = false;
+      if (!socket_)
+        return;
+      if (ec)
+        fail(ec);
+      else
+        flush();
+    }
+
+    // Write as much of the queue as the socket will accept without blocking,
+    // then wait for the socket to become writable again if data remains.
+    void flush()
+    {
+      asio::error_code ec;
+      if (!socket_->native_non_blocking())
+        socket_->native_non_blocking(true, ec);
+
+      // The kernel's unsent byte count is queried once per flush, and the room
+      // is then reduced by each write.
+      std::size_t room = kernel_room();
+      while (!ec && !queue_.empty() && room > 0)
+      {
+
+        // Gather as many queued messages as fit in the room available.
+        detail::socket_ops::buf bufs[
+          detail::buffer_sequence_adapter_base::max_buffers];
+        std::size_t count = 0;
+        std::size_t total = 0;
+        std::size_t offset = front_offset_;
+        for (typename std::deque<std::string>::iterator iter = queue_.begin();
+            iter != queue_.end() && total < room
+              && count < detail::buffer_sequence_adapter_base::max_buffers;
+            ++iter, offset = 0)
+        {
+          std::size_t size = iter->size() - offset;
+          if (size > room - total)
+            size = room - total;
+          detail::socket_ops::init_buf(bufs[count++],
+              iter->data() + offset, size);
+          total += size;
+        }
+
+        std::size_t bytes = 0;
+        if (!detail::socket_ops::non_blocking_send(socket_->native_handle(),
+              bufs, count, 0, ec, bytes))
+        {
+          // The socket is full. Wait for it to become writable.
+          ec = asio::error_code();
+          break;
+        }
+        if (!ec)
+        {
+          consume(bytes);
+          room -= bytes;
+        }
+      }
+
+      if (ec)
+      {
+        fail(ec);
+        return;
+      }
+
+      if (queued_bytes_ <= low_watermark_)
+        notify_waiters(asio::error_code());
+
+      if (!queue_.empty())
+      {
+        writing_ = true;
+        write_ready_handler handler = { this->shared_from_this() };
+        socket_->async_wait(socket_base::wait_write, handler);
+      }
+    }
+
+    void consume(std::size_t bytes)
+    {
+      queued_bytes_ -= bytes;
+      while (bytes > 0)
+      {
+        std::size_t remaining = queue_.front().size() - front_offset_;
+        if (bytes < remaining)
+        {
+          front_offset_ += bytes;
+          return;
+        }
+        bytes -= remaining;
+        front_offset_ = 0;
+        queue_.pop_front();
+      }
+    }
+
+    void fail(const asio::error_code& ec)
+    {
+      error_ = ec;
+      queue_.clear();
+      queued_bytes_ = 0;
+      front_offset_ = 0;
+      notify_waiters(ec);
+    }
+
+    void shutdown()
+    {
+      socket_ = 0;
+      queue_.clear();
+      queued_bytes_ = 0;
+      notify_waiters(asio::error::operation_aborted);
+    }
+
+    socket_type* socket_;
+    detail::io_context_impl& scheduler_;
+    std::size_t high_watermark_;
+    std::size_t low_watermark_;
+    std::size_t kernel_low_watermark_;
+    overflow_policy policy_;
+    std::deque<std::string> queue_;
+    std::size_t queued_bytes_;
+    std::size_t front_offset_;
+    std::size_t dropped_messages_;
+    bool writing_;
+    asio::error_code error_;
+    detail::op_queue<detail::wait_op> waiters_;
+  };
+
+  detail::shared_ptr<impl> impl_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BACKPRESSURE_WRITER_HPP
@@ -0,0 +1,215 @@
+#ifndef ASIO_CHECKSUM_STREAM_HPP
+#define ASIO_CHECKSUM_STREAM_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/buffer/buffer.hpp"
+#include "asio/buffer/crc32c.hpp"
+#include "asio/core/executor/helper/async_result.hpp"
+#include "asio/detail/base/stdcpp/type_traits.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Adds the first bytes_transferred bytes of a buffer sequence to a checksum.
+template <typename Checksum, typename Iterator>
+void checksum_update(Checksum& checksum, Iterator begin,
+    Iterator end, std::size_t bytes_transferred)
+{
+  for (Iterator iter = begin; iter != end && bytes_transferred > 0; ++iter)
+  {
+    asio::const_buffer b(*iter);
+    std::size_t n = b.size() < bytes_transferred
+      ? b.size() : bytes_transferred;
+    checksum.update(b.data(), n);
+    bytes_transferred -= n;
+  }
+}
+
+template <typename Checksum, typename BufferSequence>
+inline void checksum_update(Checksum& checksum,
+    const BufferSequence& buffers, std::size_t bytes_transferred)
+{
+  detail::checksum_update(checksum, asio::buffer_sequence_begin(buffers),
+      asio::buffer_sequence_end(buffers), bytes_transferred);
+}
+
+} // namespace detail
+
+/// Adds checksums to the data read from and written to a stream.
+/**
+ * The checksum_stream class template is a stream layer that passes reads and
+ * writes through to the next layer unchanged, and adds the bytes actually
+ * transferred in each direction to a running checksum. Data is not copied:
+ * each checksum is updated from the caller's own buffers once the operation
+ * has completed. Since a checksum_stream meets the same stream requirements
+ * as its next layer, it may be stacked with other layers, or used with
+ * composed operations such as async_read and async_write.
+ *
+ * The @c Checksum type must be default constructible and provide a member
+ * function <tt>update(const void* data, std::size_t size)</tt>. The default is
+ * asio::crc32c.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Concepts:
+ * AsyncReadStream, AsyncWriteStream, Stream, SyncReadStream, SyncWriteStream.
+ *
+ * @par Example
+ * @code
+ * asio::checksum_stream<asio::ip::tcp::socket&> stream(socket);
+ * asio::write(stream, asio::buffer(record));
+ * asio::uint32_t crc = stream.write_checksum().value();
+ * stream.write_checksum().reset();
+ * @endcode
+ */
+template <typename Stream, typename Checksum = crc32c>
+class checksum_stream
+  : private noncopyable
+{
+public:
+  /// The type of the next layer.
+  typedef typename remove_reference<Stream>::type next_layer_type;
+
+  /// The type of the lowest layer.
+  typedef typename next_layer_type::lowest_layer_type lowest_layer_type;
+
+  /// The type of the executor associated with the object.
+  typedef typename lowest_layer_type::executor_type executor_type;
+
+  /// The type of the checksums.
+  typedef Checksum checksum_type;
+
+  /// Construct, passing the specified argument to initialise the next layer.
+  template <typename Arg>
+  explicit checksum_stream(Arg& a)
+    : next_layer_(a)
+  {
+  }
+
+  /// Get a reference to the next layer.
+  next_layer_type& next_layer()
+  {
+    return next_layer_;
+  }
+
+  /// Get a reference to the lowest layer.
+  lowest_layer_type& lowest_layer()
+  {
+    return next_layer_.lowest_layer();
+  }
+
+  /// Get a const reference to the lowest layer.
+  const lowest_layer_type& lowest_layer() const
+  {
+    return next_layer_.lowest_layer();
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() ASIO_NOEXCEPT
+  {
+    return next_layer_.lowest_layer().get_executor();
+  }
+
+  /// Get the checksum of the data read so far.
+  checksum_type& read_checksum()
+  {
+    return read_checksum_;
+  }
+
+  /// Get the checksum of the data written so far.
+  checksum_type& write_checksum()
+  {
+    return write_checksum_;
+  }
+
+  /// Close the stream.
+  void close()
+  {
+    next_layer_.close();
+  }
+
+  /// Close the stream.
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    next_layer_.close(ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Write the given data to the stream. Returns the number of bytes written.
+  /// Throws an exception on failure.
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers)
+  {
+    std::size_t bytes_transferred = next_layer_.write_some(buffers);
+    detail::checksum_update(write_checksum_, buffers, bytes_transferred);
+    return bytes_transferred;
+  }
+
+  /// Write the given data to the stream. Returns the number of bytes written,
+  /// or 0 if an error occurred.
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    std::size_t bytes_transferred = next_layer_.write_some(buffers, ec);
+    detail::checksum_update(write_checksum_, buffers, bytes_transferred);
+    return bytes_transferred;
+  }
+
+  /// Start an asynchronous write. The data being written must be valid for the
+  /// lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename WriteHandler>
+  ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_write_some(const ConstBufferSequence& buffers,
+      ASIO_MOVE_ARG(WriteHandler) handler);
+
+  /// Read some data from the stream. Returns the number of bytes read. Throws
+  /// an exception on failure.
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers)
+  {
+    std::size_t bytes_transferred = next_layer_.read_some(buffers);
+    detail::checksum_update(read_checksum_, buffers, bytes_transferred);
+    return bytes_transferred;
+  }
+
+  /// Read some data from the stream. Returns the number of bytes read or 0 if
+  /// an error occurred.
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    std::size_t bytes_transferred = next_layer_.read_some(buffers, ec);
+    detail::checksum_update(read_checksum_, buffers, bytes_transferred);
+    return bytes_transferred;
+  }
+
+  /// Start an asynchronous read. The buffer into which the data will be read
+  /// must be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence, typename ReadHandler>
+  ASIO_INITFN_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_read_some(const MutableBufferSequence& buffers,
+      ASIO_MOVE_ARG(ReadHandler) handler);
+
+private:
+  Stream next_layer_;
+  checksum_type read_checksum_;
+  checksum_type write_checksum_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/transmit/impl/checksum_stream.hpp"
+
+#endif // ASIO_CHECKSUM_STREAM_HPP
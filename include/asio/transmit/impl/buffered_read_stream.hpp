@@ -0,0 +1,441 @@
+#ifndef ASIO_IMPL_BUFFERED_READ_STREAM_HPP
+#define ASIO_IMPL_BUFFERED_READ_STREAM_HPP
+
+#include "asio/detail/memory/associated_allocator.hpp"
+#include "asio/core/executor/helper/associated_executor.hpp"
+#include "asio/core/handler/bind_handler.hpp"
+#include "asio/buffer/consuming_buffers.hpp"
+#include "asio/detail/memory/handler_alloc_helpers.hpp"
+#include "asio/core/handler/handler_cont_helpers.hpp"
+#include "asio/core/handler/handler_invoke_helpers.hpp"
+#include "asio/core/handler/handler_type_requirements.hpp"
+#include "asio/error/throw_error.hpp"
+#include "asio/core/executor/submit/post.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  // The buffers used to read into the caller's buffers and then on into the
+  // free space of an empty internal buffer, with a single scatter operation.
+  typedef prepared_buffers<mutable_buffer,
+    buffer_sequence_adapter_base::max_buffers> read_through_buffers;
+
+  // Prepares a read through an empty internal buffer. Returns the number of
+  // bytes that the caller's buffers can hold.
+  template <typename Iterator>
+  std::size_t prepare_read_through(Iterator begin, Iterator end,
+      buffered_stream_storage& storage, read_through_buffers& result)
+  {
+    std::size_t user_size = 0;
+    for (Iterator iter = begin; iter != end
+        && result.count < read_through_buffers::max_buffers - 1; ++iter)
+    {
+      mutable_buffer b(*iter);
+      if (b.size() > 0)
+      {
+        result.elems[result.count++] = b;
+        user_size += b.size();
+      }
+    }
+
+    storage.resize(storage.capacity());
+    result.elems[result.count++] = storage.data();
+    return user_size;
+  }
+
+  template <typename MutableBufferSequence>
+  inline std::size_t prepare_read_through(
+      const MutableBufferSequence& buffers,
+      buffered_stream_storage& storage, read_through_buffers& result)
+  {
+    return detail::prepare_read_through(
+        asio::buffer_sequence_begin(buffers),
+        asio::buffer_sequence_end(buffers), storage, result);
+  }
+
+  // Keeps any data that was read beyond the caller's buffers. Returns the
+  // number of bytes read into the caller's buffers.
+  inline std::size_t finish_read_through(buffered_stream_storage& storage,
+      std::size_t user_size, std::size_t bytes_transferred)
+  {
+    if (bytes_transferred > user_size)
+    {
+      storage.resize(bytes_transferred - user_size);
+      return user_size;
+    }
+
+    storage.clear();
+    return bytes_transferred;
+  }
+} // namespace detail
+
+template <typename Stream>
+std::size_t buffered_read_stream<Stream>::fill()
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = fill(ec);
+  asio::detail::throw_error(ec, "fill");
+  return bytes_transferred;
+}
+
+template <typename Stream>
+std::size_t buffered_read_stream<Stream>::fill(asio::error_code& ec)
+{
+  std::size_t previous_size = storage_.size();
+  storage_.resize(storage_.capacity());
+  storage_.resize(previous_size + next_layer_.read_some(buffer(
+          storage_.data() + previous_size,
+          storage_.size() - previous_size),
+        ec));
+  return storage_.size() - previous_size;
+}
+
+namespace detail
+{
+  template <typename ReadHandler>
+  class buffered_fill_handler
+  {
+  public:
+    buffered_fill_handler(detail::buffered_stream_storage& storage,
+        std::size_t previous_size, ReadHandler& handler)
+      : storage_(storage),
+        previous_size_(previous_size),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    buffered_fill_handler(const buffered_fill_handler& other)
+      : storage_(other.storage_),
+        previous_size_(other.previous_size_),
+        handler_(other.handler_)
+    {
+    }
+
+    buffered_fill_handler(buffered_fill_handler&& other)
+      : storage_(other.storage_),
+        previous_size_(other.previous_size_),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(const asio::error_code& ec,
+        const std::size_t bytes_transferred)
+    {
+      storage_.resize(previous_size_ + bytes_transferred);
+      handler_(ec, bytes_transferred);
+    }
+
+  //private:
+    detail::buffered_stream_storage& storage_;
+    std::size_t previous_size_;
+    ReadHandler handler_;
+  };
+
+  template <typename ReadHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      buffered_fill_handler<ReadHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename ReadHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      buffered_fill_handler<ReadHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename ReadHandler>
+  inline bool asio_handler_is_continuation(
+      buffered_fill_handler<ReadHandler>* this_handler)
+  {
+    return asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename ReadHandler>
+  inline void asio_handler_invoke(Function& function,
+      buffered_fill_handler<ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename ReadHandler>
+  inline void asio_handler_invoke(const Function& function,
+      buffered_fill_handler<ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename ReadHandler>
+  class buffered_read_through_handler
+  {
+  public:
+    buffered_read_through_handler(detail::buffered_stream_storage& storage,
+        std::size_t user_size, ReadHandler& handler)
+      : storage_(storage),
+        user_size_(user_size),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    buffered_read_through_handler(
+        const buffered_read_through_handler& other)
+      : storage_(other.storage_),
+        user_size_(other.user_size_),
+        handler_(other.handler_)
+    {
+    }
+
+    buffered_read_through_handler(buffered_read_through_handler&& other)
+      : storage_(other.storage_),
+        user_size_(other.user_size_),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(const asio::error_code& ec,
+        const std::size_t bytes_transferred)
+    {
+      handler_(ec, detail::finish_read_through(
+            storage_, user_size_, bytes_transferred));
+    }
+
+  //private:
+    detail::buffered_stream_storage& storage_;
+    std::size_t user_size_;
+    ReadHandler handler_;
+  };
+
+  template <typename ReadHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      buffered_read_through_handler<ReadHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename ReadHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      buffered_read_through_handler<ReadHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename ReadHandler>
+  inline bool asio_handler_is_continuation(
+      buffered_read_through_handler<ReadHandler>* this_handler)
+  {
+    return asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename ReadHandler>
+  inline void asio_handler_invoke(Function& function,
+      buffered_read_through_handler<ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename ReadHandler>
+  inline void asio_handler_invoke(const Function& function,
+      buffered_read_through_handler<ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename ReadHandler, typename Allocator>
+struct associated_allocator<
+    detail::buffered_fill_handler<ReadHandler>, Allocator>
+{
+  typedef typename associated_allocator<ReadHandler, Allocator>::type type;
+
+  static type get(const detail::buffered_fill_handler<ReadHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<ReadHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename ReadHandler, typename Executor>
+struct associated_executor<
+    detail::buffered_fill_handler<ReadHandler>, Executor>
+{
+  typedef typename associated_executor<ReadHandler, Executor>::type type;
+
+  static type get(const detail::buffered_fill_handler<ReadHandler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<ReadHandler, Executor>::get(h.handler_, ex);
+  }
+};
+
+template <typename ReadHandler, typename Allocator>
+struct associated_allocator<
+    detail::buffered_read_through_handler<ReadHandler>, Allocator>
+{
+  typedef typename associated_allocator<ReadHandler, Allocator>::type type;
+
+  static type get(
+      const detail::buffered_read_through_handler<ReadHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<ReadHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename ReadHandler, typename Executor>
+struct associated_executor<
+    detail::buffered_read_through_handler<ReadHandler>, Executor>
+{
+  typedef typename associated_executor<ReadHandler, Executor>::type type;
+
+  static type get(
+      const detail::buffered_read_through_handler<ReadHandler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<ReadHandler, Executor>::get(h.handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename Stream>
+template <typename ReadHandler>
+ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+buffered_read_stream<Stream>::async_fill(
+    ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a ReadHandler.
+  ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+  async_completion<ReadHandler,
+    void (asio::error_code, std::size_t)> init(handler);
+
+  std::size_t previous_size = storage_.size();
+  storage_.resize(storage_.capacity());
+  next_layer_.async_read_some(
+      buffer(
+        storage_.data() + previous_size,
+        storage_.size() - previous_size),
+      detail::buffered_fill_handler<ASIO_HANDLER_TYPE(
+        ReadHandler, void (asio::error_code, std::size_t))>(
+        storage_, previous_size, init.completion_handler));
+
+  return init.result.get();
+}
+
+template <typename Stream>
+template <typename MutableBufferSequence>
+std::size_t buffered_read_stream<Stream>::read_some(
+    const MutableBufferSequence& buffers)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = read_some(buffers, ec);
+  asio::detail::throw_error(ec, "read_some");
+  return bytes_transferred;
+}
+
+template <typename Stream>
+template <typename MutableBufferSequence>
+std::size_t buffered_read_stream<Stream>::read_some(
+    const MutableBufferSequence& buffers, asio::error_code& ec)
+{
+  ec = asio::error_code();
+  if (asio::buffer_size(buffers) == 0)
+    return 0;
+
+  if (!storage_.empty())
+    return this->copy(buffers);
+
+  // Read into the caller's buffers, keeping anything more that has arrived.
+  detail::read_through_buffers bufs;
+  std::size_t user_size = detail::prepare_read_through(buffers, storage_, bufs);
+  return detail::finish_read_through(storage_, user_size,
+      next_layer_.read_some(bufs, ec));
+}
+
+template <typename Stream>
+template <typename MutableBufferSequence, typename ReadHandler>
+ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+buffered_read_stream<Stream>::async_read_some(
+    const MutableBufferSequence& buffers,
+    ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a ReadHandler.
+  ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+  async_completion<ReadHandler,
+    void (asio::error_code, std::size_t)> init(handler);
+
+  if (asio::buffer_size(buffers) == 0 || !storage_.empty())
+  {
+    std::size_t length = this->copy(buffers);
+    asio::post(get_executor(),
+        detail::bind_handler(
+          ASIO_MOVE_CAST(ASIO_HANDLER_TYPE(ReadHandler,
+            void (asio::error_code, std::size_t)))(
+              init.completion_handler), asio::error_code(), length));
+  }
+  else
+  {
+    // Read into the caller's buffers, keeping anything more that arrives.
+    detail::read_through_buffers bufs;
+    std::size_t user_size = detail::prepare_read_through(
+        buffers, storage_, bufs);
+    next_layer_.async_read_some(bufs,
+        detail::buffered_read_through_handler<ASIO_HANDLER_TYPE(
+          ReadHandler, void (asio::error_code, std::size_t))>(
+          storage_, user_size, init.completion_handler));
+  }
+
+  return init.result.get();
+}
+
+template <typename Stream>
+template <typename MutableBufferSequence>
+std::size_t buffered_read_stream<Stream>::peek(
+    const MutableBufferSequence& buffers)
+{
+  if (storage_.empty())
+    this->fill();
+  return this->peek_copy(buffers);
+}
+
+template <typename Stream>
+template <typename MutableBufferSequence>
+std::size_t buffered_read_stream<Stream>::peek(
+    const MutableBufferSequence& buffers, asio::error_code& ec)
+{
+  ec = asio::error_code();
+  if (storage_.empty() && !this->fill(ec))
+    return 0;
+  return this->peek_copy(buffers);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_BUFFERED_READ_STREAM_HPP
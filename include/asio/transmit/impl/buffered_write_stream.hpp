@@ -0,0 +1,492 @@
+#ifndef ASIO_IMPL_BUFFERED_WRITE_STREAM_HPP
+#define ASIO_IMPL_BUFFERED_WRITE_STREAM_HPP
+
+#include "asio/detail/memory/associated_allocator.hpp"
+#include "asio/core/executor/helper/associated_executor.hpp"
+#include "asio/core/handler/bind_handler.hpp"
+#include "asio/buffer/consuming_buffers.hpp"
+#include "asio/detail/memory/handler_alloc_helpers.hpp"
+#include "asio/core/handler/handler_cont_helpers.hpp"
+#include "asio/core/handler/handler_invoke_helpers.hpp"
+#include "asio/core/handler/handler_type_requirements.hpp"
+#include "asio/error/throw_error.hpp"
+#include "asio/core/executor/submit/post.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  // The buffers used to send the buffered data and a write that does not fit
+  // in the internal buffer, with a single gather operation. The sequence is
+  // copied into the send operation, and is kept small so that the operation
+  // still fits in the thread's recycled handler memory.
+  typedef prepared_buffers<const_buffer, 16> write_through_buffers;
+
+  // Prepares a write of the buffered data followed by the caller's data.
+  // Returns the number of bytes of buffered data.
+  template <typename Iterator>
+  std::size_t prepare_write_through(buffered_stream_storage& storage,
+      Iterator begin, Iterator end, write_through_buffers& result)
+  {
+    if (!storage.empty())
+      result.elems[result.count++] = storage.data();
+
+    for (Iterator iter = begin; iter != end
+        && result.count < write_through_buffers::max_buffers; ++iter)
+    {
+      const_buffer b(*iter);
+      if (b.size() > 0)
+        result.elems[result.count++] = b;
+    }
+
+    return storage.size();
+  }
+
+  template <typename ConstBufferSequence>
+  inline std::size_t prepare_write_through(buffered_stream_storage& storage,
+      const ConstBufferSequence& buffers, write_through_buffers& result)
+  {
+    return detail::prepare_write_through(storage,
+        asio::buffer_sequence_begin(buffers),
+        asio::buffer_sequence_end(buffers), result);
+  }
+
+  // Copies as much of the caller's data as will fit into the internal buffer.
+  // Returns the number of bytes copied.
+  template <typename ConstBufferSequence>
+  std::size_t buffered_write_copy(buffered_stream_storage& storage,
+      const ConstBufferSequence& buffers)
+  {
+    std::size_t orig_size = storage.size();
+    std::size_t space_avail = storage.capacity() - orig_size;
+    std::size_t bytes_avail = asio::buffer_size(buffers);
+    std::size_t length = bytes_avail < space_avail ? bytes_avail : space_avail;
+    storage.resize(orig_size + length);
+    return asio::buffer_copy(storage.data() + orig_size, buffers, length);
+  }
+} // namespace detail
+
+template <typename Stream>
+std::size_t buffered_write_stream<Stream>::flush()
+{
+  std::size_t bytes_written = write(next_layer_, storage_.data());
+  storage_.consume(bytes_written);
+  return bytes_written;
+}
+
+template <typename Stream>
+std::size_t buffered_write_stream<Stream>::flush(asio::error_code& ec)
+{
+  std::size_t bytes_written = write(next_layer_,
+      storage_.data(), transfer_all(), ec);
+  storage_.consume(bytes_written);
+  return bytes_written;
+}
+
+namespace detail
+{
+  template <typename WriteHandler>
+  class buffered_flush_handler
+  {
+  public:
+    buffered_flush_handler(detail::buffered_stream_storage& storage,
+        WriteHandler& handler)
+      : storage_(storage),
+        handler_(ASIO_MOVE_CAST(WriteHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    buffered_flush_handler(const buffered_flush_handler& other)
+      : storage_(other.storage_),
+        handler_(other.handler_)
+    {
+    }
+
+    buffered_flush_handler(buffered_flush_handler&& other)
+      : storage_(other.storage_),
+        handler_(ASIO_MOVE_CAST(WriteHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(const asio::error_code& ec,
+        const std::size_t bytes_written)
+    {
+      storage_.consume(bytes_written);
+      handler_(ec, bytes_written);
+    }
+
+  //private:
+    detail::buffered_stream_storage& storage_;
+    WriteHandler handler_;
+  };
+
+  template <typename WriteHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      buffered_flush_handler<WriteHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename WriteHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      buffered_flush_handler<WriteHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename WriteHandler>
+  inline bool asio_handler_is_continuation(
+      buffered_flush_handler<WriteHandler>* this_handler)
+  {
+    return asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename WriteHandler>
+  inline void asio_handler_invoke(Function& function,
+      buffered_flush_handler<WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename WriteHandler>
+  inline void asio_handler_invoke(const Function& function,
+      buffered_flush_handler<WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Stream, typename ConstBufferSequence,
+      typename WriteHandler>
+  class buffered_write_through_op
+  {
+  public:
+    buffered_write_through_op(Stream& next_layer,
+        detail::buffered_stream_storage& storage,
+        const ConstBufferSequence& buffers, WriteHandler& handler)
+      : next_layer_(next_layer),
+        storage_(storage),
+        buffers_(buffers),
+        pending_(0),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(WriteHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    buffered_write_through_op(const buffered_write_through_op& other)
+      : next_layer_(other.next_layer_),
+        storage_(other.storage_),
+        buffers_(other.buffers_),
+        pending_(other.pending_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    buffered_write_through_op(buffered_write_through_op&& other)
+      : next_layer_(other.next_layer_),
+        storage_(other.storage_),
+        buffers_(other.buffers_),
+        pending_(other.pending_),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(WriteHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(const asio::error_code& ec,
+        std::size_t bytes_transferred, int start = 0)
+    {
+      switch (start_ = start)
+      {
+        case 1:
+        for (;;)
+        {
+          {
+            write_through_buffers bufs;
+            pending_ = detail::prepare_write_through(storage_, buffers_, bufs);
+            next_layer_.async_write_some(bufs,
+                ASIO_MOVE_CAST(buffered_write_through_op)(*this));
+          }
+          return; default:
+          if (bytes_transferred < pending_)
+          {
+            // Only some of the buffered data was sent.
+            storage_.consume(bytes_transferred);
+            if (!ec)
+              continue;
+            bytes_transferred = 0;
+          }
+          else
+          {
+            storage_.clear();
+            bytes_transferred -= pending_;
+
+            // If exactly the buffered data was sent, there is now room to
+            // buffer the new data instead.
+            if (bytes_transferred == 0 && !ec)
+              bytes_transferred = detail::buffered_write_copy(
+                  storage_, buffers_);
+          }
+          break;
+        }
+
+        handler_(ec, static_cast<const std::size_t&>(bytes_transferred));
+      }
+    }
+
+  //private:
+    Stream& next_layer_;
+    detail::buffered_stream_storage& storage_;
+    ConstBufferSequence buffers_;
+    std::size_t pending_;
+    int start_;
+    WriteHandler handler_;
+  };
+
+  template <typename Stream, typename ConstBufferSequence,
+      typename WriteHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      buffered_write_through_op<Stream,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename Stream, typename ConstBufferSequence,
+      typename WriteHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      buffered_write_through_op<Stream,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename Stream, typename ConstBufferSequence,
+      typename WriteHandler>
+  inline bool asio_handler_is_continuation(
+      buffered_write_through_op<Stream,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename Stream,
+      typename ConstBufferSequence, typename WriteHandler>
+  inline void asio_handler_invoke(Function& function,
+      buffered_write_through_op<Stream,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename Stream,
+      typename ConstBufferSequence, typename WriteHandler>
+  inline void asio_handler_invoke(const Function& function,
+      buffered_write_through_op<Stream,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename WriteHandler, typename Allocator>
+struct associated_allocator<
+    detail::buffered_flush_handler<WriteHandler>, Allocator>
+{
+  typedef typename associated_allocator<WriteHandler, Allocator>::type type;
+
+  static type get(const detail::buffered_flush_handler<WriteHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<WriteHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename WriteHandler, typename Executor>
+struct associated_executor<
+    detail::buffered_flush_handler<WriteHandler>, Executor>
+{
+  typedef typename associated_executor<WriteHandler, Executor>::type type;
+
+  static type get(const detail::buffered_flush_handler<WriteHandler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<WriteHandler, Executor>::get(h.handler_, ex);
+  }
+};
+
+template <typename Stream, typename ConstBufferSequence,
+    typename WriteHandler, typename Allocator>
+struct associated_allocator<
+    detail::buffered_write_through_op<Stream,
+      ConstBufferSequence, WriteHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<WriteHandler, Allocator>::type type;
+
+  static type get(
+      const detail::buffered_write_through_op<Stream,
+        ConstBufferSequence, WriteHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<WriteHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Stream, typename ConstBufferSequence,
+    typename WriteHandler, typename Executor>
+struct associated_executor<
+    detail::buffered_write_through_op<Stream,
+      ConstBufferSequence, WriteHandler>,
+    Executor>
+{
+  typedef typename associated_executor<WriteHandler, Executor>::type type;
+
+  static type get(
+      const detail::buffered_write_through_op<Stream,
+        ConstBufferSequence, WriteHandler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<WriteHandler, Executor>::get(h.handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename Stream>
+template <typename WriteHandler>
+ASIO_INITFN_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+buffered_write_stream<Stream>::async_flush(
+    ASIO_MOVE_ARG(WriteHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a WriteHandler.
+  ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+  async_completion<WriteHandler,
+    void (asio::error_code, std::size_t)> init(handler);
+
+  async_write(next_layer_, storage_.data(),
+      detail::buffered_flush_handler<ASIO_HANDLER_TYPE(
+        WriteHandler, void (asio::error_code, std::size_t))>(
+        storage_, init.completion_handler));
+
+  return init.result.get();
+}
+
+template <typename Stream>
+template <typename ConstBufferSequence>
+std::size_t buffered_write_stream<Stream>::write_some(
+    const ConstBufferSequence& buffers)
+{
+  asio::error_code ec;
+  std::size_t bytes_written = write_some(buffers, ec);
+  asio::detail::throw_error(ec, "write_some");
+  return bytes_written;
+}
+
+template <typename Stream>
+template <typename ConstBufferSequence>
+std::size_t buffered_write_stream<Stream>::write_some(
+    const ConstBufferSequence& buffers, asio::error_code& ec)
+{
+  ec = asio::error_code();
+  std::size_t length = asio::buffer_size(buffers);
+  if (length == 0 || storage_.size() + length <= storage_.capacity())
+    return this->copy(buffers);
+
+  // Send the buffered data and the new data together.
+  for (;;)
+  {
+    detail::write_through_buffers bufs;
+    std::size_t pending = detail::prepare_write_through(storage_, buffers, bufs);
+    std::size_t bytes_transferred = next_layer_.write_some(bufs, ec);
+    if (bytes_transferred < pending)
+    {
+      // Only some of the buffered data was sent.
+      storage_.consume(bytes_transferred);
+      if (ec)
+        return 0;
+      continue;
+    }
+
+    storage_.clear();
+    bytes_transferred -= pending;
+
+    // If exactly the buffered data was sent, there is now room to buffer the
+    // new data instead.
+    if (bytes_transferred == 0 && !ec)
+      return this->copy(buffers);
+    return bytes_transferred;
+  }
+}
+
+template <typename Stream>
+template <typename ConstBufferSequence, typename WriteHandler>
+ASIO_INITFN_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+buffered_write_stream<Stream>::async_write_some(
+    const ConstBufferSequence& buffers,
+    ASIO_MOVE_ARG(WriteHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a WriteHandler.
+  ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+  async_completion<WriteHandler,
+    void (asio::error_code, std::size_t)> init(handler);
+
+  std::size_t length = asio::buffer_size(buffers);
+  if (length == 0 || storage_.size() + length <= storage_.capacity())
+  {
+    std::size_t bytes_copied = this->copy(buffers);
+    asio::post(get_executor(),
+        detail::bind_handler(
+          ASIO_MOVE_CAST(ASIO_HANDLER_TYPE(WriteHandler,
+            void (asio::error_code, std::size_t)))(
+              init.completion_handler), asio::error_code(), bytes_copied));
+  }
+  else
+  {
+    // Send the buffered data and the new data together.
+    detail::buffered_write_through_op<next_layer_type, ConstBufferSequence,
+      ASIO_HANDLER_TYPE(WriteHandler, void (asio::error_code, std::size_t))>(
+        next_layer_, storage_, buffers, init.completion_handler)(
+          asio::error_code(), 0, 1);
+  }
+
+  return init.result.get();
+}
+
+template <typename Stream>
+template <typename ConstBufferSequence>
+std::size_t buffered_write_stream<Stream>::copy(
+    const ConstBufferSequence& buffers)
+{
+  return detail::buffered_write_copy(storage_, buffers);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_BUFFERED_WRITE_STREAM_HPP
@@ -0,0 +1,191 @@
+#ifndef ASIO_IMPL_CHECKSUM_STREAM_HPP
+#define ASIO_IMPL_CHECKSUM_STREAM_HPP
+
+#include "asio/detail/memory/associated_allocator.hpp"
+#include "asio/core/executor/helper/associated_executor.hpp"
+#include "asio/detail/memory/handler_alloc_helpers.hpp"
+#include "asio/core/handler/handler_cont_helpers.hpp"
+#include "asio/core/handler/handler_invoke_helpers.hpp"
+#include "asio/core/handler/handler_type_requirements.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  // Adds the bytes transferred by a read or write to a checksum, and then
+  // passes the result on to the handler.
+  template <typename Checksum, typename BufferSequence, typename Handler>
+  class checksum_op
+  {
+  public:
+    checksum_op(Checksum& checksum,
+        const BufferSequence& buffers, Handler& handler)
+      : checksum_(checksum),
+        buffers_(buffers),
+        handler_(ASIO_MOVE_CAST(Handler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    checksum_op(const checksum_op& other)
+      : checksum_(other.checksum_),
+        buffers_(other.buffers_),
+        handler_(other.handler_)
+    {
+    }
+
+    checksum_op(checksum_op&& other)
+      : checksum_(other.checksum_),
+        buffers_(other.buffers_),
+        handler_(ASIO_MOVE_CAST(Handler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(const asio::error_code& ec,
+        const std::size_t bytes_transferred)
+    {
+      detail::checksum_update(checksum_, buffers_, bytes_transferred);
+      handler_(ec, bytes_transferred);
+    }
+
+  //private:
+    Checksum& checksum_;
+    BufferSequence buffers_;
+    Handler handler_;
+  };
+
+  template <typename Checksum, typename BufferSequence, typename Handler>
+  inline void* asio_handler_allocate(std::size_t size,
+      checksum_op<Checksum, BufferSequence, Handler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename Checksum, typename BufferSequence, typename Handler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      checksum_op<Checksum, BufferSequence, Handler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename Checksum, typename BufferSequence, typename Handler>
+  inline bool asio_handler_is_continuation(
+      checksum_op<Checksum, BufferSequence, Handler>* this_handler)
+  {
+    return asio_handler_cont_helpers::is_continuation(
+        this_handler->handler_);
+  }
+
+  template <typename Function, typename Checksum,
+      typename BufferSequence, typename Handler>
+  inline void asio_handler_invoke(Function& function,
+      checksum_op<Checksum, BufferSequence, Handler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename Checksum,
+      typename BufferSequence, typename Handler>
+  inline void asio_handler_invoke(const Function& function,
+      checksum_op<Checksum, BufferSequence, Handler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename Checksum, typename BufferSequence,
+    typename Handler, typename Allocator>
+struct associated_allocator<
+    detail::checksum_op<Checksum, BufferSequence, Handler>,
+    Allocator>
+{
+  typedef typename associated_allocator<Handler, Allocator>::type type;
+
+  static type get(
+      const detail::checksum_op<Checksum, BufferSequence, Handler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<Handler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Checksum, typename BufferSequence,
+    typename Handler, typename Executor>
+struct associated_executor<
+    detail::checksum_op<Checksum, BufferSequence, Handler>,
+    Executor>
+{
+  typedef typename associated_executor<Handler, Executor>::type type;
+
+  static type get(
+      const detail::checksum_op<Checksum, BufferSequence, Handler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<Handler, Executor>::get(h.handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename Stream, typename Checksum>
+template <typename ConstBufferSequence, typename WriteHandler>
+ASIO_INITFN_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+checksum_stream<Stream, Checksum>::async_write_some(
+    const ConstBufferSequence& buffers,
+    ASIO_MOVE_ARG(WriteHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a WriteHandler.
+  ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+  async_completion<WriteHandler,
+    void (asio::error_code, std::size_t)> init(handler);
+
+  next_layer_.async_write_some(buffers,
+      detail::checksum_op<Checksum, ConstBufferSequence,
+        ASIO_HANDLER_TYPE(WriteHandler,
+          void (asio::error_code, std::size_t))>(
+            write_checksum_, buffers, init.completion_handler));
+
+  return init.result.get();
+}
+
+template <typename Stream, typename Checksum>
+template <typename MutableBufferSequence, typename ReadHandler>
+ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+checksum_stream<Stream, Checksum>::async_read_some(
+    const MutableBufferSequence& buffers,
+    ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a ReadHandler.
+  ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+  async_completion<ReadHandler,
+    void (asio::error_code, std::size_t)> init(handler);
+
+  next_layer_.async_read_some(buffers,
+      detail::checksum_op<Checksum, MutableBufferSequence,
+        ASIO_HANDLER_TYPE(ReadHandler,
+          void (asio::error_code, std::size_t))>(
+            read_checksum_, buffers, init.completion_handler));
+
+  return init.result.get();
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_CHECKSUM_STREAM_HPP
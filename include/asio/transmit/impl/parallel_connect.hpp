@@ -0,0 +1,412 @@
+#ifndef ASIO_IMPL_PARALLEL_CONNECT_HPP
+#define ASIO_IMPL_PARALLEL_CONNECT_HPP
+
+#include <deque>
+#include <vector>
+#include "asio/detail/memory/associated_allocator.hpp"
+#include "asio/core/executor/helper/associated_executor.hpp"
+#include "asio/core/handler/bind_handler.hpp"
+#include "asio/detail/memory/handler_alloc_helpers.hpp"
+#include "asio/core/handler/handler_cont_helpers.hpp"
+#include "asio/core/handler/handler_invoke_helpers.hpp"
+#include "asio/core/handler/handler_type_requirements.hpp"
+#include "asio/detail/base/mutex.hpp"
+#include "asio/detail/memory/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error/error.hpp"
+#include "asio/core/executor/submit/post.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  template <typename Protocol, typename RangeConnectHandler>
+  class parallel_connect_handler;
+
+  // The state shared by all of the connection attempts and the attempt timer
+  // of a single async_connect_parallel operation.
+  template <typename Protocol, typename RangeConnectHandler>
+  class parallel_connect_op
+    : public parallel_connect_op_base,
+      private noncopyable
+  {
+  public:
+    typedef typename Protocol::endpoint endpoint_type;
+    typedef typename Protocol::socket socket_type;
+    typedef parallel_connect_handler<Protocol,
+        RangeConnectHandler> handler_type;
+    typedef shared_ptr<parallel_connect_op> ptr;
+
+    template <typename EndpointSequence>
+    parallel_connect_op(basic_socket<Protocol>& sock,
+        const EndpointSequence& endpoints,
+        const steady_timer::duration& attempt_delay,
+        RangeConnectHandler& handler)
+      : socket_(sock),
+        timer_(sock.get_executor().context()),
+        attempt_delay_(attempt_delay),
+        next_(0),
+        pending_(0),
+        done_(false),
+        cancelled_(false),
+        winner_(0),
+        last_ec_(asio::error::not_found),
+        handler_(ASIO_MOVE_CAST(RangeConnectHandler)(handler))
+    {
+      // Alternate address families, starting with the family of the first
+      // endpoint, as recommended by RFC 8305.
+      std::vector<endpoint_type> others;
+      typename EndpointSequence::const_iterator iter = endpoints.begin();
+      typename EndpointSequence::const_iterator end = endpoints.end();
+      for (; iter != end; ++iter)
+      {
+        endpoint_type e = *iter;
+        if (endpoints_.empty()
+            || e.protocol().family() == endpoints_[0].protocol().family())
+          endpoints_.push_back(e);
+        else
+          others.push_back(e);
+      }
+      for (std::size_t i = 0; i < others.size(); ++i)
+      {
+        std::size_t pos = 2 * i + 1;
+        if (pos > endpoints_.size())
+          pos = endpoints_.size();
+        endpoints_.insert(endpoints_.begin() + pos, others[i]);
+      }
+    }
+
+    // Start the first connection attempt.
+    static void start(const ptr& self)
+    {
+      asio::error_code ec;
+      self->socket_.close(ec);
+
+      asio::detail::mutex::scoped_lock lock(self->mutex_);
+      self->start_next_attempt(self);
+      if (self->pending_ == 0)
+      {
+        ec = self->last_ec_;
+        lock.unlock();
+
+        asio::post(self->socket_.get_executor(),
+            detail::bind_handler(
+              ASIO_MOVE_CAST(RangeConnectHandler)(self->handler_),
+              ec, endpoint_type()));
+      }
+    }
+
+    // Called when the connection attempt to the endpoint at the given index has
+    // completed.
+    static void attempt_complete(const ptr& self,
+        std::size_t index, const asio::error_code& ec)
+    {
+      asio::detail::mutex::scoped_lock lock(self->mutex_);
+      --self->pending_;
+      asio::error_code ignored_ec;
+      if (self->done_)
+      {
+        if (index != self->winner_)
+          self->sockets_[index].close(ignored_ec);
+      }
+      else if (!ec)
+      {
+        // This attempt wins. Abandon all of the others.
+        self->done_ = true;
+        self->winner_ = index;
+        self->timer_.cancel();
+        for (std::size_t i = 0; i < self->sockets_.size(); ++i)
+          if (i != index)
+            self->sockets_[i].close(ignored_ec);
+      }
+      else
+      {
+        self->last_ec_ = ec;
+        self->sockets_[index].close(ignored_ec);
+        self->start_next_attempt(self);
+      }
+      self->complete_if_finished(lock);
+    }
+
+    // Called when the attempt timer armed after starting the attempt at the
+    // given index has expired or been cancelled.
+    static void timer_expired(const ptr& self,
+        std::size_t index, const asio::error_code& ec)
+    {
+      asio::detail::mutex::scoped_lock lock(self->mutex_);
+      --self->pending_;
+
+      // Only start a new attempt if no other attempt has been started since
+      // this wait was initiated.
+      if (!self->done_ && !ec && index + 1 == self->next_)
+        self->start_next_attempt(self);
+      self->complete_if_finished(lock);
+    }
+
+    // Abandon all of the attempts, including one that has already won.
+    virtual void cancel()
+    {
+      asio::detail::mutex::scoped_lock lock(mutex_);
+      if (pending_ == 0 || cancelled_)
+        return;
+
+      cancelled_ = true;
+      done_ = true;
+      asio::error_code ignored_ec;
+      timer_.cancel();
+      for (std::size_t i = 0; i < sockets_.size(); ++i)
+        sockets_[i].close(ignored_ec);
+    }
+
+  //private:
+    // Start connection attempts until one is in progress, or until no
+    // endpoints remain. Must be called with the mutex held.
+    void start_next_attempt(const ptr& self)
+    {
+      while (next_ < endpoints_.size())
+      {
+        std::size_t index = next_++;
+        sockets_.push_back(socket_type(socket_.get_executor().context()));
+
+        asio::error_code ec;
+        sockets_.back().open(endpoints_[index].protocol(), ec);
+        if (ec)
+        {
+          last_ec_ = ec;
+          continue;
+        }
+
+        ++pending_;
+        sockets_.back().async_connect(endpoints_[index],
+            handler_type(self, index, false));
+
+        if (next_ < endpoints_.size())
+        {
+          ++pending_;
+          timer_.expires_after(attempt_delay_);
+          timer_.async_wait(handler_type(self, index, true));
+        }
+        return;
+      }
+    }
+
+    // Deliver the result once no attempts or waits remain outstanding.
+    void complete_if_finished(asio::detail::mutex::scoped_lock& lock)
+    {
+      if (pending_ != 0)
+        return;
+
+      asio::error_code ec;
+      endpoint_type endpoint;
+      if (cancelled_)
+        ec = asio::error::operation_aborted;
+      else if (done_)
+      {
+        socket_ = ASIO_MOVE_CAST(socket_type)(sockets_[winner_]);
+        endpoint = endpoints_[winner_];
+      }
+      else
+        ec = last_ec_;
+      sockets_.clear();
+      lock.unlock();
+
+      handler_(static_cast<const asio::error_code&>(ec),
+          static_cast<const endpoint_type&>(endpoint));
+    }
+
+    asio::detail::mutex mutex_;
+    basic_socket<Protocol>& socket_;
+    std::vector<endpoint_type> endpoints_;
+    std::deque<socket_type> sockets_;
+    steady_timer timer_;
+    steady_timer::duration attempt_delay_;
+    std::size_t next_;
+    std::size_t pending_;
+    bool done_;
+    bool cancelled_;
+    std::size_t winner_;
+    asio::error_code last_ec_;
+    RangeConnectHandler handler_;
+  };
+
+  // The handler used for the connection attempts and the attempt timer.
+  template <typename Protocol, typename RangeConnectHandler>
+  class parallel_connect_handler
+  {
+  public:
+    typedef parallel_connect_op<Protocol, RangeConnectHandler> op_type;
+
+    parallel_connect_handler(const typename op_type::ptr& op,
+        std::size_t index, bool timer)
+      : op_(op),
+        index_(index),
+        timer_(timer)
+    {
+    }
+
+    void operator()(const asio::error_code& ec)
+    {
+      if (timer_)
+        op_type::timer_expired(op_, index_, ec);
+      else
+        op_type::attempt_complete(op_, index_, ec);
+    }
+
+  //private:
+    typename op_type::ptr op_;
+    std::size_t index_;
+    bool timer_;
+  };
+
+  template <typename Protocol, typename RangeConnectHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      parallel_connect_handler<Protocol, RangeConnectHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->op_->handler_);
+  }
+
+  template <typename Protocol, typename RangeConnectHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      parallel_connect_handler<Protocol, RangeConnectHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->op_->handler_);
+  }
+
+  template <typename Protocol, typename RangeConnectHandler>
+  inline bool asio_handler_is_continuation(
+      parallel_connect_handler<Protocol, RangeConnectHandler>* this_handler)
+  {
+    return asio_handler_cont_helpers::is_continuation(
+        this_handler->op_->handler_);
+  }
+
+  template <typename Function, typename Protocol, typename RangeConnectHandler>
+  inline void asio_handler_invoke(Function& function,
+      parallel_connect_handler<Protocol, RangeConnectHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->op_->handler_);
+  }
+
+  template <typename Function, typename Protocol, typename RangeConnectHandler>
+  inline void asio_handler_invoke(const Function& function,
+      parallel_connect_handler<Protocol, RangeConnectHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->op_->handler_);
+  }
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename Protocol, typename RangeConnectHandler, typename Allocator>
+struct associated_allocator<
+    detail::parallel_connect_handler<Protocol, RangeConnectHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<
+      RangeConnectHandler, Allocator>::type type;
+
+  static type get(
+      const detail::parallel_connect_handler<Protocol,
+        RangeConnectHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<RangeConnectHandler,
+        Allocator>::get(h.op_->handler_, a);
+  }
+};
+
+template <typename Protocol, typename RangeConnectHandler, typename Executor>
+struct associated_executor<
+    detail::parallel_connect_handler<Protocol, RangeConnectHandler>,
+    Executor>
+{
+  typedef typename associated_executor<
+      RangeConnectHandler, Executor>::type type;
+
+  static type get(
+      const detail::parallel_connect_handler<Protocol,
+        RangeConnectHandler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<RangeConnectHandler,
+        Executor>::get(h.op_->handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename Protocol,
+    typename EndpointSequence, typename RangeConnectHandler>
+inline ASIO_INITFN_RESULT_TYPE(RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint))
+async_connect_parallel(basic_socket<Protocol>& s,
+    const EndpointSequence& endpoints,
+    const steady_timer::duration& attempt_delay,
+    parallel_connect_canceller& canceller,
+    ASIO_MOVE_ARG(RangeConnectHandler) handler,
+    typename enable_if<is_endpoint_sequence<
+        EndpointSequence>::value>::type*)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a RangeConnectHandler.
+  ASIO_RANGE_CONNECT_HANDLER_CHECK(
+      RangeConnectHandler, handler, typename Protocol::endpoint) type_check;
+
+  async_completion<RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint)>
+      init(handler);
+
+  typedef detail::parallel_connect_op<Protocol,
+    ASIO_HANDLER_TYPE(RangeConnectHandler,
+      void (asio::error_code, typename Protocol::endpoint))> op;
+
+  typename op::ptr o(new op(s, endpoints,
+        attempt_delay, init.completion_handler));
+  canceller.attach(o);
+  op::start(o);
+
+  return init.result.get();
+}
+
+template <typename Protocol,
+    typename EndpointSequence, typename RangeConnectHandler>
+inline ASIO_INITFN_RESULT_TYPE(RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint))
+async_connect_parallel(basic_socket<Protocol>& s,
+    const EndpointSequence& endpoints,
+    const steady_timer::duration& attempt_delay,
+    ASIO_MOVE_ARG(RangeConnectHandler) handler,
+    typename enable_if<is_endpoint_sequence<
+        EndpointSequence>::value>::type*)
+{
+  parallel_connect_canceller canceller;
+  return async_connect_parallel(s, endpoints, attempt_delay, canceller,
+      ASIO_MOVE_CAST(RangeConnectHandler)(handler));
+}
+
+template <typename Protocol,
+    typename EndpointSequence, typename RangeConnectHandler>
+inline ASIO_INITFN_RESULT_TYPE(RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint))
+async_connect_parallel(basic_socket<Protocol>& s,
+    const EndpointSequence& endpoints,
+    ASIO_MOVE_ARG(RangeConnectHandler) handler,
+    typename enable_if<is_endpoint_sequence<
+        EndpointSequence>::value>::type*)
+{
+  return async_connect_parallel(s, endpoints,
+      asio::chrono::milliseconds(250),
+      ASIO_MOVE_CAST(RangeConnectHandler)(handler));
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_PARALLEL_CONNECT_HPP
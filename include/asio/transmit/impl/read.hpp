@@ -11,6 +11,7 @@
 #include "asio/core/handler/bind_handler.hpp"
 #include "asio/buffer/consuming_buffers.hpp"
 #include "asio/transmit/dependent_type.hpp"
+#include "asio/transmit/read_size.hpp"
 #include "asio/detail/memory/handler_alloc_helpers.hpp"
 #include "asio/core/handler/handler_cont_helpers.hpp"
 #include "asio/core/handler/handler_invoke_helpers.hpp"
@@ -109,19 +110,17 @@ std::size_t read(SyncReadStream& s,
   std::size_t total_transferred = 0;
   std::size_t max_size = detail::adapt_completion_condition_result(
         completion_condition(ec, total_transferred));
-  std::size_t bytes_available = std::min<std::size_t>(
-        std::max<std::size_t>(512, b.capacity() - b.size()),
-        std::min<std::size_t>(max_size, b.max_size() - b.size()));
+  std::size_t bytes_available = detail::read_size(s, b, max_size, true);
   while (bytes_available > 0)
   {
     std::size_t bytes_transferred = s.read_some(b.prepare(bytes_available), ec);
     b.commit(bytes_transferred);
+    detail::read_size_record(b, bytes_transferred);
     total_transferred += bytes_transferred;
     max_size = detail::adapt_completion_condition_result(
           completion_condition(ec, total_transferred));
-    bytes_available = std::min<std::size_t>(
-          std::max<std::size_t>(512, b.capacity() - b.size()),
-          std::min<std::size_t>(max_size, b.max_size() - b.size()));
+    bytes_available = max_size > 0
+      ? detail::read_size(s, b, max_size, true) : 0;
   }
   return total_transferred;
 }
@@ -217,6 +216,9 @@ namespace detail
     : detail::base_from_completion_cond<CompletionCondition>
   {
   public:
+    typedef asio::detail::consuming_buffers<mutable_buffer,
+        MutableBufferSequence, MutableBufferIterator> buffers_type;
+
     read_op(AsyncReadStream& stream, const MutableBufferSequence& buffers,
         CompletionCondition completion_condition, ReadHandler& handler)
       : detail::base_from_completion_cond<
@@ -241,7 +243,7 @@ namespace detail
     read_op(read_op&& other)
       : detail::base_from_completion_cond<CompletionCondition>(other),
         stream_(other.stream_),
-        buffers_(other.buffers_),
+        buffers_(static_cast<buffers_type&&>(other.buffers_)),
         start_(other.start_),
         handler_(static_cast<ReadHandler&&>(other.handler_))
     {
@@ -273,8 +275,7 @@ namespace detail
 
   //private:
     AsyncReadStream& stream_;
-    asio::detail::consuming_buffers<mutable_buffer,
-        MutableBufferSequence, MutableBufferIterator> buffers_;
+    buffers_type buffers_;
     int start_;
     ReadHandler handler_;
   };
@@ -492,11 +493,7 @@ namespace detail
       {
         case 1:
         max_size = this->check_for_completion(ec, total_transferred_);
-        bytes_available = std::min<std::size_t>(
-              std::max<std::size_t>(512,
-                buffers_.capacity() - buffers_.size()),
-              std::min<std::size_t>(max_size,
-                buffers_.max_size() - buffers_.size()));
+        bytes_available = read_size(stream_, buffers_, max_size, true);
         for (;;)
         {
           stream_.async_read_some(buffers_.prepare(bytes_available),
@@ -504,12 +501,10 @@ namespace detail
           return; default:
           total_transferred_ += bytes_transferred;
           buffers_.commit(bytes_transferred);
+          read_size_record(buffers_, bytes_transferred);
           max_size = this->check_for_completion(ec, total_transferred_);
-          bytes_available = std::min<std::size_t>(
-                std::max<std::size_t>(512,
-                  buffers_.capacity() - buffers_.size()),
-                std::min<std::size_t>(max_size,
-                  buffers_.max_size() - buffers_.size()));
+          bytes_available = max_size > 0
+            ? read_size(stream_, buffers_, max_size, true) : 0;
           if ((!ec && bytes_transferred == 0) || bytes_available == 0)
             break;
         }
@@ -0,0 +1,553 @@
+#ifndef ASIO_IMPL_READ_FRAMES_HPP
+#define ASIO_IMPL_READ_FRAMES_HPP
+
+#include <algorithm>
+#include <string>
+#include "asio/detail/memory/associated_allocator.hpp"
+#include "asio/core/executor/helper/associated_executor.hpp"
+#include "asio/buffer/buffer_search.hpp"
+#include "asio/detail/memory/handler_alloc_helpers.hpp"
+#include "asio/core/handler/handler_cont_helpers.hpp"
+#include "asio/core/handler/handler_invoke_helpers.hpp"
+#include "asio/core/handler/handler_type_requirements.hpp"
+#include "asio/error/throw_error.hpp"
+#include "asio/transmit/read_size.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  // Collect the complete frames in the data, resuming the search for the first
+  // delimiter at search_position. Returns the number of bytes up to and
+  // including the last delimiter, or 0 if there are no complete frames, in
+  // which case search_position is updated for the next search.
+  inline std::size_t read_frames_scan(const asio::const_buffer& data,
+      const char* delim, std::size_t length, std::size_t& search_position,
+      std::vector<asio::const_buffer>& frames)
+  {
+    const char* p = static_cast<const char*>(data.data());
+    std::size_t frame_start = 0;
+    for (;;)
+    {
+      std::pair<std::size_t, bool> result = length == 1
+        ? detail::buffer_search(&data, &data + 1, search_position, delim[0])
+        : detail::buffer_search(&data, &data + 1,
+            search_position, delim, length);
+      if (!result.second)
+      {
+        if (frame_start == 0)
+          search_position = result.first;
+        return frame_start;
+      }
+
+      std::size_t frame_end = result.first + length;
+      frames.push_back(asio::const_buffer(
+            p + frame_start, frame_end - frame_start));
+      frame_start = search_position = frame_end;
+    }
+  }
+
+  // A framing splits the data in a dynamic buffer into frames. Its scan
+  // function collects the complete frames, returning the number of bytes up to
+  // the end of the last one, or 0 if there are none. The state is carried
+  // between scans of the same data as more of it arrives. Its needed function
+  // gives the number of bytes still required to complete the first frame, or
+  // 0 if that is not known.
+
+  // Frames that end with a delimiter.
+  class delimited_framing
+  {
+  public:
+    delimited_framing(const char* delim, std::size_t length)
+      : delim_(delim, length)
+    {
+    }
+
+    std::size_t scan(const asio::const_buffer& data, std::size_t& state,
+        std::vector<asio::const_buffer>& frames, asio::error_code& ec) const
+    {
+      // An empty delimiter cannot separate frames.
+      if (delim_.empty())
+      {
+        ec = asio::error::invalid_argument;
+        return 0;
+      }
+
+      ec = asio::error_code();
+      return read_frames_scan(data, delim_.data(),
+          delim_.length(), state, frames);
+    }
+
+    std::size_t needed(std::size_t, std::size_t) const
+    {
+      return 0;
+    }
+
+  private:
+    std::string delim_;
+  };
+
+  // Frames that start with the length of their payload.
+  class length_prefixed_framing
+  {
+  public:
+    explicit length_prefixed_framing(const length_prefix& prefix)
+      : prefix_(prefix)
+    {
+    }
+
+    std::size_t scan(const asio::const_buffer& data, std::size_t& state,
+        std::vector<asio::const_buffer>& frames, asio::error_code& ec) const
+    {
+      const char* p = static_cast<const char*>(data.data());
+      std::size_t size = data.size();
+      std::size_t offset = 0;
+      for (;;)
+      {
+        std::size_t length = 0;
+        std::size_t header = prefix_.decode(
+            p + offset, size - offset, length, ec);
+        if (ec)
+        {
+          // Deliver the complete frames before the bad header. The error is
+          // reported by the next operation.
+          if (offset > 0)
+            ec = asio::error_code();
+          return offset;
+        }
+
+        if (header == 0 || size - offset - header < length)
+        {
+          // Remember the total size of the first frame, once it is known.
+          if (offset == 0)
+            state = header == 0 ? 0 : header + length;
+          return offset;
+        }
+
+        frames.push_back(asio::const_buffer(p + offset + header, length));
+        offset += header + length;
+      }
+    }
+
+    std::size_t needed(std::size_t size, std::size_t state) const
+    {
+      return state > size ? state - size : 0;
+    }
+
+  private:
+    length_prefix prefix_;
+  };
+
+  // Determine how much to prepare for the next read, making it large enough to
+  // complete the first frame if its size is known.
+  template <typename Stream, typename DynamicBuffer, typename Framing>
+  inline std::size_t read_frames_size(Stream& s, DynamicBuffer& b,
+      const Framing& framing, std::size_t state)
+  {
+    std::size_t bytes_to_read = read_size(s, b,
+        default_max_transfer_size, false);
+    std::size_t needed = (std::min)(framing.needed(b.size(), state),
+        b.max_size() - b.size());
+    return (std::max)(bytes_to_read, needed);
+  }
+
+  template <typename SyncReadStream,
+      typename DynamicBuffer, typename Framing>
+  std::size_t read_frames(SyncReadStream& s, DynamicBuffer& b,
+      const Framing& framing, std::vector<asio::const_buffer>& frames,
+      asio::error_code& ec)
+  {
+    frames.clear();
+    std::size_t state = 0;
+    for (;;)
+    {
+      // Collect the complete frames in the data.
+      std::size_t bytes = framing.scan(b.data(), state, frames, ec);
+      if (bytes > 0 || ec)
+        return bytes;
+
+      // Check if buffer is full.
+      if (b.size() == b.max_size())
+      {
+        ec = error::not_found;
+        return 0;
+      }
+
+      // Need more data.
+      std::size_t bytes_to_read = read_frames_size(s, b, framing, state);
+      std::size_t bytes_transferred = s.read_some(b.prepare(bytes_to_read), ec);
+      b.commit(bytes_transferred);
+      read_size_record(b, bytes_transferred);
+      if (ec)
+        return 0;
+    }
+  }
+} // namespace detail
+
+template <typename SyncReadStream, typename DynamicBuffer>
+inline std::size_t read_frames(SyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers, char delim,
+    std::vector<asio::const_buffer>& frames)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = read_frames(s,
+      ASIO_MOVE_CAST(DynamicBuffer)(buffers), delim, frames, ec);
+  asio::detail::throw_error(ec, "read_frames");
+  return bytes_transferred;
+}
+
+template <typename SyncReadStream, typename DynamicBuffer>
+inline std::size_t read_frames(SyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers, char delim,
+    std::vector<asio::const_buffer>& frames, asio::error_code& ec)
+{
+  typename decay<DynamicBuffer>::type b(
+      ASIO_MOVE_CAST(DynamicBuffer)(buffers));
+
+  return detail::read_frames(s, b,
+      detail::delimited_framing(&delim, 1), frames, ec);
+}
+
+template <typename SyncReadStream, typename DynamicBuffer>
+inline std::size_t read_frames(SyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers,
+    ASIO_STRING_VIEW_PARAM delim,
+    std::vector<asio::const_buffer>& frames)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = read_frames(s,
+      ASIO_MOVE_CAST(DynamicBuffer)(buffers), delim, frames, ec);
+  asio::detail::throw_error(ec, "read_frames");
+  return bytes_transferred;
+}
+
+template <typename SyncReadStream, typename DynamicBuffer>
+inline std::size_t read_frames(SyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers,
+    ASIO_STRING_VIEW_PARAM delim,
+    std::vector<asio::const_buffer>& frames, asio::error_code& ec)
+{
+  typename decay<DynamicBuffer>::type b(
+      ASIO_MOVE_CAST(DynamicBuffer)(buffers));
+
+  return detail::read_frames(s, b,
+      detail::delimited_framing(delim.data(), delim.length()), frames, ec);
+}
+
+template <typename SyncReadStream, typename DynamicBuffer>
+inline std::size_t read_frames(SyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers, const length_prefix& prefix,
+    std::vector<asio::const_buffer>& frames)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = read_frames(s,
+      ASIO_MOVE_CAST(DynamicBuffer)(buffers), prefix, frames, ec);
+  asio::detail::throw_error(ec, "read_frames");
+  return bytes_transferred;
+}
+
+template <typename SyncReadStream, typename DynamicBuffer>
+inline std::size_t read_frames(SyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers, const length_prefix& prefix,
+    std::vector<asio::const_buffer>& frames, asio::error_code& ec)
+{
+  typename decay<DynamicBuffer>::type b(
+      ASIO_MOVE_CAST(DynamicBuffer)(buffers));
+
+  return detail::read_frames(s, b,
+      detail::length_prefixed_framing(prefix), frames, ec);
+}
+
+namespace detail
+{
+  template <typename AsyncReadStream, typename DynamicBuffer,
+      typename Framing, typename ReadHandler>
+  class read_frames_op
+  {
+  public:
+    template <typename BufferSequence>
+    read_frames_op(AsyncReadStream& stream,
+        ASIO_MOVE_ARG(BufferSequence) buffers,
+        const Framing& framing, std::vector<asio::const_buffer>& frames,
+        ReadHandler& handler)
+      : stream_(stream),
+        buffers_(ASIO_MOVE_CAST(BufferSequence)(buffers)),
+        framing_(framing),
+        frames_(frames),
+        start_(0),
+        state_(0),
+        frame_bytes_(0),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    read_frames_op(const read_frames_op& other)
+      : stream_(other.stream_),
+        buffers_(other.buffers_),
+        framing_(other.framing_),
+        frames_(other.frames_),
+        start_(other.start_),
+        state_(other.state_),
+        frame_bytes_(other.frame_bytes_),
+        result_ec_(other.result_ec_),
+        handler_(other.handler_)
+    {
+    }
+
+    read_frames_op(read_frames_op&& other)
+      : stream_(other.stream_),
+        buffers_(ASIO_MOVE_CAST(DynamicBuffer)(other.buffers_)),
+        framing_(ASIO_MOVE_CAST(Framing)(other.framing_)),
+        frames_(other.frames_),
+        start_(other.start_),
+        state_(other.state_),
+        frame_bytes_(other.frame_bytes_),
+        result_ec_(other.result_ec_),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(const asio::error_code& ec,
+        std::size_t bytes_transferred, int start = 0)
+    {
+      std::size_t bytes_to_read;
+      switch (start_ = start)
+      {
+      case 1:
+        frames_.clear();
+        for (;;)
+        {
+          {
+            // Collect the complete frames in the data. If there is at least
+            // one, or the data is bad, we're done.
+            if ((frame_bytes_ = framing_.scan(buffers_.data(),
+                    state_, frames_, result_ec_)) > 0 || result_ec_)
+            {
+              bytes_to_read = 0;
+            }
+
+            // No frame yet. Check if buffer is full.
+            else if (buffers_.size() == buffers_.max_size())
+            {
+              result_ec_ = error::not_found;
+              bytes_to_read = 0;
+            }
+
+            // Need to read some more data.
+            else
+            {
+              bytes_to_read = read_frames_size(
+                  stream_, buffers_, framing_, state_);
+            }
+          }
+
+          // Check if we're done.
+          if (!start && bytes_to_read == 0)
+            break;
+
+          // Start a new asynchronous read operation to obtain more data.
+          stream_.async_read_some(buffers_.prepare(bytes_to_read),
+              ASIO_MOVE_CAST(read_frames_op)(*this));
+          return; default:
+          buffers_.commit(bytes_transferred);
+          read_size_record(buffers_, bytes_transferred);
+          if (ec || bytes_transferred == 0)
+            break;
+        }
+
+        const asio::error_code result_ec = ec ? ec : result_ec_;
+        const std::size_t result_n = result_ec ? 0 : frame_bytes_;
+
+        if (result_n == 0)
+          frames_.clear();
+
+        handler_(result_ec, result_n);
+      }
+    }
+
+  //private:
+    AsyncReadStream& stream_;
+    DynamicBuffer buffers_;
+    Framing framing_;
+    std::vector<asio::const_buffer>& frames_;
+    int start_;
+    std::size_t state_;
+    std::size_t frame_bytes_;
+    asio::error_code result_ec_;
+    ReadHandler handler_;
+  };
+
+  template <typename AsyncReadStream, typename DynamicBuffer,
+      typename Framing, typename ReadHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      read_frames_op<AsyncReadStream,
+        DynamicBuffer, Framing, ReadHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename AsyncReadStream, typename DynamicBuffer,
+      typename Framing, typename ReadHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      read_frames_op<AsyncReadStream,
+        DynamicBuffer, Framing, ReadHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename AsyncReadStream, typename DynamicBuffer,
+      typename Framing, typename ReadHandler>
+  inline bool asio_handler_is_continuation(
+      read_frames_op<AsyncReadStream,
+        DynamicBuffer, Framing, ReadHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename AsyncReadStream,
+      typename DynamicBuffer, typename Framing, typename ReadHandler>
+  inline void asio_handler_invoke(Function& function,
+      read_frames_op<AsyncReadStream,
+        DynamicBuffer, Framing, ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename AsyncReadStream,
+      typename DynamicBuffer, typename Framing, typename ReadHandler>
+  inline void asio_handler_invoke(const Function& function,
+      read_frames_op<AsyncReadStream,
+        DynamicBuffer, Framing, ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename AsyncReadStream, typename DynamicBuffer,
+      typename Framing, typename ReadHandler>
+  inline void start_read_frames_op(AsyncReadStream& s,
+      ASIO_MOVE_ARG(DynamicBuffer) buffers, const Framing& framing,
+      std::vector<asio::const_buffer>& frames, ReadHandler& handler)
+  {
+    detail::read_frames_op<AsyncReadStream,
+      typename decay<DynamicBuffer>::type, Framing, ReadHandler>(
+        s, ASIO_MOVE_CAST(DynamicBuffer)(buffers),
+          framing, frames, handler)(asio::error_code(), 0, 1);
+  }
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename AsyncReadStream, typename DynamicBuffer,
+    typename Framing, typename ReadHandler, typename Allocator>
+struct associated_allocator<
+    detail::read_frames_op<AsyncReadStream,
+      DynamicBuffer, Framing, ReadHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<ReadHandler, Allocator>::type type;
+
+  static type get(
+      const detail::read_frames_op<AsyncReadStream,
+        DynamicBuffer, Framing, ReadHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<ReadHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename AsyncReadStream, typename DynamicBuffer,
+    typename Framing, typename ReadHandler, typename Executor>
+struct associated_executor<
+    detail::read_frames_op<AsyncReadStream,
+      DynamicBuffer, Framing, ReadHandler>,
+    Executor>
+{
+  typedef typename associated_executor<ReadHandler, Executor>::type type;
+
+  static type get(
+      const detail::read_frames_op<AsyncReadStream,
+        DynamicBuffer, Framing, ReadHandler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<ReadHandler, Executor>::get(h.handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename AsyncReadStream,
+    typename DynamicBuffer, typename ReadHandler>
+inline ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_read_frames(AsyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers, char delim,
+    std::vector<asio::const_buffer>& frames,
+    ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  return async_read_frames(s, ASIO_MOVE_CAST(DynamicBuffer)(buffers),
+      ASIO_STRING_VIEW_PARAM(&delim, 1), frames,
+      ASIO_MOVE_CAST(ReadHandler)(handler));
+}
+
+template <typename AsyncReadStream,
+    typename DynamicBuffer, typename ReadHandler>
+ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_read_frames(AsyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers,
+    ASIO_STRING_VIEW_PARAM delim,
+    std::vector<asio::const_buffer>& frames,
+    ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a ReadHandler.
+  ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+  async_completion<ReadHandler,
+    void (asio::error_code, std::size_t)> init(handler);
+
+  detail::start_read_frames_op(s, ASIO_MOVE_CAST(DynamicBuffer)(buffers),
+      detail::delimited_framing(delim.data(), delim.length()),
+      frames, init.completion_handler);
+
+  return init.result.get();
+}
+
+template <typename AsyncReadStream,
+    typename DynamicBuffer, typename ReadHandler>
+ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_read_frames(AsyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers, const length_prefix& prefix,
+    std::vector<asio::const_buffer>& frames,
+    ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a ReadHandler.
+  ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+  async_completion<ReadHandler,
+    void (asio::error_code, std::size_t)> init(handler);
+
+  detail::start_read_frames_op(s, ASIO_MOVE_CAST(DynamicBuffer)(buffers),
+      detail::length_prefixed_framing(prefix),
+      frames, init.completion_handler);
+
+  return init.result.get();
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_READ_FRAMES_HPP
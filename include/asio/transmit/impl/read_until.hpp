@@ -18,6 +18,7 @@
 #include "asio/detail/memory/associated_allocator.hpp"
 #include "asio/core/executor/helper/associated_executor.hpp"
 #include "asio/buffer/buffer.hpp"
+#include "asio/buffer/buffer_search.hpp"
 #include "asio/buffer/buffers_iterator.hpp"
 #include "asio/core/handler/bind_handler.hpp"
 #include "asio/detail/memory/handler_alloc_helpers.hpp"
@@ -26,6 +27,7 @@
 #include "asio/core/handler/handler_type_requirements.hpp"
 #include "asio/detail/base/stdcpp/limits.hpp"
 #include "asio/error/throw_error.hpp"
+#include "asio/transmit/read_size.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -53,26 +55,22 @@ std::size_t read_until(SyncReadStream& s,
   std::size_t search_position = 0;
   for (;;)
   {
-    // Determine the range of the data to be searched.
+    // Look for a match in the data.
     typedef typename DynamicBuffer::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers = b.data();
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
-
-    // Look for a match.
-    iterator iter = std::find(start_pos, end, delim);
-    if (iter != end)
+    std::pair<std::size_t, bool> result = detail::buffer_search(
+        asio::buffer_sequence_begin(data_buffers),
+        asio::buffer_sequence_end(data_buffers), search_position, delim);
+    if (result.second)
     {
       // Found a match. We're done.
       ec = asio::error_code();
-      return iter - begin + 1;
+      return result.first + 1;
     }
     else
     {
       // No match. Next search can start with the new data.
-      search_position = end - begin;
+      search_position = result.first;
     }
 
     // Check if buffer is full.
@@ -83,10 +81,11 @@ std::size_t read_until(SyncReadStream& s,
     }
 
     // Need more data.
-    std::size_t bytes_to_read = std::min<std::size_t>(
-          std::max<std::size_t>(512, b.capacity() - b.size()),
-          std::min<std::size_t>(65536, b.max_size() - b.size()));
-    b.commit(s.read_some(b.prepare(bytes_to_read), ec));
+    std::size_t bytes_to_read = detail::read_size(
+        s, b, detail::default_max_transfer_size, false);
+    std::size_t bytes_transferred = s.read_some(b.prepare(bytes_to_read), ec);
+    b.commit(bytes_transferred);
+    detail::read_size_record(b, bytes_transferred);
     if (ec)
       return 0;
   }
@@ -104,41 +103,6 @@ inline std::size_t read_until(SyncReadStream& s,
   return bytes_transferred;
 }
 
-namespace detail
-{
-  // Algorithm that finds a subsequence of equal values in a sequence. Returns
-  // (iterator,true) if a full match was found, in which case the iterator
-  // points to the beginning of the match. Returns (iterator,false) if a
-  // partial match was found at the end of the first sequence, in which case
-  // the iterator points to the beginning of the partial match. Returns
-  // (last1,false) if no full or partial match was found.
-  template <typename Iterator1, typename Iterator2>
-  std::pair<Iterator1, bool> partial_search(
-      Iterator1 first1, Iterator1 last1, Iterator2 first2, Iterator2 last2)
-  {
-    for (Iterator1 iter1 = first1; iter1 != last1; ++iter1)
-    {
-      Iterator1 test_iter1 = iter1;
-      Iterator2 test_iter2 = first2;
-      for (;; ++test_iter1, ++test_iter2)
-      {
-        if (test_iter2 == last2)
-          return std::make_pair(iter1, true);
-        if (test_iter1 == last1)
-        {
-          if (test_iter2 != first2)
-            return std::make_pair(iter1, false);
-          else
-            break;
-        }
-        if (*test_iter1 != *test_iter2)
-          break;
-      }
-    }
-    return std::make_pair(last1, false);
-  }
-} // namespace detail
-
 template <typename SyncReadStream, typename DynamicBuffer>
 std::size_t read_until(SyncReadStream& s,
     ASIO_MOVE_ARG(DynamicBuffer) buffers,
@@ -150,35 +114,24 @@ std::size_t read_until(SyncReadStream& s,
   std::size_t search_position = 0;
   for (;;)
   {
-    // Determine the range of the data to be searched.
+    // Look for a match in the data.
     typedef typename DynamicBuffer::const_buffers_type buffers_type;
-    typedef buffers_iterator<buffers_type> iterator;
     buffers_type data_buffers = b.data();
-    iterator begin = iterator::begin(data_buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(data_buffers);
-
-    // Look for a match.
-    std::pair<iterator, bool> result = detail::partial_search(
-        start_pos, end, delim.begin(), delim.end());
-    if (result.first != end)
+    std::pair<std::size_t, bool> result = detail::buffer_search(
+        asio::buffer_sequence_begin(data_buffers),
+        asio::buffer_sequence_end(data_buffers), search_position,
+        delim.data(), delim.length());
+    if (result.second)
     {
-      if (result.second)
-      {
-        // Full match. We're done.
-        ec = asio::error_code();
-        return result.first - begin + delim.length();
-      }
-      else
-      {
-        // Partial match. Next search needs to start from beginning of match.
-        search_position = result.first - begin;
-      }
+      // Full match. We're done.
+      ec = asio::error_code();
+      return result.first + delim.length();
     }
     else
     {
-      // No match. Next search can start with the new data.
-      search_position = end - begin;
+      // Partial match or no match. Next search needs to start from the
+      // beginning of the partial match, or with the new data.
+      search_position = result.first;
     }
 
     // Check if buffer is full.
@@ -189,10 +142,11 @@ std::size_t read_until(SyncReadStream& s,
     }
 
     // Need more data.
-    std::size_t bytes_to_read = std::min<std::size_t>(
-          std::max<std::size_t>(512, b.capacity() - b.size()),
-          std::min<std::size_t>(65536, b.max_size() - b.size()));
-    b.commit(s.read_some(b.prepare(bytes_to_read), ec));
+    std::size_t bytes_to_read = detail::read_size(
+        s, b, detail::default_max_transfer_size, false);
+    std::size_t bytes_transferred = s.read_some(b.prepare(bytes_to_read), ec);
+    b.commit(bytes_transferred);
+    detail::read_size_record(b, bytes_transferred);
     if (ec)
       return 0;
   }
@@ -263,10 +217,11 @@ std::size_t read_until(SyncReadStream& s,
     }
 
     // Need more data.
-    std::size_t bytes_to_read = std::min<std::size_t>(
-          std::max<std::size_t>(512, b.capacity() - b.size()),
-          std::min<std::size_t>(65536, b.max_size() - b.size()));
-    b.commit(s.read_some(b.prepare(bytes_to_read), ec));
+    std::size_t bytes_to_read = detail::read_size(
+        s, b, detail::default_max_transfer_size, false);
+    std::size_t bytes_transferred = s.read_some(b.prepare(bytes_to_read), ec);
+    b.commit(bytes_transferred);
+    detail::read_size_record(b, bytes_transferred);
     if (ec)
       return 0;
   }
@@ -378,21 +333,18 @@ namespace detail
         for (;;)
         {
           {
-            // Determine the range of the data to be searched.
+            // Look for a match in the data.
             typedef typename DynamicBuffer::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers = buffers_.data();
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
-
-            // Look for a match.
-            iterator iter = std::find(start_pos, end, delim_);
-            if (iter != end)
+            std::pair<std::size_t, bool> result = detail::buffer_search(
+                asio::buffer_sequence_begin(data_buffers),
+                asio::buffer_sequence_end(data_buffers),
+                search_position_, delim_);
+            if (result.second)
             {
               // Found a match. We're done.
-              search_position_ = iter - begin + 1;
+              search_position_ = result.first + 1;
               bytes_to_read = 0;
             }
 
@@ -407,12 +359,9 @@ namespace detail
             else
             {
               // Next search can start with the new data.
-              search_position_ = end - begin;
-              bytes_to_read = std::min<std::size_t>(
-                    std::max<std::size_t>(512,
-                      buffers_.capacity() - buffers_.size()),
-                    std::min<std::size_t>(65536,
-                      buffers_.max_size() - buffers_.size()));
+              search_position_ = result.first;
+              bytes_to_read = detail::read_size(stream_,
+                  buffers_, detail::default_max_transfer_size, false);
             }
           }
 
@@ -425,6 +374,7 @@ namespace detail
               ASIO_MOVE_CAST(read_until_delim_op)(*this));
           return; default:
           buffers_.commit(bytes_transferred);
+          detail::read_size_record(buffers_, bytes_transferred);
           if (ec || bytes_transferred == 0)
             break;
         }
@@ -620,22 +570,18 @@ namespace detail
         for (;;)
         {
           {
-            // Determine the range of the data to be searched.
+            // Look for a match in the data.
             typedef typename DynamicBuffer::const_buffers_type
               buffers_type;
-            typedef buffers_iterator<buffers_type> iterator;
             buffers_type data_buffers = buffers_.data();
-            iterator begin = iterator::begin(data_buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(data_buffers);
-
-            // Look for a match.
-            std::pair<iterator, bool> result = detail::partial_search(
-                start_pos, end, delim_.begin(), delim_.end());
-            if (result.first != end && result.second)
+            std::pair<std::size_t, bool> result = detail::buffer_search(
+                asio::buffer_sequence_begin(data_buffers),
+                asio::buffer_sequence_end(data_buffers),
+                search_position_, delim_.data(), delim_.length());
+            if (result.second)
             {
               // Full match. We're done.
-              search_position_ = result.first - begin + delim_.length();
+              search_position_ = result.first + delim_.length();
               bytes_to_read = 0;
             }
 
@@ -649,23 +595,12 @@ namespace detail
             // Need to read some more data.
             else
             {
-              if (result.first != end)
-              {
-                // Partial match. Next search needs to start from beginning of
-                // match.
-                search_position_ = result.first - begin;
-              }
-              else
-              {
-                // Next search can start with the new data.
-                search_position_ = end - begin;
-              }
+              // Partial match or no match. Next search needs to start from
+              // the beginning of the partial match, or with the new data.
+              search_position_ = result.first;
 
-              bytes_to_read = std::min<std::size_t>(
-                    std::max<std::size_t>(512,
-                      buffers_.capacity() - buffers_.size()),
-                    std::min<std::size_t>(65536,
-                      buffers_.max_size() - buffers_.size()));
+              bytes_to_read = detail::read_size(stream_,
+                  buffers_, detail::default_max_transfer_size, false);
             }
           }
 
@@ -678,6 +613,7 @@ namespace detail
               ASIO_MOVE_CAST(read_until_delim_string_op)(*this));
           return; default:
           buffers_.commit(bytes_transferred);
+          detail::read_size_record(buffers_, bytes_transferred);
           if (ec || bytes_transferred == 0)
             break;
         }
@@ -917,11 +853,8 @@ namespace detail
                 search_position_ = end - begin;
               }
 
-              bytes_to_read = std::min<std::size_t>(
-                    std::max<std::size_t>(512,
-                      buffers_.capacity() - buffers_.size()),
-                    std::min<std::size_t>(65536,
-                      buffers_.max_size() - buffers_.size()));
+              bytes_to_read = detail::read_size(stream_,
+                  buffers_, detail::default_max_transfer_size, false);
             }
           }
 
@@ -934,6 +867,7 @@ namespace detail
               ASIO_MOVE_CAST(read_until_match_op)(*this));
           return; default:
           buffers_.commit(bytes_transferred);
+          detail::read_size_record(buffers_, bytes_transferred);
           if (ec || bytes_transferred == 0)
             break;
         }
@@ -0,0 +1,221 @@
+#ifndef ASIO_IMPL_READ_WHEN_READY_HPP
+#define ASIO_IMPL_READ_WHEN_READY_HPP
+
+#include "asio/detail/memory/associated_allocator.hpp"
+#include "asio/core/executor/helper/associated_executor.hpp"
+#include "asio/detail/memory/handler_alloc_helpers.hpp"
+#include "asio/core/handler/handler_cont_helpers.hpp"
+#include "asio/core/handler/handler_invoke_helpers.hpp"
+#include "asio/core/handler/handler_type_requirements.hpp"
+#include "asio/transmit/read_size.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  template <typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
+  class read_when_ready_op
+  {
+  public:
+    template <typename BufferSequence>
+    read_when_ready_op(AsyncReadStream& stream,
+        ASIO_MOVE_ARG(BufferSequence) buffers, ReadHandler& handler)
+      : stream_(stream),
+        buffers_(ASIO_MOVE_CAST(BufferSequence)(buffers)),
+        start_(0),
+        reading_(false),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    read_when_ready_op(const read_when_ready_op& other)
+      : stream_(other.stream_),
+        buffers_(other.buffers_),
+        start_(other.start_),
+        reading_(other.reading_),
+        handler_(other.handler_)
+    {
+    }
+
+    read_when_ready_op(read_when_ready_op&& other)
+      : stream_(other.stream_),
+        buffers_(ASIO_MOVE_CAST(DynamicBuffer)(other.buffers_)),
+        start_(other.start_),
+        reading_(other.reading_),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(const asio::error_code& ec,
+        std::size_t bytes_transferred = 0, int start = 0)
+    {
+      std::size_t bytes_to_read;
+      switch (start_ = start)
+      {
+      case 1:
+        // Wait for the stream to become readable without reserving any space,
+        // unless there is no room to read into anyway.
+        if (buffers_.size() < buffers_.max_size())
+        {
+          stream_.async_wait(AsyncReadStream::wait_read,
+              ASIO_MOVE_CAST(read_when_ready_op)(*this));
+          return;
+        }
+        // Fall through.
+      default:
+        if (!reading_ && !ec)
+        {
+          // Data has arrived, so now prepare the space to read it into.
+          reading_ = true;
+          bytes_to_read = read_size(stream_,
+              buffers_, default_max_transfer_size, false);
+          stream_.async_read_some(buffers_.prepare(bytes_to_read),
+              ASIO_MOVE_CAST(read_when_ready_op)(*this));
+          return;
+        }
+
+        if (reading_)
+        {
+          buffers_.commit(bytes_transferred);
+          read_size_record(buffers_, bytes_transferred);
+        }
+
+        handler_(ec, static_cast<const std::size_t&>(bytes_transferred));
+      }
+    }
+
+  //private:
+    AsyncReadStream& stream_;
+    DynamicBuffer buffers_;
+    int start_;
+    bool reading_;
+    ReadHandler handler_;
+  };
+
+  template <typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      read_when_ready_op<AsyncReadStream,
+        DynamicBuffer, ReadHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      read_when_ready_op<AsyncReadStream,
+        DynamicBuffer, ReadHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
+  inline bool asio_handler_is_continuation(
+      read_when_ready_op<AsyncReadStream,
+        DynamicBuffer, ReadHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
+  inline void asio_handler_invoke(Function& function,
+      read_when_ready_op<AsyncReadStream,
+        DynamicBuffer, ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
+  inline void asio_handler_invoke(const Function& function,
+      read_when_ready_op<AsyncReadStream,
+        DynamicBuffer, ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename AsyncReadStream, typename DynamicBuffer,
+    typename ReadHandler, typename Allocator>
+struct associated_allocator<
+    detail::read_when_ready_op<AsyncReadStream,
+      DynamicBuffer, ReadHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<ReadHandler, Allocator>::type type;
+
+  static type get(
+      const detail::read_when_ready_op<AsyncReadStream,
+        DynamicBuffer, ReadHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<ReadHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename AsyncReadStream, typename DynamicBuffer,
+    typename ReadHandler, typename Executor>
+struct associated_executor<
+    detail::read_when_ready_op<AsyncReadStream,
+      DynamicBuffer, ReadHandler>,
+    Executor>
+{
+  typedef typename associated_executor<ReadHandler, Executor>::type type;
+
+  static type get(
+      const detail::read_when_ready_op<AsyncReadStream,
+        DynamicBuffer, ReadHandler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<ReadHandler, Executor>::get(h.handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename AsyncReadStream,
+    typename DynamicBuffer, typename ReadHandler>
+ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_read_when_ready(AsyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers,
+    ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a ReadHandler.
+  ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+  async_completion<ReadHandler,
+    void (asio::error_code, std::size_t)> init(handler);
+
+  detail::read_when_ready_op<AsyncReadStream,
+    typename decay<DynamicBuffer>::type,
+      ASIO_HANDLER_TYPE(ReadHandler,
+        void (asio::error_code, std::size_t))>(
+          s, ASIO_MOVE_CAST(DynamicBuffer)(buffers),
+            init.completion_handler)(asio::error_code(), 0, 1);
+
+  return init.result.get();
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_READ_WHEN_READY_HPP
@@ -0,0 +1,393 @@
+#ifndef ASIO_IMPL_SEND_FILE_HPP
+#define ASIO_IMPL_SEND_FILE_HPP
+
+#include "asio/detail/memory/associated_allocator.hpp"
+#include "asio/core/executor/helper/associated_executor.hpp"
+#include "asio/transmit/completion_condition.hpp"
+#include "asio/transmit/base_from_completion_cond.hpp"
+#include "asio/detail/memory/handler_alloc_helpers.hpp"
+#include "asio/core/handler/handler_cont_helpers.hpp"
+#include "asio/core/handler/handler_invoke_helpers.hpp"
+#include "asio/core/handler/handler_type_requirements.hpp"
+#include "asio/detail/memory/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/network/socket_ops.hpp"
+#include "asio/error/throw_error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+template <typename Protocol, typename CompletionCondition>
+std::size_t send_file(basic_stream_socket<Protocol>& s, int fd,
+    uint64_t offset, std::size_t length,
+    CompletionCondition completion_condition, asio::error_code& ec)
+{
+  bool pipe = false;
+  if (!detail::socket_ops::is_regular_file(fd, ec))
+  {
+    if (!ec)
+      pipe = detail::socket_ops::is_pipe(fd, ec);
+    if (!ec && !pipe)
+      ec = asio::error::operation_not_supported;
+    if (ec)
+      return 0;
+  }
+
+  detail::socket_ops::state_type state = detail::socket_ops::stream_oriented;
+  if (s.non_blocking())
+    state |= detail::socket_ops::user_set_non_blocking;
+
+  std::size_t total_transferred = 0;
+  while (total_transferred < length)
+  {
+    std::size_t max_size = detail::adapt_completion_condition_result(
+        completion_condition(ec, total_transferred));
+    if (max_size == 0)
+      break;
+
+    if (max_size > length - total_transferred)
+      max_size = length - total_transferred;
+    std::size_t bytes = pipe
+      ? detail::socket_ops::sync_splice(s.native_handle(),
+          state, fd, max_size, ec)
+      : detail::socket_ops::sync_sendfile(s.native_handle(),
+          state, fd, offset, max_size, ec);
+    total_transferred += bytes;
+
+    // Stop at the end of the file, or when the pipe's writers have closed.
+    if (ec || bytes == 0)
+      break;
+  }
+
+  return total_transferred;
+}
+
+template <typename Protocol>
+inline std::size_t send_file(basic_stream_socket<Protocol>& s, int fd,
+    uint64_t offset, std::size_t length)
+{
+  asio::error_code ec;
+  std::size_t bytes_transferred = send_file(s, fd,
+      offset, length, transfer_all(), ec);
+  asio::detail::throw_error(ec, "send_file");
+  return bytes_transferred;
+}
+
+template <typename Protocol>
+inline std::size_t send_file(basic_stream_socket<Protocol>& s, int fd,
+    uint64_t offset, std::size_t length, asio::error_code& ec)
+{
+  return send_file(s, fd, offset, length, transfer_all(), ec);
+}
+
+namespace detail
+{
+  // Registers a source pipe with the socket's reactor, so that a send_file_op
+  // can wait for the pipe to become readable. The pipe is released rather than
+  // closed when the operation has finished with it.
+  template <typename Protocol>
+  class send_file_pipe
+    : private noncopyable
+  {
+  public:
+    send_file_pipe(basic_stream_socket<Protocol>& socket, int fd,
+        asio::error_code& ec)
+      : pipe_(socket.get_executor().context())
+    {
+      typename Protocol::endpoint endpoint = socket.local_endpoint(ec);
+      if (!ec)
+        pipe_.assign(endpoint.protocol(), fd, ec);
+    }
+
+    ~send_file_pipe()
+    {
+      asio::error_code ec;
+      if (pipe_.is_open())
+        pipe_.release(ec);
+    }
+
+    template <typename Handler>
+    void async_wait(Handler&& handler)
+    {
+      pipe_.async_wait(socket_base::wait_read,
+          static_cast<Handler&&>(handler));
+    }
+
+  private:
+    basic_stream_socket<Protocol> pipe_;
+  };
+
+  template <typename Protocol, typename CompletionCondition,
+      typename WriteHandler>
+  class send_file_op
+    : detail::base_from_completion_cond<CompletionCondition>
+  {
+  public:
+    send_file_op(basic_stream_socket<Protocol>& socket, int fd,
+        uint64_t offset, std::size_t length,
+        CompletionCondition completion_condition, WriteHandler& handler)
+      : detail::base_from_completion_cond<
+          CompletionCondition>(completion_condition),
+        socket_(socket),
+        fd_(fd),
+        checked_(false),
+        pipe_(false),
+        offset_(offset),
+        length_(length),
+        total_transferred_(0),
+        start_(0),
+        handler_(static_cast<WriteHandler&&>(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    send_file_op(const send_file_op& other)
+      : detail::base_from_completion_cond<CompletionCondition>(other),
+        socket_(other.socket_),
+        fd_(other.fd_),
+        checked_(other.checked_),
+        pipe_(other.pipe_),
+        source_(other.source_),
+        offset_(other.offset_),
+        length_(other.length_),
+        total_transferred_(other.total_transferred_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    send_file_op(send_file_op&& other)
+      : detail::base_from_completion_cond<CompletionCondition>(other),
+        socket_(other.socket_),
+        fd_(other.fd_),
+        checked_(other.checked_),
+        pipe_(other.pipe_),
+        source_(static_cast<
+          shared_ptr<send_file_pipe<Protocol> >&&>(other.source_)),
+        offset_(other.offset_),
+        length_(other.length_),
+        total_transferred_(other.total_transferred_),
+        start_(other.start_),
+        handler_(static_cast<WriteHandler&&>(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(asio::error_code ec, int start = 0)
+    {
+      if ((start_ = start) == 1)
+      {
+        socket_.async_wait(socket_base::wait_write,
+            static_cast<send_file_op&&>(*this));
+        return;
+      }
+
+      // Regular files are sent with sendfile, and pipes with splice. Other
+      // kinds of descriptor are not supported.
+      if (!ec && !checked_)
+      {
+        if (!socket_ops::is_regular_file(fd_, ec) && !ec)
+        {
+          pipe_ = socket_ops::is_pipe(fd_, ec);
+          if (!ec && !pipe_)
+            ec = asio::error::operation_not_supported;
+        }
+        checked_ = true;
+      }
+
+      // Put the underlying socket into non-blocking mode.
+      if (!ec)
+        if (!socket_.native_non_blocking())
+          socket_.native_non_blocking(true, ec);
+
+      while (!ec && total_transferred_ < length_)
+      {
+        std::size_t max_size =
+          this->check_for_completion(ec, total_transferred_);
+        if (max_size == 0)
+          break;
+
+        if (max_size > length_ - total_transferred_)
+          max_size = length_ - total_transferred_;
+        std::size_t bytes = 0;
+        if (!(pipe_
+              ? socket_ops::non_blocking_splice(socket_.native_handle(),
+                fd_, max_size, ec, bytes)
+              : socket_ops::non_blocking_sendfile(socket_.native_handle(),
+                fd_, offset_, max_size, ec, bytes)))
+        {
+          // An empty pipe has to be waited on separately, as the socket may
+          // well be writable already.
+          if (pipe_)
+          {
+            if (socket_ops::poll_read(fd_, 0, 0, ec) == 0)
+            {
+              if (!source_)
+                source_.reset(new send_file_pipe<Protocol>(socket_, fd_, ec));
+              if (ec)
+                break;
+              source_->async_wait(static_cast<send_file_op&&>(*this));
+              return;
+            }
+            if (ec)
+              break;
+          }
+
+          // We have to wait for the socket to become ready again.
+          socket_.async_wait(socket_base::wait_write,
+              static_cast<send_file_op&&>(*this));
+          return;
+        }
+        total_transferred_ += bytes;
+
+        // Stop at the end of the file, or when the pipe's writers have closed.
+        if (bytes == 0)
+          break;
+      }
+
+      // Let the caller close the pipe from within the handler.
+      source_.reset();
+
+      handler_(ec, static_cast<const std::size_t&>(total_transferred_));
+    }
+
+  //private:
+    basic_stream_socket<Protocol>& socket_;
+    int fd_;
+    bool checked_;
+    bool pipe_;
+    shared_ptr<send_file_pipe<Protocol> > source_;
+    uint64_t offset_;
+    std::size_t length_;
+    std::size_t total_transferred_;
+    int start_;
+    WriteHandler handler_;
+  };
+
+  template <typename Protocol, typename CompletionCondition,
+      typename WriteHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      send_file_op<Protocol, CompletionCondition, WriteHandler>* this_handler)
+  {
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename Protocol, typename CompletionCondition,
+      typename WriteHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      send_file_op<Protocol, CompletionCondition, WriteHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename Protocol, typename CompletionCondition,
+      typename WriteHandler>
+  inline bool asio_handler_is_continuation(
+      send_file_op<Protocol, CompletionCondition, WriteHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename Protocol,
+      typename CompletionCondition, typename WriteHandler>
+  inline void asio_handler_invoke(Function& function,
+      send_file_op<Protocol, CompletionCondition, WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename Protocol,
+      typename CompletionCondition, typename WriteHandler>
+  inline void asio_handler_invoke(const Function& function,
+      send_file_op<Protocol, CompletionCondition, WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename Protocol, typename CompletionCondition,
+    typename WriteHandler, typename Allocator>
+struct associated_allocator<
+    detail::send_file_op<Protocol, CompletionCondition, WriteHandler>,
+    Allocator>
+{
+  typedef typename associated_allocator<WriteHandler, Allocator>::type type;
+
+  static type get(
+      const detail::send_file_op<Protocol,
+        CompletionCondition, WriteHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<WriteHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Protocol, typename CompletionCondition,
+    typename WriteHandler, typename Executor>
+struct associated_executor<
+    detail::send_file_op<Protocol, CompletionCondition, WriteHandler>,
+    Executor>
+{
+  typedef typename associated_executor<WriteHandler, Executor>::type type;
+
+  static type get(
+      const detail::send_file_op<Protocol,
+        CompletionCondition, WriteHandler>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<WriteHandler, Executor>::get(h.handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename Protocol, typename CompletionCondition,
+    typename WriteHandler>
+inline ASIO_INITFN_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+async_send_file(basic_stream_socket<Protocol>& s, int fd,
+    uint64_t offset, std::size_t length,
+    CompletionCondition completion_condition,
+    WriteHandler&& handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a WriteHandler.
+  ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+  async_completion<WriteHandler,
+    void (asio::error_code, std::size_t)> init(handler);
+
+  detail::send_file_op<Protocol, CompletionCondition,
+    ASIO_HANDLER_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))>(
+        s, fd, offset, length, completion_condition,
+          init.completion_handler)(asio::error_code(), 1);
+
+  return init.result.get();
+}
+
+template <typename Protocol, typename WriteHandler>
+inline ASIO_INITFN_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+async_send_file(basic_stream_socket<Protocol>& s, int fd,
+    uint64_t offset, std::size_t length,
+    WriteHandler&& handler)
+{
+  return async_send_file(s, fd, offset, length, transfer_all(),
+      static_cast<WriteHandler&&>(handler));
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_SEND_FILE_HPP
@@ -200,6 +200,9 @@ namespace detail
     : detail::base_from_completion_cond<CompletionCondition>
   {
   public:
+    typedef asio::detail::consuming_buffers<const_buffer,
+        ConstBufferSequence, ConstBufferIterator> buffers_type;
+
     write_op(AsyncWriteStream& stream, const ConstBufferSequence& buffers,
         CompletionCondition completion_condition, WriteHandler& handler)
       : detail::base_from_completion_cond<
@@ -224,7 +227,7 @@ namespace detail
     write_op(write_op&& other)
       : detail::base_from_completion_cond<CompletionCondition>(other),
         stream_(other.stream_),
-        buffers_(other.buffers_),
+        buffers_(static_cast<buffers_type&&>(other.buffers_)),
         start_(other.start_),
         handler_(static_cast<WriteHandler&&>(other.handler_))
     {
@@ -256,8 +259,7 @@ namespace detail
 
   //private:
     AsyncWriteStream& stream_;
-    asio::detail::consuming_buffers<const_buffer,
-        ConstBufferSequence, ConstBufferIterator> buffers_;
+    buffers_type buffers_;
     int start_;
     WriteHandler handler_;
   };
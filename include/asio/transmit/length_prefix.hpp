@@ -0,0 +1,436 @@
+#ifndef ASIO_LENGTH_PREFIX_HPP
+#define ASIO_LENGTH_PREFIX_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include "asio/buffer/buffer.hpp"
+#include "asio/error/error.hpp"
+#include "asio/error/throw_exception.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Describes how the length of a frame is encoded in front of its payload.
+/**
+ * A length_prefix is used with read_frames and async_read_frames to split a
+ * stream into frames that each start with the length of their payload, and
+ * with framed_buffers to write such frames. Two encodings are supported:
+ *
+ * @li A variable-width encoding, created by varint(), with seven bits of the
+ * length in each byte, least significant first, and the high bit of each byte
+ * set if another byte follows. Small frames therefore need only a one byte
+ * header.
+ *
+ * @li A fixed-width encoding, created by fixed(), with the length as an
+ * unsigned integer of 1 to 8 bytes in network byte order.
+ *
+ * Each length_prefix also has a maximum frame size. A frame whose length
+ * exceeds it is rejected with asio::error::message_size before any of its
+ * payload is read, so that a peer cannot make the receiver buffer an
+ * arbitrary amount of data.
+ *
+ * @par Example
+ * @code
+ * asio::length_prefix prefix = asio::length_prefix::fixed(4, 65536);
+ * std::string data;
+ * std::vector<asio::const_buffer> frames;
+ * std::size_t n = asio::read_frames(socket,
+ *     asio::dynamic_buffer(data), prefix, frames);
+ * @endcode
+ */
+class length_prefix
+{
+public:
+  /// The largest header that any encoding produces.
+  ASIO_STATIC_CONSTANT(std::size_t, max_header_size = 10);
+
+  /// The default maximum frame size.
+  ASIO_STATIC_CONSTANT(std::size_t, default_max_frame_size = 1048576);
+
+  /// Create a variable-width length prefix.
+  static length_prefix varint(
+      std::size_t max_frame_size = default_max_frame_size)
+  {
+    return length_prefix(0, max_frame_size);
+  }
+
+  /// Create a fixed-width length prefix.
+  /**
+   * @param width The number of bytes in the prefix, from 1 to 8.
+   *
+   * @param max_frame_size The largest payload to accept. It is reduced if
+   * necessary to the largest length that can be encoded in @c width bytes.
+   *
+   * @throws std::invalid_argument Thrown if @c width is out of range.
+   */
+  static length_prefix fixed(std::size_t width,
+      std::size_t max_frame_size = default_max_frame_size)
+  {
+    if (width < 1 || width > 8)
+    {
+      std::invalid_argument ex("length_prefix width out of range");
+      asio::detail::throw_exception(ex);
+    }
+
+    if (width < sizeof(std::size_t))
+    {
+      std::size_t limit = (std::size_t(1) << (width * 8)) - 1;
+      if (max_frame_size > limit)
+        max_frame_size = limit;
+    }
+
+    return length_prefix(width, max_frame_size);
+  }
+
+  /// Get the largest payload that will be accepted.
+  std::size_t max_frame_size() const ASIO_NOEXCEPT
+  {
+    return max_frame_size_;
+  }
+
+  /// Get the width of the prefix, or 0 if it is variable.
+  std::size_t width() const ASIO_NOEXCEPT
+  {
+    return width_;
+  }
+
+  /// Get the size of the header for a payload of the given length.
+  std::size_t header_size(std::size_t length) const ASIO_NOEXCEPT
+  {
+    if (width_ > 0)
+      return width_;
+
+    std::size_t n = 1;
+    for (; length >= 0x80; length >>= 7)
+      ++n;
+    return n;
+  }
+
+  /// Encode the header for a payload of the given length.
+  /**
+   * @param length The length of the payload, which must not exceed
+   * max_frame_size().
+   *
+   * @param header The location to which the header is written. It must have
+   * room for header_size(length) bytes.
+   *
+   * @returns The size of the header.
+   */
+  std::size_t encode(std::size_t length, void* header) const ASIO_NOEXCEPT
+  {
+    unsigned char* p = static_cast<unsigned char*>(header);
+    if (width_ > 0)
+    {
+      for (std::size_t i = width_; i > 0; --i, length >>= 8)
+        p[i - 1] = static_cast<unsigned char>(length & 0xFF);
+      return width_;
+    }
+
+    std::size_t n = 0;
+    for (; length >= 0x80; length >>= 7)
+      p[n++] = static_cast<unsigned char>((length & 0x7F) | 0x80);
+    p[n++] = static_cast<unsigned char>(length);
+    return n;
+  }
+
+  /// Decode the header at the start of some data.
+  /**
+   * @param data The data, which starts with a header.
+   *
+   * @param size The number of bytes of data available.
+   *
+   * @param length Set to the length of the payload if a complete header was
+   * decoded.
+   *
+   * @param ec Set to asio::error::message_size if the length exceeds
+   * max_frame_size() or cannot be represented.
+   *
+   * @returns The size of the header, or 0 if the data does not yet contain a
+   * complete header or an error occurred.
+   */
+  std::size_t decode(const void* data, std::size_t size,
+      std::size_t& length, asio::error_code& ec) const ASIO_NOEXCEPT
+  {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    ec = asio::error_code();
+    std::size_t value = 0;
+    std::size_t n = 0;
+    if (width_ > 0)
+    {
+      if (size < width_)
+        return 0;
+      for (; n < width_; ++n)
+      {
+        if (value > (max_frame_size_ >> 8))
+        {
+          ec = asio::error::message_size;
+          return 0;
+        }
+        value = (value << 8) | p[n];
+      }
+    }
+    else
+    {
+      for (std::size_t shift = 0;; shift += 7)
+      {
+        if (n == size)
+          return 0;
+        std::size_t bits = p[n] & 0x7F;
+        if (shift >= sizeof(std::size_t) * 8
+            || (bits << shift >> shift) != bits)
+        {
+          ec = asio::error::message_size;
+          return 0;
+        }
+        value |= bits << shift;
+        if ((p[n++] & 0x80) == 0)
+          break;
+      }
+    }
+
+    if (value > max_frame_size_)
+    {
+      ec = asio::error::message_size;
+      return 0;
+    }
+
+    length = value;
+    return n;
+  }
+
+private:
+  length_prefix(std::size_t width, std::size_t max_frame_size)
+    : width_(width),
+      max_frame_size_(max_frame_size)
+  {
+  }
+
+  std::size_t width_;
+  std::size_t max_frame_size_;
+};
+
+/// A buffer sequence that writes payloads as length-prefixed frames.
+/**
+ * The framed_buffers class collects the payloads of one or more frames and
+ * encodes their headers into storage that it owns, so that all of the frames
+ * can be written with a single gather write and no payload is copied. Its
+ * storage is reused after clear().
+ *
+ * The framed_buffers object meets the ConstBufferSequence requirements, but
+ * copying it copies its storage. Asynchronous operations hold a copy of the
+ * buffer sequence they are given, so they should be given the non-owning view
+ * returned by buffers() instead. A framed_buffers object that is kept with a
+ * connection and written through buffers() does not allocate once it has
+ * grown to the largest batch of frames written.
+ *
+ * The buffers refer to the payloads, which must remain valid until the write
+ * has completed, and to the headers, which are owned by the framed_buffers
+ * object. The object must therefore not be modified or destroyed until the
+ * write has completed.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::framed_buffers frames(asio::length_prefix::varint());
+ * for (std::size_t i = 0; i < messages.size(); ++i)
+ *   frames.push_back(asio::buffer(messages[i]));
+ * asio::async_write(socket, frames.buffers(), handler);
+ * @endcode
+ */
+class framed_buffers
+{
+public:
+  /// The type for each element in the list of buffers.
+  typedef asio::const_buffer value_type;
+
+  /// A random-access iterator type that may be used to read elements.
+  typedef std::vector<asio::const_buffer>::const_iterator const_iterator;
+
+  /// A non-owning view of the buffers, which is cheap to copy.
+  /**
+   * The view meets the ConstBufferSequence requirements. It refers to the
+   * buffers of the framed_buffers object, and is invalidated when the object
+   * is modified or destroyed.
+   */
+  class const_buffers_type
+  {
+  public:
+    /// The type for each element in the list of buffers.
+    typedef asio::const_buffer value_type;
+
+    /// A random-access iterator type that may be used to read elements.
+    typedef const asio::const_buffer* const_iterator;
+
+    /// Get a random-access iterator to the first element.
+    const_iterator begin() const ASIO_NOEXCEPT
+    {
+      return begin_;
+    }
+
+    /// Get a random-access iterator for one past the last element.
+    const_iterator end() const ASIO_NOEXCEPT
+    {
+      return end_;
+    }
+
+  private:
+    friend class framed_buffers;
+
+    const_buffers_type(const_iterator b, const_iterator e) ASIO_NOEXCEPT
+      : begin_(b),
+        end_(e)
+    {
+    }
+
+    const_iterator begin_;
+    const_iterator end_;
+  };
+
+  /// Construct with storage for the given number of frames.
+  explicit framed_buffers(const length_prefix& prefix,
+      std::size_t frames_hint = 16)
+    : prefix_(prefix),
+      headers_(frames_hint * length_prefix::max_header_size),
+      headers_used_(0),
+      frames_(0),
+      size_(0)
+  {
+    buffers_.reserve(frames_hint * 2);
+    header_indexes_.reserve(frames_hint);
+  }
+
+  /// Add a frame with the given payload.
+  /**
+   * @param payload The payload of the frame, which may be any buffer or
+   * ConstBufferSequence.
+   *
+   * @throws std::length_error Thrown if the payload is larger than the
+   * maximum frame size of the length prefix.
+   */
+  template <typename ConstBufferSequence>
+  void push_back(const ConstBufferSequence& payload)
+  {
+    std::size_t length = asio::buffer_size(payload);
+    if (length > prefix_.max_frame_size())
+    {
+      std::length_error ex("framed_buffers frame too long");
+      asio::detail::throw_exception(ex);
+    }
+
+    if (headers_.size() - headers_used_ < length_prefix::max_header_size)
+      grow_headers();
+
+    char* header = &headers_[0] + headers_used_;
+    std::size_t header_size = prefix_.encode(length, header);
+    headers_used_ += header_size;
+    header_indexes_.push_back(buffers_.size());
+    buffers_.push_back(asio::const_buffer(header, header_size));
+
+    push_payload(asio::buffer_sequence_begin(payload),
+        asio::buffer_sequence_end(payload));
+
+    ++frames_;
+    size_ += header_size + length;
+  }
+
+  /// Remove all frames, keeping the storage for reuse.
+  void clear() ASIO_NOEXCEPT
+  {
+    buffers_.clear();
+    header_indexes_.clear();
+    headers_used_ = 0;
+    frames_ = 0;
+    size_ = 0;
+  }
+
+  /// Get the number of frames.
+  std::size_t frames() const ASIO_NOEXCEPT
+  {
+    return frames_;
+  }
+
+  /// Get the total number of bytes in the frames, including their headers.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// Determine whether there are no frames.
+  bool empty() const ASIO_NOEXCEPT
+  {
+    return frames_ == 0;
+  }
+
+  /// Get a random-access iterator to the first element.
+  const_iterator begin() const ASIO_NOEXCEPT
+  {
+    return buffers_.begin();
+  }
+
+  /// Get a random-access iterator for one past the last element.
+  const_iterator end() const ASIO_NOEXCEPT
+  {
+    return buffers_.end();
+  }
+
+  /// Get a non-owning view of the buffers, for use with asynchronous
+  /// operations.
+  const_buffers_type buffers() const ASIO_NOEXCEPT
+  {
+    return const_buffers_type(buffers_.data(),
+        buffers_.data() + buffers_.size());
+  }
+
+private:
+  template <typename Iterator>
+  void push_payload(Iterator begin, Iterator end)
+  {
+    for (Iterator iter = begin; iter != end; ++iter)
+    {
+      asio::const_buffer b(*iter);
+      if (b.size() > 0)
+        buffers_.push_back(b);
+    }
+  }
+
+  // Enlarge the header storage, moving the existing header buffers with it.
+  void grow_headers()
+  {
+    std::vector<char> headers(
+        (headers_.size() + length_prefix::max_header_size) * 2);
+    const char* old_base = headers_.empty() ? 0 : &headers_[0];
+    char* new_base = &headers[0];
+    if (headers_used_ > 0)
+      std::memcpy(new_base, old_base, headers_used_);
+
+    for (std::size_t i = 0; i < header_indexes_.size(); ++i)
+    {
+      asio::const_buffer& b = buffers_[header_indexes_[i]];
+      b = asio::const_buffer(new_base
+          + (static_cast<const char*>(b.data()) - old_base), b.size());
+    }
+
+    headers_.swap(headers);
+  }
+
+  length_prefix prefix_;
+  std::vector<char> headers_;
+  std::size_t headers_used_;
+  std::vector<std::size_t> header_indexes_;
+  std::vector<asio::const_buffer> buffers_;
+  std::size_t frames_;
+  std::size_t size_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_LENGTH_PREFIX_HPP
@@ -0,0 +1,272 @@
+#ifndef ASIO_PARALLEL_CONNECT_HPP
+#define ASIO_PARALLEL_CONNECT_HPP
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_CHRONO)
+
+#include "asio/core/executor/helper/async_result.hpp"
+#include "asio/network/basic_socket.hpp"
+#include "asio/service/timer/steady_timer.hpp"
+#include "asio/transmit/connect.hpp"
+#include "asio/detail/base/stdcpp/type_traits.hpp"
+#include "asio/detail/memory/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/error/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+namespace detail
+{
+  // The interface through which an outstanding async_connect_parallel
+  // operation is cancelled.
+  class parallel_connect_op_base
+  {
+  public:
+    virtual void cancel() = 0;
+
+  protected:
+    ~parallel_connect_op_base()
+    {
+    }
+  };
+} // namespace detail
+
+/// Cancels an outstanding async_connect_parallel operation.
+/**
+ * The connection attempts made by async_connect_parallel use sockets of their
+ * own, so closing or cancelling the socket passed to async_connect_parallel
+ * does not stop them. To abandon the operation, pass a
+ * parallel_connect_canceller to async_connect_parallel and call its cancel()
+ * member function.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code asio::parallel_connect_canceller canceller;
+ * asio::async_connect_parallel(socket, endpoints,
+ *     asio::chrono::milliseconds(250), canceller, connect_handler);
+ * ...
+ * canceller.cancel(); @endcode
+ */
+class parallel_connect_canceller
+  : private detail::noncopyable
+{
+public:
+  /// Constructor.
+  parallel_connect_canceller()
+  {
+  }
+
+  /// Cancel the operation most recently started with this canceller.
+  /**
+   * Every outstanding connection attempt is cancelled and its socket is
+   * closed. The handler is called with asio::error::operation_aborted,
+   * even if an attempt had already succeeded, and the socket passed to
+   * async_connect_parallel is left closed. Has no effect if the handler has
+   * already been called.
+   */
+  void cancel()
+  {
+    detail::shared_ptr<detail::parallel_connect_op_base> op = op_.lock();
+    if (op)
+      op->cancel();
+  }
+
+#if !defined(GENERATING_DOCUMENTATION)
+  // Associate the canceller with an operation. For internal use only.
+  void attach(const detail::shared_ptr<detail::parallel_connect_op_base>& op)
+  {
+    op_ = op;
+  }
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+private:
+  detail::weak_ptr<detail::parallel_connect_op_base> op_;
+};
+
+/**
+ * @defgroup async_connect_parallel asio::async_connect_parallel
+ *
+ * @brief The @c async_connect_parallel function is a composed asynchronous
+ * operation that establishes a socket connection by making staggered,
+ * concurrent connection attempts to the endpoints in a sequence.
+ */
+/*@{*/
+
+/// Asynchronously establishes a socket connection by racing staggered
+/// connection attempts to each endpoint in a sequence.
+/**
+ * This function attempts to connect a socket to one of a sequence of
+ * endpoints, using the "Happy Eyeballs" algorithm described in RFC 8305. The
+ * endpoints are reordered so that address families alternate, starting with
+ * the family of the first endpoint. A connection attempt is started to the
+ * first endpoint. If it has not completed after @c attempt_delay, an attempt
+ * to the next endpoint is started in parallel, and so on. When an attempt
+ * fails, the attempt to the next endpoint is started immediately.
+ *
+ * The first attempt to succeed wins. All other attempts are cancelled and
+ * their sockets are closed, and the winning connection is moved into @c s.
+ * The handler is called once every attempt has finished, so that no
+ * operations remain outstanding on the losing sockets.
+ *
+ * Unlike async_connect, a blackholed endpoint delays the connection by no
+ * more than @c attempt_delay.
+ *
+ * The attempts use sockets of their own, so closing or cancelling @c s does
+ * not stop them. Use the overload that takes a parallel_connect_canceller to
+ * abandon the operation.
+ *
+ * @param s The socket to be connected. If the socket is already open, it will
+ * be closed.
+ *
+ * @param endpoints A sequence of endpoints.
+ *
+ * @param attempt_delay The time to wait for an attempt to complete before the
+ * next attempt is started. RFC 8305 recommends 250 milliseconds.
+ *
+ * @param handler The handler to be called when the connect operation
+ * completes. Copies will be made of the handler as required. The function
+ * signature of the handler must be:
+ * @code void handler(
+ *   // Result of operation. if the sequence is empty, set to
+ *   // asio::error::not_found. Otherwise, contains the
+ *   // error from the last connection attempt to fail.
+ *   const asio::error_code& error,
+ *
+ *   // On success, the successfully connected endpoint.
+ *   // Otherwise, a default-constructed endpoint.
+ *   const typename Protocol::endpoint& endpoint
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation
+ * of the handler will be performed in a manner equivalent to using
+ * asio::io_context::post().
+ *
+ * @par Example
+ * @code void resolve_handler(
+ *     const asio::error_code& ec,
+ *     tcp::resolver::results_type results)
+ * {
+ *   if (!ec)
+ *   {
+ *     asio::async_connect_parallel(s, results,
+ *         asio::chrono::milliseconds(250), connect_handler);
+ *   }
+ * } @endcode
+ */
+template <typename Protocol,
+    typename EndpointSequence, typename RangeConnectHandler>
+ASIO_INITFN_RESULT_TYPE(RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint))
+async_connect_parallel(basic_socket<Protocol>& s,
+    const EndpointSequence& endpoints,
+    const steady_timer::duration& attempt_delay,
+    ASIO_MOVE_ARG(RangeConnectHandler) handler,
+    typename enable_if<is_endpoint_sequence<
+        EndpointSequence>::value>::type* = 0);
+
+/// Asynchronously establishes a socket connection by racing staggered
+/// connection attempts to each endpoint in a sequence, with support for
+/// cancellation.
+/**
+ * This function attempts to connect a socket to one of a sequence of
+ * endpoints, as described above. Calling @c canceller.cancel() before the
+ * handler has been called abandons every attempt, and the handler is then
+ * called with asio::error::operation_aborted.
+ *
+ * @param s The socket to be connected. If the socket is already open, it will
+ * be closed.
+ *
+ * @param endpoints A sequence of endpoints.
+ *
+ * @param attempt_delay The time to wait for an attempt to complete before the
+ * next attempt is started.
+ *
+ * @param canceller The object used to cancel the operation. It is associated
+ * with this operation until another operation is started with it.
+ *
+ * @param handler The handler to be called when the connect operation
+ * completes. Copies will be made of the handler as required. The function
+ * signature of the handler must be:
+ * @code void handler(
+ *   // Result of operation. If the operation was cancelled, set to
+ *   // asio::error::operation_aborted.
+ *   const asio::error_code& error,
+ *
+ *   // On success, the successfully connected endpoint.
+ *   // Otherwise, a default-constructed endpoint.
+ *   const typename Protocol::endpoint& endpoint
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation
+ * of the handler will be performed in a manner equivalent to using
+ * asio::io_context::post().
+ */
+template <typename Protocol,
+    typename EndpointSequence, typename RangeConnectHandler>
+ASIO_INITFN_RESULT_TYPE(RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint))
+async_connect_parallel(basic_socket<Protocol>& s,
+    const EndpointSequence& endpoints,
+    const steady_timer::duration& attempt_delay,
+    parallel_connect_canceller& canceller,
+    ASIO_MOVE_ARG(RangeConnectHandler) handler,
+    typename enable_if<is_endpoint_sequence<
+        EndpointSequence>::value>::type* = 0);
+
+/// Asynchronously establishes a socket connection by racing staggered
+/// connection attempts to each endpoint in a sequence.
+/**
+ * This function attempts to connect a socket to one of a sequence of
+ * endpoints, as described above, using the 250 millisecond attempt delay
+ * recommended by RFC 8305.
+ *
+ * @param s The socket to be connected. If the socket is already open, it will
+ * be closed.
+ *
+ * @param endpoints A sequence of endpoints.
+ *
+ * @param handler The handler to be called when the connect operation
+ * completes. Copies will be made of the handler as required. The function
+ * signature of the handler must be:
+ * @code void handler(
+ *   // Result of operation. if the sequence is empty, set to
+ *   // asio::error::not_found. Otherwise, contains the
+ *   // error from the last connection attempt to fail.
+ *   const asio::error_code& error,
+ *
+ *   // On success, the successfully connected endpoint.
+ *   // Otherwise, a default-constructed endpoint.
+ *   const typename Protocol::endpoint& endpoint
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation
+ * of the handler will be performed in a manner equivalent to using
+ * asio::io_context::post().
+ */
+template <typename Protocol,
+    typename EndpointSequence, typename RangeConnectHandler>
+ASIO_INITFN_RESULT_TYPE(RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint))
+async_connect_parallel(basic_socket<Protocol>& s,
+    const EndpointSequence& endpoints,
+    ASIO_MOVE_ARG(RangeConnectHandler) handler,
+    typename enable_if<is_endpoint_sequence<
+        EndpointSequence>::value>::type* = 0);
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/transmit/impl/parallel_connect.hpp"
+
+#endif // defined(ASIO_HAS_CHRONO)
+
+#endif // ASIO_PARALLEL_CONNECT_HPP
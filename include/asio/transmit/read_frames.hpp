@@ -0,0 +1,477 @@
+#ifndef ASIO_READ_FRAMES_HPP
+#define ASIO_READ_FRAMES_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <vector>
+#include "asio/buffer/buffer.hpp"
+#include "asio/core/executor/helper/async_result.hpp"
+#include "asio/detail/base/stdcpp/string_view.hpp"
+#include "asio/detail/base/stdcpp/type_traits.hpp"
+#include "asio/error/error.hpp"
+#include "asio/transmit/length_prefix.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/**
+ * @defgroup read_frames asio::read_frames
+ *
+ * @brief The @c read_frames function is a composed operation that reads data
+ * into a dynamic buffer sequence until it contains at least one complete
+ * delimited or length-prefixed frame, and returns all of the complete frames
+ * it contains.
+ */
+/*@{*/
+
+/// Read data into a dynamic buffer sequence until it contains one or more
+/// frames ending with a specified delimiter.
+/**
+ * This function is used to read data into the specified dynamic buffer
+ * sequence until the dynamic buffer sequence's get area contains the specified
+ * delimiter. Every complete frame in the get area, up to and including the
+ * last delimiter, is then returned in @c frames. The call will block until
+ * one of the following conditions is true:
+ *
+ * @li The get area of the dynamic buffer sequence contains the specified
+ * delimiter.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of zero or more calls to the stream's
+ * read_some function. If the dynamic buffer sequence's get area already
+ * contains the delimiter, the function returns immediately.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the SyncReadStream concept.
+ *
+ * @param buffers The dynamic buffer sequence into which the data will be read.
+ * Its get area must be a single contiguous buffer, as is the case for
+ * dynamic_string_buffer and dynamic_vector_buffer.
+ *
+ * @param delim The delimiter character.
+ *
+ * @param frames Cleared, and then filled with a buffer for each complete frame,
+ * including its delimiter. The buffers refer to the get area of the dynamic
+ * buffer sequence, and remain valid until it is next modified.
+ *
+ * @returns The number of bytes in the dynamic buffer sequence's get area up to
+ * and including the last delimiter.
+ *
+ * @throws asio::system_error Thrown on failure.
+ *
+ * @note The returned number of bytes should be consumed from the dynamic buffer
+ * sequence once the frames have been processed. Any partial frame after the
+ * last delimiter is left for a subsequent read_frames operation.
+ *
+ * @par Example
+ * To read all complete lines into a @c std::string:
+ * @code std::string data;
+ * std::vector<asio::const_buffer> lines;
+ * std::size_t n = asio::read_frames(s,
+ *     asio::dynamic_buffer(data), '\n', lines);
+ * for (std::size_t i = 0; i < lines.size(); ++i)
+ *   process_line(lines[i]);
+ * data.erase(0, n); @endcode
+ */
+template <typename SyncReadStream, typename DynamicBuffer>
+std::size_t read_frames(SyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers, char delim,
+    std::vector<asio::const_buffer>& frames);
+
+/// Read data into a dynamic buffer sequence until it contains one or more
+/// frames ending with a specified delimiter.
+/**
+ * This function is used to read data into the specified dynamic buffer
+ * sequence until the dynamic buffer sequence's get area contains the specified
+ * delimiter. Every complete frame in the get area, up to and including the
+ * last delimiter, is then returned in @c frames. The call will block until
+ * one of the following conditions is true:
+ *
+ * @li The get area of the dynamic buffer sequence contains the specified
+ * delimiter.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of zero or more calls to the stream's
+ * read_some function. If the dynamic buffer sequence's get area already
+ * contains the delimiter, the function returns immediately.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the SyncReadStream concept.
+ *
+ * @param buffers The dynamic buffer sequence into which the data will be read.
+ * Its get area must be a single contiguous buffer.
+ *
+ * @param delim The delimiter character.
+ *
+ * @param frames Cleared, and then filled with a buffer for each complete frame,
+ * including its delimiter.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes in the dynamic buffer sequence's get area up to
+ * and including the last delimiter. Returns 0 if an error occurred.
+ */
+template <typename SyncReadStream, typename DynamicBuffer>
+std::size_t read_frames(SyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers, char delim,
+    std::vector<asio::const_buffer>& frames, asio::error_code& ec);
+
+/// Read data into a dynamic buffer sequence until it contains one or more
+/// frames ending with a specified delimiter.
+/**
+ * This function is used to read data into the specified dynamic buffer
+ * sequence until the dynamic buffer sequence's get area contains the specified
+ * delimiter. Every complete frame in the get area, up to and including the
+ * last delimiter, is then returned in @c frames.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the SyncReadStream concept.
+ *
+ * @param buffers The dynamic buffer sequence into which the data will be read.
+ * Its get area must be a single contiguous buffer.
+ *
+ * @param delim The delimiter string. Must not be empty.
+ *
+ * @param frames Cleared, and then filled with a buffer for each complete frame,
+ * including its delimiter.
+ *
+ * @returns The number of bytes in the dynamic buffer sequence's get area up to
+ * and including the last delimiter.
+ *
+ * @throws asio::system_error Thrown on failure.
+ */
+template <typename SyncReadStream, typename DynamicBuffer>
+std::size_t read_frames(SyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers,
+    ASIO_STRING_VIEW_PARAM delim,
+    std::vector<asio::const_buffer>& frames);
+
+/// Read data into a dynamic buffer sequence until it contains one or more
+/// frames ending with a specified delimiter.
+/**
+ * This function is used to read data into the specified dynamic buffer
+ * sequence until the dynamic buffer sequence's get area contains the specified
+ * delimiter. Every complete frame in the get area, up to and including the
+ * last delimiter, is then returned in @c frames.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the SyncReadStream concept.
+ *
+ * @param buffers The dynamic buffer sequence into which the data will be read.
+ * Its get area must be a single contiguous buffer.
+ *
+ * @param delim The delimiter string. Must not be empty.
+ *
+ * @param frames Cleared, and then filled with a buffer for each complete frame,
+ * including its delimiter.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes in the dynamic buffer sequence's get area up to
+ * and including the last delimiter. Returns 0 if an error occurred.
+ */
+template <typename SyncReadStream, typename DynamicBuffer>
+std::size_t read_frames(SyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers,
+    ASIO_STRING_VIEW_PARAM delim,
+    std::vector<asio::const_buffer>& frames, asio::error_code& ec);
+
+/// Read data into a dynamic buffer sequence until it contains one or more
+/// length-prefixed frames.
+/**
+ * This function is used to read data into the specified dynamic buffer
+ * sequence until the dynamic buffer sequence's get area contains at least one
+ * complete frame, made up of a header encoded as described by @c prefix and
+ * the payload whose length it gives. The payload of every complete frame in
+ * the get area is then returned in @c frames. The call will block until one of
+ * the following conditions is true:
+ *
+ * @li The get area of the dynamic buffer sequence contains a complete frame.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of zero or more calls to the stream's
+ * read_some function. Once the header of a frame has been received, each read
+ * is made large enough to complete the frame. If the dynamic buffer
+ * sequence's get area already contains a complete frame, the function returns
+ * immediately.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the SyncReadStream concept.
+ *
+ * @param buffers The dynamic buffer sequence into which the data will be read.
+ * Its get area must be a single contiguous buffer.
+ *
+ * @param prefix The encoding of the frame headers, and the maximum frame size.
+ *
+ * @param frames Cleared, and then filled with a buffer for the payload of each
+ * complete frame. The buffers refer to the get area of the dynamic buffer
+ * sequence, and remain valid until it is next modified.
+ *
+ * @returns The number of bytes in the dynamic buffer sequence's get area up to
+ * the end of the last complete frame.
+ *
+ * @throws asio::system_error Thrown on failure. A frame larger than the
+ * maximum frame size fails with asio::error::message_size.
+ *
+ * @par Example
+ * @code std::string data;
+ * std::vector<asio::const_buffer> frames;
+ * std::size_t n = asio::read_frames(s, asio::dynamic_buffer(data),
+ *     asio::length_prefix::varint(), frames);
+ * for (std::size_t i = 0; i < frames.size(); ++i)
+ *   process_message(frames[i]);
+ * data.erase(0, n); @endcode
+ */
+template <typename SyncReadStream, typename DynamicBuffer>
+std::size_t read_frames(SyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers, const length_prefix& prefix,
+    std::vector<asio::const_buffer>& frames);
+
+/// Read data into a dynamic buffer sequence until it contains one or more
+/// length-prefixed frames.
+/**
+ * This function is used to read data into the specified dynamic buffer
+ * sequence until the dynamic buffer sequence's get area contains at least one
+ * complete frame. The payload of every complete frame in the get area is then
+ * returned in @c frames.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the SyncReadStream concept.
+ *
+ * @param buffers The dynamic buffer sequence into which the data will be read.
+ * Its get area must be a single contiguous buffer.
+ *
+ * @param prefix The encoding of the frame headers, and the maximum frame size.
+ *
+ * @param frames Cleared, and then filled with a buffer for the payload of each
+ * complete frame.
+ *
+ * @param ec Set to indicate what error occurred, if any. A frame larger than
+ * the maximum frame size fails with asio::error::message_size.
+ *
+ * @returns The number of bytes in the dynamic buffer sequence's get area up to
+ * the end of the last complete frame. Returns 0 if an error occurred.
+ */
+template <typename SyncReadStream, typename DynamicBuffer>
+std::size_t read_frames(SyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers, const length_prefix& prefix,
+    std::vector<asio::const_buffer>& frames, asio::error_code& ec);
+
+/*@}*/
+/**
+ * @defgroup async_read_frames asio::async_read_frames
+ *
+ * @brief The @c async_read_frames function is a composed asynchronous
+ * operation that reads data into a dynamic buffer sequence until it contains
+ * at least one complete delimited or length-prefixed frame, and returns all of
+ * the complete frames it contains.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to read data into a dynamic buffer sequence
+/// until it contains one or more frames ending with a specified delimiter.
+/**
+ * This function is used to asynchronously read data into the specified dynamic
+ * buffer sequence until the dynamic buffer sequence's get area contains the
+ * specified delimiter. Every complete frame in the get area, up to and
+ * including the last delimiter, is then returned in @c frames, so that a
+ * single completion delivers all of the frames received by a read. The
+ * function call always returns immediately. The asynchronous operation will
+ * continue until one of the following conditions is true:
+ *
+ * @li The get area of the dynamic buffer sequence contains the specified
+ * delimiter.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of zero or more calls to the stream's
+ * async_read_some function, and is known as a <em>composed operation</em>. If
+ * the dynamic buffer sequence's get area already contains the delimiter, this
+ * asynchronous operation completes immediately. The program must ensure that
+ * the stream performs no other read operations (such as async_read,
+ * async_read_until, the stream's async_read_some function, or any other
+ * composed operations that perform reads) until this operation completes.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the AsyncReadStream concept.
+ *
+ * @param buffers The dynamic buffer sequence into which the data will be read.
+ * Its get area must be a single contiguous buffer. Although the buffers object
+ * may be copied as necessary, ownership of the underlying memory blocks is
+ * retained by the caller, which must guarantee that they remain valid until
+ * the handler is called.
+ *
+ * @param delim The delimiter character.
+ *
+ * @param frames Cleared, and then filled with a buffer for each complete frame,
+ * including its delimiter. The buffers refer to the get area of the dynamic
+ * buffer sequence, and remain valid until it is next modified. The caller must
+ * guarantee that the vector remains valid until the handler is called.
+ *
+ * @param handler The handler to be called when the read operation completes.
+ * Copies will be made of the handler as required. The function signature of the
+ * handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // The number of bytes in the dynamic buffer sequence's
+ *   // get area up to and including the last delimiter.
+ *   // 0 if an error occurred.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation of
+ * the handler will be performed in a manner equivalent to using
+ * asio::io_context::post().
+ *
+ * @par Example
+ * To asynchronously read all complete lines into a @c std::string:
+ * @code std::string data;
+ * std::vector<asio::const_buffer> lines;
+ * ...
+ * void handler(const asio::error_code& e, std::size_t n)
+ * {
+ *   if (!e)
+ *   {
+ *     for (std::size_t i = 0; i < lines.size(); ++i)
+ *       process_line(lines[i]);
+ *     data.erase(0, n);
+ *     ...
+ *   }
+ * }
+ * ...
+ * asio::async_read_frames(s, asio::dynamic_buffer(data),
+ *     '\n', lines, handler); @endcode
+ */
+template <typename AsyncReadStream,
+    typename DynamicBuffer, typename ReadHandler>
+ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_read_frames(AsyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers, char delim,
+    std::vector<asio::const_buffer>& frames,
+    ASIO_MOVE_ARG(ReadHandler) handler);
+
+/// Start an asynchronous operation to read data into a dynamic buffer sequence
+/// until it contains one or more frames ending with a specified delimiter.
+/**
+ * This function is used to asynchronously read data into the specified dynamic
+ * buffer sequence until the dynamic buffer sequence's get area contains the
+ * specified delimiter. Every complete frame in the get area, up to and
+ * including the last delimiter, is then returned in @c frames. The function
+ * call always returns immediately.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the AsyncReadStream concept.
+ *
+ * @param buffers The dynamic buffer sequence into which the data will be read.
+ * Its get area must be a single contiguous buffer. Ownership of the underlying
+ * memory blocks is retained by the caller, which must guarantee that they
+ * remain valid until the handler is called.
+ *
+ * @param delim The delimiter string. Must not be empty.
+ *
+ * @param frames Cleared, and then filled with a buffer for each complete frame,
+ * including its delimiter. The caller must guarantee that the vector remains
+ * valid until the handler is called.
+ *
+ * @param handler The handler to be called when the read operation completes.
+ * Copies will be made of the handler as required. The function signature of the
+ * handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // The number of bytes in the dynamic buffer sequence's
+ *   // get area up to and including the last delimiter.
+ *   // 0 if an error occurred.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation of
+ * the handler will be performed in a manner equivalent to using
+ * asio::io_context::post().
+ */
+template <typename AsyncReadStream,
+    typename DynamicBuffer, typename ReadHandler>
+ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_read_frames(AsyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers,
+    ASIO_STRING_VIEW_PARAM delim,
+    std::vector<asio::const_buffer>& frames,
+    ASIO_MOVE_ARG(ReadHandler) handler);
+
+/// Start an asynchronous operation to read data into a dynamic buffer sequence
+/// until it contains one or more length-prefixed frames.
+/**
+ * This function is used to asynchronously read data into the specified dynamic
+ * buffer sequence until the dynamic buffer sequence's get area contains at
+ * least one complete frame, made up of a header encoded as described by
+ * @c prefix and the payload whose length it gives. The payload of every
+ * complete frame in the get area is then returned in @c frames, so that a
+ * single completion delivers all of the frames received by a read. The
+ * function call always returns immediately.
+ *
+ * This operation is implemented in terms of zero or more calls to the stream's
+ * async_read_some function, and is known as a <em>composed operation</em>.
+ * Once the header of a frame has been received, each read is made large
+ * enough to complete the frame. The program must ensure that the stream
+ * performs no other read operations until this operation completes.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the AsyncReadStream concept.
+ *
+ * @param buffers The dynamic buffer sequence into which the data will be read.
+ * Its get area must be a single contiguous buffer. Ownership of the underlying
+ * memory blocks is retained by the caller, which must guarantee that they
+ * remain valid until the handler is called.
+ *
+ * @param prefix The encoding of the frame headers, and the maximum frame size.
+ * A frame larger than the maximum frame size fails with
+ * asio::error::message_size.
+ *
+ * @param frames Cleared, and then filled with a buffer for the payload of each
+ * complete frame. The caller must guarantee that the vector remains valid
+ * until the handler is called.
+ *
+ * @param handler The handler to be called when the read operation completes.
+ * Copies will be made of the handler as required. The function signature of the
+ * handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // The number of bytes in the dynamic buffer sequence's
+ *   // get area up to the end of the last complete frame.
+ *   // 0 if an error occurred.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation of
+ * the handler will be performed in a manner equivalent to using
+ * asio::io_context::post().
+ */
+template <typename AsyncReadStream,
+    typename DynamicBuffer, typename ReadHandler>
+ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_read_frames(AsyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers, const length_prefix& prefix,
+    std::vector<asio::const_buffer>& frames,
+    ASIO_MOVE_ARG(ReadHandler) handler);
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/transmit/impl/read_frames.hpp"
+
+#endif // ASIO_READ_FRAMES_HPP
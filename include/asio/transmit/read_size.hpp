@@ -0,0 +1,320 @@
+#ifndef ASIO_READ_SIZE_HPP
+#define ASIO_READ_SIZE_HPP
+
+#include "asio/detail/config.hpp"
+#include <algorithm>
+#include <cstddef>
+#include "asio/detail/base/stdcpp/type_traits.hpp"
+#include "asio/error/error.hpp"
+#include "asio/transmit/completion_condition.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Adapts the size of the reads made into a dynamic buffer to the traffic.
+/**
+ * By default, the read operations on dynamic buffers (read, read_until,
+ * read_frames and their asynchronous forms) prepare between 512 and 65536
+ * bytes for each read, depending only on the spare capacity of the buffer. A
+ * read_size_policy instead tracks the reads actually made on a stream:
+ *
+ * @li When a read fills the space prepared for it, the next read size is
+ * doubled, up to the maximum. If the stream can report how much data is
+ * queued (as sockets do through @c available()), the next read is instead
+ * sized to take exactly that much, within the limits.
+ *
+ * @li When a read uses less than a quarter of the space prepared for it, the
+ * next read size is halved, down to the minimum.
+ *
+ * Bulk transfers therefore make fewer, larger reads, while request/response
+ * traffic does not grow its buffers for data that never arrives.
+ *
+ * A policy is applied by wrapping a dynamic buffer with adaptive_buffer. The
+ * policy object holds the history, so it should be kept with the stream and
+ * reused for each operation on it.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::read_size_policy policy;
+ * std::string data;
+ * ...
+ * std::size_t n = asio::read_until(socket,
+ *     asio::adaptive_buffer(asio::dynamic_buffer(data), policy), '\n');
+ * @endcode
+ */
+class read_size_policy
+{
+public:
+  /// Construct a policy with the given limits.
+  /**
+   * @param min_size The smallest read size that will be used.
+   *
+   * @param max_size The largest read size that will be used.
+   *
+   * @param initial_size The read size to use for the first read.
+   */
+  explicit read_size_policy(std::size_t min_size = 512,
+      std::size_t max_size = 1048576, std::size_t initial_size = 4096)
+    : min_size_(min_size),
+      max_size_(max_size < min_size ? min_size : max_size),
+      size_((std::min)((std::max)(initial_size, min_size_), max_size_)),
+      requested_(0),
+      filled_(false)
+  {
+  }
+
+  /// Get the smallest read size that will be used.
+  std::size_t min_size() const
+  {
+    return min_size_;
+  }
+
+  /// Get the largest read size that will be used.
+  std::size_t max_size() const
+  {
+    return max_size_;
+  }
+
+  /// Get the read size to use for the next read, if no other information is
+  /// available.
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  /// Determine whether the last read filled the space prepared for it, in
+  /// which case more data is likely to be queued on the stream.
+  bool filled() const
+  {
+    return filled_;
+  }
+
+  /// Get the size for the next read, and remember it.
+  /**
+   * @param available The number of bytes known to be queued on the stream, or
+   * 0 if not known.
+   *
+   * @param limit The most that may be read.
+   */
+  std::size_t next(std::size_t available, std::size_t limit)
+  {
+    std::size_t n = available > 0
+      ? (std::min)((std::max)(available, min_size_), max_size_) : size_;
+    requested_ = (std::min)(n, limit);
+    return requested_;
+  }
+
+  /// Record the result of the last read.
+  void record(std::size_t bytes_transferred)
+  {
+    filled_ = requested_ > 0 && bytes_transferred >= requested_;
+    if (filled_)
+      size_ = (std::min)(size_ * 2, max_size_);
+    else if (bytes_transferred < requested_ / 4)
+      size_ = (std::max)(size_ / 2, min_size_);
+    requested_ = 0;
+  }
+
+private:
+  std::size_t min_size_;
+  std::size_t max_size_;
+  std::size_t size_;
+  std::size_t requested_;
+  bool filled_;
+};
+
+/// A dynamic buffer whose reads are sized by a read_size_policy.
+/**
+ * The adaptive_dynamic_buffer class template forwards all DynamicBuffer
+ * operations to the underlying dynamic buffer, and gives the read operations
+ * access to a read_size_policy.
+ */
+template <typename DynamicBuffer>
+class adaptive_dynamic_buffer
+{
+public:
+  /// The type used to represent the input sequence as a list of buffers.
+  typedef typename DynamicBuffer::const_buffers_type const_buffers_type;
+
+  /// The type used to represent the output sequence as a list of buffers.
+  typedef typename DynamicBuffer::mutable_buffers_type mutable_buffers_type;
+
+  /// Construct from a dynamic buffer and a policy.
+  /**
+   * The object stores a reference to the policy and the user is responsible
+   * for ensuring that the policy remains valid until the
+   * adaptive_dynamic_buffer object is destroyed.
+   */
+  adaptive_dynamic_buffer(const DynamicBuffer& buffers,
+      read_size_policy& policy)
+    : buffers_(buffers),
+      policy_(&policy)
+  {
+  }
+
+  /// Copy construct an adaptive dynamic buffer.
+  /**
+   * The copy shares the policy with the original.
+   */
+  adaptive_dynamic_buffer(const adaptive_dynamic_buffer& other)
+    : buffers_(other.buffers_),
+      policy_(other.policy_)
+  {
+  }
+
+#if defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+  /// Construct from a dynamic buffer and a policy.
+  adaptive_dynamic_buffer(DynamicBuffer&& buffers,
+      read_size_policy& policy)
+    : buffers_(ASIO_MOVE_CAST(DynamicBuffer)(buffers)),
+      policy_(&policy)
+  {
+  }
+
+  /// Move construct an adaptive dynamic buffer.
+  adaptive_dynamic_buffer(adaptive_dynamic_buffer&& other)
+    : buffers_(ASIO_MOVE_CAST(DynamicBuffer)(other.buffers_)),
+      policy_(other.policy_)
+  {
+  }
+#endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
+
+  /// Get the read size policy.
+  read_size_policy& policy() const
+  {
+    return *policy_;
+  }
+
+  /// Get the size of the input sequence.
+  std::size_t size() const
+  {
+    return buffers_.size();
+  }
+
+  /// Get the maximum size of the dynamic buffer.
+  std::size_t max_size() const
+  {
+    return buffers_.max_size();
+  }
+
+  /// Get the current capacity of the dynamic buffer.
+  std::size_t capacity() const
+  {
+    return buffers_.capacity();
+  }
+
+  /// Get a list of buffers that represents the input sequence.
+  const_buffers_type data() const
+  {
+    return buffers_.data();
+  }
+
+  /// Get a list of buffers that represents the output sequence, with the given
+  /// size.
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    return buffers_.prepare(n);
+  }
+
+  /// Move bytes from the output sequence to the input sequence.
+  void commit(std::size_t n)
+  {
+    buffers_.commit(n);
+  }
+
+  /// Remove characters from the input sequence.
+  void consume(std::size_t n)
+  {
+    buffers_.consume(n);
+  }
+
+private:
+  DynamicBuffer buffers_;
+  read_size_policy* policy_;
+};
+
+/// Wrap a dynamic buffer so that reads into it are sized by a policy.
+/**
+ * @returns <tt>adaptive_dynamic_buffer<DynamicBuffer>(buffers, policy)</tt>.
+ */
+template <typename DynamicBuffer>
+inline adaptive_dynamic_buffer<typename decay<DynamicBuffer>::type>
+adaptive_buffer(ASIO_MOVE_ARG(DynamicBuffer) buffers,
+    read_size_policy& policy)
+{
+  return adaptive_dynamic_buffer<typename decay<DynamicBuffer>::type>(
+      ASIO_MOVE_CAST(DynamicBuffer)(buffers), policy);
+}
+
+namespace detail {
+
+#if defined(ASIO_HAS_DECLTYPE)
+
+// Get the number of bytes queued on a stream, if the stream can say.
+template <typename Stream>
+inline auto read_size_available(Stream& s, int)
+  -> decltype(s.available(*static_cast<asio::error_code*>(0)))
+{
+  asio::error_code ec;
+  std::size_t n = s.available(ec);
+  return ec ? 0 : n;
+}
+
+#endif // defined(ASIO_HAS_DECLTYPE)
+
+template <typename Stream>
+inline std::size_t read_size_available(Stream&, long)
+{
+  return 0;
+}
+
+// Determine how much to prepare for the next read into a dynamic buffer, given
+// the maximum allowed by the operation. If is_limit is false, max_size is only
+// the cap on the default sizing, and does not restrict a read_size_policy.
+template <typename Stream, typename DynamicBuffer>
+inline std::size_t read_size(Stream&, DynamicBuffer& b,
+    std::size_t max_size, bool /*is_limit*/)
+{
+  return std::min<std::size_t>(
+      std::max<std::size_t>(512, b.capacity() - b.size()),
+      std::min<std::size_t>(max_size, b.max_size() - b.size()));
+}
+
+template <typename Stream, typename DynamicBuffer>
+inline std::size_t read_size(Stream& s,
+    adaptive_dynamic_buffer<DynamicBuffer>& b,
+    std::size_t max_size, bool is_limit)
+{
+  std::size_t limit = b.max_size() - b.size();
+  if (is_limit)
+    limit = std::min<std::size_t>(max_size, limit);
+
+  read_size_policy& policy = b.policy();
+  std::size_t available = policy.filled() ? read_size_available(s, 0) : 0;
+  return policy.next(available, limit);
+}
+
+// Record the result of a read made with the size given by read_size.
+template <typename DynamicBuffer>
+inline void read_size_record(DynamicBuffer&, std::size_t)
+{
+}
+
+template <typename DynamicBuffer>
+inline void read_size_record(adaptive_dynamic_buffer<DynamicBuffer>& b,
+    std::size_t bytes_transferred)
+{
+  b.policy().record(bytes_transferred);
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_READ_SIZE_HPP
@@ -0,0 +1,92 @@
+#ifndef ASIO_READ_WHEN_READY_HPP
+#define ASIO_READ_WHEN_READY_HPP
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/core/executor/helper/async_result.hpp"
+#include "asio/detail/base/stdcpp/type_traits.hpp"
+#include "asio/error/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/**
+ * @defgroup async_read_when_ready asio::async_read_when_ready
+ *
+ * @brief The @c async_read_when_ready function is a composed asynchronous
+ * operation that waits for a stream to become readable before preparing space
+ * in a dynamic buffer and reading into it.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to wait until a stream is readable, and
+/// then read some data from it into a dynamic buffer sequence.
+/**
+ * This function is used to asynchronously read data from a stream without
+ * holding any buffer space while the stream is idle. The function call always
+ * returns immediately. The asynchronous operation will continue until one of
+ * the following conditions is true:
+ *
+ * @li Some data has been read into the dynamic buffer sequence.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of a call to the stream's async_wait
+ * function with @c wait_read, which reserves no buffer space, followed by a
+ * call to its async_read_some function. The dynamic buffer sequence's prepare
+ * function is only called once the wait has completed. Used with a
+ * pooled_buffer, a connection that is waiting for its next message therefore
+ * holds no memory from the pool.
+ *
+ * If the dynamic buffer sequence is already full, the operation completes
+ * immediately, with 0 bytes transferred.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the AsyncReadStream concept, and must also provide an async_wait function,
+ * as basic_socket does.
+ *
+ * @param buffers The dynamic buffer sequence into which the data will be read.
+ * Although the buffers object may be copied as necessary, ownership of the
+ * underlying memory blocks is retained by the caller, which must guarantee
+ * that they remain valid until the handler is called.
+ *
+ * @param handler The handler to be called when the read operation completes.
+ * Copies will be made of the handler as required. The function signature of the
+ * handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const asio::error_code& error,
+ *
+ *   // The number of bytes read into the dynamic buffer sequence's get area.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation of
+ * the handler will be performed in a manner equivalent to using
+ * asio::post().
+ *
+ * @par Example
+ * @code asio::buffer_pool pool;
+ * ...
+ * asio::pooled_buffer storage(pool);
+ * asio::async_read_when_ready(socket,
+ *     asio::dynamic_buffer(storage), handler); @endcode
+ */
+template <typename AsyncReadStream,
+    typename DynamicBuffer, typename ReadHandler>
+ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_read_when_ready(AsyncReadStream& s,
+    ASIO_MOVE_ARG(DynamicBuffer) buffers,
+    ASIO_MOVE_ARG(ReadHandler) handler);
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/transmit/impl/read_when_ready.hpp"
+
+#endif // ASIO_READ_WHEN_READY_HPP
@@ -0,0 +1,291 @@
+#ifndef ASIO_SEND_FILE_HPP
+#define ASIO_SEND_FILE_HPP
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SENDFILE)
+
+#include <cstddef>
+#include "asio/core/executor/helper/async_result.hpp"
+#include "asio/detail/base/stdcpp/cstdint.hpp"
+#include "asio/error/error.hpp"
+#include "asio/network/basic_stream_socket.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/**
+ * @defgroup send_file asio::send_file
+ *
+ * @brief The @c send_file function is a composed operation that transfers the
+ * contents of a file descriptor to a stream socket without copying the data
+ * through user space.
+ */
+/*@{*/
+
+/// Write a region of a file to a stream socket before returning.
+/**
+ * This function is used to transfer @c length bytes, starting at @c offset,
+ * from the file descriptor @c fd to the socket. The call will block until one
+ * of the following conditions is true:
+ *
+ * @li @c length bytes have been transferred.
+ *
+ * @li The end of the file has been reached.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of zero or more calls to @c sendfile
+ * for a regular file, or to @c splice for a pipe. @c SIGPIPE is blocked in the
+ * calling thread during each call, so a connection reset by the peer is
+ * reported as asio::error::broken_pipe rather than by a signal.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param fd The file descriptor from which the data is to be read. It must
+ * refer to a regular file or a pipe, otherwise the operation fails with
+ * asio::error::operation_not_supported. Data sent from a pipe is consumed
+ * from it, and the end of the file is reached when the pipe is empty and all
+ * of its writers have closed.
+ *
+ * @param offset The position in the file at which to start reading. It is
+ * ignored for a pipe.
+ *
+ * @param length The maximum number of bytes to transfer.
+ *
+ * @returns The number of bytes transferred.
+ *
+ * @throws asio::system_error Thrown on failure.
+ *
+ * @note This overload is equivalent to calling:
+ * @code asio::send_file(
+ *     s, fd, offset, length,
+ *     asio::transfer_all()); @endcode
+ */
+template <typename Protocol>
+std::size_t send_file(basic_stream_socket<Protocol>& s, int fd,
+    uint64_t offset, std::size_t length);
+
+/// Write a region of a file to a stream socket before returning.
+/**
+ * This function is used to transfer @c length bytes, starting at @c offset,
+ * from the file descriptor @c fd to the socket. The call will block until one
+ * of the following conditions is true:
+ *
+ * @li @c length bytes have been transferred.
+ *
+ * @li The end of the file has been reached.
+ *
+ * @li An error occurred.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param fd The file descriptor from which the data is to be read.
+ *
+ * @param offset The position in the file at which to start reading.
+ *
+ * @param length The maximum number of bytes to transfer.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes transferred.
+ */
+template <typename Protocol>
+std::size_t send_file(basic_stream_socket<Protocol>& s, int fd,
+    uint64_t offset, std::size_t length, asio::error_code& ec);
+
+/// Write a region of a file to a stream socket before returning.
+/**
+ * This function is used to transfer up to @c length bytes, starting at
+ * @c offset, from the file descriptor @c fd to the socket. The call will block
+ * until one of the following conditions is true:
+ *
+ * @li @c length bytes have been transferred.
+ *
+ * @li The end of the file has been reached.
+ *
+ * @li The completion_condition function object returns 0.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param fd The file descriptor from which the data is to be read.
+ *
+ * @param offset The position in the file at which to start reading.
+ *
+ * @param length The maximum number of bytes to transfer.
+ *
+ * @param completion_condition The function object to be called to determine
+ * whether the transfer is complete. The signature of the function object
+ * must be:
+ * @code std::size_t completion_condition(
+ *   // Result of latest sendfile operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes transferred so far.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * A return value of 0 indicates that the transfer is complete. A non-zero
+ * return value indicates the maximum number of bytes to be transferred on the
+ * next call to @c sendfile.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes transferred.
+ */
+template <typename Protocol, typename CompletionCondition>
+std::size_t send_file(basic_stream_socket<Protocol>& s, int fd,
+    uint64_t offset, std::size_t length,
+    CompletionCondition completion_condition, asio::error_code& ec);
+
+/*@}*/
+/**
+ * @defgroup async_send_file asio::async_send_file
+ *
+ * @brief The @c async_send_file function is a composed asynchronous operation
+ * that transfers the contents of a file descriptor to a stream socket without
+ * copying the data through user space.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to write a region of a file to a stream
+/// socket.
+/**
+ * This function is used to asynchronously transfer @c length bytes, starting
+ * at @c offset, from the file descriptor @c fd to the socket. The function
+ * call always returns immediately. The asynchronous operation will continue
+ * until one of the following conditions is true:
+ *
+ * @li @c length bytes have been transferred.
+ *
+ * @li The end of the file has been reached.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of the socket's async_wait function
+ * with socket_base::wait_write, followed by as many non-blocking calls to
+ * @c sendfile (for a regular file) or @c splice (for a pipe) as the socket
+ * will accept. While a pipe is empty, the operation instead waits for it to
+ * become readable, using the socket's io_context. The
+ * program must ensure that the socket performs no other write operations
+ * until this operation completes.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param fd The file descriptor from which the data is to be read. It must
+ * refer to a regular file or a pipe, otherwise the handler is called with
+ * asio::error::operation_not_supported. Ownership of the descriptor is
+ * retained by the caller, which must guarantee that it remains open until the
+ * handler is called. A pipe must not be in use by another I/O object on the
+ * same io_context.
+ *
+ * @param offset The position in the file at which to start reading. It is
+ * ignored for a pipe.
+ *
+ * @param length The maximum number of bytes to transfer.
+ *
+ * @param handler The handler to be called when the operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *
+ *   std::size_t bytes_transferred           // Number of bytes sent. If an
+ *                                           // error occurred, this is the
+ *                                           // partial progress, and the
+ *                                           // transfer may be resumed at
+ *                                           // offset + bytes_transferred.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation of
+ * the handler will be performed in a manner equivalent to using
+ * asio::io_context::post().
+ *
+ * @note There is no @c MSG_NOSIGNAL equivalent for @c sendfile, so
+ * @c SIGPIPE is blocked in the calling thread during each call, and a signal
+ * raised by the call is discarded. A connection reset by the peer is reported
+ * as asio::error::broken_pipe.
+ *
+ * @note Cancelling the socket does not interrupt a wait for data on a pipe.
+ *
+ * @par Example
+ * @code asio::async_send_file(socket, fd, 0, file_size, handler); @endcode
+ */
+template <typename Protocol, typename WriteHandler>
+ASIO_INITFN_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+async_send_file(basic_stream_socket<Protocol>& s, int fd,
+    uint64_t offset, std::size_t length,
+    WriteHandler&& handler);
+
+/// Start an asynchronous operation to write a region of a file to a stream
+/// socket.
+/**
+ * This function is used to asynchronously transfer up to @c length bytes,
+ * starting at @c offset, from the file descriptor @c fd to the socket. The
+ * function call always returns immediately. The asynchronous operation will
+ * continue until one of the following conditions is true:
+ *
+ * @li @c length bytes have been transferred.
+ *
+ * @li The end of the file has been reached.
+ *
+ * @li The completion_condition function object returns 0.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param fd The file descriptor from which the data is to be read.
+ *
+ * @param offset The position in the file at which to start reading.
+ *
+ * @param length The maximum number of bytes to transfer.
+ *
+ * @param completion_condition The function object to be called after each
+ * underlying @c sendfile call to determine whether the transfer is complete.
+ * It receives the running total of bytes sent, and so may also be used to
+ * observe the progress of a large transfer. The signature of the function
+ * object must be:
+ * @code std::size_t completion_condition(
+ *   // Result of latest sendfile operation.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes transferred so far.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * A return value of 0 indicates that the transfer is complete. A non-zero
+ * return value indicates the maximum number of bytes to be transferred on the
+ * next call to @c sendfile.
+ *
+ * @param handler The handler to be called when the operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *
+ *   std::size_t bytes_transferred           // Number of bytes sent.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation of
+ * the handler will be performed in a manner equivalent to using
+ * asio::io_context::post().
+ */
+template <typename Protocol, typename CompletionCondition,
+    typename WriteHandler>
+ASIO_INITFN_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+async_send_file(basic_stream_socket<Protocol>& s, int fd,
+    uint64_t offset, std::size_t length,
+    CompletionCondition completion_condition,
+    WriteHandler&& handler);
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/transmit/impl/send_file.hpp"
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
+#endif // ASIO_SEND_FILE_HPP
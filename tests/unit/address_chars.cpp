@@ -0,0 +1,209 @@
+//
+// address_chars.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/ip/chars_result.hpp"
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <string>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::ip::address;
+using asio::ip::address_v4;
+using asio::ip::address_v6;
+using asio::ip::tcp;
+
+namespace address_chars_test {
+
+template <typename T>
+std::string format(const T& value)
+{
+  char buf[128];
+  asio::ip::to_chars_result result = value.to_chars(buf, buf + sizeof(buf));
+  ASIO_CHECK(!result.ec);
+  return std::string(buf, result.ptr);
+}
+
+template <typename T>
+bool parse(const std::string& s, T& value)
+{
+  asio::ip::from_chars_result result =
+    asio::ip::from_chars(s.data(), s.data() + s.size(), value);
+  return !result.ec && result.ptr == s.data() + s.size();
+}
+
+uint32_t next_random(uint32_t& x)
+{
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return x;
+}
+
+void test_v4_against_inet()
+{
+  uint32_t x = 2463534242u;
+  for (int i = 0; i < 10000; ++i)
+  {
+    address_v4 addr(next_random(x) >> (i % 32));
+    address_v4::bytes_type bytes = addr.to_bytes();
+    char expected[INET_ADDRSTRLEN];
+    ::inet_ntop(AF_INET, bytes.data(), expected, sizeof(expected));
+    ASIO_CHECK(format(addr) == expected);
+
+    address_v4 parsed;
+    ASIO_CHECK(parse(std::string(expected), parsed));
+    ASIO_CHECK(parsed == addr);
+  }
+}
+
+void test_v6_against_inet()
+{
+  uint32_t x = 88172645u;
+  for (int i = 0; i < 10000; ++i)
+  {
+    // Zero some groups, so that runs of zeros are compressed.
+    address_v6::bytes_type bytes;
+    uint32_t zero_mask = next_random(x);
+    for (int g = 0; g < 8; ++g)
+    {
+      uint32_t r = (zero_mask >> g) & 1 ? 0 : next_random(x);
+      bytes[2 * g] = static_cast<unsigned char>(r >> 8);
+      bytes[2 * g + 1] = static_cast<unsigned char>(r);
+    }
+    if (i % 7 == 0)
+    {
+      // An IPv4-mapped address.
+      std::memset(bytes.data(), 0, 10);
+      bytes[10] = bytes[11] = 0xFF;
+    }
+
+    address_v6 addr(bytes);
+    char expected[INET6_ADDRSTRLEN];
+    ::inet_ntop(AF_INET6, bytes.data(), expected, sizeof(expected));
+    ASIO_CHECK(format(addr) == expected);
+
+    address_v6 parsed;
+    ASIO_CHECK(parse(std::string(expected), parsed));
+    ASIO_CHECK(parsed == addr);
+  }
+}
+
+void test_invalid()
+{
+  const char* bad_v4[] = { "", "1.2.3", "1.2.3.256", "1..2.3", "a.b.c.d",
+    "1.2.3.4.5", "01.2.3.4", ".1.2.3" };
+  for (std::size_t i = 0; i < sizeof(bad_v4) / sizeof(bad_v4[0]); ++i)
+  {
+    address_v4 addr;
+    unsigned char buf[4];
+    bool expected = ::inet_pton(AF_INET, bad_v4[i], buf) == 1;
+    ASIO_CHECK(parse(std::string(bad_v4[i]), addr) == expected);
+  }
+
+  const char* bad_v6[] = { "", ":", "1:2:3:4:5:6:7", "1::2::3", "12345::",
+    "1:2:3:4:5:6:7:8:9", "::g", ":::", "::1.2.3", "1:2:3:4:5:6:7:1.2.3.4" };
+  for (std::size_t i = 0; i < sizeof(bad_v6) / sizeof(bad_v6[0]); ++i)
+  {
+    address_v6 addr;
+    unsigned char buf[16];
+    bool expected = ::inet_pton(AF_INET6, bad_v6[i], buf) == 1;
+    ASIO_CHECK(parse(std::string(bad_v6[i]), addr) == expected);
+  }
+
+  // On failure the result points to the start of the input.
+  const char* s = "300.1.1.1";
+  address_v4 addr;
+  asio::ip::from_chars_result result =
+    asio::ip::from_chars(s, s + std::strlen(s), addr);
+  ASIO_CHECK(result.ec == asio::error::invalid_argument);
+  ASIO_CHECK(result.ptr == s);
+}
+
+void test_trailing()
+{
+  // Parsing stops at the first character that is not part of the value.
+  const char* s = "10.0.0.1 rest";
+  address_v4 v4;
+  asio::ip::from_chars_result result =
+    asio::ip::from_chars(s, s + std::strlen(s), v4);
+  ASIO_CHECK(!result.ec);
+  ASIO_CHECK(result.ptr == s + 8);
+  ASIO_CHECK(v4 == address_v4(0x0A000001));
+
+  s = "fe80::1%eth0,next";
+  address_v6 v6;
+  result = asio::ip::from_chars(s, s + std::strlen(s), v6);
+  ASIO_CHECK(!result.ec);
+  ASIO_CHECK(*result.ptr == ',');
+}
+
+void test_address()
+{
+  address a;
+  ASIO_CHECK(parse(std::string("192.168.1.1"), a));
+  ASIO_CHECK(a.is_v4());
+  ASIO_CHECK(format(a) == "192.168.1.1");
+
+  ASIO_CHECK(parse(std::string("2001:db8::1"), a));
+  ASIO_CHECK(a.is_v6());
+  ASIO_CHECK(format(a) == "2001:db8::1");
+  ASIO_CHECK(a.to_string() == "2001:db8::1");
+  ASIO_CHECK(asio::ip::make_address("2001:db8::1") == a);
+}
+
+void test_endpoint()
+{
+  tcp::endpoint e(asio::ip::make_address("10.1.2.3"), 8080);
+  ASIO_CHECK(format(e) == "10.1.2.3:8080");
+
+  tcp::endpoint e6(asio::ip::make_address("::1"), 443);
+  ASIO_CHECK(format(e6) == "[::1]:443");
+
+  tcp::endpoint parsed;
+  ASIO_CHECK(parse(std::string("10.1.2.3:8080"), parsed));
+  ASIO_CHECK(parsed == e);
+  ASIO_CHECK(parse(std::string("[::1]:443"), parsed));
+  ASIO_CHECK(parsed == e6);
+
+  ASIO_CHECK(!parse(std::string("10.1.2.3"), parsed));
+  ASIO_CHECK(!parse(std::string("10.1.2.3:65536"), parsed));
+  ASIO_CHECK(!parse(std::string("[::1:443"), parsed));
+  ASIO_CHECK(!parse(std::string("::1:443"), parsed));
+}
+
+void test_buffer_too_small()
+{
+  address_v6 addr = asio::ip::make_address_v6("2001:db8:1:2:3:4:5:6");
+  std::string full = format(addr);
+  for (std::size_t size = 0; size < full.size(); ++size)
+  {
+    char buf[64];
+    asio::ip::to_chars_result result = addr.to_chars(buf, buf + size);
+    ASIO_CHECK(result.ec == asio::error::no_buffer_space);
+    ASIO_CHECK(result.ptr == buf + size);
+  }
+
+  tcp::endpoint e(asio::ip::make_address("10.1.2.3"), 8080);
+  char buf[8];
+  asio::ip::to_chars_result result = e.to_chars(buf, buf + sizeof(buf));
+  ASIO_CHECK(result.ec == asio::error::no_buffer_space);
+}
+
+} // namespace address_chars_test
+
+ASIO_TEST_SUITE
+(
+  "address_chars",
+  ASIO_TEST_CASE(address_chars_test::test_v4_against_inet)
+  ASIO_TEST_CASE(address_chars_test::test_v6_against_inet)
+  ASIO_TEST_CASE(address_chars_test::test_invalid)
+  ASIO_TEST_CASE(address_chars_test::test_trailing)
+  ASIO_TEST_CASE(address_chars_test::test_address)
+  ASIO_TEST_CASE(address_chars_test::test_endpoint)
+  ASIO_TEST_CASE(address_chars_test::test_buffer_too_small)
+)
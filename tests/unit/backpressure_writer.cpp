@@ -0,0 +1,228 @@
+//
+// backpressure_writer.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/transmit/backpressure_writer.hpp"
+
+#include <string>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::ip::tcp;
+
+namespace backpressure_writer_test {
+
+typedef asio::backpressure_writer<tcp> writer_type;
+
+const std::size_t high_watermark = 64 * 1024;
+const std::size_t low_watermark = 16 * 1024;
+const std::size_t message_size = 1000;
+
+// Connect a pair of sockets with small buffers, so that the kernel fills up
+// quickly when the receiver does not read.
+void connect_pair(asio::io_context& ioc, tcp::socket& a, tcp::socket& b)
+{
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  a.open(tcp::v4());
+  a.set_option(asio::socket_base::send_buffer_size(4096));
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+  b.set_option(asio::socket_base::receive_buffer_size(4096));
+}
+
+// Write messages until one is not queued.
+std::size_t fill(writer_type& writer, asio::error_code& ec)
+{
+  std::string msg(message_size, 'x');
+  std::size_t count = 0;
+  while (count < 100000 && writer.write(msg, ec))
+    ++count;
+  return count;
+}
+
+void test_oversized_message()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  writer_type writer(a, high_watermark, low_watermark,
+      writer_type::disconnect);
+
+  asio::error_code ec;
+  ASIO_CHECK(!writer.write(std::string(high_watermark + 1, 'x'), ec));
+  ASIO_CHECK(ec == asio::error::message_size);
+  ASIO_CHECK(writer.queued_bytes() == 0);
+
+  // The writer and its socket are unaffected.
+  ASIO_CHECK(!writer.error());
+  ASIO_CHECK(a.is_open());
+  ASIO_CHECK(writer.write("abc", ec));
+  ASIO_CHECK(!ec);
+}
+
+void test_empty_message()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  writer_type writer(a, high_watermark, low_watermark);
+
+  // An empty message is accepted, and there is nothing to queue.
+  asio::error_code ec;
+  ASIO_CHECK(writer.write(std::string(), ec));
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(writer.queued_bytes() == 0);
+
+  // Empty messages between and after others do not stall the queue.
+  ASIO_CHECK(writer.write("abc", ec));
+  ASIO_CHECK(writer.write(std::string(), ec));
+  ASIO_CHECK(writer.write("def", ec));
+  ASIO_CHECK(writer.write(std::string(), ec));
+  ioc.run();
+  ASIO_CHECK(writer.queued_bytes() == 0);
+
+  char data[6];
+  asio::read(b, asio::buffer(data), ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(std::string(data, 6) == "abcdef");
+}
+
+void test_block_producer()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  writer_type writer(a, high_watermark, low_watermark,
+      writer_type::block_producer);
+
+  asio::error_code ec;
+  std::size_t count = fill(writer, ec);
+  ASIO_CHECK(ec == asio::error::would_block);
+  ASIO_CHECK(writer.queued_bytes() <= high_watermark);
+  ASIO_CHECK(writer.queued_bytes() + message_size > high_watermark);
+  ASIO_CHECK(!writer.error());
+
+  // Once the receiver reads, the queue drains and the producer is resumed.
+  bool ready = false;
+  writer.async_wait_ready(
+      [&](const asio::error_code& e)
+      {
+        ASIO_CHECK(!e);
+        ready = true;
+        ASIO_CHECK(writer.queued_bytes() <= low_watermark);
+      });
+
+  std::string received(count * message_size, '\0');
+  asio::error_code read_ec;
+  asio::async_read(b, asio::buffer(&received[0], received.size()),
+      [&](const asio::error_code& e, std::size_t)
+      {
+        read_ec = e;
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(ready);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(received == std::string(count * message_size, 'x'));
+  ASIO_CHECK(writer.queued_bytes() == 0);
+}
+
+void test_drop_oldest()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  writer_type writer(a, high_watermark, low_watermark,
+      writer_type::drop_oldest);
+
+  std::string msg(message_size, 'x');
+  for (int i = 0; i < 1000; ++i)
+  {
+    writer.write(msg);
+    ASIO_CHECK(writer.queued_bytes() <= high_watermark);
+  }
+
+  ASIO_CHECK(writer.dropped_messages() > 0);
+  ASIO_CHECK(!writer.error());
+}
+
+void test_disconnect()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  writer_type writer(a, high_watermark, low_watermark,
+      writer_type::disconnect);
+
+  asio::error_code ec;
+  fill(writer, ec);
+  ASIO_CHECK(ec == asio::error::no_buffer_space);
+  ASIO_CHECK(writer.error() == asio::error::no_buffer_space);
+  ASIO_CHECK(!a.is_open());
+
+  ASIO_CHECK(!writer.write("abc", ec));
+  ASIO_CHECK(ec == asio::error::no_buffer_space);
+}
+
+void test_kernel_low_watermark()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  writer_type writer(a, 1024 * 1024, low_watermark);
+  ASIO_CHECK(writer.kernel_room() == 1024 * 1024);
+
+  asio::error_code ec;
+  writer.kernel_low_watermark(8192, ec);
+#if defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+  ASIO_CHECK(!ec);
+#if defined(ASIO_OS_DEF_SIOCOUTQNSD)
+  ASIO_CHECK(writer.kernel_room() <= 8192);
+#endif // defined(ASIO_OS_DEF_SIOCOUTQNSD)
+#else // defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+  ASIO_CHECK(ec == asio::error::operation_not_supported);
+#endif // defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+
+  // Data written under the kernel low watermark arrives intact and in order.
+  std::string data;
+  for (int i = 0; i < 200; ++i)
+  {
+    std::string msg(message_size, static_cast<char>('a' + i % 26));
+    ASIO_CHECK(writer.write(msg));
+    data += msg;
+  }
+
+  std::string received(data.size(), '\0');
+  asio::async_read(b, asio::buffer(&received[0], received.size()),
+      [&](const asio::error_code& e, std::size_t)
+      {
+        ASIO_CHECK(!e);
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(received == data);
+}
+
+} // namespace backpressure_writer_test
+
+ASIO_TEST_SUITE
+(
+  "backpressure_writer",
+  ASIO_TEST_CASE(backpressure_writer_test::test_oversized_message)
+  ASIO_TEST_CASE(backpressure_writer_test::test_empty_message)
+  ASIO_TEST_CASE(backpressure_writer_test::test_block_producer)
+  ASIO_TEST_CASE(backpressure_writer_test::test_drop_oldest)
+  ASIO_TEST_CASE(backpressure_writer_test::test_disconnect)
+  ASIO_TEST_CASE(backpressure_writer_test::test_kernel_low_watermark)
+)
@@ -0,0 +1,180 @@
+//
+// basic_socket_streambuf.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/network/basic_socket_streambuf.hpp"
+
+#include <string>
+#include <thread>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::ip::tcp;
+
+namespace basic_socket_streambuf_test {
+
+typedef asio::basic_socket_streambuf<tcp> streambuf_type;
+
+std::string make_data(std::size_t size)
+{
+  std::string data(size, '\0');
+  for (std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>('a' + i % 26);
+  return data;
+}
+
+void connect_pair(asio::io_context& ioc, streambuf_type& sb, tcp::socket& peer)
+{
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  ASIO_CHECK(sb.connect(acceptor.local_endpoint()) != 0);
+  acceptor.accept(peer);
+}
+
+std::string read_all(tcp::socket& s)
+{
+  std::string data;
+  char buf[4096];
+  asio::error_code ec;
+  while (!ec)
+  {
+    std::size_t n = s.read_some(asio::buffer(buf), ec);
+    data.append(buf, n);
+  }
+  return data;
+}
+
+void test_buffer_size()
+{
+  asio::io_context ioc;
+  streambuf_type sb(16);
+  tcp::socket peer(ioc);
+  connect_pair(ioc, sb, peer);
+
+  // Data smaller than the put buffer is held until the stream is flushed.
+  ASIO_CHECK(sb.sputn("hello", 5) == 5);
+  peer.non_blocking(true);
+  char buf[64];
+  asio::error_code ec;
+  peer.read_some(asio::buffer(buf), ec);
+  ASIO_CHECK(ec == asio::error::would_block);
+  peer.non_blocking(false);
+
+  ASIO_CHECK(sb.pubsync() == 0);
+  std::size_t n = asio::read(peer, asio::buffer(buf, 5));
+  ASIO_CHECK(std::string(buf, n) == "hello");
+
+  // Input is read through the get buffer.
+  asio::write(peer, asio::buffer("world", 5));
+  char in[5];
+  ASIO_CHECK(sb.sgetn(in, 5) == 5);
+  ASIO_CHECK(std::string(in, 5) == "world");
+}
+
+void test_unbuffered()
+{
+  asio::io_context ioc;
+  streambuf_type sb(0);
+  tcp::socket peer(ioc);
+  connect_pair(ioc, sb, peer);
+
+  // Each character is sent as soon as it is written.
+  ASIO_CHECK(sb.sputc('x') == 'x');
+  char c = 0;
+  asio::read(peer, asio::buffer(&c, 1));
+  ASIO_CHECK(c == 'x');
+}
+
+void test_user_buffers()
+{
+  char get_buffer[32];
+  char put_buffer[32];
+
+  asio::io_context ioc;
+  streambuf_type sb(get_buffer, sizeof(get_buffer),
+      put_buffer, sizeof(put_buffer));
+  tcp::socket peer(ioc);
+  connect_pair(ioc, sb, peer);
+
+  // Output is staged in the supplied put buffer.
+  ASIO_CHECK(sb.sputn("abc", 3) == 3);
+  ASIO_CHECK(std::string(put_buffer, 3) == "abc");
+  ASIO_CHECK(sb.pubsync() == 0);
+  char buf[3];
+  asio::read(peer, asio::buffer(buf));
+  ASIO_CHECK(std::string(buf, 3) == "abc");
+
+  // Input is received into the supplied get buffer.
+  asio::write(peer, asio::buffer("def", 3));
+  ASIO_CHECK(sb.sgetc() == 'd');
+  ASIO_CHECK(std::string(get_buffer + 8, 3) == "def");
+
+  bool threw = false;
+  try
+  {
+    char small[8];
+    streambuf_type bad(small, sizeof(small), put_buffer, sizeof(put_buffer));
+  }
+  catch (std::invalid_argument&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+}
+
+void test_large_write()
+{
+  asio::io_context ioc;
+  streambuf_type sb(64);
+  tcp::socket peer(ioc);
+  connect_pair(ioc, sb, peer);
+
+  std::string received;
+  std::thread reader([&]{ received = read_all(peer); });
+
+  // Buffered data is sent along with a write larger than the put buffer.
+  std::string data = make_data(1024 * 1024);
+  ASIO_CHECK(sb.sputn("prefix", 6) == 6);
+  ASIO_CHECK(sb.sputn(data.data(), data.size())
+      == static_cast<std::streamsize>(data.size()));
+  sb.close();
+  reader.join();
+
+  ASIO_CHECK(received == "prefix" + data);
+}
+
+void test_partial_write()
+{
+  asio::io_context ioc;
+  streambuf_type sb(64);
+  tcp::socket peer(ioc);
+  connect_pair(ioc, sb, peer);
+
+  // The peer does not read, so the write times out once the socket buffers
+  // are full. The result is the number of characters that were sent.
+  std::string data = make_data(64 * 1024 * 1024);
+  ASIO_CHECK(sb.sputn("prefix", 6) == 6);
+  sb.expires_after(std::chrono::milliseconds(200));
+  std::streamsize n = sb.sputn(data.data(), data.size());
+  ASIO_CHECK(sb.error() == asio::error::timed_out);
+  ASIO_CHECK(n > 0);
+  ASIO_CHECK(n < static_cast<std::streamsize>(data.size()));
+
+  sb.close();
+  std::string received = read_all(peer);
+  ASIO_CHECK(received == "prefix" + data.substr(0, n));
+}
+
+} // namespace basic_socket_streambuf_test
+
+ASIO_TEST_SUITE
+(
+  "basic_socket_streambuf",
+  ASIO_TEST_CASE(basic_socket_streambuf_test::test_buffer_size)
+  ASIO_TEST_CASE(basic_socket_streambuf_test::test_unbuffered)
+  ASIO_TEST_CASE(basic_socket_streambuf_test::test_user_buffers)
+  ASIO_TEST_CASE(basic_socket_streambuf_test::test_large_write)
+  ASIO_TEST_CASE(basic_socket_streambuf_test::test_partial_write)
+)
@@ -0,0 +1,256 @@
+//
+// buffer_pool.cpp
+// ~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/buffer/buffer_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::ip::tcp;
+
+namespace buffer_pool_test {
+
+void test_slab_size()
+{
+  asio::buffer_pool pool(100);
+  ASIO_CHECK(pool.slab_size() == 128);
+
+  asio::buffer_pool pool2(0);
+  ASIO_CHECK(pool2.slab_size() == 64);
+}
+
+void test_allocate()
+{
+  asio::buffer_pool pool(1024, 8192);
+
+  // Slabs are distinct and usable for their whole size.
+  std::set<void*> slabs;
+  for (int i = 0; i < 100; ++i)
+  {
+    void* p = pool.allocate();
+    ASIO_CHECK(slabs.insert(p).second);
+    std::memset(p, i, pool.slab_size());
+  }
+
+  for (std::set<void*>::iterator i = slabs.begin(); i != slabs.end(); ++i)
+    pool.deallocate(*i);
+
+  // Returned slabs are reused.
+  void* p = pool.allocate();
+  ASIO_CHECK(slabs.count(p) == 1);
+  pool.deallocate(p);
+}
+
+void test_threads()
+{
+  asio::buffer_pool pool(256, 4096);
+
+  // Slabs allocated on one thread may be returned on another.
+  std::vector<void*> slabs;
+  for (int i = 0; i < 200; ++i)
+    slabs.push_back(pool.allocate());
+
+  std::thread t(
+      [&]()
+      {
+        for (std::size_t i = 0; i < slabs.size(); ++i)
+          pool.deallocate(slabs[i]);
+        for (int i = 0; i < 1000; ++i)
+          pool.deallocate(pool.allocate());
+      });
+  for (int i = 0; i < 1000; ++i)
+    pool.deallocate(pool.allocate());
+  t.join();
+}
+
+void test_thread_exit()
+{
+  asio::buffer_pool pool(256, 256 * 32);
+
+  // A thread's cache of free slabs is returned to the pool when the thread
+  // exits, so the slabs can be reused without obtaining more memory.
+  std::set<void*> first;
+  std::thread([&]
+      {
+        std::vector<void*> slabs;
+        for (int i = 0; i < 32; ++i)
+          slabs.push_back(pool.allocate());
+        first.insert(slabs.begin(), slabs.end());
+        for (std::size_t i = 0; i < slabs.size(); ++i)
+          pool.deallocate(slabs[i]);
+      }).join();
+  ASIO_CHECK(first.size() == 32);
+
+  std::vector<void*> second;
+  for (int i = 0; i < 32; ++i)
+    second.push_back(pool.allocate());
+  std::size_t reused = 0;
+  for (std::size_t i = 0; i < second.size(); ++i)
+    reused += first.count(second[i]);
+  ASIO_CHECK(reused == 32);
+  for (std::size_t i = 0; i < second.size(); ++i)
+    pool.deallocate(second[i]);
+}
+
+void test_many_pools()
+{
+  // Pools do not each use up a thread-specific storage key.
+  std::vector<asio::buffer_pool*> pools;
+  for (int i = 0; i < 2000; ++i)
+  {
+    pools.push_back(new asio::buffer_pool(64, 64));
+    pools.back()->deallocate(pools.back()->allocate());
+  }
+
+  // A thread's caches are found after pools are destroyed and created.
+  for (std::size_t i = 0; i < pools.size(); i += 2)
+  {
+    delete pools[i];
+    pools[i] = new asio::buffer_pool(64, 64);
+  }
+  for (std::size_t i = 0; i < pools.size(); ++i)
+  {
+    void* p = pools[i]->allocate();
+    pools[i]->deallocate(p);
+    ASIO_CHECK(pools[i]->allocate() == p);
+    pools[i]->deallocate(p);
+  }
+
+  for (std::size_t i = 0; i < pools.size(); ++i)
+    delete pools[i];
+}
+
+void test_huge_page_alignment()
+{
+#if defined(ASIO_HAS_HUGEPAGES)
+  // Chunks of at least one huge page start on a huge page boundary.
+  asio::buffer_pool pool(8192, 2097152);
+  std::vector<void*> slabs;
+  std::size_t lowest = ~std::size_t(0);
+  for (int i = 0; i < 256; ++i)
+  {
+    slabs.push_back(pool.allocate());
+    lowest = (std::min)(lowest, reinterpret_cast<std::size_t>(slabs.back()));
+  }
+  ASIO_CHECK(lowest % 2097152 == 0);
+  for (std::size_t i = 0; i < slabs.size(); ++i)
+    pool.deallocate(slabs[i]);
+#endif // defined(ASIO_HAS_HUGEPAGES)
+}
+
+void test_pooled_buffer()
+{
+  asio::buffer_pool pool(1024);
+  asio::pooled_buffer b(pool);
+  ASIO_CHECK(!b.borrowed());
+  ASIO_CHECK(b.size() == 0);
+  ASIO_CHECK(b.capacity() == 1024);
+
+  // A slab is borrowed only while the buffer holds data.
+  asio::mutable_buffer out = b.prepare(5);
+  ASIO_CHECK(b.borrowed());
+  std::memcpy(out.data(), "hello", 5);
+  b.commit(5);
+  ASIO_CHECK(b.size() == 5);
+  ASIO_CHECK(std::string(static_cast<const char*>(b.data().data()), 5)
+      == "hello");
+
+  b.consume(2);
+  ASIO_CHECK(b.borrowed());
+  ASIO_CHECK(std::string(static_cast<const char*>(b.data().data()), 3)
+      == "llo");
+
+  b.consume(3);
+  ASIO_CHECK(!b.borrowed());
+
+  b.prepare(10);
+  b.commit(0);
+  ASIO_CHECK(!b.borrowed());
+
+  bool threw = false;
+  try
+  {
+    b.prepare(1025);
+  }
+  catch (std::length_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+}
+
+void test_read_when_ready()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket a(ioc), b(ioc);
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+
+  asio::buffer_pool pool(4096);
+  asio::pooled_buffer storage(pool);
+
+  bool called = false;
+  asio::async_read_when_ready(a, asio::dynamic_buffer(storage),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        called = true;
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(n == 5);
+      });
+
+  // No slab is held while the socket is idle.
+  ioc.poll();
+  ASIO_CHECK(!called);
+  ASIO_CHECK(!storage.borrowed());
+
+  asio::write(b, asio::buffer("hello", 5));
+  ioc.run();
+
+  ASIO_CHECK(called);
+  ASIO_CHECK(storage.size() == 5);
+  ASIO_CHECK(std::string(static_cast<const char*>(storage.data().data()), 5)
+      == "hello");
+
+  // Errors are reported without borrowing a slab.
+  storage.consume(5);
+  b.close();
+  called = false;
+  asio::async_read_when_ready(a, asio::dynamic_buffer(storage),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        called = true;
+        ASIO_CHECK(ec == asio::error::eof);
+        ASIO_CHECK(n == 0);
+      });
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(!storage.borrowed());
+}
+
+} // namespace buffer_pool_test
+
+ASIO_TEST_SUITE
+(
+  "buffer_pool",
+  ASIO_TEST_CASE(buffer_pool_test::test_slab_size)
+  ASIO_TEST_CASE(buffer_pool_test::test_allocate)
+  ASIO_TEST_CASE(buffer_pool_test::test_threads)
+  ASIO_TEST_CASE(buffer_pool_test::test_thread_exit)
+  ASIO_TEST_CASE(buffer_pool_test::test_many_pools)
+  ASIO_TEST_CASE(buffer_pool_test::test_huge_page_alignment)
+  ASIO_TEST_CASE(buffer_pool_test::test_pooled_buffer)
+  ASIO_TEST_CASE(buffer_pool_test::test_read_when_ready)
+)
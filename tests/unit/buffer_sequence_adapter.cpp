@@ -0,0 +1,153 @@
+//
+// buffer_sequence_adapter.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/buffer/buffer_sequence_adapter.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::detail::buffer_sequence_adapter;
+using asio::detail::buffer_sequence_adapter_base;
+
+namespace buffer_sequence_adapter_test {
+
+void test_std_array()
+{
+  char a[3], b[5], c[7], d[11];
+  std::array<asio::mutable_buffer, 4> bufs = {{
+    asio::buffer(a), asio::buffer(b), asio::buffer(c), asio::buffer(d) }};
+
+  typedef buffer_sequence_adapter<asio::mutable_buffer,
+      std::array<asio::mutable_buffer, 4> > adapter_type;
+  adapter_type adapter(bufs);
+
+  ASIO_CHECK(adapter.count() == 4);
+  ASIO_CHECK(adapter.total_size() == 26);
+  ASIO_CHECK(!adapter.all_empty());
+  ASIO_CHECK(adapter.buffers()[0].iov_base == a);
+  ASIO_CHECK(adapter.buffers()[1].iov_base == b);
+  ASIO_CHECK(adapter.buffers()[2].iov_base == c);
+  ASIO_CHECK(adapter.buffers()[3].iov_base == d);
+  ASIO_CHECK(adapter.buffers()[3].iov_len == 11);
+
+  // The native array holds exactly the number of buffers in the sequence.
+  ASIO_CHECK(sizeof(adapter_type)
+      < sizeof(buffer_sequence_adapter<asio::mutable_buffer,
+        std::vector<asio::mutable_buffer> >));
+
+  ASIO_CHECK(adapter_type::first(bufs).data() == a);
+  ASIO_CHECK(!adapter_type::all_empty(bufs));
+}
+
+void test_empty_elements()
+{
+  char d[4];
+  std::array<asio::const_buffer, 3> bufs = {{
+    asio::const_buffer(), asio::const_buffer(), asio::buffer(d) }};
+
+  typedef buffer_sequence_adapter<asio::const_buffer,
+      std::array<asio::const_buffer, 3> > adapter_type;
+  adapter_type adapter(bufs);
+
+  ASIO_CHECK(adapter.count() == 3);
+  ASIO_CHECK(adapter.total_size() == 4);
+  ASIO_CHECK(adapter_type::first(bufs).data() == d);
+  ASIO_CHECK(adapter_type::first(bufs).size() == 4);
+
+  bufs[2] = asio::const_buffer();
+  ASIO_CHECK(adapter_type::all_empty(bufs));
+  ASIO_CHECK(adapter_type(bufs).all_empty());
+  ASIO_CHECK(adapter_type::first(bufs).size() == 0);
+}
+
+void test_long_array()
+{
+  // Arrays longer than the native limit are truncated to that limit.
+  static char data[200];
+  std::array<asio::mutable_buffer, 200> bufs;
+  for (std::size_t i = 0; i < bufs.size(); ++i)
+    bufs[i] = asio::buffer(data + i, 1);
+
+  buffer_sequence_adapter<asio::mutable_buffer,
+      std::array<asio::mutable_buffer, 200> > adapter(bufs);
+  std::size_t limit = buffer_sequence_adapter_base::max_buffers;
+  ASIO_CHECK(adapter.count() == limit);
+  ASIO_CHECK(adapter.total_size() == limit);
+}
+
+void test_prepared_buffers()
+{
+  char a[2], b[3];
+  asio::detail::prepared_buffers<asio::const_buffer, 2> bufs;
+  bufs.elems[0] = asio::buffer(a);
+  bufs.elems[1] = asio::buffer(b);
+  bufs.count = 2;
+
+  typedef buffer_sequence_adapter<asio::const_buffer,
+      asio::detail::prepared_buffers<asio::const_buffer, 2> > adapter_type;
+  adapter_type adapter(bufs);
+  ASIO_CHECK(adapter.count() == 2);
+  ASIO_CHECK(adapter.total_size() == 5);
+  std::size_t capacity = asio::detail::buffer_sequence_capacity<
+      asio::detail::prepared_buffers<asio::const_buffer, 2> >::value;
+  ASIO_CHECK(capacity == 2);
+}
+
+void test_buffer_array()
+{
+  char a[4];
+  const char b[6] = "hello";
+
+  std::array<asio::mutable_buffer, 2> m =
+    asio::buffer_array(asio::buffer(a), asio::buffer(a, 2));
+  ASIO_CHECK(m[0].size() == 4);
+  ASIO_CHECK(m[1].size() == 2);
+
+  // A single const argument makes the whole array const.
+  std::array<asio::const_buffer, 2> c =
+    asio::buffer_array(asio::buffer(a), asio::buffer(b));
+  ASIO_CHECK(c[0].data() == a);
+  ASIO_CHECK(c[1].data() == b);
+  ASIO_CHECK(asio::buffer_size(c) == 10);
+}
+
+void test_gather_write()
+{
+  asio::io_context ioc;
+  asio::ip::tcp::acceptor acceptor(ioc,
+      asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  asio::ip::tcp::socket a(ioc), b(ioc);
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+
+  std::string header = "head:", body = "body";
+  std::size_t n = asio::write(a,
+      asio::buffer_array(asio::buffer(header), asio::buffer(body)));
+  ASIO_CHECK(n == 9);
+
+  char out[9];
+  std::array<asio::mutable_buffer, 2> in =
+    asio::buffer_array(asio::buffer(out, 5), asio::buffer(out + 5, 4));
+  n = asio::read(b, in);
+  ASIO_CHECK(n == 9);
+  ASIO_CHECK(std::string(out, 9) == "head:body");
+}
+
+} // namespace buffer_sequence_adapter_test
+
+ASIO_TEST_SUITE
+(
+  "buffer_sequence_adapter",
+  ASIO_TEST_CASE(buffer_sequence_adapter_test::test_std_array)
+  ASIO_TEST_CASE(buffer_sequence_adapter_test::test_empty_elements)
+  ASIO_TEST_CASE(buffer_sequence_adapter_test::test_long_array)
+  ASIO_TEST_CASE(buffer_sequence_adapter_test::test_prepared_buffers)
+  ASIO_TEST_CASE(buffer_sequence_adapter_test::test_buffer_array)
+  ASIO_TEST_CASE(buffer_sequence_adapter_test::test_gather_write)
+)
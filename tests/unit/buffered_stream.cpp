@@ -0,0 +1,304 @@
+//
+// buffered_stream.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/transmit/buffered_stream.hpp"
+
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::ip::tcp;
+
+// Count every allocation made by the program, so that the test can check that
+// the operations of a write-through are recycled.
+static std::size_t allocation_count = 0;
+
+void* operator new(std::size_t size)
+{
+  ++allocation_count;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) ASIO_NOEXCEPT
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) ASIO_NOEXCEPT
+{
+  std::free(p);
+}
+
+namespace buffered_stream_test {
+
+std::string make_data(std::size_t size)
+{
+  std::string data(size, '\0');
+  for (std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>('a' + i % 26);
+  return data;
+}
+
+void connect_pair(asio::io_context& ioc, tcp::socket& a, tcp::socket& b)
+{
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+}
+
+std::size_t available(tcp::socket& s)
+{
+  tcp::socket::bytes_readable command;
+  s.io_control(command);
+  return command.get();
+}
+
+void test_write_coalescing()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  asio::buffered_write_stream<tcp::socket&> stream(a, 64);
+
+  // Writes that fit are held in the buffer.
+  ASIO_CHECK(stream.write_some(asio::buffer("abc", 3)) == 3);
+  ASIO_CHECK(stream.write_some(asio::buffer("def", 3)) == 3);
+  ASIO_CHECK(stream.pending() == 6);
+  ASIO_CHECK(available(b) == 0);
+
+  ASIO_CHECK(stream.flush() == 6);
+  ASIO_CHECK(stream.pending() == 0);
+  char buf[6];
+  asio::read(b, asio::buffer(buf));
+  ASIO_CHECK(std::string(buf, 6) == "abcdef");
+}
+
+void test_write_large()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  asio::buffered_write_stream<tcp::socket&> stream(a, 64);
+
+  // A write that does not fit is sent with the buffered data, without being
+  // copied into the buffer.
+  std::string data = make_data(100);
+  ASIO_CHECK(stream.write_some(asio::buffer("xyz", 3)) == 3);
+  std::size_t n = asio::write(stream, asio::buffer(data));
+  ASIO_CHECK(n == data.size());
+  ASIO_CHECK(stream.pending() == 0);
+
+  std::string received(103, '\0');
+  asio::read(b, asio::buffer(&received[0], received.size()));
+  ASIO_CHECK(received == "xyz" + data);
+}
+
+void test_async_write()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  asio::buffered_write_stream<tcp::socket&> stream(a, 1024);
+
+  std::string expected;
+  int writes = 0;
+  for (int i = 0; i < 10; ++i)
+  {
+    expected += "message\n";
+    asio::async_write(stream, asio::buffer("message\n", 8),
+        [&](const asio::error_code& ec, std::size_t n)
+        {
+          ASIO_CHECK(!ec);
+          ASIO_CHECK(n == 8);
+          ++writes;
+        });
+    ioc.run();
+    ioc.restart();
+  }
+  ASIO_CHECK(writes == 10);
+  ASIO_CHECK(stream.pending() == 80);
+
+  bool flushed = false;
+  stream.async_flush(
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        ASIO_CHECK(!ec);
+        flushed = true;
+      });
+  ioc.run();
+  ASIO_CHECK(flushed);
+  ASIO_CHECK(stream.pending() == 0);
+
+  std::string received(expected.size(), '\0');
+  asio::read(b, asio::buffer(&received[0], received.size()));
+  ASIO_CHECK(received == expected);
+}
+
+void test_async_write_through_allocation()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket a(ioc), b(ioc);
+  a.open(tcp::v4());
+  a.set_option(asio::socket_base::send_buffer_size(4096));
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+
+  asio::buffered_write_stream<tcp::socket&> stream(a, 64);
+
+  std::string data = make_data(1000 * 1000);
+  std::vector<asio::const_buffer> buffers;
+  for (std::size_t i = 0; i < 1000; ++i)
+    buffers.push_back(asio::buffer(data.data() + i * 1000, 1000));
+  std::string received(data.size() + 3, '\0');
+
+  // Run one write and read first, so that the thread's recycled memory is in
+  // place and the reactor has allocated its descriptor state.
+  asio::async_write(a, asio::buffer("xyz", 3),
+      [](const asio::error_code&, std::size_t) {});
+  asio::async_read(b, asio::buffer(&received[0], 3),
+      [](const asio::error_code&, std::size_t) {});
+  ioc.run();
+  ioc.restart();
+
+  // Every step of the write is a write-through, as each buffer is larger than
+  // the stream's internal buffer. Each step must reuse the memory of the
+  // last, rather than allocate.
+  std::size_t before = allocation_count;
+  asio::async_write(stream, buffers,
+      [](const asio::error_code&, std::size_t) {});
+  asio::async_read(b, asio::buffer(&received[3], data.size()),
+      [](const asio::error_code&, std::size_t) {});
+  std::size_t handlers = ioc.run();
+  std::size_t allocations = allocation_count - before;
+
+  ASIO_CHECK(received.substr(3) == data);
+  ASIO_CHECK(handlers > 50);
+  ASIO_CHECK(allocations < 10);
+}
+
+void test_read_peek_consume()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  asio::buffered_read_stream<tcp::socket&> stream(b, 64);
+  asio::write(a, asio::buffer("hello world", 11));
+
+  while (stream.in_avail() < 11)
+    stream.fill();
+  ASIO_CHECK(stream.in_avail() == 11);
+
+  // Peeking does not consume the data.
+  char buf[5];
+  ASIO_CHECK(stream.peek(asio::buffer(buf)) == 5);
+  ASIO_CHECK(std::string(buf, 5) == "hello");
+  asio::const_buffer data = stream.peek();
+  ASIO_CHECK(data.size() == 11);
+  ASIO_CHECK(std::string(static_cast<const char*>(data.data()), 5) == "hello");
+
+  stream.consume(6);
+  ASIO_CHECK(stream.in_avail() == 5);
+  ASIO_CHECK(stream.read_some(asio::buffer(buf)) == 5);
+  ASIO_CHECK(std::string(buf, 5) == "world");
+  ASIO_CHECK(stream.in_avail() == 0);
+}
+
+void test_read_large()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  asio::buffered_read_stream<tcp::socket&> stream(b, 64);
+  std::string data = make_data(150);
+  asio::write(a, asio::buffer(data));
+  while (available(b) < data.size())
+    ;
+
+  // A read into an empty buffer fills the caller's buffer first, and keeps
+  // the excess.
+  char buf[100];
+  std::size_t n = stream.read_some(asio::buffer(buf));
+  ASIO_CHECK(n == 100);
+  ASIO_CHECK(std::string(buf, 100) == data.substr(0, 100));
+  ASIO_CHECK(stream.in_avail() == 50);
+
+  n = asio::read(stream, asio::buffer(buf, 50));
+  ASIO_CHECK(n == 50);
+  ASIO_CHECK(std::string(buf, 50) == data.substr(100));
+}
+
+void test_buffered_stream()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  asio::buffered_stream<tcp::socket&> writer(a, 128, 128);
+  asio::buffered_stream<tcp::socket&> reader(b, 128, 128);
+
+  std::string lines;
+  for (int i = 0; i < 100; ++i)
+    lines += "line " + std::to_string(i) + "\n";
+
+  asio::async_write(writer, asio::buffer(lines),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        ASIO_CHECK(!ec);
+        writer.async_flush(
+            [](const asio::error_code& e, std::size_t)
+            {
+              ASIO_CHECK(!e);
+            });
+      });
+
+  std::string received;
+  int count = 0;
+  std::function<void()> read_line = [&]()
+  {
+    asio::async_read_until(reader, asio::dynamic_buffer(received), '\n',
+        [&](const asio::error_code& ec, std::size_t n)
+        {
+          ASIO_CHECK(!ec);
+          ASIO_CHECK(received.substr(0, n)
+              == "line " + std::to_string(count) + "\n");
+          received.erase(0, n);
+          if (++count < 100)
+            read_line();
+        });
+  };
+  read_line();
+
+  ioc.run();
+  ASIO_CHECK(count == 100);
+}
+
+} // namespace buffered_stream_test
+
+ASIO_TEST_SUITE
+(
+  "buffered_stream",
+  ASIO_TEST_CASE(buffered_stream_test::test_write_coalescing)
+  ASIO_TEST_CASE(buffered_stream_test::test_write_large)
+  ASIO_TEST_CASE(buffered_stream_test::test_async_write)
+  ASIO_TEST_CASE(buffered_stream_test::test_async_write_through_allocation)
+  ASIO_TEST_CASE(buffered_stream_test::test_read_peek_consume)
+  ASIO_TEST_CASE(buffered_stream_test::test_read_large)
+  ASIO_TEST_CASE(buffered_stream_test::test_buffered_stream)
+)
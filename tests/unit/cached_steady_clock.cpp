@@ -0,0 +1,116 @@
+//
+// cached_steady_clock.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/service/timer/helper/cached_steady_clock.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+namespace cached_steady_clock_test {
+
+using asio::cached_steady_clock;
+namespace chrono = asio::chrono;
+
+void test_cached()
+{
+  cached_steady_clock::time_point t1 = cached_steady_clock::now();
+  ASIO_CHECK(cached_steady_clock::in_use());
+  ASIO_CHECK(t1.time_since_epoch().count() != 0);
+  ASIO_CHECK(t1 <= chrono::steady_clock::now());
+
+  // Without a refresh, the cached time does not change.
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  ASIO_CHECK(cached_steady_clock::now() == t1);
+
+  // A refresh reads the clock and caches the time that it returns.
+  cached_steady_clock::time_point t2 = cached_steady_clock::refresh();
+  ASIO_CHECK(t2 >= t1 + chrono::milliseconds(5));
+  ASIO_CHECK(cached_steady_clock::now() == t2);
+
+  asio::detail::refresh_cached_clock();
+  ASIO_CHECK(cached_steady_clock::now() > t2);
+}
+
+void test_monotonic_concurrent()
+{
+  std::atomic<bool> stop(false);
+  std::atomic<int> backwards(0);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.push_back(std::thread([&]()
+        {
+          cached_steady_clock::time_point last = cached_steady_clock::now();
+          while (!stop.load())
+          {
+            cached_steady_clock::time_point t = cached_steady_clock::refresh();
+            cached_steady_clock::time_point n = cached_steady_clock::now();
+            if (t < last || n < t)
+              ++backwards;
+            last = n;
+          }
+        }));
+  }
+  for (int i = 0; i < 2; ++i)
+  {
+    threads.push_back(std::thread([&]()
+        {
+          cached_steady_clock::time_point last = cached_steady_clock::now();
+          while (!stop.load())
+          {
+            cached_steady_clock::time_point n = cached_steady_clock::now();
+            if (n < last)
+              ++backwards;
+            last = n;
+          }
+        }));
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  stop = true;
+  for (std::size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+
+  ASIO_CHECK(backwards.load() == 0);
+}
+
+void test_timer()
+{
+  asio::io_context ioc;
+  asio::cached_steady_timer t(ioc);
+
+  // The cached time may lag, so refresh it before measuring from it.
+  cached_steady_clock::refresh();
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  t.expires_after(chrono::milliseconds(20));
+
+  bool fired = false;
+  t.async_wait([&](const asio::error_code& ec)
+      {
+        fired = !ec;
+        ASIO_CHECK(cached_steady_clock::now() >= t.expiry());
+      });
+  ioc.run();
+
+  // The reactor refreshes the cache, so the timer fires without any other
+  // call to refresh().
+  ASIO_CHECK(fired);
+  ASIO_CHECK(chrono::steady_clock::now() - start >= chrono::milliseconds(20));
+}
+
+} // namespace cached_steady_clock_test
+
+ASIO_TEST_SUITE
+(
+  "cached_steady_clock",
+  ASIO_TEST_CASE(cached_steady_clock_test::test_cached)
+  ASIO_TEST_CASE(cached_steady_clock_test::test_monotonic_concurrent)
+  ASIO_TEST_CASE(cached_steady_clock_test::test_timer)
+)
@@ -0,0 +1,179 @@
+//
+// checksum_stream.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/transmit/checksum_stream.hpp"
+
+#include <cstring>
+#include <string>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::ip::tcp;
+
+namespace checksum_stream_test {
+
+// A bitwise CRC-32C, to check the optimised implementations against.
+asio::crc32c::value_type reference_crc32c(const void* data, std::size_t size)
+{
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  uint32_t crc = 0xFFFFFFFF;
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    crc ^= p[i];
+    for (int k = 0; k < 8; ++k)
+      crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+  }
+  return crc ^ 0xFFFFFFFF;
+}
+
+std::string make_data(std::size_t size)
+{
+  std::string data(size, '\0');
+  uint32_t x = 12345;
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    x = x * 1103515245 + 12345;
+    data[i] = static_cast<char>(x >> 16);
+  }
+  return data;
+}
+
+asio::crc32c::value_type crc_of(const std::string& data)
+{
+  asio::crc32c crc;
+  crc.update(data.data(), data.size());
+  return crc.value();
+}
+
+void test_known_values()
+{
+  asio::crc32c crc;
+  ASIO_CHECK(crc.value() == 0);
+
+  crc.update("123456789", 9);
+  ASIO_CHECK(crc.value() == 0xE3069283);
+
+  crc.reset();
+  char zeros[32];
+  std::memset(zeros, 0, sizeof(zeros));
+  crc.update(zeros, sizeof(zeros));
+  ASIO_CHECK(crc.value() == 0x8A9136AA);
+}
+
+void test_against_reference()
+{
+  // Cover every alignment and the tails left over by the wide loops.
+  std::string data = make_data(4096 + 16);
+  for (std::size_t offset = 0; offset < 16; ++offset)
+  {
+    for (std::size_t size = 0; size < 64; ++size)
+    {
+      asio::crc32c crc;
+      crc.update(data.data() + offset, size);
+      ASIO_CHECK(crc.value() == reference_crc32c(data.data() + offset, size));
+    }
+
+    asio::crc32c crc;
+    crc.update(data.data() + offset, 4096);
+    ASIO_CHECK(crc.value() == reference_crc32c(data.data() + offset, 4096));
+  }
+}
+
+void test_incremental()
+{
+  std::string data = make_data(10000);
+  asio::crc32c whole;
+  whole.update(data.data(), data.size());
+
+  asio::crc32c pieces;
+  std::size_t pos = 0;
+  for (std::size_t n = 1; pos < data.size(); n = n * 3 + 1)
+  {
+    std::size_t len = (std::min)(n, data.size() - pos);
+    pieces.update(data.data() + pos, len);
+    pos += len;
+  }
+  ASIO_CHECK(pieces.value() == whole.value());
+}
+
+void connect_pair(asio::io_context& ioc, tcp::socket& a, tcp::socket& b)
+{
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+}
+
+void test_sync()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  asio::checksum_stream<tcp::socket&> writer(a);
+  asio::checksum_stream<tcp::socket&> reader(b);
+
+  std::string data = make_data(1000);
+  asio::write(writer, asio::buffer(data));
+
+  // Only the bytes actually read are added to the checksum.
+  std::string received(2000, '\0');
+  std::size_t n = asio::read(reader, asio::buffer(&received[0], 600));
+  ASIO_CHECK(n == 600);
+  ASIO_CHECK(reader.read_checksum().value() == crc_of(data.substr(0, 600)));
+  n = asio::read(reader, asio::buffer(&received[600], 400));
+  ASIO_CHECK(n == 400);
+
+  ASIO_CHECK(received.substr(0, 1000) == data);
+  ASIO_CHECK(writer.write_checksum().value() == crc_of(data));
+  ASIO_CHECK(reader.read_checksum().value() == crc_of(data));
+  ASIO_CHECK(writer.read_checksum().value() == 0);
+}
+
+void test_async()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  asio::checksum_stream<tcp::socket&> writer(a);
+  asio::checksum_stream<tcp::socket&> reader(b);
+
+  // Larger than the socket buffers, so that both operations must wait.
+  std::string data = make_data(4 * 1024 * 1024);
+  std::string header = "header";
+  std::array<asio::const_buffer, 2> bufs = {{
+    asio::buffer(header), asio::buffer(data) }};
+
+  asio::error_code write_ec;
+  asio::async_write(writer, bufs,
+      [&](const asio::error_code& ec, std::size_t) { write_ec = ec; });
+
+  std::string received(header.size() + data.size(), '\0');
+  asio::error_code read_ec;
+  asio::async_read(reader, asio::buffer(&received[0], received.size()),
+      [&](const asio::error_code& ec, std::size_t) { read_ec = ec; });
+
+  ioc.run();
+
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(received == header + data);
+  ASIO_CHECK(writer.write_checksum().value() == crc_of(header + data));
+  ASIO_CHECK(reader.read_checksum().value() == crc_of(header + data));
+}
+
+} // namespace checksum_stream_test
+
+ASIO_TEST_SUITE
+(
+  "checksum_stream",
+  ASIO_TEST_CASE(checksum_stream_test::test_known_values)
+  ASIO_TEST_CASE(checksum_stream_test::test_against_reference)
+  ASIO_TEST_CASE(checksum_stream_test::test_incremental)
+  ASIO_TEST_CASE(checksum_stream_test::test_sync)
+  ASIO_TEST_CASE(checksum_stream_test::test_async)
+)
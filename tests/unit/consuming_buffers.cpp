@@ -0,0 +1,212 @@
+//
+// consuming_buffers.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/buffer/consuming_buffers.hpp"
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::ip::tcp;
+
+// Count every allocation made by the program, so that the test can check that
+// the operations of a multi-buffer write are recycled.
+static std::size_t allocation_count = 0;
+
+void* operator new(std::size_t size)
+{
+  ++allocation_count;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) ASIO_NOEXCEPT
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) ASIO_NOEXCEPT
+{
+  std::free(p);
+}
+
+namespace consuming_buffers_test {
+
+typedef std::vector<asio::const_buffer> buffers_type;
+typedef asio::detail::consuming_buffers<asio::const_buffer,
+    buffers_type, buffers_type::const_iterator> consuming_type;
+typedef consuming_type::prepared_buffers_type prepared_type;
+
+// Make a sequence of buffers of varying sizes, including empty ones, over the
+// given data.
+buffers_type make_buffers(const std::string& data)
+{
+  buffers_type buffers;
+  std::size_t pos = 0;
+  for (std::size_t i = 0; pos < data.size(); ++i)
+  {
+    std::size_t size = i % 7;
+    if (size > data.size() - pos)
+      size = data.size() - pos;
+    buffers.push_back(asio::buffer(data.data() + pos, size));
+    pos += size;
+  }
+  return buffers;
+}
+
+std::string make_data(std::size_t size)
+{
+  std::string data(size, '\0');
+  for (std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>('a' + i % 26);
+  return data;
+}
+
+void test_prepare_consume()
+{
+  std::string data = make_data(5000);
+  buffers_type buffers = make_buffers(data);
+  consuming_type cb(buffers);
+
+  // Consume in uneven steps, checking that each prepared sequence starts at
+  // the consumption point and never holds more than the window allows.
+  std::string out;
+  std::size_t step = 1;
+  while (!cb.empty())
+  {
+    prepared_type prepared = cb.prepare(1000);
+    ASIO_CHECK(prepared.count > 0);
+    ASIO_CHECK(prepared.count
+        <= static_cast<std::size_t>(prepared_type::max_buffers));
+
+    std::string p;
+    for (std::size_t i = 0; i < prepared.count; ++i)
+    {
+      ASIO_CHECK(prepared.elems[i].size() > 0);
+      p.append(static_cast<const char*>(prepared.elems[i].data()),
+          prepared.elems[i].size());
+    }
+    ASIO_CHECK(p.size() <= 1000);
+
+    std::size_t n = step < p.size() ? step : p.size();
+    out.append(p, 0, n);
+    cb.consume(n);
+    step = step * 3 % 97 + 1;
+  }
+
+  ASIO_CHECK(out == data);
+  ASIO_CHECK(cb.total_consumed() == data.size());
+}
+
+void test_prepare_max_size()
+{
+  std::string data = make_data(100);
+  buffers_type buffers = make_buffers(data);
+  consuming_type cb(buffers);
+
+  prepared_type prepared = cb.prepare(10);
+  ASIO_CHECK(asio::buffer_size(prepared) == 10);
+  cb.consume(10);
+  prepared = cb.prepare(0);
+  ASIO_CHECK(asio::buffer_size(prepared) == 0);
+  prepared = cb.prepare(1000);
+  ASIO_CHECK(asio::buffer_size(prepared) <= 90);
+  ASIO_CHECK(std::string(static_cast<const char*>(prepared.elems[0].data()),
+        prepared.elems[0].size()) == data.substr(10, prepared.elems[0].size()));
+}
+
+void test_socket_write()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket a(ioc), b(ioc);
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+
+  std::string data = make_data(2 * 1024 * 1024);
+  buffers_type buffers = make_buffers(data);
+
+  asio::error_code write_ec;
+  std::size_t written = 0;
+  asio::async_write(a, buffers,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        write_ec = ec;
+        written = n;
+      });
+
+  std::string received(data.size(), '\0');
+  asio::error_code read_ec;
+  asio::async_read(b, asio::buffer(&received[0], received.size()),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        read_ec = ec;
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(written == data.size());
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(received == data);
+}
+
+void test_recycled_allocation()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket a(ioc), b(ioc);
+  a.open(tcp::v4());
+  a.set_option(asio::socket_base::send_buffer_size(4096));
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+
+  std::string data = make_data(2000 * 1500);
+  buffers_type buffers;
+  for (std::size_t i = 0; i < 2000; ++i)
+    buffers.push_back(asio::buffer(data.data() + i * 1500, 1500));
+  std::string received(data.size(), '\0');
+
+  // Run one write and read first, so that the thread's recycled memory is in
+  // place and the reactor has allocated its descriptor state.
+  asio::async_write(a, asio::buffer(data, 10),
+      [](const asio::error_code&, std::size_t) {});
+  asio::async_read(b, asio::buffer(&received[0], 10),
+      [](const asio::error_code&, std::size_t) {});
+  ioc.run();
+  ioc.restart();
+
+  // The small send buffer makes the write take hundreds of steps. Each step
+  // must reuse the memory of the last, rather than allocate.
+  std::size_t before = allocation_count;
+  asio::async_write(a, buffers, asio::transfer_all(),
+      [](const asio::error_code&, std::size_t) {});
+  asio::async_read(b, asio::buffer(&received[0], received.size()),
+      [](const asio::error_code&, std::size_t) {});
+  std::size_t handlers = ioc.run();
+  std::size_t allocations = allocation_count - before;
+
+  ASIO_CHECK(received == data);
+  ASIO_CHECK(handlers > 100);
+  ASIO_CHECK(allocations < 10);
+}
+
+} // namespace consuming_buffers_test
+
+ASIO_TEST_SUITE
+(
+  "consuming_buffers",
+  ASIO_TEST_CASE(consuming_buffers_test::test_prepare_consume)
+  ASIO_TEST_CASE(consuming_buffers_test::test_prepare_max_size)
+  ASIO_TEST_CASE(consuming_buffers_test::test_socket_write)
+  ASIO_TEST_CASE(consuming_buffers_test::test_recycled_allocation)
+)
@@ -0,0 +1,177 @@
+//
+// immediate_completion.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::ip::tcp;
+
+namespace immediate_completion_test {
+
+void connect_pair(asio::io_context& ioc, tcp::socket& a, tcp::socket& b)
+{
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+}
+
+void test_mode()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  ASIO_CHECK(!a.immediate_completion());
+  a.immediate_completion(true);
+  ASIO_CHECK(a.immediate_completion());
+  a.immediate_completion(false);
+  ASIO_CHECK(!a.immediate_completion());
+}
+
+void test_inline_completion()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+  a.immediate_completion(true);
+
+  asio::write(b, asio::buffer("abc", 3));
+
+  // Wait until the data is readable, so that the read can complete at once.
+  a.wait(tcp::socket::wait_read);
+
+  char data[16];
+  bool initiated = false;
+  bool inline_completion = false;
+  std::size_t bytes = 0;
+  asio::post(ioc,
+      [&]()
+      {
+        a.async_read_some(asio::buffer(data),
+            [&](const asio::error_code& ec, std::size_t n)
+            {
+              ASIO_CHECK(!ec);
+              inline_completion = !initiated;
+              bytes = n;
+            });
+        initiated = true;
+      });
+  ioc.run();
+
+  ASIO_CHECK(inline_completion);
+  ASIO_CHECK(bytes == 3);
+}
+
+void test_deferred_completion()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+  a.immediate_completion(true);
+
+  // The read cannot complete when it is started, and must complete once the
+  // data arrives from another thread.
+  const int count = 1000;
+  int completed = 0;
+  char data[1];
+  std::function<void()> start_read = [&]()
+  {
+    a.async_read_some(asio::buffer(data),
+        [&](const asio::error_code& ec, std::size_t n)
+        {
+          if (!ec && n == 1 && ++completed < count)
+            start_read();
+        });
+  };
+  asio::post(ioc, start_read);
+
+  std::thread t(
+      [&]()
+      {
+        for (int i = 0; i < count; ++i)
+          asio::write(b, asio::buffer("x", 1));
+      });
+
+  ioc.run();
+  t.join();
+
+  ASIO_CHECK(completed == count);
+}
+
+// A read handler that throws, and counts the allocations made for it.
+struct throwing_handler
+{
+  int* allocations;
+  int* deallocations;
+
+  void operator()(const asio::error_code&, std::size_t)
+  {
+    throw std::runtime_error("handler");
+  }
+
+  friend void* asio_handler_allocate(std::size_t size, throwing_handler* h)
+  {
+    ++*h->allocations;
+    return std::malloc(size);
+  }
+
+  friend void asio_handler_deallocate(void* p, std::size_t,
+      throwing_handler* h)
+  {
+    ++*h->deallocations;
+    std::free(p);
+  }
+};
+
+void test_throwing_handler()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+  a.immediate_completion(true);
+
+  asio::write(b, asio::buffer("abc", 3));
+  a.wait(tcp::socket::wait_read);
+
+  // An exception thrown by an inline handler propagates out of the initiating
+  // function, and the operation is freed exactly once.
+  char data[16];
+  int allocations = 0, deallocations = 0;
+  bool caught = false;
+  asio::post(ioc,
+      [&]()
+      {
+        throwing_handler h = { &allocations, &deallocations };
+        try
+        {
+          a.async_read_some(asio::buffer(data), h);
+        }
+        catch (std::runtime_error&)
+        {
+          caught = true;
+        }
+      });
+  ioc.run();
+
+  ASIO_CHECK(caught);
+  ASIO_CHECK(allocations == 1);
+  ASIO_CHECK(deallocations == 1);
+}
+
+} // namespace immediate_completion_test
+
+ASIO_TEST_SUITE
+(
+  "immediate_completion",
+  ASIO_TEST_CASE(immediate_completion_test::test_mode)
+  ASIO_TEST_CASE(immediate_completion_test::test_inline_completion)
+  ASIO_TEST_CASE(immediate_completion_test::test_deferred_completion)
+  ASIO_TEST_CASE(immediate_completion_test::test_throwing_handler)
+)
@@ -0,0 +1,306 @@
+//
+// length_prefix.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/transmit/length_prefix.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "asio.hpp"
+#include "test_stream.hpp"
+#include "unit_test.hpp"
+
+namespace length_prefix_test {
+
+std::string to_string(const asio::const_buffer& b)
+{
+  return std::string(static_cast<const char*>(b.data()), b.size());
+}
+
+void test_encode_decode()
+{
+  const std::size_t lengths[] = { 0, 1, 127, 128, 300, 16383, 16384, 65535 };
+  const asio::length_prefix prefixes[] = {
+    asio::length_prefix::varint(),
+    asio::length_prefix::fixed(2),
+    asio::length_prefix::fixed(4),
+    asio::length_prefix::fixed(8)
+  };
+
+  for (std::size_t p = 0; p < sizeof(prefixes) / sizeof(prefixes[0]); ++p)
+  {
+    for (std::size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i)
+    {
+      unsigned char header[asio::length_prefix::max_header_size];
+      std::size_t n = prefixes[p].encode(lengths[i], header);
+      ASIO_CHECK(n == prefixes[p].header_size(lengths[i]));
+
+      // An incomplete header decodes as nothing.
+      std::size_t length = 0;
+      asio::error_code ec;
+      ASIO_CHECK(prefixes[p].decode(header, n - 1, length, ec) == 0);
+      ASIO_CHECK(!ec);
+
+      ASIO_CHECK(prefixes[p].decode(header, n, length, ec) == n);
+      ASIO_CHECK(!ec);
+      ASIO_CHECK(length == lengths[i]);
+    }
+  }
+
+  // Variable-width headers grow by one byte per seven bits.
+  asio::length_prefix v = asio::length_prefix::varint();
+  ASIO_CHECK(v.header_size(127) == 1);
+  ASIO_CHECK(v.header_size(128) == 2);
+  ASIO_CHECK(v.header_size(16384) == 3);
+
+  // Fixed-width headers are big-endian.
+  unsigned char header[4];
+  asio::length_prefix::fixed(4).encode(0x01020304, header);
+  ASIO_CHECK(header[0] == 1 && header[1] == 2
+      && header[2] == 3 && header[3] == 4);
+}
+
+void test_limits()
+{
+  bool threw = false;
+  try
+  {
+    asio::length_prefix::fixed(9);
+  }
+  catch (std::invalid_argument&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+
+  ASIO_CHECK(asio::length_prefix::fixed(1).max_frame_size() == 255);
+  ASIO_CHECK(asio::length_prefix::fixed(2, 100).max_frame_size() == 100);
+
+  // A length above the maximum frame size is an error.
+  asio::length_prefix p = asio::length_prefix::varint(1000);
+  unsigned char header[asio::length_prefix::max_header_size];
+  std::size_t n = asio::length_prefix::varint().encode(1001, header);
+  std::size_t length = 0;
+  asio::error_code ec;
+  ASIO_CHECK(p.decode(header, n, length, ec) == 0);
+  ASIO_CHECK(ec == asio::error::message_size);
+
+  asio::length_prefix f = asio::length_prefix::fixed(4, 1000);
+  asio::length_prefix::fixed(4).encode(0x7FFFFFFF, header);
+  ASIO_CHECK(f.decode(header, 4, length, ec) == 0);
+  ASIO_CHECK(ec == asio::error::message_size);
+
+  // A varint that does not fit in std::size_t is an error.
+  unsigned char overlong[11];
+  for (int i = 0; i < 10; ++i)
+    overlong[i] = 0xFF;
+  overlong[10] = 0x01;
+  ASIO_CHECK(asio::length_prefix::varint(~std::size_t(0)).decode(
+        overlong, sizeof(overlong), length, ec) == 0);
+  ASIO_CHECK(ec == asio::error::message_size);
+}
+
+void test_framed_buffers()
+{
+  asio::length_prefix prefix = asio::length_prefix::varint();
+
+  // More frames than the hint, so that the header storage grows.
+  asio::framed_buffers frames(prefix, 2);
+  ASIO_CHECK(frames.empty());
+  std::vector<std::string> payloads;
+  payloads.reserve(51);
+  for (int i = 0; i < 50; ++i)
+  {
+    payloads.push_back(std::string(i * 7, static_cast<char>('a' + i % 26)));
+    frames.push_back(asio::buffer(payloads.back()));
+  }
+
+  std::vector<asio::const_buffer> two;
+  two.push_back(asio::buffer("ab", 2));
+  two.push_back(asio::buffer("", 0));
+  two.push_back(asio::buffer("cde", 3));
+  frames.push_back(two);
+  payloads.push_back("abcde");
+
+  ASIO_CHECK(frames.frames() == payloads.size());
+  ASIO_CHECK(frames.size() == asio::buffer_size(frames));
+
+  // Decode the serialised frames.
+  std::string wire(asio::buffer_size(frames), '\0');
+  asio::buffer_copy(asio::buffer(&wire[0], wire.size()), frames);
+  std::size_t pos = 0;
+  for (std::size_t i = 0; i < payloads.size(); ++i)
+  {
+    std::size_t length = 0;
+    asio::error_code ec;
+    std::size_t n = prefix.decode(wire.data() + pos,
+        wire.size() - pos, length, ec);
+    ASIO_CHECK(n > 0);
+    ASIO_CHECK(wire.substr(pos + n, length) == payloads[i]);
+    pos += n + length;
+  }
+  ASIO_CHECK(pos == wire.size());
+
+  frames.clear();
+  ASIO_CHECK(frames.empty());
+  ASIO_CHECK(asio::buffer_size(frames) == 0);
+
+  asio::framed_buffers small(asio::length_prefix::fixed(1));
+  bool threw = false;
+  try
+  {
+    small.push_back(asio::buffer(std::string(256, 'x')));
+  }
+  catch (std::length_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+}
+
+void test_framed_buffers_view()
+{
+  asio::length_prefix prefix = asio::length_prefix::fixed(2);
+  asio::framed_buffers frames(prefix);
+  frames.push_back(asio::buffer("hello", 5));
+  frames.push_back(asio::buffer("world!", 6));
+
+  // The view refers to the object's own buffers, rather than a copy of them.
+  asio::framed_buffers::const_buffers_type view = frames.buffers();
+  ASIO_CHECK(view.end() - view.begin() == frames.end() - frames.begin());
+  ASIO_CHECK(view.begin() == &*frames.begin());
+  ASIO_CHECK(asio::buffer_size(view) == frames.size());
+
+  std::string expected(frames.size(), '\0');
+  asio::buffer_copy(asio::buffer(&expected[0], expected.size()), frames);
+  ASIO_CHECK(expected == std::string("\x00\x05hello\x00\x06world!", 15));
+
+  // The view may be given to an asynchronous write.
+  asio::io_context ioc;
+  test_stream s(ioc);
+  asio::error_code write_ec;
+  std::size_t written = 0;
+  asio::async_write(s, frames.buffers(),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        write_ec = ec;
+        written = n;
+      });
+  ioc.run();
+  ASIO_CHECK(!write_ec);
+  ASIO_CHECK(written == expected.size());
+  ASIO_CHECK(s.written() == expected);
+
+  frames.clear();
+  view = frames.buffers();
+  ASIO_CHECK(view.begin() == view.end());
+  ASIO_CHECK(asio::buffer_size(view) == 0);
+}
+
+void test_read_frames()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  asio::length_prefix prefix = asio::length_prefix::fixed(2);
+  asio::framed_buffers out(prefix);
+  std::string large(1000, 'x');
+  out.push_back(asio::buffer("first", 5));
+  out.push_back(asio::buffer("", 0));
+  out.push_back(asio::buffer(large));
+  std::string wire(asio::buffer_size(out), '\0');
+  asio::buffer_copy(asio::buffer(&wire[0], wire.size()), out);
+  wire += "\x00\x05par";
+
+  for (std::size_t len = 1; len < wire.size(); len += 7)
+  {
+    s.reset(wire, len);
+    std::string data;
+    std::vector<asio::const_buffer> frames;
+    std::vector<std::string> all;
+    asio::error_code ec;
+    for (;;)
+    {
+      std::size_t n = asio::read_frames(s,
+          asio::dynamic_buffer(data), prefix, frames, ec);
+      if (ec)
+        break;
+      for (std::size_t i = 0; i < frames.size(); ++i)
+        all.push_back(to_string(frames[i]));
+      data.erase(0, n);
+    }
+    ASIO_CHECK(ec == asio::error::eof);
+    ASIO_CHECK(all.size() == 3);
+    if (all.size() == 3)
+    {
+      ASIO_CHECK(all[0] == "first");
+      ASIO_CHECK(all[1].empty());
+      ASIO_CHECK(all[2] == large);
+    }
+  }
+
+  // A frame above the maximum size fails.
+  s.reset(wire, wire.size());
+  std::string data;
+  std::vector<asio::const_buffer> frames;
+  asio::error_code ec;
+  std::size_t n = asio::read_frames(s, asio::dynamic_buffer(data),
+      asio::length_prefix::fixed(2, 100), frames, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(frames.size() == 2);
+  data.erase(0, n);
+  n = asio::read_frames(s, asio::dynamic_buffer(data),
+      asio::length_prefix::fixed(2, 100), frames, ec);
+  ASIO_CHECK(ec == asio::error::message_size);
+  ASIO_CHECK(n == 0);
+}
+
+void test_async_read_frames()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  asio::length_prefix prefix = asio::length_prefix::varint();
+  asio::framed_buffers out(prefix);
+  std::string large(300, 'y');
+  out.push_back(asio::buffer(large));
+  out.push_back(asio::buffer("z", 1));
+  std::string wire(asio::buffer_size(out), '\0');
+  asio::buffer_copy(asio::buffer(&wire[0], wire.size()), out);
+
+  for (std::size_t len = 1; len <= wire.size(); len += 13)
+  {
+    s.reset(wire, len);
+    std::string data;
+    std::vector<asio::const_buffer> frames;
+    bool called = false;
+    asio::async_read_frames(s, asio::dynamic_buffer(data), prefix, frames,
+        [&](const asio::error_code& ec, std::size_t n)
+        {
+          called = true;
+          ASIO_CHECK(!ec);
+          ASIO_CHECK(!frames.empty());
+          ASIO_CHECK(to_string(frames[0]) == large);
+          ASIO_CHECK(n == wire.size() - (frames.size() == 2 ? 0 : 2));
+        });
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(called);
+  }
+}
+
+} // namespace length_prefix_test
+
+ASIO_TEST_SUITE
+(
+  "length_prefix",
+  ASIO_TEST_CASE(length_prefix_test::test_encode_decode)
+  ASIO_TEST_CASE(length_prefix_test::test_limits)
+  ASIO_TEST_CASE(length_prefix_test::test_framed_buffers)
+  ASIO_TEST_CASE(length_prefix_test::test_framed_buffers_view)
+  ASIO_TEST_CASE(length_prefix_test::test_read_frames)
+  ASIO_TEST_CASE(length_prefix_test::test_async_read_frames)
+)
@@ -0,0 +1,122 @@
+//
+// network_map.cpp
+// ~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/ip/network_map.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::ip::make_address;
+using asio::ip::make_network_v4;
+using asio::ip::make_network_v6;
+using asio::ip::network_map;
+
+namespace network_map_test {
+
+void test_longest_prefix()
+{
+  network_map<std::string> map;
+  ASIO_CHECK(map.empty());
+  ASIO_CHECK(map.find(make_address("10.1.2.3")) == 0);
+
+  map.insert(make_network_v4("10.0.0.0/8"), "ten");
+  map.insert(make_network_v4("10.1.0.0/16"), "ten-one");
+  map.insert(make_network_v4("0.0.0.0/0"), "default");
+  ASIO_CHECK(map.size() == 3);
+
+  ASIO_CHECK(*map.find(make_address("10.1.2.3")) == "ten-one");
+  ASIO_CHECK(*map.find(make_address("10.2.0.1")) == "ten");
+  ASIO_CHECK(*map.find(make_address("192.168.0.1")) == "default");
+
+  // Host bits are ignored, and inserting a network again replaces its value.
+  map.insert(make_network_v4("10.1.255.255/16"), "replaced");
+  ASIO_CHECK(map.size() == 3);
+  ASIO_CHECK(*map.find(make_address("10.1.2.3")) == "replaced");
+
+  map.clear();
+  ASIO_CHECK(map.empty());
+  ASIO_CHECK(map.find(make_address("10.1.2.3")) == 0);
+}
+
+void test_v6()
+{
+  network_map<int> map;
+  map.insert(make_network_v6("2001:db8::/32"), 1);
+  map.insert(make_network_v6("2001:db8:1::/48"), 2);
+  map.insert(make_network_v4("192.0.2.0/24"), 3);
+
+  ASIO_CHECK(*map.find(make_address("2001:db8::1")) == 1);
+  ASIO_CHECK(*map.find(make_address("2001:db8:1::1")) == 2);
+  ASIO_CHECK(map.find(make_address("2001:db9::1")) == 0);
+
+  // IPv4-mapped addresses match the IPv4 networks.
+  ASIO_CHECK(*map.find(make_address("::ffff:192.0.2.7")) == 3);
+  ASIO_CHECK(map.find(make_address("::ffff:192.0.3.7")) == 0);
+}
+
+void test_bool()
+{
+  network_map<bool> allowed;
+  allowed.insert(make_network_v4("10.0.0.0/8"), true);
+  allowed.insert(make_network_v4("10.1.0.0/16"), false);
+  allowed.insert(make_network_v6("fd00::/8"), true);
+
+  const bool* allow = allowed.find(make_address("10.2.3.4"));
+  ASIO_CHECK(allow != 0);
+  ASIO_CHECK(*allow);
+
+  allow = allowed.find(make_address("10.1.3.4"));
+  ASIO_CHECK(allow != 0);
+  ASIO_CHECK(!*allow);
+
+  allow = allowed.find(make_address("fd12::1"));
+  ASIO_CHECK(allow != 0);
+  ASIO_CHECK(*allow);
+
+  ASIO_CHECK(allowed.find(make_address("11.0.0.1")) == 0);
+
+  network_map<bool>::snapshot_type rules = allowed.snapshot();
+  allowed.insert(make_network_v4("10.1.0.0/16"), true);
+  ASIO_CHECK(*allowed.find(make_address("10.1.3.4")));
+  ASIO_CHECK(!*rules->find(make_address("10.1.3.4")));
+}
+
+void test_range_constructor()
+{
+  std::vector<std::pair<asio::ip::network_v4, int> > entries;
+  for (int i = 0; i < 1000; ++i)
+  {
+    asio::ip::address_v4 addr(static_cast<asio::ip::address_v4::uint_type>(
+          (10u << 24) | (static_cast<unsigned>(i) << 8)));
+    entries.push_back(std::make_pair(asio::ip::network_v4(addr, 24), i));
+  }
+  entries.push_back(std::make_pair(make_network_v4("10.0.5.0/24"), -5));
+
+  network_map<int> map(entries.begin(), entries.end());
+  ASIO_CHECK(map.size() == 1000);
+  for (int i = 0; i < 1000; ++i)
+  {
+    asio::ip::address_v4 addr(static_cast<asio::ip::address_v4::uint_type>(
+          (10u << 24) | (static_cast<unsigned>(i) << 8) | 1));
+    const int* value = map.find(addr);
+    ASIO_CHECK(value != 0);
+    ASIO_CHECK(*value == (i == 5 ? -5 : i));
+  }
+}
+
+} // namespace network_map_test
+
+ASIO_TEST_SUITE
+(
+  "network_map",
+  ASIO_TEST_CASE(network_map_test::test_longest_prefix)
+  ASIO_TEST_CASE(network_map_test::test_v6)
+  ASIO_TEST_CASE(network_map_test::test_bool)
+  ASIO_TEST_CASE(network_map_test::test_range_constructor)
+)
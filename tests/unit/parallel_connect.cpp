@@ -0,0 +1,213 @@
+//
+// parallel_connect.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/transmit/parallel_connect.hpp"
+
+#include <vector>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::ip::tcp;
+
+namespace parallel_connect_test {
+
+// An endpoint on which nothing is listening.
+tcp::endpoint refused_endpoint(asio::io_context& ioc)
+{
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::endpoint endpoint = acceptor.local_endpoint();
+  acceptor.close();
+  return endpoint;
+}
+
+// A listening endpoint whose backlog has been filled, so that further
+// connection attempts neither succeed nor fail.
+struct stalled_listener
+{
+  tcp::acceptor acceptor;
+  std::vector<tcp::socket*> clients;
+
+  explicit stalled_listener(asio::io_context& ioc)
+    : acceptor(ioc)
+  {
+    acceptor.open(tcp::v4());
+    acceptor.bind(tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+    acceptor.listen(0);
+    for (int i = 0; i < 4; ++i)
+    {
+      // A synchronous connect would wait, so the connect is made directly.
+      clients.push_back(new tcp::socket(ioc, tcp::v4()));
+      clients.back()->native_non_blocking(true);
+      tcp::endpoint endpoint = acceptor.local_endpoint();
+      int result = ::connect(clients.back()->native_handle(),
+          endpoint.data(), static_cast<socklen_t>(endpoint.size()));
+      (void)result;
+    }
+  }
+
+  ~stalled_listener()
+  {
+    for (std::size_t i = 0; i < clients.size(); ++i)
+      delete clients[i];
+  }
+};
+
+void test_connect()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+  std::vector<tcp::endpoint> endpoints;
+  endpoints.push_back(refused_endpoint(ioc));
+  endpoints.push_back(acceptor.local_endpoint());
+
+  // The failed attempt is followed immediately by the next.
+  tcp::socket s(ioc);
+  asio::error_code result_ec = asio::error::would_block;
+  tcp::endpoint result;
+  asio::async_connect_parallel(s, endpoints, asio::chrono::seconds(10),
+      [&](const asio::error_code& ec, const tcp::endpoint& e)
+      {
+        result_ec = ec;
+        result = e;
+      });
+  ioc.run();
+
+  ASIO_CHECK(!result_ec);
+  ASIO_CHECK(result == acceptor.local_endpoint());
+  ASIO_CHECK(s.is_open());
+  ASIO_CHECK(s.remote_endpoint() == acceptor.local_endpoint());
+}
+
+void test_stalled_first()
+{
+  asio::io_context ioc;
+  stalled_listener stalled(ioc);
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+  std::vector<tcp::endpoint> endpoints;
+  endpoints.push_back(stalled.acceptor.local_endpoint());
+  endpoints.push_back(acceptor.local_endpoint());
+
+  // The stalled attempt is raced by the next one after the attempt delay.
+  tcp::socket s(ioc);
+  asio::error_code result_ec = asio::error::would_block;
+  tcp::endpoint result;
+  asio::async_connect_parallel(s, endpoints, asio::chrono::milliseconds(50),
+      [&](const asio::error_code& ec, const tcp::endpoint& e)
+      {
+        result_ec = ec;
+        result = e;
+      });
+  ioc.run();
+
+  ASIO_CHECK(!result_ec);
+  ASIO_CHECK(result == acceptor.local_endpoint());
+}
+
+void test_failure()
+{
+  asio::io_context ioc;
+  tcp::socket s(ioc);
+
+  std::vector<tcp::endpoint> endpoints;
+  asio::error_code result_ec;
+  asio::async_connect_parallel(s, endpoints,
+      [&](const asio::error_code& ec, const tcp::endpoint&)
+      {
+        result_ec = ec;
+      });
+  ioc.run();
+  ASIO_CHECK(result_ec == asio::error::not_found);
+
+  endpoints.push_back(refused_endpoint(ioc));
+  endpoints.push_back(refused_endpoint(ioc));
+  ioc.restart();
+  asio::async_connect_parallel(s, endpoints,
+      [&](const asio::error_code& ec, const tcp::endpoint&)
+      {
+        result_ec = ec;
+      });
+  ioc.run();
+  ASIO_CHECK(result_ec == asio::error::connection_refused);
+  ASIO_CHECK(!s.is_open());
+}
+
+void test_cancel()
+{
+  asio::io_context ioc;
+  stalled_listener stalled(ioc);
+
+  std::vector<tcp::endpoint> endpoints(3, stalled.acceptor.local_endpoint());
+
+  tcp::socket s(ioc);
+  asio::parallel_connect_canceller canceller;
+  asio::error_code result_ec;
+  int calls = 0;
+  asio::async_connect_parallel(s, endpoints, asio::chrono::milliseconds(10),
+      canceller,
+      [&](const asio::error_code& ec, const tcp::endpoint&)
+      {
+        result_ec = ec;
+        ++calls;
+      });
+
+  // Cancel once all of the attempts are in progress.
+  asio::steady_timer timer(ioc, asio::chrono::milliseconds(100));
+  timer.async_wait([&](const asio::error_code&) { canceller.cancel(); });
+
+  asio::chrono::steady_clock::time_point start =
+    asio::chrono::steady_clock::now();
+  ioc.run();
+
+  ASIO_CHECK(calls == 1);
+  ASIO_CHECK(result_ec == asio::error::operation_aborted);
+  ASIO_CHECK(!s.is_open());
+  ASIO_CHECK(asio::chrono::steady_clock::now() - start
+      < asio::chrono::seconds(5));
+
+  // Cancelling after the handler has been called has no effect.
+  canceller.cancel();
+  ASIO_CHECK(calls == 1);
+}
+
+void test_cancel_after_success()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  std::vector<tcp::endpoint> endpoints(1, acceptor.local_endpoint());
+
+  tcp::socket s(ioc);
+  asio::parallel_connect_canceller canceller;
+  asio::error_code result_ec;
+  asio::async_connect_parallel(s, endpoints, asio::chrono::milliseconds(10),
+      canceller,
+      [&](const asio::error_code& ec, const tcp::endpoint&)
+      {
+        result_ec = ec;
+        canceller.cancel();
+      });
+  ioc.run();
+
+  ASIO_CHECK(!result_ec);
+  ASIO_CHECK(s.is_open());
+}
+
+} // namespace parallel_connect_test
+
+ASIO_TEST_SUITE
+(
+  "parallel_connect",
+  ASIO_TEST_CASE(parallel_connect_test::test_connect)
+  ASIO_TEST_CASE(parallel_connect_test::test_stalled_first)
+  ASIO_TEST_CASE(parallel_connect_test::test_failure)
+  ASIO_TEST_CASE(parallel_connect_test::test_cancel)
+  ASIO_TEST_CASE(parallel_connect_test::test_cancel_after_success)
+)
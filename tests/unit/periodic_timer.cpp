@@ -0,0 +1,377 @@
+//
+// periodic_timer.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/service/timer/basic_periodic_timer.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+static std::size_t allocation_count = 0;
+
+void* operator new(std::size_t size)
+{
+  ++allocation_count;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) ASIO_NOEXCEPT
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) ASIO_NOEXCEPT
+{
+  std::free(p);
+}
+
+namespace periodic_timer_test {
+
+using asio::steady_periodic_timer;
+namespace chrono = asio::chrono;
+
+typedef chrono::steady_clock::time_point time_point;
+
+void test_ticks()
+{
+  asio::io_context ioc;
+  steady_periodic_timer timer(ioc, chrono::milliseconds(10));
+  ASIO_CHECK(timer.period() == chrono::milliseconds(10));
+  ASIO_CHECK(timer.policy() == steady_periodic_timer::skip_missed_ticks);
+
+  time_point first = chrono::steady_clock::now() + chrono::milliseconds(10);
+  std::vector<time_point> expiries;
+  int ticks = 0, aborted = 0;
+  timer.start(first, [&](const asio::error_code& ec, std::size_t n)
+      {
+        if (ec == asio::error::operation_aborted)
+        {
+          ++aborted;
+          return;
+        }
+        ASIO_CHECK(!ec);
+        ticks += static_cast<int>(n);
+        expiries.push_back(timer.expiry());
+        ASIO_CHECK(chrono::steady_clock::now() >= expiries.back()
+            - timer.period());
+        if (ticks >= 5)
+          timer.cancel();
+      });
+  ioc.run();
+
+  ASIO_CHECK(ticks >= 5);
+  ASIO_CHECK(aborted == 1);
+  ASIO_CHECK(chrono::steady_clock::now() >= first + chrono::milliseconds(40));
+
+  // Ticks are measured from the first tick, not from when each handler ran.
+  for (std::size_t i = 0; i < expiries.size(); ++i)
+  {
+    chrono::steady_clock::duration offset = expiries[i] - first;
+    ASIO_CHECK(offset % chrono::milliseconds(10)
+        == chrono::steady_clock::duration::zero());
+    ASIO_CHECK(offset > chrono::steady_clock::duration::zero());
+  }
+}
+
+void test_skip_missed_ticks()
+{
+  asio::io_context ioc;
+  steady_periodic_timer timer(ioc, chrono::milliseconds(100));
+
+  time_point first = chrono::steady_clock::now() - chrono::seconds(1);
+  std::size_t ticks = 0;
+  time_point next;
+  int calls = 0;
+  timer.start(first, [&](const asio::error_code& ec, std::size_t n)
+      {
+        if (ec)
+          return;
+        ++calls;
+        ticks = n;
+        next = timer.expiry();
+        timer.cancel();
+      });
+  ioc.run();
+
+  // One tick accounts for every missed period, and the next is in the future.
+  ASIO_CHECK(calls == 1);
+  ASIO_CHECK(ticks >= 11);
+  ASIO_CHECK(next - first == chrono::milliseconds(100)
+      * static_cast<int>(ticks));
+  ASIO_CHECK(next > first + chrono::seconds(1));
+}
+
+void test_catch_up_missed_ticks()
+{
+  asio::io_context ioc;
+  steady_periodic_timer timer(ioc, chrono::milliseconds(100),
+      steady_periodic_timer::catch_up_missed_ticks);
+  ASIO_CHECK(timer.policy() == steady_periodic_timer::catch_up_missed_ticks);
+
+  time_point start = chrono::steady_clock::now();
+  time_point first = start - chrono::seconds(1);
+  std::vector<time_point> expiries;
+  bool all_single = true;
+  timer.start(first, [&](const asio::error_code& ec, std::size_t n)
+      {
+        if (ec)
+          return;
+        all_single = all_single && n == 1;
+        expiries.push_back(timer.expiry());
+        if (expiries.size() == 10)
+          timer.cancel();
+      });
+  ioc.run();
+
+  // Every missed tick is delivered, without waiting for the period.
+  ASIO_CHECK(all_single);
+  ASIO_CHECK(expiries.size() == 10);
+  for (std::size_t i = 0; i < expiries.size(); ++i)
+  {
+    chrono::steady_clock::duration offset = expiries[i] - first;
+    ASIO_CHECK(offset == chrono::milliseconds(100) * static_cast<int>(i + 1));
+  }
+  ASIO_CHECK(chrono::steady_clock::now() - start < chrono::milliseconds(500));
+}
+
+void test_cancel()
+{
+  asio::io_context ioc;
+  steady_periodic_timer timer(ioc, chrono::seconds(10));
+
+  std::vector<asio::error_code> results;
+  timer.start([&](const asio::error_code& ec, std::size_t n)
+      {
+        results.push_back(ec);
+        ASIO_CHECK(n == 0);
+      });
+
+  asio::steady_timer stopper(ioc, chrono::milliseconds(10));
+  stopper.async_wait([&](const asio::error_code&)
+      {
+        timer.cancel();
+        // Cancelling a stopped timer does nothing.
+        timer.cancel();
+      });
+  ioc.run();
+
+  ASIO_CHECK(results.size() == 1);
+  ASIO_CHECK(results[0] == asio::error::operation_aborted);
+}
+
+void test_restart()
+{
+  asio::io_context ioc;
+  steady_periodic_timer timer(ioc, chrono::milliseconds(5));
+
+  int first_aborted = 0, first_ticks = 0;
+  timer.start(chrono::steady_clock::now() + chrono::seconds(10),
+      [&](const asio::error_code& ec, std::size_t)
+      {
+        if (ec == asio::error::operation_aborted)
+          ++first_aborted;
+        else
+          ++first_ticks;
+      });
+
+  // Starting again stops the first handler.
+  int second_aborted = 0, second_ticks = 0;
+  timer.start([&](const asio::error_code& ec, std::size_t)
+      {
+        if (ec == asio::error::operation_aborted)
+          ++second_aborted;
+        else if (++second_ticks == 3)
+          timer.cancel();
+      });
+  ioc.run();
+
+  ASIO_CHECK(first_aborted == 1);
+  ASIO_CHECK(first_ticks == 0);
+  ASIO_CHECK(second_aborted == 1);
+  ASIO_CHECK(second_ticks == 3);
+}
+
+void test_destroy_and_move()
+{
+  asio::io_context ioc;
+  int aborted = 0, ticks = 0;
+  {
+    steady_periodic_timer timer(ioc, chrono::milliseconds(5));
+    timer.start([&](const asio::error_code& ec, std::size_t)
+        {
+          if (ec == asio::error::operation_aborted)
+            ++aborted;
+          else
+            ++ticks;
+        });
+
+    // A moved timer keeps running.
+    steady_periodic_timer moved(std::move(timer));
+    ASIO_CHECK(moved.period() == chrono::milliseconds(5));
+    ioc.run_for(chrono::milliseconds(30));
+    ASIO_CHECK(ticks > 0);
+    ASIO_CHECK(aborted == 0);
+  }
+
+  // Destroying the timer stops it.
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(aborted == 1);
+}
+
+void test_invalid_period()
+{
+  asio::io_context ioc;
+
+  bool threw = false;
+  try
+  {
+    steady_periodic_timer timer(ioc, chrono::steady_clock::duration::zero());
+  }
+  catch (asio::system_error& e)
+  {
+    threw = e.code() == asio::error::invalid_argument;
+  }
+  ASIO_CHECK(threw);
+
+  threw = false;
+  try
+  {
+    steady_periodic_timer timer(ioc, -chrono::milliseconds(1));
+  }
+  catch (asio::system_error& e)
+  {
+    threw = e.code() == asio::error::invalid_argument;
+  }
+  ASIO_CHECK(threw);
+}
+
+void test_handler_executor()
+{
+  asio::io_context ioc, handler_ioc;
+  steady_periodic_timer timer(ioc, chrono::milliseconds(1));
+
+  // Ticks run on the handler's executor. When that executor cannot run a tick
+  // inline, the running timer still does not allocate.
+  int ticks = 0, aborted = 0;
+  bool on_handler_ioc = true;
+  std::size_t allocations = 0;
+  timer.start(asio::bind_executor(handler_ioc.get_executor(),
+        [&](const asio::error_code& ec, std::size_t)
+        {
+          on_handler_ioc = on_handler_ioc
+            && handler_ioc.get_executor().running_in_this_thread();
+          if (ec == asio::error::operation_aborted)
+            ++aborted;
+          else if (++ticks == 3)
+            allocations = allocation_count;
+          else if (ticks == 10)
+          {
+            allocations = allocation_count - allocations;
+            timer.cancel();
+          }
+        }));
+  while (aborted == 0)
+  {
+    // The timer's io_context runs out of work while each tick is with the
+    // handler's io_context.
+    ioc.restart();
+    ioc.run_one();
+    handler_ioc.poll();
+  }
+
+  ASIO_CHECK(ticks == 10);
+  ASIO_CHECK(aborted == 1);
+  ASIO_CHECK(on_handler_ioc);
+  ASIO_CHECK(allocations == 0);
+}
+
+void test_tick_destroyed()
+{
+  asio::io_context ioc;
+  steady_periodic_timer timer(ioc, chrono::milliseconds(1));
+  std::shared_ptr<int> owner(new int(0));
+
+  // A tick that is destroyed without running, here because the handler's
+  // io_context is destroyed, destroys the timer's handler with it.
+  {
+    asio::io_context handler_ioc;
+    std::shared_ptr<int> handler_owner(owner);
+    timer.start(asio::bind_executor(handler_ioc.get_executor(),
+          [handler_owner](const asio::error_code&, std::size_t)
+          {
+            ASIO_ERROR("handler invoked");
+          }));
+    handler_owner.reset();
+    ASIO_CHECK(owner.use_count() == 2);
+    ioc.run_one();
+  }
+  ASIO_CHECK(owner.use_count() == 1);
+
+  // The timer is stopped.
+  timer.cancel();
+  ioc.restart();
+  ASIO_CHECK(ioc.poll() == 0);
+}
+
+void test_throwing_handler()
+{
+  asio::io_context ioc;
+  steady_periodic_timer timer(ioc, chrono::milliseconds(1));
+  std::shared_ptr<int> owner(new int(0));
+
+  // A handler that throws stops the timer, and is destroyed.
+  {
+    std::shared_ptr<int> handler_owner(owner);
+    timer.start([handler_owner](const asio::error_code& ec, std::size_t)
+        {
+          if (!ec)
+            throw std::runtime_error("tick");
+        });
+  }
+  ASIO_CHECK(owner.use_count() == 2);
+
+  bool threw = false;
+  try
+  {
+    ioc.run();
+  }
+  catch (std::runtime_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+  ASIO_CHECK(owner.use_count() == 1);
+
+  timer.cancel();
+  ioc.restart();
+  ASIO_CHECK(ioc.run() == 0);
+}
+
+} // namespace periodic_timer_test
+
+ASIO_TEST_SUITE
+(
+  "periodic_timer",
+  ASIO_TEST_CASE(periodic_timer_test::test_ticks)
+  ASIO_TEST_CASE(periodic_timer_test::test_skip_missed_ticks)
+  ASIO_TEST_CASE(periodic_timer_test::test_catch_up_missed_ticks)
+  ASIO_TEST_CASE(periodic_timer_test::test_cancel)
+  ASIO_TEST_CASE(periodic_timer_test::test_restart)
+  ASIO_TEST_CASE(periodic_timer_test::test_destroy_and_move)
+  ASIO_TEST_CASE(periodic_timer_test::test_invalid_period)
+  ASIO_TEST_CASE(periodic_timer_test::test_handler_executor)
+  ASIO_TEST_CASE(periodic_timer_test::test_tick_destroyed)
+  ASIO_TEST_CASE(periodic_timer_test::test_throwing_handler)
+)
@@ -0,0 +1,188 @@
+//
+// read_frames.cpp
+// ~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/transmit/read_frames.hpp"
+
+#include <string>
+#include <vector>
+#include "asio.hpp"
+#include "test_stream.hpp"
+#include "unit_test.hpp"
+
+namespace read_frames_test {
+
+std::string to_string(const asio::const_buffer& b)
+{
+  return std::string(static_cast<const char*>(b.data()), b.size());
+}
+
+const char lines[] = "one\ntwo\nthree\npartial";
+
+void test_char_delim()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  // With a large read, all complete lines arrive together. With small reads,
+  // the operation returns as soon as the first line is complete.
+  for (std::size_t len = 1; len < sizeof(lines); ++len)
+  {
+    s.reset(lines, len);
+    std::string data;
+    std::vector<asio::const_buffer> frames;
+    std::string all;
+    asio::error_code ec;
+    while (!ec)
+    {
+      std::size_t n = asio::read_frames(s,
+          asio::dynamic_buffer(data), '\n', frames, ec);
+      if (ec)
+      {
+        ASIO_CHECK(ec == asio::error::eof);
+        ASIO_CHECK(n == 0);
+        break;
+      }
+      ASIO_CHECK(!frames.empty());
+      std::size_t total = 0;
+      for (std::size_t i = 0; i < frames.size(); ++i)
+      {
+        ASIO_CHECK(to_string(frames[i]).back() == '\n');
+        all += to_string(frames[i]);
+        total += frames[i].size();
+      }
+      ASIO_CHECK(total == n);
+      data.erase(0, n);
+    }
+    ASIO_CHECK(all == "one\ntwo\nthree\n");
+    ASIO_CHECK(data == "partial");
+  }
+
+  s.reset(lines, sizeof(lines));
+  std::string data;
+  std::vector<asio::const_buffer> frames;
+  std::size_t n = asio::read_frames(s,
+      asio::dynamic_buffer(data), '\n', frames);
+  ASIO_CHECK(n == 14);
+  ASIO_CHECK(frames.size() == 3);
+  ASIO_CHECK(to_string(frames[0]) == "one\n");
+  ASIO_CHECK(to_string(frames[1]) == "two\n");
+  ASIO_CHECK(to_string(frames[2]) == "three\n");
+}
+
+void test_string_delim()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  const char crlf[] = "a\r\nbc\r\n\r\nd";
+  for (std::size_t len = 1; len < sizeof(crlf); ++len)
+  {
+    s.reset(crlf, len);
+    std::string data;
+    std::vector<asio::const_buffer> frames;
+    std::vector<std::string> all;
+    asio::error_code ec;
+    for (;;)
+    {
+      std::size_t n = asio::read_frames(s,
+          asio::dynamic_buffer(data), "\r\n", frames, ec);
+      if (ec)
+        break;
+      for (std::size_t i = 0; i < frames.size(); ++i)
+        all.push_back(to_string(frames[i]));
+      data.erase(0, n);
+    }
+    ASIO_CHECK(ec == asio::error::eof);
+    ASIO_CHECK(all.size() == 3);
+    if (all.size() == 3)
+    {
+      ASIO_CHECK(all[0] == "a\r\n");
+      ASIO_CHECK(all[1] == "bc\r\n");
+      ASIO_CHECK(all[2] == "\r\n");
+    }
+  }
+}
+
+void test_buffer_full()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+  s.reset("abcdefgh\n", 3);
+
+  std::string data;
+  std::vector<asio::const_buffer> frames;
+  asio::error_code ec;
+  std::size_t n = asio::read_frames(s,
+      asio::dynamic_buffer(data, 6), '\n', frames, ec);
+  ASIO_CHECK(ec == asio::error::not_found);
+  ASIO_CHECK(n == 0);
+  ASIO_CHECK(frames.empty());
+}
+
+void test_async_char_delim()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  for (std::size_t len = 1; len < sizeof(lines); ++len)
+  {
+    s.reset(lines, len);
+    std::string data;
+    std::vector<asio::const_buffer> frames;
+    bool called = false;
+    asio::async_read_frames(s, asio::dynamic_buffer(data), '\n', frames,
+        [&](const asio::error_code& ec, std::size_t n)
+        {
+          called = true;
+          ASIO_CHECK(!ec);
+          ASIO_CHECK(!frames.empty());
+          ASIO_CHECK(to_string(frames[0]) == "one\n");
+          ASIO_CHECK(n == data.rfind('\n') + 1);
+        });
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(called);
+  }
+}
+
+void test_async_string_delim()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  const char crlf[] = "a\r\nbc\r\nd";
+  for (std::size_t len = 1; len < sizeof(crlf); ++len)
+  {
+    s.reset(crlf, len);
+    std::string data;
+    std::vector<asio::const_buffer> frames;
+    bool called = false;
+    asio::async_read_frames(s, asio::dynamic_buffer(data), "\r\n", frames,
+        [&](const asio::error_code& ec, std::size_t n)
+        {
+          called = true;
+          ASIO_CHECK(!ec);
+          ASIO_CHECK(!frames.empty());
+          ASIO_CHECK(to_string(frames[0]) == "a\r\n");
+          ASIO_CHECK(n == 3 || n == 7);
+        });
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(called);
+  }
+}
+
+} // namespace read_frames_test
+
+ASIO_TEST_SUITE
+(
+  "read_frames",
+  ASIO_TEST_CASE(read_frames_test::test_char_delim)
+  ASIO_TEST_CASE(read_frames_test::test_string_delim)
+  ASIO_TEST_CASE(read_frames_test::test_buffer_full)
+  ASIO_TEST_CASE(read_frames_test::test_async_char_delim)
+  ASIO_TEST_CASE(read_frames_test::test_async_string_delim)
+)
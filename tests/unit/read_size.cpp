@@ -0,0 +1,149 @@
+//
+// read_size.cpp
+// ~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/transmit/read_size.hpp"
+
+#include <string>
+#include "asio.hpp"
+#include "test_stream.hpp"
+#include "unit_test.hpp"
+
+namespace read_size_test {
+
+void test_policy()
+{
+  asio::read_size_policy policy(512, 8192, 1024);
+  ASIO_CHECK(policy.min_size() == 512);
+  ASIO_CHECK(policy.max_size() == 8192);
+  ASIO_CHECK(policy.size() == 1024);
+
+  // A read that fills its space doubles the next read, up to the maximum.
+  ASIO_CHECK(policy.next(0, 100000) == 1024);
+  policy.record(1024);
+  ASIO_CHECK(policy.filled());
+  ASIO_CHECK(policy.size() == 2048);
+  for (int i = 0; i < 10; ++i)
+    policy.record(policy.next(0, 100000));
+  ASIO_CHECK(policy.size() == 8192);
+
+  // A read that uses less than a quarter halves it, down to the minimum.
+  policy.next(0, 100000);
+  policy.record(100);
+  ASIO_CHECK(!policy.filled());
+  ASIO_CHECK(policy.size() == 4096);
+  for (int i = 0; i < 10; ++i)
+  {
+    policy.next(0, 100000);
+    policy.record(1);
+  }
+  ASIO_CHECK(policy.size() == 512);
+
+  // A read that uses between a quarter and all of its space keeps the size.
+  policy.next(0, 100000);
+  policy.record(300);
+  ASIO_CHECK(policy.size() == 512);
+
+  // Known queued data sizes the read, within the limits.
+  ASIO_CHECK(policy.next(3000, 100000) == 3000);
+  ASIO_CHECK(policy.next(100000, 100000) == 8192);
+  ASIO_CHECK(policy.next(10, 100000) == 512);
+  ASIO_CHECK(policy.next(3000, 100) == 100);
+}
+
+void test_copy()
+{
+  asio::read_size_policy policy;
+  asio::ring_buffer storage(4096);
+  asio::adaptive_dynamic_buffer<asio::dynamic_ring_buffer> b(
+      asio::dynamic_buffer(storage), policy);
+
+  // A copy refers to the same storage and shares the policy.
+  asio::adaptive_dynamic_buffer<asio::dynamic_ring_buffer> b2(b);
+  ASIO_CHECK(&b2.policy() == &policy);
+  b2.prepare(3);
+  b2.commit(3);
+  ASIO_CHECK(b.size() == 3);
+  ASIO_CHECK(storage.size() == 3);
+}
+
+void test_read_until()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  std::string input(100000, 'x');
+  input += '\n';
+  s.reset(input, input.size());
+
+  // Reads that fill their space grow the policy's read size.
+  asio::read_size_policy policy(512, 65536, 512);
+  std::string data;
+  std::size_t n = asio::read_until(s,
+      asio::adaptive_buffer(asio::dynamic_buffer(data), policy), '\n');
+  ASIO_CHECK(n == input.size());
+  ASIO_CHECK(policy.size() > 512);
+}
+
+void test_read_limit()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+  s.reset(std::string(1000000, 'x'), 1000000);
+
+  // The limit from the completion condition is honoured, however large the
+  // policy's read size.
+  asio::read_size_policy policy(512, 1048576, 1048576);
+  std::string data;
+  std::size_t n = asio::read(s,
+      asio::adaptive_buffer(asio::dynamic_buffer(data), policy),
+      asio::transfer_exactly(100000));
+  ASIO_CHECK(n == 100000);
+  ASIO_CHECK(data.size() == 100000);
+
+  // Without a limit from the operation, the policy's size is used even above
+  // the default maximum transfer size.
+  s.reset(std::string(1000000, 'x') + '\n', 1000001);
+  data.clear();
+  asio::read_size_policy big(512, 1048576, 1048576);
+  asio::read_until(s,
+      asio::adaptive_buffer(asio::dynamic_buffer(data), big), '\n');
+  ASIO_CHECK(data.size() == 1000001);
+}
+
+void test_async_read()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+  s.reset(std::string(200000, 'x'), 200000);
+
+  asio::read_size_policy policy(512, 1048576, 131072);
+  std::string data;
+  bool called = false;
+  asio::async_read(s,
+      asio::adaptive_buffer(asio::dynamic_buffer(data), policy),
+      asio::transfer_exactly(100000),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        called = true;
+        ASIO_CHECK(!ec);
+        ASIO_CHECK(n == 100000);
+      });
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(data.size() == 100000);
+}
+
+} // namespace read_size_test
+
+ASIO_TEST_SUITE
+(
+  "read_size",
+  ASIO_TEST_CASE(read_size_test::test_policy)
+  ASIO_TEST_CASE(read_size_test::test_copy)
+  ASIO_TEST_CASE(read_size_test::test_read_until)
+  ASIO_TEST_CASE(read_size_test::test_read_limit)
+  ASIO_TEST_CASE(read_size_test::test_async_read)
+)
@@ -0,0 +1,220 @@
+//
+// read_until.cpp
+// ~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/transmit/read_until.hpp"
+
+#include <string>
+#include <utility>
+#include "asio.hpp"
+#include "test_stream.hpp"
+#include "unit_test.hpp"
+
+namespace read_until_test {
+
+typedef asio::buffers_iterator<
+    asio::dynamic_string_buffer<char, std::char_traits<char>,
+      std::allocator<char> >::const_buffers_type> iterator;
+
+// Match a run of three identical characters.
+std::pair<iterator, bool> match_triple(iterator begin, iterator end)
+{
+  int count = 0;
+  char last = 0;
+  for (iterator i = begin; i != end; ++i)
+  {
+    count = (count > 0 && *i == last) ? count + 1 : 1;
+    last = *i;
+    if (count == 3)
+      return std::make_pair(i + 1, true);
+  }
+
+  // The last characters may be the start of a match.
+  iterator first = end;
+  for (int n = 0; n < count; ++n)
+    --first;
+  return std::make_pair(first, false);
+}
+
+const char data[] = "abc\r\ndefgh\r\nxyzzzq";
+
+void test_char_delim()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  for (std::size_t len = 1; len < sizeof(data); ++len)
+  {
+    s.reset(data, len);
+    std::string buf;
+    asio::error_code ec;
+    std::size_t n = asio::read_until(s, asio::dynamic_buffer(buf), '\n', ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(n == 5);
+    buf.erase(0, n);
+    n = asio::read_until(s, asio::dynamic_buffer(buf), '\n', ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(n == 7);
+    buf.erase(0, n);
+    n = asio::read_until(s, asio::dynamic_buffer(buf), '\n', ec);
+    ASIO_CHECK(ec == asio::error::eof);
+    ASIO_CHECK(n == 0);
+  }
+}
+
+void test_string_delim()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  // Every read length splits the delimiter differently.
+  for (std::size_t len = 1; len < sizeof(data); ++len)
+  {
+    s.reset(data, len);
+    std::string buf;
+    asio::error_code ec;
+    std::size_t n = asio::read_until(s, asio::dynamic_buffer(buf), "\r\n", ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(n == 5);
+    buf.erase(0, n);
+    n = asio::read_until(s, asio::dynamic_buffer(buf), "\r\n", ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(n == 7);
+    ASIO_CHECK(buf.substr(0, n) == "defgh\r\n");
+    buf.erase(0, n);
+    n = asio::read_until(s, asio::dynamic_buffer(buf), "zzz", ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(n == 5);
+  }
+}
+
+void test_not_found()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+  s.reset(data, 1);
+
+  std::string buf;
+  asio::error_code ec;
+  std::size_t n = asio::read_until(s,
+      asio::dynamic_buffer(buf, 4), "\r\n", ec);
+  ASIO_CHECK(ec == asio::error::not_found);
+  ASIO_CHECK(n == 0);
+}
+
+void test_match_condition()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  for (std::size_t len = 1; len < sizeof(data); ++len)
+  {
+    s.reset(data, len);
+    std::string buf;
+    asio::error_code ec;
+    std::size_t n = asio::read_until(s,
+        asio::dynamic_buffer(buf), match_triple, ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(n == 17);
+  }
+}
+
+void test_async_char_delim()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  for (std::size_t len = 1; len < sizeof(data); ++len)
+  {
+    s.reset(data, len);
+    std::string buf;
+    bool called = false;
+    asio::async_read_until(s, asio::dynamic_buffer(buf), '\n',
+        [&](const asio::error_code& ec, std::size_t n)
+        {
+          called = true;
+          ASIO_CHECK(!ec);
+          ASIO_CHECK(n == 5);
+        });
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(called);
+  }
+}
+
+void test_async_string_delim()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  for (std::size_t len = 1; len < sizeof(data); ++len)
+  {
+    s.reset(data, len);
+    std::string buf;
+    bool called = false;
+    asio::async_read_until(s, asio::dynamic_buffer(buf), "h\r\n",
+        [&](const asio::error_code& ec, std::size_t n)
+        {
+          called = true;
+          ASIO_CHECK(!ec);
+          ASIO_CHECK(n == 12);
+        });
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(called);
+  }
+}
+
+void test_async_match_condition()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+
+  for (std::size_t len = 1; len < sizeof(data); ++len)
+  {
+    s.reset(data, len);
+    std::string buf;
+    bool called = false;
+    asio::async_read_until(s, asio::dynamic_buffer(buf), match_triple,
+        [&](const asio::error_code& ec, std::size_t n)
+        {
+          called = true;
+          ASIO_CHECK(!ec);
+          ASIO_CHECK(n == 17);
+        });
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(called);
+  }
+
+  // No match before the buffer is full.
+  s.reset(data, 2);
+  std::string buf;
+  bool called = false;
+  asio::async_read_until(s, asio::dynamic_buffer(buf, 8), match_triple,
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        called = true;
+        ASIO_CHECK(ec == asio::error::not_found);
+        ASIO_CHECK(n == 0);
+      });
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+}
+
+} // namespace read_until_test
+
+ASIO_TEST_SUITE
+(
+  "read_until",
+  ASIO_TEST_CASE(read_until_test::test_char_delim)
+  ASIO_TEST_CASE(read_until_test::test_string_delim)
+  ASIO_TEST_CASE(read_until_test::test_not_found)
+  ASIO_TEST_CASE(read_until_test::test_match_condition)
+  ASIO_TEST_CASE(read_until_test::test_async_char_delim)
+  ASIO_TEST_CASE(read_until_test::test_async_string_delim)
+  ASIO_TEST_CASE(read_until_test::test_async_match_condition)
+)
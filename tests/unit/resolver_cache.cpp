@@ -0,0 +1,220 @@
+//
+// resolver_cache.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+
+// The cache is disabled by default. Enable it, and keep it small enough to
+// fill.
+#define ASIO_RESOLVER_CACHE_TTL 30
+#define ASIO_RESOLVER_NEGATIVE_CACHE_TTL 5
+#define ASIO_RESOLVER_CACHE_MAX_ENTRIES 4
+
+// Test that header file is self-contained.
+#include "asio/network/resolver_cache.hpp"
+
+#include <string>
+#include <vector>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::ip::tcp;
+
+namespace resolver_cache_test {
+
+typedef asio::detail::resolver_cache<tcp> cache_type;
+
+tcp::resolver::results_type make_results(unsigned short port)
+{
+  return tcp::resolver::results_type::create(
+      tcp::endpoint(asio::ip::address_v4::loopback(), port), "host", "svc");
+}
+
+void test_find_insert()
+{
+  cache_type cache;
+  cache_type::key_type a(cache_type::query_type("a", "1"));
+  cache_type::key_type b(cache_type::query_type("b", "1"));
+  cache_type::key_type a2(cache_type::query_type("a", "2"));
+
+  tcp::resolver::results_type results;
+  asio::error_code ec;
+  ASIO_CHECK(!cache.find(a, results, ec));
+
+  cache.insert(a, make_results(1), asio::error_code());
+  ASIO_CHECK(cache.find(a, results, ec));
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(results.size() == 1);
+  ASIO_CHECK(results.begin()->endpoint().port() == 1);
+
+  // Keys differ by host and by service.
+  ASIO_CHECK(!cache.find(b, results, ec));
+  ASIO_CHECK(!cache.find(a2, results, ec));
+
+  // Queries with different hints are different keys.
+  cache_type::key_type v6(cache_type::query_type(tcp::v6(), "a", "1"));
+  ASIO_CHECK(!cache.find(v6, results, ec));
+
+  cache.clear();
+  ASIO_CHECK(!cache.find(a, results, ec));
+}
+
+void test_errors()
+{
+  cache_type cache;
+  cache_type::key_type a(cache_type::query_type("a", "1"));
+  cache_type::key_type b(cache_type::query_type("b", "1"));
+
+  // Definitive failures are remembered.
+  cache.insert(a, tcp::resolver::results_type(),
+      asio::error::host_not_found);
+  tcp::resolver::results_type results;
+  asio::error_code ec;
+  ASIO_CHECK(cache.find(a, results, ec));
+  ASIO_CHECK(ec == asio::error::host_not_found);
+
+  // Transient failures are not.
+  cache.insert(b, tcp::resolver::results_type(),
+      asio::error::host_not_found_try_again);
+  ASIO_CHECK(!cache.find(b, results, ec));
+}
+
+void test_max_entries()
+{
+  cache_type cache;
+  std::vector<cache_type::key_type> keys;
+  for (int i = 0; i < 5; ++i)
+  {
+    keys.push_back(cache_type::key_type(
+          cache_type::query_type("h" + std::to_string(i), "1")));
+    cache.insert(keys.back(), make_results(1), asio::error_code());
+  }
+
+  tcp::resolver::results_type results;
+  asio::error_code ec;
+  for (int i = 0; i < 4; ++i)
+    ASIO_CHECK(cache.find(keys[i], results, ec));
+  ASIO_CHECK(!cache.find(keys[4], results, ec));
+
+  // An existing entry can still be updated when the cache is full.
+  cache.insert(keys[0], make_results(2), asio::error_code());
+  ASIO_CHECK(cache.find(keys[0], results, ec));
+  ASIO_CHECK(results.begin()->endpoint().port() == 2);
+}
+
+void test_resolver()
+{
+  asio::io_context ioc;
+  tcp::resolver resolver(ioc);
+
+  asio::error_code ec;
+  tcp::resolver::results_type first = resolver.resolve(
+      "127.0.0.1", "80", ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(!first.empty());
+
+  // A resolution that is repeated, synchronously or asynchronously, has the
+  // same results.
+  tcp::resolver::results_type second = resolver.resolve(
+      "127.0.0.1", "80", ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(second == first);
+
+  // Identical asynchronous queries that are in progress together all
+  // complete with the same results.
+  tcp::resolver other(ioc);
+  int completed = 0;
+  for (int i = 0; i < 10; ++i)
+  {
+    (i % 2 ? resolver : other).async_resolve("127.0.0.2", "81",
+        [&](const asio::error_code& e, tcp::resolver::results_type r)
+        {
+          ASIO_CHECK(!e);
+          ASIO_CHECK(!r.empty());
+          ASIO_CHECK(r.begin()->endpoint().port() == 81);
+          ++completed;
+        });
+  }
+  ioc.run();
+  ASIO_CHECK(completed == 10);
+
+  // Unknown services are reported the same way each time.
+  resolver.resolve("127.0.0.1", "no-such-service-asio", ec);
+  ASIO_CHECK(ec == asio::error::service_not_found);
+  resolver.resolve("127.0.0.1", "no-such-service-asio", ec);
+  ASIO_CHECK(ec == asio::error::service_not_found);
+}
+
+void test_cancel()
+{
+  asio::io_context ioc;
+  tcp::resolver a(ioc), b(ioc);
+
+  // Cancelling one resolver does not affect another that shares the query.
+  asio::error_code a_ec, b_ec;
+  bool a_done = false, b_done = false;
+  a.async_resolve("127.0.0.3", "82",
+      [&](const asio::error_code& e, tcp::resolver::results_type)
+      {
+        a_ec = e;
+        a_done = true;
+      });
+  b.async_resolve("127.0.0.3", "82",
+      [&](const asio::error_code& e, tcp::resolver::results_type)
+      {
+        b_ec = e;
+        b_done = true;
+      });
+  a.cancel();
+  ioc.run();
+
+  ASIO_CHECK(a_done);
+  ASIO_CHECK(b_done);
+  ASIO_CHECK(!b_ec);
+  ASIO_CHECK(a_ec == asio::error::operation_aborted || !a_ec);
+}
+
+void test_cancel_joined()
+{
+  asio::io_context ioc;
+  tcp::resolver a(ioc), b(ioc);
+
+  // An operation that joined a resolution started by another resolver is
+  // completed as soon as it is cancelled, without waiting for the resolution.
+  asio::error_code a_ec, b_ec;
+  bool a_done = false, b_done = false;
+  b.async_resolve("localhost", "83",
+      [&](const asio::error_code& e, tcp::resolver::results_type)
+      {
+        b_ec = e;
+        b_done = true;
+      });
+  a.async_resolve("localhost", "83",
+      [&](const asio::error_code& e, tcp::resolver::results_type)
+      {
+        a_ec = e;
+        a_done = true;
+      });
+  a.cancel();
+  ioc.poll();
+  ASIO_CHECK(a_done);
+  ASIO_CHECK(a_ec == asio::error::operation_aborted || !a_ec);
+
+  // Cancelling a resolver with no outstanding operations has no effect.
+  a.cancel();
+  ioc.run();
+  ASIO_CHECK(b_done);
+  ASIO_CHECK(b_ec != asio::error::operation_aborted);
+}
+
+} // namespace resolver_cache_test
+
+ASIO_TEST_SUITE
+(
+  "resolver_cache",
+  ASIO_TEST_CASE(resolver_cache_test::test_find_insert)
+  ASIO_TEST_CASE(resolver_cache_test::test_errors)
+  ASIO_TEST_CASE(resolver_cache_test::test_max_entries)
+  ASIO_TEST_CASE(resolver_cache_test::test_resolver)
+  ASIO_TEST_CASE(resolver_cache_test::test_cancel)
+  ASIO_TEST_CASE(resolver_cache_test::test_cancel_joined)
+)
@@ -0,0 +1,137 @@
+//
+// ring_buffer.cpp
+// ~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/buffer/ring_buffer.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "asio.hpp"
+#include "test_stream.hpp"
+#include "unit_test.hpp"
+
+namespace ring_buffer_test {
+
+std::string to_string(const asio::const_buffer& b)
+{
+  return std::string(static_cast<const char*>(b.data()), b.size());
+}
+
+void test_capacity()
+{
+  asio::ring_buffer r(1000);
+  ASIO_CHECK(r.capacity() >= 1000);
+  ASIO_CHECK((r.capacity() & (r.capacity() - 1)) == 0);
+  ASIO_CHECK(r.size() == 0);
+  ASIO_CHECK(asio::dynamic_buffer(r).max_size() == r.capacity());
+}
+
+void test_too_large()
+{
+  // A capacity that cannot be rounded up to a power of two is rejected
+  // rather than looping forever.
+  bool threw = false;
+  try
+  {
+    asio::ring_buffer r((std::numeric_limits<std::size_t>::max)());
+  }
+  catch (std::length_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+
+  threw = false;
+  try
+  {
+    asio::ring_buffer r(asio::ring_buffer::max_size() + 1);
+  }
+  catch (std::length_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+}
+
+void test_prepare_commit_consume()
+{
+  asio::ring_buffer r(4096);
+  const std::size_t capacity = r.capacity();
+
+  // Push data through the buffer many times over, so that the input sequence
+  // wraps around the end of the storage.
+  std::string expected;
+  std::size_t counter = 0;
+  for (int i = 0; i < 1000; ++i)
+  {
+    std::size_t n = (i * 37) % 1000 + 1;
+    if (n > capacity - r.size())
+      n = capacity - r.size();
+    asio::mutable_buffer b = r.prepare(n);
+    ASIO_CHECK(b.size() == n);
+    char* p = static_cast<char*>(b.data());
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      p[j] = static_cast<char>('a' + counter++ % 26);
+      expected += p[j];
+    }
+    r.commit(n);
+
+    ASIO_CHECK(to_string(r.data()) == expected);
+
+    std::size_t m = (i * 53) % 1200;
+    r.consume(m);
+    expected.erase(0, m);
+    ASIO_CHECK(r.size() == expected.size());
+  }
+}
+
+void test_prepare_too_long()
+{
+  asio::ring_buffer r(4096);
+  r.prepare(r.capacity());
+  r.commit(10);
+
+  bool threw = false;
+  try
+  {
+    r.prepare(r.capacity() - 9);
+  }
+  catch (std::length_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+}
+
+void test_read_until()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+  s.reset("abc\ndefg\nhi", 3);
+
+  asio::ring_buffer r(4096);
+  std::size_t n = asio::read_until(s, asio::dynamic_buffer(r), '\n');
+  ASIO_CHECK(n == 4);
+  ASIO_CHECK(to_string(r.data()).substr(0, n) == "abc\n");
+  asio::dynamic_buffer(r).consume(n);
+
+  n = asio::read_until(s, asio::dynamic_buffer(r), '\n');
+  ASIO_CHECK(n == 5);
+  ASIO_CHECK(to_string(r.data()).substr(0, n) == "defg\n");
+}
+
+} // namespace ring_buffer_test
+
+ASIO_TEST_SUITE
+(
+  "ring_buffer",
+  ASIO_TEST_CASE(ring_buffer_test::test_capacity)
+  ASIO_TEST_CASE(ring_buffer_test::test_too_large)
+  ASIO_TEST_CASE(ring_buffer_test::test_prepare_commit_consume)
+  ASIO_TEST_CASE(ring_buffer_test::test_prepare_too_long)
+  ASIO_TEST_CASE(ring_buffer_test::test_read_until)
+)
@@ -0,0 +1,305 @@
+//
+// send_file.cpp
+// ~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/transmit/send_file.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_SENDFILE)
+
+using asio::ip::tcp;
+
+namespace send_file_test {
+
+// A temporary file that is removed when it goes out of scope.
+struct temp_file
+{
+  int fd;
+
+  explicit temp_file(const std::string& data)
+  {
+    char name[] = "/tmp/asio_send_file_XXXXXX";
+    fd = ::mkstemp(name);
+    ::unlink(name);
+    ssize_t n = ::write(fd, data.data(), data.size());
+    (void)n;
+  }
+
+  ~temp_file()
+  {
+    ::close(fd);
+  }
+};
+
+std::string make_data(std::size_t size)
+{
+  std::string data(size, '\0');
+  for (std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>('a' + i % 26);
+  return data;
+}
+
+void connect_pair(asio::io_context& ioc, tcp::socket& a, tcp::socket& b)
+{
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+}
+
+std::string read_n(tcp::socket& s, std::size_t n)
+{
+  std::string data(n, '\0');
+  asio::error_code ec;
+  std::size_t got = asio::read(s, asio::buffer(&data[0], n), ec);
+  data.resize(got);
+  return data;
+}
+
+void test_sync()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  std::string data = make_data(1000);
+  temp_file f(data);
+
+  asio::error_code ec;
+  std::size_t n = asio::send_file(a, f.fd, 100, 500, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == 500);
+  ASIO_CHECK(read_n(b, 500) == data.substr(100, 500));
+
+  // A length past the end of the file stops at the end of the file.
+  n = asio::send_file(a, f.fd, 900, 500, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == 100);
+  ASIO_CHECK(read_n(b, 100) == data.substr(900));
+}
+
+void test_async()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  // Larger than the socket buffers, so that the operation must wait.
+  std::string data = make_data(8 * 1024 * 1024);
+  temp_file f(data);
+
+  asio::error_code send_ec;
+  std::size_t sent = 0;
+  asio::async_send_file(a, f.fd, 0, data.size(),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        send_ec = ec;
+        sent = n;
+      });
+
+  std::string received(data.size(), '\0');
+  asio::error_code read_ec;
+  std::size_t read = 0;
+  asio::async_read(b, asio::buffer(&received[0], received.size()),
+      [&](const asio::error_code& ec, std::size_t n)
+      {
+        read_ec = ec;
+        read = n;
+      });
+
+  ioc.run();
+
+  ASIO_CHECK(!send_ec);
+  ASIO_CHECK(sent == data.size());
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(read == data.size());
+  ASIO_CHECK(received == data);
+}
+
+void test_pipe()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  int fds[2];
+  ASIO_CHECK(::pipe(fds) == 0);
+  ssize_t w = ::write(fds[1], "abc", 3);
+  (void)w;
+  ::close(fds[1]);
+
+  // The offset is ignored, and the transfer stops when the writer has closed.
+  asio::error_code ec;
+  std::size_t n = asio::send_file(a, fds[0], 100, 10, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == 3);
+  ASIO_CHECK(read_n(b, 3) == "abc");
+
+  ::close(fds[0]);
+}
+
+void test_async_pipe()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  int fds[2];
+  ASIO_CHECK(::pipe(fds) == 0);
+
+  // More than a pipe holds, written only once the operation is waiting for the
+  // pipe to become readable.
+  std::string data = make_data(1024 * 1024);
+  std::thread writer([&]
+      {
+        ::usleep(100 * 1000);
+        for (std::size_t i = 0; i < data.size(); )
+        {
+          ssize_t w = ::write(fds[1], data.data() + i, data.size() - i);
+          if (w <= 0)
+            break;
+          i += w;
+        }
+      });
+
+  asio::error_code send_ec;
+  std::size_t sent = 0;
+  asio::async_send_file(a, fds[0], 0, data.size(),
+      [&](const asio::error_code& e, std::size_t bytes)
+      {
+        send_ec = e;
+        sent = bytes;
+      });
+
+  std::string received(data.size(), '\0');
+  asio::error_code read_ec;
+  std::size_t read = 0;
+  asio::async_read(b, asio::buffer(&received[0], received.size()),
+      [&](const asio::error_code& e, std::size_t bytes)
+      {
+        read_ec = e;
+        read = bytes;
+      });
+
+  ioc.run();
+  writer.join();
+
+  ASIO_CHECK(!send_ec);
+  ASIO_CHECK(sent == data.size());
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(read == data.size());
+  ASIO_CHECK(received == data);
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+
+void test_async_pipe_abandoned()
+{
+  int fds[2];
+  ASIO_CHECK(::pipe(fds) == 0);
+
+  {
+    asio::io_context ioc;
+    tcp::socket a(ioc), b(ioc);
+    connect_pair(ioc, a, b);
+
+    bool called = false;
+    asio::async_send_file(a, fds[0], 0, 3,
+        [&](const asio::error_code&, std::size_t)
+        {
+          called = true;
+        });
+    ioc.poll();
+    ASIO_CHECK(!called);
+  }
+
+  // The pipe is released, not closed, when the operation is destroyed.
+  ASIO_CHECK(::fcntl(fds[0], F_GETFD) != -1);
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+
+void test_not_supported()
+{
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  int fd = ::open("/dev/null", O_RDONLY);
+  ASIO_CHECK(fd != -1);
+
+  asio::error_code ec;
+  std::size_t n = asio::send_file(a, fd, 0, 3, ec);
+  ASIO_CHECK(ec == asio::error::operation_not_supported);
+  ASIO_CHECK(n == 0);
+
+  bool called = false;
+  asio::async_send_file(a, fd, 0, 3,
+      [&](const asio::error_code& e, std::size_t bytes)
+      {
+        called = true;
+        ASIO_CHECK(e == asio::error::operation_not_supported);
+        ASIO_CHECK(bytes == 0);
+      });
+  ioc.run();
+  ASIO_CHECK(called);
+
+  ::close(fd);
+}
+
+void test_peer_reset()
+{
+  // SIGPIPE is left at its default disposition, which terminates the process
+  // if it is raised.
+  asio::io_context ioc;
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(ioc, a, b);
+
+  b.set_option(asio::socket_base::linger(true, 0));
+  b.close();
+
+  std::string data = make_data(64 * 1024);
+  temp_file f(data);
+
+  asio::error_code ec;
+  for (int i = 0; i < 100 && !ec; ++i)
+    asio::send_file(a, f.fd, 0, data.size(), ec);
+  ASIO_CHECK(ec == asio::error::broken_pipe
+      || ec == asio::error::connection_reset);
+}
+
+} // namespace send_file_test
+
+ASIO_TEST_SUITE
+(
+  "send_file",
+  ASIO_TEST_CASE(send_file_test::test_sync)
+  ASIO_TEST_CASE(send_file_test::test_async)
+  ASIO_TEST_CASE(send_file_test::test_pipe)
+  ASIO_TEST_CASE(send_file_test::test_async_pipe)
+  ASIO_TEST_CASE(send_file_test::test_async_pipe_abandoned)
+  ASIO_TEST_CASE(send_file_test::test_not_supported)
+  ASIO_TEST_CASE(send_file_test::test_peer_reset)
+)
+
+#else // defined(ASIO_HAS_SENDFILE)
+
+ASIO_TEST_SUITE
+(
+  "send_file",
+)
+
+#endif // defined(ASIO_HAS_SENDFILE)
@@ -0,0 +1,252 @@
+//
+// system_timer.cpp
+// ~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/service/timer/system_timer.hpp"
+
+#include <string>
+#include "asio.hpp"
+#include "asio/detail/reactor/timeQueue/timer_queue.hpp"
+#include "asio/detail/reactor/wait_op.hpp"
+#include "unit_test.hpp"
+
+namespace system_timer_test {
+
+namespace chrono = asio::chrono;
+
+typedef asio::detail::chrono_time_traits<chrono::steady_clock,
+    asio::wait_traits<chrono::steady_clock> > steady_traits;
+typedef asio::detail::chrono_time_traits<chrono::system_clock,
+    asio::wait_traits<chrono::system_clock> > system_traits;
+
+// Wait traits that differ from the default, and so have no native clock.
+struct custom_wait_traits
+{
+  static chrono::steady_clock::duration to_wait_duration(
+      const chrono::steady_clock::duration& d)
+  {
+    return d;
+  }
+
+  static chrono::steady_clock::duration to_wait_duration(
+      const chrono::steady_clock::time_point& t)
+  {
+    return t - chrono::steady_clock::now();
+  }
+};
+
+typedef asio::detail::chrono_time_traits<
+    chrono::steady_clock, custom_wait_traits> custom_traits;
+
+// A wait operation that does nothing when completed or destroyed.
+struct null_op : asio::detail::wait_op
+{
+  null_op() : asio::detail::wait_op(&null_op::do_complete) {}
+
+  static void do_complete(void*, asio::detail::operation*,
+      const asio::error_code&, std::size_t)
+  {
+  }
+};
+
+void test_native_clock()
+{
+  using asio::detail::timer_queue;
+  using asio::detail::timer_queue_base;
+
+  timer_queue<steady_traits> steady_queue;
+  timer_queue<system_traits> system_queue;
+  timer_queue<custom_traits> custom_queue;
+
+#if defined(ASIO_HAS_TIMERFD)
+  ASIO_CHECK(steady_queue.native_clock() == timer_queue_base::monotonic_clock);
+  ASIO_CHECK(system_queue.native_clock() == timer_queue_base::realtime_clock);
+#endif // defined(ASIO_HAS_TIMERFD)
+  ASIO_CHECK(custom_queue.native_clock() == timer_queue_base::other_clock);
+}
+
+void test_chrono_to_timespec()
+{
+#if defined(ASIO_HAS_TIMERFD)
+  using asio::detail::chrono_to_timespec;
+
+  chrono::steady_clock::time_point t(chrono::seconds(12)
+      + chrono::nanoseconds(345678901));
+  timespec ts = chrono_to_timespec(t);
+  ASIO_CHECK(ts.tv_sec == 12);
+  ASIO_CHECK(ts.tv_nsec == 345678901);
+
+  // Times at or before the epoch become the earliest time that arms a timer
+  // descriptor, rather than zero, which would disarm it.
+  ts = chrono_to_timespec(chrono::steady_clock::time_point());
+  ASIO_CHECK(ts.tv_sec == 0);
+  ASIO_CHECK(ts.tv_nsec == 1);
+  ts = chrono_to_timespec(chrono::system_clock::time_point(
+        -chrono::hours(1)));
+  ASIO_CHECK(ts.tv_sec == 0);
+  ASIO_CHECK(ts.tv_nsec == 1);
+
+  // The largest time point does not overflow.
+  ts = chrono_to_timespec(chrono::steady_clock::time_point::max());
+  ASIO_CHECK(ts.tv_sec > 0);
+  ASIO_CHECK(ts.tv_nsec >= 0 && ts.tv_nsec < 1000000000);
+#endif // defined(ASIO_HAS_TIMERFD)
+}
+
+void test_earliest_expiry()
+{
+#if defined(ASIO_HAS_TIMERFD)
+  using asio::detail::timer_queue;
+  using asio::detail::op_queue;
+  using asio::detail::operation;
+
+  timer_queue<system_traits> q;
+  timespec ts;
+  ASIO_CHECK(!q.earliest_expiry(ts));
+
+  chrono::system_clock::time_point now = chrono::system_clock::now();
+  timer_queue<system_traits>::per_timer_data t1, t2;
+  null_op op1, op2;
+  q.enqueue_timer(now + chrono::seconds(20), t1, &op1);
+  q.enqueue_timer(now + chrono::seconds(10), t2, &op2);
+
+  // The earliest expiry is reported on the clock's own timeline.
+  timespec expected = asio::detail::chrono_to_timespec(
+      now + chrono::seconds(10));
+  ASIO_CHECK(q.earliest_expiry(ts));
+  ASIO_CHECK(ts.tv_sec == expected.tv_sec);
+  ASIO_CHECK(ts.tv_nsec == expected.tv_nsec);
+
+  op_queue<operation> ops;
+  q.cancel_timer(t2, ops);
+  expected = asio::detail::chrono_to_timespec(now + chrono::seconds(20));
+  ASIO_CHECK(q.earliest_expiry(ts));
+  ASIO_CHECK(ts.tv_sec == expected.tv_sec);
+
+  q.cancel_timer(t1, ops);
+  ASIO_CHECK(!q.earliest_expiry(ts));
+
+  // A queue with no native clock never reports an absolute expiry.
+  timer_queue<custom_traits> custom;
+  timer_queue<custom_traits>::per_timer_data t3;
+  null_op op3;
+  custom.enqueue_timer(chrono::steady_clock::now(), t3, &op3);
+  ASIO_CHECK(!custom.earliest_expiry(ts));
+  custom.cancel_timer(t3, ops);
+#endif // defined(ASIO_HAS_TIMERFD)
+}
+
+void test_system_timer_fires_at_expiry()
+{
+  asio::io_context ioc;
+  asio::system_timer t(ioc);
+
+  chrono::system_clock::time_point expiry
+    = chrono::system_clock::now() + chrono::milliseconds(50);
+  t.expires_at(expiry);
+
+  asio::error_code result = asio::error::would_block;
+  chrono::system_clock::time_point fired;
+  t.async_wait([&](const asio::error_code& ec)
+      {
+        result = ec;
+        fired = chrono::system_clock::now();
+      });
+  ioc.run();
+
+  ASIO_CHECK(!result);
+  ASIO_CHECK(fired >= expiry);
+  ASIO_CHECK(fired < expiry + chrono::seconds(2));
+}
+
+void test_expired_system_timer()
+{
+  asio::io_context ioc;
+  asio::system_timer t(ioc);
+  t.expires_at(chrono::system_clock::now() - chrono::hours(1));
+
+  bool called = false;
+  t.async_wait([&](const asio::error_code& ec)
+      {
+        called = !ec;
+      });
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(chrono::steady_clock::now() - start < chrono::seconds(1));
+}
+
+void test_mixed_clocks()
+{
+  asio::io_context ioc;
+  asio::system_timer sys(ioc);
+  asio::steady_timer steady(ioc);
+  asio::high_resolution_timer high(ioc);
+  std::string order;
+
+  // Arm the latest timer first, so that the timer descriptors must be re-armed
+  // as earlier timers are added.
+  sys.expires_after(chrono::milliseconds(60));
+  sys.async_wait([&](const asio::error_code& ec)
+      {
+        if (!ec) order += 's';
+      });
+  high.expires_after(chrono::milliseconds(30));
+  high.async_wait([&](const asio::error_code& ec)
+      {
+        if (!ec) order += 'h';
+      });
+  steady.expires_after(chrono::milliseconds(5));
+  steady.async_wait([&](const asio::error_code& ec)
+      {
+        if (!ec) order += 'm';
+      });
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  ioc.run();
+  ASIO_CHECK(order == "mhs");
+  ASIO_CHECK(chrono::steady_clock::now() - start >= chrono::milliseconds(60));
+}
+
+void test_cancel_system_timer()
+{
+  asio::io_context ioc;
+  asio::system_timer long_timer(ioc), short_timer(ioc);
+
+  long_timer.expires_after(chrono::seconds(30));
+  asio::error_code long_ec;
+  long_timer.async_wait([&](const asio::error_code& ec)
+      {
+        long_ec = ec;
+      });
+
+  // Cancelling the long timer from a shorter one must not leave the reactor
+  // waiting on the long timer's expiry.
+  short_timer.expires_after(chrono::milliseconds(10));
+  short_timer.async_wait([&](const asio::error_code&)
+      {
+        long_timer.cancel();
+      });
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  ioc.run();
+  ASIO_CHECK(long_ec == asio::error::operation_aborted);
+  ASIO_CHECK(chrono::steady_clock::now() - start < chrono::seconds(5));
+}
+
+} // namespace system_timer_test
+
+ASIO_TEST_SUITE
+(
+  "system_timer",
+  ASIO_TEST_CASE(system_timer_test::test_native_clock)
+  ASIO_TEST_CASE(system_timer_test::test_chrono_to_timespec)
+  ASIO_TEST_CASE(system_timer_test::test_earliest_expiry)
+  ASIO_TEST_CASE(system_timer_test::test_system_timer_fires_at_expiry)
+  ASIO_TEST_CASE(system_timer_test::test_expired_system_timer)
+  ASIO_TEST_CASE(system_timer_test::test_mixed_clocks)
+  ASIO_TEST_CASE(system_timer_test::test_cancel_system_timer)
+)
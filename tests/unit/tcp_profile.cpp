@@ -0,0 +1,197 @@
+//
+// tcp_profile.cpp
+// ~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/ip/tcp_profile.hpp"
+
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+using asio::ip::tcp;
+
+namespace tcp_profile_test {
+
+void connect_pair(tcp::acceptor& acceptor, tcp::socket& a, tcp::socket& b)
+{
+  acceptor.open(tcp::v4());
+  acceptor.bind(tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  acceptor.listen();
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+}
+
+void test_options()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc);
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(acceptor, a, b);
+
+#if defined(ASIO_OS_DEF_TCP_CORK)
+  a.set_option(tcp::cork(true));
+  tcp::cork cork;
+  a.get_option(cork);
+  ASIO_CHECK(cork.value());
+  a.set_option(tcp::cork(false));
+  a.get_option(cork);
+  ASIO_CHECK(!cork.value());
+#endif // defined(ASIO_OS_DEF_TCP_CORK)
+
+#if defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+  a.set_option(tcp::notsent_low_watermark(32768));
+  tcp::notsent_low_watermark lowat;
+  a.get_option(lowat);
+  ASIO_CHECK(lowat.value() == 32768);
+#endif // defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+
+#if defined(ASIO_OS_DEF_TCP_DEFER_ACCEPT)
+  asio::error_code ec;
+  acceptor.set_option(tcp::defer_accept(5), ec);
+  ASIO_CHECK(!ec);
+#endif // defined(ASIO_OS_DEF_TCP_DEFER_ACCEPT)
+}
+
+void test_empty()
+{
+  asio::ip::tcp_profile p;
+  ASIO_CHECK(p.empty());
+  p.no_delay(true);
+  ASIO_CHECK(!p.empty());
+}
+
+void test_set_profile()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc);
+  tcp::socket a(ioc), b(ioc);
+  connect_pair(acceptor, a, b);
+
+  asio::ip::tcp_profile latency;
+  latency.no_delay(true);
+#if defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+  latency.notsent_low_watermark(16384);
+#endif // defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+
+  asio::error_code ec;
+  a.set_profile(latency, ec);
+  ASIO_CHECK(!ec);
+
+  tcp::no_delay no_delay;
+  a.get_option(no_delay);
+  ASIO_CHECK(no_delay.value());
+#if defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+  tcp::notsent_low_watermark lowat;
+  a.get_option(lowat);
+  ASIO_CHECK(lowat.value() == 16384);
+#endif // defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+
+  // Switching profiles changes only the options that differ.
+  asio::ip::tcp_profile bulk;
+  bulk.no_delay(false);
+#if defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+  bulk.notsent_low_watermark(16384);
+#endif // defined(ASIO_OS_DEF_TCP_NOTSENT_LOWAT)
+  a.set_profile(bulk, latency, ec);
+  ASIO_CHECK(!ec);
+  a.get_option(no_delay);
+  ASIO_CHECK(!no_delay.value());
+}
+
+void test_accepted()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc, tcp::v4());
+  tcp::socket a(ioc), b(ioc);
+
+  asio::ip::tcp_profile p;
+  p.no_delay(true);
+  asio::error_code ec;
+  acceptor.set_profile(p, ec);
+  ASIO_CHECK(!ec);
+  acceptor.bind(tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  acceptor.listen();
+  a.connect(acceptor.local_endpoint());
+  acceptor.accept(b);
+
+#if defined(__linux__)
+  // Linux passes no_delay on to accepted sockets.
+  tcp::no_delay no_delay;
+  b.get_option(no_delay);
+  ASIO_CHECK(no_delay.value());
+#endif // defined(__linux__)
+
+  // Options that are not inherited are set by applying the profile to the
+  // accepted socket.
+#if defined(ASIO_OS_DEF_TCP_QUICKACK)
+  p.quick_ack(true);
+  b.set_profile(p, ec);
+  ASIO_CHECK(!ec);
+  tcp::quick_ack quick_ack;
+  b.get_option(quick_ack);
+  ASIO_CHECK(quick_ack.value());
+#endif // defined(ASIO_OS_DEF_TCP_QUICKACK)
+}
+
+void test_roles()
+{
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc, tcp::v4());
+  tcp::socket s(ioc, tcp::v4());
+
+  // Listener-only options are not applied to a connection, and connect-only
+  // options are not applied to a listener.
+  asio::ip::tcp_profile p;
+  p.defer_accept(5).fast_open_connect(true);
+  asio::error_code ec;
+#if defined(ASIO_OS_DEF_TCP_FASTOPEN_CONNECT)
+  s.set_profile(p, ec);
+  ASIO_CHECK(!ec);
+#endif // defined(ASIO_OS_DEF_TCP_FASTOPEN_CONNECT)
+#if defined(ASIO_OS_DEF_TCP_DEFER_ACCEPT)
+  acceptor.set_profile(p, ec);
+  ASIO_CHECK(!ec);
+  tcp::defer_accept defer_accept;
+  acceptor.get_option(defer_accept);
+  ASIO_CHECK(defer_accept.value() > 0);
+#endif // defined(ASIO_OS_DEF_TCP_DEFER_ACCEPT)
+  (void)ec;
+}
+
+void test_unsupported()
+{
+  asio::io_context ioc;
+  tcp::socket s(ioc);
+  asio::ip::tcp_profile p;
+  p.no_delay(true);
+
+  // Applying a profile to a closed socket fails.
+  asio::error_code ec;
+  s.set_profile(p, ec);
+  ASIO_CHECK(!!ec);
+
+  bool threw = false;
+  try
+  {
+    s.set_profile(p);
+  }
+  catch (asio::system_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+}
+
+} // namespace tcp_profile_test
+
+ASIO_TEST_SUITE
+(
+  "tcp_profile",
+  ASIO_TEST_CASE(tcp_profile_test::test_options)
+  ASIO_TEST_CASE(tcp_profile_test::test_empty)
+  ASIO_TEST_CASE(tcp_profile_test::test_set_profile)
+  ASIO_TEST_CASE(tcp_profile_test::test_accepted)
+  ASIO_TEST_CASE(tcp_profile_test::test_roles)
+  ASIO_TEST_CASE(tcp_profile_test::test_unsupported)
+)
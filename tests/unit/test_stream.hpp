@@ -0,0 +1,119 @@
+#ifndef TEST_STREAM_HPP
+#define TEST_STREAM_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include "asio.hpp"
+
+// A stream that reads from a fixed string, returning at most next_read_length
+// bytes from each read, so that tests can control how data is split across
+// reads. Written data is appended to a separate string.
+class test_stream
+{
+public:
+  typedef asio::io_context::executor_type executor_type;
+
+  explicit test_stream(asio::io_context& io_context)
+    : io_context_(io_context),
+      position_(0),
+      next_read_length_(0)
+  {
+  }
+
+  executor_type get_executor() ASIO_NOEXCEPT
+  {
+    return io_context_.get_executor();
+  }
+
+  void reset(const std::string& data, std::size_t next_read_length)
+  {
+    data_ = data;
+    position_ = 0;
+    next_read_length_ = next_read_length;
+    written_.clear();
+  }
+
+  const std::string& written() const
+  {
+    return written_;
+  }
+
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    std::size_t n = next_read_length_;
+    if (n > data_.size() - position_)
+      n = data_.size() - position_;
+    if (n == 0 && asio::buffer_size(buffers) > 0)
+    {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    ec = asio::error_code();
+    n = asio::buffer_copy(buffers, asio::buffer(data_.data() + position_, n));
+    position_ += n;
+    return n;
+  }
+
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    std::size_t n = read_some(buffers, ec);
+    asio::detail::throw_error(ec, "read_some");
+    return n;
+  }
+
+  template <typename MutableBufferSequence, typename Handler>
+  void async_read_some(const MutableBufferSequence& buffers,
+      Handler&& handler)
+  {
+    asio::error_code ec;
+    std::size_t n = read_some(buffers, ec);
+    asio::post(io_context_,
+        asio::detail::bind_handler(
+          static_cast<Handler&&>(handler), ec, n));
+  }
+
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers,
+      asio::error_code& ec)
+  {
+    std::size_t n = asio::buffer_size(buffers);
+    std::size_t old_size = written_.size();
+    written_.resize(old_size + n);
+    asio::buffer_copy(asio::buffer(&written_[old_size], n), buffers);
+    ec = asio::error_code();
+    return n;
+  }
+
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers)
+  {
+    asio::error_code ec;
+    return write_some(buffers, ec);
+  }
+
+  template <typename ConstBufferSequence, typename Handler>
+  void async_write_some(const ConstBufferSequence& buffers,
+      Handler&& handler)
+  {
+    asio::error_code ec;
+    std::size_t n = write_some(buffers, ec);
+    asio::post(io_context_,
+        asio::detail::bind_handler(
+          static_cast<Handler&&>(handler), ec, n));
+  }
+
+private:
+  asio::io_context& io_context_;
+  std::string data_;
+  std::size_t position_;
+  std::size_t next_read_length_;
+  std::string written_;
+};
+
+#endif // TEST_STREAM_HPP
@@ -0,0 +1,271 @@
+//
+// timer_group.cpp
+// ~~~~~~~~~~~~~~~
+//
+
+// Give each thread its own timer queue where possible.
+#define ASIO_TIMER_QUEUE_SHARDS 4
+
+// Test that header file is self-contained.
+#include "asio/service/timer/basic_timer_group.hpp"
+
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+namespace timer_group_test {
+
+using asio::steady_timer;
+using asio::steady_timer_group;
+namespace chrono = asio::chrono;
+
+struct wait_counter
+{
+  int* aborted;
+  int* fired;
+
+  void operator()(const asio::error_code& ec) const
+  {
+    if (ec == asio::error::operation_aborted)
+      ++*aborted;
+    else if (!ec)
+      ++*fired;
+  }
+};
+
+void test_membership()
+{
+  asio::io_context ioc;
+  steady_timer_group group(ioc);
+  ASIO_CHECK(group.size() == 0);
+
+  steady_timer t1(ioc), t2(ioc);
+  t1.join(group);
+  t2.join(group);
+  ASIO_CHECK(group.size() == 2);
+
+  // Joining again does not add the timer twice.
+  t1.join(group);
+  ASIO_CHECK(group.size() == 2);
+
+  t1.leave_group();
+  ASIO_CHECK(group.size() == 1);
+
+  // A timer leaves its group when it is destroyed.
+  {
+    steady_timer t3(ioc);
+    t3.join(group);
+    ASIO_CHECK(group.size() == 2);
+  }
+  ASIO_CHECK(group.size() == 1);
+
+  // Joining another group leaves the first.
+  steady_timer_group other(ioc);
+  t2.join(other);
+  ASIO_CHECK(group.size() == 0);
+  ASIO_CHECK(other.size() == 1);
+}
+
+void test_cancel()
+{
+  asio::io_context ioc;
+  steady_timer_group group(ioc);
+  int aborted = 0, fired = 0;
+  wait_counter counter = { &aborted, &fired };
+
+  steady_timer t1(ioc), t2(ioc), t3(ioc), outsider(ioc);
+  t1.join(group);
+  t2.join(group);
+  t3.join(group);
+
+  t1.expires_after(chrono::seconds(10));
+  t2.expires_after(chrono::seconds(10));
+  t3.expires_after(chrono::seconds(10));
+  t1.async_wait(counter);
+  t2.async_wait(counter);
+  t2.async_wait(counter);
+  // t3 has no pending wait.
+
+  // A timer outside the group is unaffected.
+  outsider.expires_after(chrono::milliseconds(1));
+  outsider.async_wait(counter);
+
+  ASIO_CHECK(group.cancel() == 3);
+  ioc.run();
+  ASIO_CHECK(aborted == 3);
+  ASIO_CHECK(fired == 1);
+
+  // Nothing is left to cancel.
+  ASIO_CHECK(group.cancel() == 0);
+
+  // Members may wait again after the group is cancelled.
+  ioc.restart();
+  t1.expires_after(chrono::milliseconds(1));
+  t1.async_wait(counter);
+  ioc.run();
+  ASIO_CHECK(fired == 2);
+}
+
+void test_expires_after()
+{
+  asio::io_context ioc;
+  steady_timer_group group(ioc);
+  int aborted = 0, fired = 0;
+  wait_counter counter = { &aborted, &fired };
+
+  steady_timer t1(ioc), t2(ioc);
+  t1.join(group);
+  t2.join(group);
+  t1.expires_after(chrono::seconds(10));
+  t1.async_wait(counter);
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  ASIO_CHECK(group.expires_after(chrono::milliseconds(20)) == 1);
+
+  // Both members have the new expiry time, whether or not they were waiting.
+  ASIO_CHECK(t1.expiry() == t2.expiry());
+  ASIO_CHECK(t1.expiry() >= start + chrono::milliseconds(20));
+
+  t1.async_wait(counter);
+  t2.async_wait(counter);
+  ioc.run();
+  ASIO_CHECK(aborted == 1);
+  ASIO_CHECK(fired == 2);
+  ASIO_CHECK(chrono::steady_clock::now() >= start + chrono::milliseconds(20));
+
+  chrono::steady_clock::time_point at = chrono::steady_clock::now();
+  ASIO_CHECK(group.expires_at(at) == 0);
+  ASIO_CHECK(t1.expiry() == at);
+  ASIO_CHECK(t2.expiry() == at);
+}
+
+void test_destroy_group()
+{
+  asio::io_context ioc;
+  int aborted = 0, fired = 0;
+  wait_counter counter = { &aborted, &fired };
+
+  steady_timer t(ioc);
+  {
+    steady_timer_group group(ioc);
+    t.join(group);
+    t.expires_after(chrono::milliseconds(1));
+    t.async_wait(counter);
+  }
+
+  // The timer is otherwise unaffected, and may leave or join again.
+  t.leave_group();
+  ioc.run();
+  ASIO_CHECK(fired == 1);
+  ASIO_CHECK(aborted == 0);
+
+  steady_timer_group group(ioc);
+  t.join(group);
+  ASIO_CHECK(group.size() == 1);
+}
+
+void test_move()
+{
+  asio::io_context ioc;
+  steady_timer_group group(ioc);
+  int aborted = 0, fired = 0;
+  wait_counter counter = { &aborted, &fired };
+
+  steady_timer t1(ioc);
+  t1.join(group);
+  t1.expires_after(chrono::seconds(10));
+  t1.async_wait(counter);
+
+  // The moved-to timer takes the group membership with it.
+  steady_timer t2(std::move(t1));
+  ASIO_CHECK(group.size() == 1);
+
+  steady_timer t3(ioc);
+  t3 = std::move(t2);
+  ASIO_CHECK(group.size() == 1);
+
+  ASIO_CHECK(group.cancel() == 1);
+  ioc.run();
+  ASIO_CHECK(aborted == 1);
+}
+
+void test_other_io_context()
+{
+  asio::io_context ioc1, ioc2;
+  steady_timer_group group(ioc1);
+  steady_timer t(ioc2);
+
+  bool threw = false;
+  try
+  {
+    t.join(group);
+  }
+  catch (asio::system_error&)
+  {
+    threw = true;
+  }
+  ASIO_CHECK(threw);
+  ASIO_CHECK(group.size() == 0);
+}
+
+void test_group_queue()
+{
+  typedef asio::detail::deadline_timer_service<
+    asio::detail::chrono_time_traits<chrono::steady_clock,
+      asio::wait_traits<chrono::steady_clock> > > service_type;
+
+  asio::io_context ioc;
+  service_type& service = asio::use_service<service_type>(ioc);
+  service_type::group_type group;
+  service.construct_group(group);
+  service_type::implementation_type waiter, ticker;
+  service.construct(waiter);
+  service.construct(ticker);
+  asio::error_code ec;
+  service.join_group(waiter, group, ec);
+  service.join_group(ticker, group, ec);
+
+  // Members start their waits on the group's queue, whichever thread starts
+  // them.
+  int aborted = 0, fired = 0;
+  wait_counter counter = { &aborted, &fired };
+  auto tick_counter = [counter](const asio::error_code& e, std::size_t)
+  {
+    counter(e);
+  };
+  std::thread([&]
+      {
+        service.expires_after(waiter, chrono::seconds(10), ec);
+        service.async_wait(waiter, counter);
+        service.start_periodic(ticker,
+            chrono::steady_clock::now() + chrono::seconds(10),
+            chrono::seconds(1), false, tick_counter);
+      }).join();
+  ASIO_CHECK(waiter.queue_index == group.queue_index);
+  ASIO_CHECK(ticker.queue_index == group.queue_index);
+
+  ASIO_CHECK(service.cancel_group(group, ec) == 2);
+  ioc.run();
+  ASIO_CHECK(aborted == 2);
+  ASIO_CHECK(fired == 0);
+
+  service.destroy(waiter);
+  service.destroy(ticker);
+  service.destroy_group(group);
+}
+
+} // namespace timer_group_test
+
+ASIO_TEST_SUITE
+(
+  "timer_group",
+  ASIO_TEST_CASE(timer_group_test::test_membership)
+  ASIO_TEST_CASE(timer_group_test::test_cancel)
+  ASIO_TEST_CASE(timer_group_test::test_expires_after)
+  ASIO_TEST_CASE(timer_group_test::test_destroy_group)
+  ASIO_TEST_CASE(timer_group_test::test_move)
+  ASIO_TEST_CASE(timer_group_test::test_other_io_context)
+  ASIO_TEST_CASE(timer_group_test::test_group_queue)
+)
@@ -0,0 +1,168 @@
+//
+// timer_metrics.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+
+// Collect timer metrics in this test.
+#define ASIO_ENABLE_TIMER_METRICS 1
+
+// Test that header file is self-contained.
+#include "asio/core/timer_metrics.hpp"
+
+#include <cstddef>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+namespace timer_metrics_test {
+
+namespace chrono = asio::chrono;
+
+asio::uint64_t lateness_total(const asio::timer_metrics& m)
+{
+  asio::uint64_t total = 0;
+  for (std::size_t i = 0; i < asio::timer_metrics::lateness_buckets; ++i)
+    total += m.lateness[i];
+  return total;
+}
+
+void null_handler(const asio::error_code&)
+{
+}
+
+void test_default()
+{
+  asio::timer_metrics m;
+  ASIO_CHECK(m.timer_count == 0);
+  ASIO_CHECK(m.queue_sizes.empty());
+  ASIO_CHECK(m.fired == 0);
+  ASIO_CHECK(m.cancelled == 0);
+  ASIO_CHECK(lateness_total(m) == 0);
+  ASIO_CHECK(m.timerfd_settime_calls == 0);
+  ASIO_CHECK(m.cancel_fire_ratio() == 0.0);
+
+  m.fired = 4;
+  m.cancelled = 2;
+  ASIO_CHECK(m.cancel_fire_ratio() == 0.5);
+}
+
+void test_queue_sizes()
+{
+  asio::io_context ioc;
+  asio::steady_timer s1(ioc), s2(ioc);
+  asio::system_timer sys(ioc);
+
+  s1.expires_after(chrono::seconds(10));
+  s2.expires_after(chrono::seconds(10));
+  sys.expires_after(chrono::seconds(10));
+  s1.async_wait(&null_handler);
+  s1.async_wait(&null_handler);
+  s2.async_wait(&null_handler);
+  sys.async_wait(&null_handler);
+
+  // One queue per clock. Each timer is counted once however many waits it has.
+  asio::timer_metrics m = ioc.get_timer_metrics();
+  ASIO_CHECK(m.queue_sizes.size() == 2);
+  ASIO_CHECK(m.timer_count == 3);
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < m.queue_sizes.size(); ++i)
+    total += m.queue_sizes[i];
+  ASIO_CHECK(total == 3);
+
+  s1.cancel();
+  m = ioc.get_timer_metrics();
+  ASIO_CHECK(m.timer_count == 2);
+  ASIO_CHECK(m.cancelled == 2);
+
+  s2.cancel();
+  sys.cancel();
+  ioc.run();
+  m = ioc.get_timer_metrics();
+  ASIO_CHECK(m.timer_count == 0);
+  ASIO_CHECK(m.cancelled == 4);
+  ASIO_CHECK(m.fired == 0);
+}
+
+void test_fired_and_cancelled()
+{
+  asio::io_context ioc;
+  asio::steady_timer t1(ioc), t2(ioc), t3(ioc);
+
+  t1.expires_after(chrono::milliseconds(1));
+  t1.async_wait(&null_handler);
+  t1.async_wait(&null_handler);
+  t2.expires_after(chrono::milliseconds(2));
+  t2.async_wait(&null_handler);
+  t3.expires_after(chrono::seconds(10));
+  t3.async_wait(&null_handler);
+
+  // Setting the expiry cancels the pending wait.
+  t3.expires_after(chrono::seconds(10));
+  t3.async_wait(&null_handler);
+  t3.cancel();
+
+  ioc.run();
+
+  asio::timer_metrics m = ioc.get_timer_metrics();
+  ASIO_CHECK(m.fired == 3);
+  ASIO_CHECK(m.cancelled == 2);
+  ASIO_CHECK(lateness_total(m) == m.fired);
+  ASIO_CHECK(m.cancel_fire_ratio() == 2.0 / 3.0);
+  ASIO_CHECK(m.timer_count == 0);
+}
+
+void test_lateness()
+{
+  asio::io_context ioc;
+  asio::steady_timer t(ioc);
+
+  // A timer that expired 700ms ago is between 2^19 and 2^20 microseconds
+  // late when it is dequeued, and so is counted in bucket 20.
+  t.expires_at(chrono::steady_clock::now() - chrono::milliseconds(700));
+  t.async_wait(&null_handler);
+  ioc.run();
+
+  asio::timer_metrics m = ioc.get_timer_metrics();
+  ASIO_CHECK(m.fired == 1);
+  ASIO_CHECK(m.lateness[20] == 1);
+  ASIO_CHECK(lateness_total(m) == 1);
+
+  // A timer that expired long ago is counted in the last bucket.
+  ioc.restart();
+  t.expires_at(chrono::steady_clock::now() - chrono::hours(24 * 365));
+  t.async_wait(&null_handler);
+  ioc.run();
+
+  m = ioc.get_timer_metrics();
+  ASIO_CHECK(m.fired == 2);
+  ASIO_CHECK(m.lateness[asio::timer_metrics::lateness_buckets - 1] == 1);
+  ASIO_CHECK(lateness_total(m) == 2);
+}
+
+void test_timerfd_settime_calls()
+{
+  asio::io_context ioc;
+  asio::steady_timer t(ioc);
+
+  t.expires_after(chrono::milliseconds(1));
+  t.async_wait(&null_handler);
+  ioc.run();
+
+  asio::timer_metrics m = ioc.get_timer_metrics();
+#if defined(ASIO_HAS_TIMERFD)
+  ASIO_CHECK(m.timerfd_settime_calls > 0);
+#else // defined(ASIO_HAS_TIMERFD)
+  ASIO_CHECK(m.timerfd_settime_calls == 0);
+#endif // defined(ASIO_HAS_TIMERFD)
+}
+
+} // namespace timer_metrics_test
+
+ASIO_TEST_SUITE
+(
+  "timer_metrics",
+  ASIO_TEST_CASE(timer_metrics_test::test_default)
+  ASIO_TEST_CASE(timer_metrics_test::test_queue_sizes)
+  ASIO_TEST_CASE(timer_metrics_test::test_fired_and_cancelled)
+  ASIO_TEST_CASE(timer_metrics_test::test_lateness)
+  ASIO_TEST_CASE(timer_metrics_test::test_timerfd_settime_calls)
+)
@@ -0,0 +1,118 @@
+//
+// timer_queue_locking.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+
+// Test that header file is self-contained.
+#include "asio/detail/reactor/timeQueue/timer_queue_set.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "asio.hpp"
+#include "unit_test.hpp"
+
+namespace timer_queue_locking_test {
+
+void test_concurrent_arm_cancel()
+{
+  asio::io_context ioc;
+  asio::executor_work_guard<asio::io_context::executor_type> work(
+      ioc.get_executor());
+
+  std::vector<std::thread> runners;
+  for (int i = 0; i < 4; ++i)
+    runners.push_back(std::thread([&]{ ioc.run(); }));
+
+  // Several threads arm and cancel timers while others run the reactor.
+  const int producers = 4;
+  const int timers_per_producer = 500;
+  std::atomic<int> fired(0), aborted(0), other(0);
+  std::atomic<int> completed[producers];
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p)
+  {
+    completed[p] = 0;
+    threads.push_back(std::thread([&, p]
+    {
+      std::vector<std::unique_ptr<asio::steady_timer> > timers;
+      for (int i = 0; i < timers_per_producer; ++i)
+      {
+        // Every third timer is cancelled, well before it would expire.
+        asio::chrono::microseconds expiry(i % 3 == 0
+            ? 10000000 : (i * 37 + p) % 2000);
+        timers.push_back(std::unique_ptr<asio::steady_timer>(
+              new asio::steady_timer(ioc, expiry)));
+        timers.back()->async_wait(
+            [&, p](const asio::error_code& ec)
+            {
+              if (!ec)
+                ++fired;
+              else if (ec == asio::error::operation_aborted)
+                ++aborted;
+              else
+                ++other;
+              ++completed[p];
+            });
+        if (i % 3 == 0)
+          timers.back()->cancel();
+      }
+
+      // The timers must outlive their waits.
+      while (completed[p] < timers_per_producer)
+        std::this_thread::sleep_for(asio::chrono::milliseconds(1));
+    }));
+  }
+
+  for (std::size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+  work.reset();
+  for (std::size_t i = 0; i < runners.size(); ++i)
+    runners[i].join();
+
+  ASIO_CHECK(fired + aborted == producers * timers_per_producer);
+  ASIO_CHECK(other == 0);
+  ASIO_CHECK(aborted == producers * ((timers_per_producer + 2) / 3));
+}
+
+struct self_owned_wait
+{
+  std::shared_ptr<asio::steady_timer> timer;
+  std::shared_ptr<int> token;
+
+  void operator()(const asio::error_code&)
+  {
+  }
+};
+
+void test_shutdown_releases_timers()
+{
+  std::weak_ptr<int> token;
+  {
+    asio::io_context ioc;
+    std::shared_ptr<int> t(new int(0));
+    token = t;
+
+    // Each timer is owned only by its own pending wait, so it is destroyed
+    // when the reactor abandons the wait at shutdown.
+    for (int i = 0; i < 10; ++i)
+    {
+      std::shared_ptr<asio::steady_timer> timer(
+          new asio::steady_timer(ioc, asio::chrono::hours(1)));
+      self_owned_wait w = { timer, t };
+      timer->async_wait(w);
+    }
+    ASIO_CHECK(!token.expired());
+  }
+  ASIO_CHECK(token.expired());
+}
+
+} // namespace timer_queue_locking_test
+
+ASIO_TEST_SUITE
+(
+  "timer_queue_locking",
+  ASIO_TEST_CASE(timer_queue_locking_test::test_concurrent_arm_cancel)
+  ASIO_TEST_CASE(timer_queue_locking_test::test_shutdown_releases_timers)
+)
@@ -0,0 +1,92 @@
+#ifndef UNIT_TEST_HPP
+#define UNIT_TEST_HPP
+
+#include "asio/detail/config.hpp"
+#include <iostream>
+
+namespace asio {
+namespace detail {
+
+inline const char*& test_name()
+{
+  static const char* name = 0;
+  return name;
+}
+
+inline long& test_errors()
+{
+  static long errors = 0;
+  return errors;
+}
+
+inline void begin_test_suite(const char* name)
+{
+  std::cerr << name << " test suite begins" << std::endl;
+}
+
+inline int end_test_suite(const char* name)
+{
+  std::cerr << name << " test suite ends" << std::endl;
+  std::cerr << "\n*** ";
+  long errors = test_errors();
+  if (errors == 0)
+    std::cerr << "No errors detected.";
+  else if (errors == 1)
+    std::cerr << "1 error detected.";
+  else
+    std::cerr << errors << " errors detected." << std::endl;
+  std::cerr << std::endl;
+  return errors == 0 ? 0 : 1;
+}
+
+template <void (*Test)()>
+void run_test(const char* name)
+{
+  test_name() = name;
+  long errors_before = test_errors();
+  Test();
+  if (test_errors() == errors_before)
+    std::cerr << name << " passed" << std::endl;
+  else
+    std::cerr << name << " failed" << std::endl;
+}
+
+} // namespace detail
+} // namespace asio
+
+#define ASIO_CHECK(expr) \
+  do { if (!(expr)) { \
+    std::cerr << __FILE__ << "(" << __LINE__ << "): " \
+      << asio::detail::test_name() << ": " \
+      << "check '" << #expr << "' failed" << std::endl; \
+    ++asio::detail::test_errors(); \
+  } } while (0)
+
+#define ASIO_CHECK_MESSAGE(expr, msg) \
+  do { if (!(expr)) { \
+    std::cerr << __FILE__ << "(" << __LINE__ << "): " \
+      << asio::detail::test_name() << ": " \
+      << msg << std::endl; \
+    ++asio::detail::test_errors(); \
+  } } while (0)
+
+#define ASIO_ERROR(msg) \
+  do { \
+    std::cerr << __FILE__ << "(" << __LINE__ << "): " \
+      << asio::detail::test_name() << ": " \
+      << msg << std::endl; \
+    ++asio::detail::test_errors(); \
+  } while (0)
+
+#define ASIO_TEST_SUITE(name, tests) \
+  int main() \
+  { \
+    asio::detail::begin_test_suite(name); \
+    tests \
+    return asio::detail::end_test_suite(name); \
+  }
+
+#define ASIO_TEST_CASE(test) \
+  asio::detail::run_test<&test>(#test);
+
+#endif // UNIT_TEST_HPP